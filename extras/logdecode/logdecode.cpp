@@ -0,0 +1,87 @@
+// =============================================================================
+// logdecode.cpp — AMOURANTH RTX Engine © 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. Creative Commons Attribution-NonCommercial 4.0 International (CC BY-NC 4.0)
+//    https://creativecommons.org/licenses/by-nc/4.0/
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// Decodes a binary amouranth_engine.log (LOG_BINARY_FILE = true) back into the
+// same plain-text layout the engine writes in text mode.
+//
+// Usage: ./logdecode [amouranth_engine.log] [-o out.txt]
+// =============================================================================
+
+#include "engine/GLOBAL/logging.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace {
+
+std::string deltaString(int64_t deltaNs) {
+    const int64_t deltaUs = deltaNs / 1'000;
+    if (deltaUs < 10'000)        return std::format("{:>7}µs", deltaUs);
+    if (deltaUs < 1'000'000)     return std::format("{:>7.3f}ms", deltaUs / 1'000.0);
+    if (deltaUs < 60'000'000)    return std::format("{:>7.3f}s", deltaUs / 1'000'000.0);
+    if (deltaUs < 3'600'000'000) return std::format("{:>7.1f}m", deltaUs / 60'000'000.0);
+    return std::format("{:>7.1f}h", deltaUs / 3'600'000'000.0);
+}
+
+std::string timeString(int64_t epochNs, int64_t deltaNs) {
+    const std::time_t tt = static_cast<std::time_t>((epochNs + deltaNs) / 1'000'000'000);
+    std::tm tm = *std::localtime(&tt);
+    char buf[9];
+    std::strftime(buf, sizeof(buf), "%H:%M:%S", &tm);
+    return buf;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string inPath = "amouranth_engine.log";
+    std::string outPath;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) outPath = argv[++i];
+        else if (arg == "-h" || arg == "--help") {
+            std::cout << "Usage: " << argv[0] << " [amouranth_engine.log] [-o out.txt]\n";
+            return 0;
+        }
+        else inPath = arg;
+    }
+
+    std::ifstream in(inPath, std::ios::binary);
+    if (!in) {
+        std::cerr << "logdecode: cannot open " << inPath << '\n';
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!outPath.empty()) file.open(outPath);
+    std::ostream& out = outPath.empty() ? std::cout : file;
+
+    Logging::Binary::Reader reader(in);
+    Logging::Binary::DecodedLine line;
+    uint64_t count = 0;
+    try {
+        while (reader.next(line)) {
+            const auto levelIdx = std::min<size_t>(static_cast<size_t>(line.level), Logging::LEVEL_INFOS.size() - 1);
+            out << std::format("{:<{}} {:>{}} {:>{}} [{:>{}}] [{:>{}}] {}\n{}:{}:{}\n\n",
+                               Logging::LEVEL_INFOS[levelIdx].str, LEVEL_WIDTH,
+                               deltaString(line.deltaNs), DELTA_WIDTH,
+                               timeString(line.epochNs, line.deltaNs), TIME_WIDTH,
+                               line.category, CAT_WIDTH,
+                               line.threadId, THREAD_WIDTH,
+                               line.message,
+                               line.file, line.line, line.function);
+            ++count;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << " after " << count << " record(s)\n";
+        return 2;
+    }
+    return 0;
+}
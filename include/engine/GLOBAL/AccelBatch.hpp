@@ -0,0 +1,100 @@
+// include/engine/GLOBAL/AccelBatch.hpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// ACCELERATION STRUCTURE BATCHES — scratch packing + batch recording
+//   ScratchPlan is pure packing math, ScratchSizing the scratch pool's
+//   grow/release policy. recordBuildBatches() and
+//   recordCompactedSizes() record from the device and entry points they are
+//   handed — no engine context, no buffer tracker — so
+//   VulkanAccel::createBLASBatch and the tests run the same code:
+//   tests/unit/test_scratch_plan.cpp packs on the host,
+//   tests/unit/test_scratch_pool.cpp drives ScratchSizing frame by frame,
+//   tests/device/test_blas_batch.cpp builds 1000 meshes on a headless device.
+// =============================================================================
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// =============================================================================
+// SCRATCH PLAN — no Vulkan calls. Builds are packed in order into batches
+// whose aligned scratch fits the budget; every batch starts at offset 0 of
+// one shared arena (reused after a barrier), so the arena is as large as the
+// largest batch. A build bigger than the budget gets a batch to itself.
+// =============================================================================
+struct ScratchPlan
+{
+    std::vector<VkDeviceSize> offsets;      // per build, from the arena base
+    std::vector<uint32_t>     batchStart;   // first build of each batch; batch b ends at batchStart[b+1]
+    VkDeviceSize              arenaSize = 0;
+
+    [[nodiscard]] uint32_t batchCount() const noexcept { return static_cast<uint32_t>(batchStart.size()); }
+    [[nodiscard]] uint32_t batchEnd(uint32_t b) const noexcept {
+        return b + 1 < batchStart.size() ? batchStart[b + 1] : static_cast<uint32_t>(offsets.size());
+    }
+
+    // alignment: minAccelerationStructureScratchOffsetAlignment (a power of two; 0 = 1)
+    [[nodiscard]] static ScratchPlan pack(std::span<const VkDeviceSize> sizes, VkDeviceSize alignment, VkDeviceSize budget);
+};
+
+// =============================================================================
+// SCRATCH SIZING — no Vulkan calls. What ScratchPool (LAS.hpp) allocates and
+// when it lets go: grow-only, capacity = the high-water mark rounded to the
+// alignment, released after idleLimit ticks without a request. After a
+// release the high-water mark starts over.
+// =============================================================================
+class ScratchSizing
+{
+public:
+    void setAlignment(VkDeviceSize alignment) noexcept { alignment_ = alignment ? alignment : 1; }
+
+    // true: (re)allocate capacity() bytes — nothing held yet, or size no longer fits
+    [[nodiscard]] bool request(VkDeviceSize size) noexcept;
+    // Once per frame — true: release the buffer now
+    [[nodiscard]] bool tick(uint32_t idleLimit) noexcept;
+    void released() noexcept;
+
+    [[nodiscard]] bool         held()      const noexcept { return held_; }
+    [[nodiscard]] VkDeviceSize alignment() const noexcept { return alignment_; }
+    [[nodiscard]] VkDeviceSize capacity()  const noexcept { return capacity_; }
+    [[nodiscard]] VkDeviceSize highWater() const noexcept { return highWater_; }
+    [[nodiscard]] uint32_t     idle()      const noexcept { return idle_; }
+    [[nodiscard]] uint32_t     grows()     const noexcept { return grows_; }
+
+private:
+    VkDeviceSize capacity_  = 0;
+    VkDeviceSize highWater_ = 0;
+    VkDeviceSize alignment_ = 256;
+    uint32_t     idle_      = 0;
+    uint32_t     grows_     = 0;
+    bool         held_      = false;
+};
+
+// Build output → the same build stage reading it (query, copy, or the next build sharing scratch)
+void accelBuildBarrier(VkCommandBuffer cmd) noexcept;
+
+// Points infos[i] at arena + plan.offsets[i], then one build call per batch, each
+// behind accelBuildBarrier() — the batch before it (or any earlier build) is done
+// with the arena. No barrier after the last batch.
+void recordBuildBatches(VkCommandBuffer cmd, PFN_vkCmdBuildAccelerationStructuresKHR build,
+                        const ScratchPlan& plan, VkDeviceAddress arena,
+                        std::span<VkAccelerationStructureBuildGeometryInfoKHR> infos,
+                        std::span<const VkAccelerationStructureBuildRangeInfoKHR* const> ranges);
+
+// Compacted sizes of every structure through one query pool: query i is structures[i],
+// reset and written by one call each. Record after the builds and an accelBuildBarrier().
+// The caller destroys the pool once the results are read; VK_NULL_HANDLE if it can't be made.
+[[nodiscard]] VkQueryPool recordCompactedSizes(VkDevice device, VkCommandBuffer cmd,
+                                               PFN_vkCmdWriteAccelerationStructuresPropertiesKHR write,
+                                               std::span<const VkAccelerationStructureKHR> structures);
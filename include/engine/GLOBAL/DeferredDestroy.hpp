@@ -0,0 +1,89 @@
+// include/engine/GLOBAL/DeferredDestroy.hpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// DEFERRED DESTRUCTION — RETIRE NOW, DESTROY WHEN THE FENCE SAYS SO
+//   Every frame submit bumps a serial. retire(fn) tags fn with the serial of
+//   the NEXT submit (the one that may still be recorded against the resource)
+//   and queues it; fenceSignaled(slot) runs everything whose serial the GPU
+//   has passed. Tags only grow, so the queue is FIFO and collection is a
+//   front pop — no sort, no scan.
+//   A fence covers every earlier submit on its queue, so one-time builds
+//   (LAS, uploads) that were submitted before a frame are covered too.
+//
+//   BUFFER_DESTROY and Handle<T>::retire() go through here. reset() and
+//   tracker.destroy() stay immediate for paths that must have the object
+//   gone right now (swapchain recreation, shutdown after idle).
+//   drain() after vkDeviceWaitIdle runs everything; shutdown() also turns
+//   retire() into an immediate call for whatever is torn down after it.
+// =============================================================================
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace RTX {
+
+class DeferredDestroyQueue {
+public:
+    static constexpr uint32_t MAX_SLOTS = 8;          // ≥ Options::Performance::MAX_FRAMES_IN_FLIGHT
+
+    using Fn = std::function<void()>;
+
+    DeferredDestroyQueue() = default;
+    ~DeferredDestroyQueue() = default;
+    DeferredDestroyQueue(const DeferredDestroyQueue&) = delete;
+    DeferredDestroyQueue& operator=(const DeferredDestroyQueue&) = delete;
+
+    // Destroy once the next frame submit has completed (immediately after shutdown())
+    void retire(Fn fn);
+
+    // Call right after vkQueueSubmit with that frame's fence
+    void submitted(uint32_t slot) noexcept;
+
+    // Call right after vkWaitForFences on the slot's fence
+    void fenceSignaled(uint32_t slot);
+
+    // Every submitted frame is known complete (all frame fences waited)
+    void allSignaled();
+
+    // Device is idle — run everything still queued
+    void drain();
+
+    // drain() and destroy immediately from now on
+    void shutdown();
+
+    [[nodiscard]] size_t   pending()   const noexcept;
+    [[nodiscard]] size_t   highWater() const noexcept;
+    [[nodiscard]] uint64_t serial()    const noexcept;
+
+private:
+    struct Entry {
+        uint64_t serial = 0;
+        Fn       fn;
+    };
+
+    void collect(uint64_t completed);                 // runs entries with serial ≤ completed
+
+    mutable std::mutex mutex_;
+    std::deque<Entry>  entries_;
+    std::array<uint64_t, MAX_SLOTS> slotSerial_{};    // serial of each slot's last submit
+    uint64_t submitted_ = 0;
+    uint64_t completed_ = 0;
+    size_t   highWater_ = 0;
+    bool     closed_    = false;
+};
+
+[[nodiscard]] DeferredDestroyQueue& retireQueue() noexcept;
+
+} // namespace RTX
@@ -0,0 +1,180 @@
+// include/engine/GLOBAL/DeviceHeap.hpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// DEVICE HEAP — BLOCK SUB-ALLOCATOR BEHIND UltraLowLevelBufferTracker
+//   One vkAllocateMemory per 64/128/256 MB block (picked from the heap size),
+//   blocks kept per memory type. Ranges inside a block are handed out by a
+//   two-level segregated fit (TLSF) allocator — O(1) alloc/free, immediate
+//   coalescing. Requests larger than half a block get a dedicated allocation.
+//   Host-visible blocks are mapped once at creation; map() is base + offset.
+//   Ranges in host-visible, non-coherent types are padded to
+//   nonCoherentAtomSize on both ends, so flush()/invalidate() can round a
+//   sub-range out to whole atoms without touching a neighbour or running
+//   past the end of the VkDeviceMemory. Both are no-ops on coherent memory.
+//
+//   bufferImageGranularity: blocks are tagged linear (buffers) or optimal
+//   (images) and never mix, so neighbouring ranges can't alias a page of the
+//   other kind — only memReq.alignment applies inside a block.
+// =============================================================================
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace RTX {
+
+// ========================================================================
+// TLSF range allocator — offsets only, no headers in GPU memory
+// ========================================================================
+class TlsfRanges {
+public:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    TlsfRanges() = default;
+    explicit TlsfRanges(VkDeviceSize capacity);
+
+    // Returns a node id (NIL on failure); offsetOut is aligned to `alignment`
+    [[nodiscard]] uint32_t allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offsetOut);
+    void free(uint32_t node) noexcept;
+
+    [[nodiscard]] VkDeviceSize capacity()    const noexcept { return capacity_; }
+    [[nodiscard]] VkDeviceSize used()        const noexcept { return used_; }
+    [[nodiscard]] uint32_t     allocations() const noexcept { return allocations_; }
+    [[nodiscard]] uint32_t     freeRanges()  const noexcept { return freeRanges_; }
+    [[nodiscard]] VkDeviceSize largestFree() const noexcept;
+
+private:
+    static constexpr uint32_t SL_LOG    = 4;
+    static constexpr uint32_t SL_COUNT  = 1u << SL_LOG;
+    static constexpr uint32_t SMALL_LOG = 8;             // < 256 B: linear 16 B classes
+    static constexpr uint32_t FL_COUNT  = 48;
+
+    struct Node {
+        VkDeviceSize offset = 0;
+        VkDeviceSize size   = 0;
+        uint32_t prevPhys = NIL, nextPhys = NIL;
+        uint32_t prevFree = NIL, nextFree = NIL;
+        bool     free     = false;
+    };
+
+    static void mapping(VkDeviceSize size, uint32_t& fl, uint32_t& sl) noexcept;
+    [[nodiscard]] uint32_t findFree(VkDeviceSize size) const noexcept;
+    [[nodiscard]] uint32_t newNode();
+    void releaseNode(uint32_t n) noexcept;
+    void insertFree(uint32_t n) noexcept;
+    void removeFree(uint32_t n) noexcept;
+
+    std::vector<Node>     nodes_;
+    std::vector<uint32_t> spare_;
+    uint64_t flBitmap_ = 0;
+    std::array<uint32_t, FL_COUNT> slBitmap_{};
+    std::array<std::array<uint32_t, SL_COUNT>, FL_COUNT> heads_{};
+    VkDeviceSize capacity_    = 0;
+    VkDeviceSize used_        = 0;
+    uint32_t     allocations_ = 0;
+    uint32_t     freeRanges_  = 0;
+};
+
+// ========================================================================
+// Device heap
+// ========================================================================
+enum class HeapResource : uint8_t { Linear, Optimal };
+
+struct HeapAllocation {
+    VkDeviceMemory memory     = VK_NULL_HANDLE;
+    VkDeviceSize   offset     = 0;
+    VkDeviceSize   size       = 0;
+    void*          mapped     = nullptr;      // base + offset when host-visible
+    uint32_t       block      = UINT32_MAX;   // UINT32_MAX → dedicated
+    uint32_t       node       = TlsfRanges::NIL;
+    uint32_t       memoryType = UINT32_MAX;
+    bool           coherent   = true;         // false → host writes/reads need flush()/invalidate()
+
+    [[nodiscard]] bool valid()     const noexcept { return memory != VK_NULL_HANDLE; }
+    [[nodiscard]] bool dedicated() const noexcept { return block == UINT32_MAX; }
+};
+
+struct HeapStats {
+    uint64_t     deviceAllocations = 0;   // live vkAllocateMemory objects (blocks + dedicated)
+    uint64_t     subAllocations    = 0;   // live ranges inside blocks
+    uint64_t     dedicated         = 0;
+    uint64_t     blocks            = 0;
+    VkDeviceSize reservedBytes     = 0;   // sum of block sizes + dedicated sizes
+    VkDeviceSize usedBytes         = 0;
+    double       fragmentation     = 0.0; // 1 - largestFree/totalFree, worst block
+};
+
+class DeviceHeap {
+public:
+    DeviceHeap() = default;
+    ~DeviceHeap() = default;
+    DeviceHeap(const DeviceHeap&) = delete;
+    DeviceHeap& operator=(const DeviceHeap&) = delete;
+
+    void init(VkDevice device, VkPhysicalDevice physicalDevice) noexcept;
+
+    // excludeBlock lets the defragmenter allocate anywhere but the block it is emptying
+    [[nodiscard]] HeapAllocation allocate(const VkMemoryRequirements& req, VkMemoryPropertyFlags props,
+                                          HeapResource kind, std::string_view tag,
+                                          uint32_t excludeBlock = UINT32_MAX);
+    void free(const HeapAllocation& a) noexcept;
+    void releaseAll() noexcept;
+
+    // Host writes → device / device writes → host for [offset, offset+size) of a.
+    // offset/size are relative to the allocation; VK_WHOLE_SIZE runs to its end.
+    void flush(const HeapAllocation& a, VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE) const noexcept;
+    void invalidate(const HeapAllocation& a, VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE) const noexcept;
+
+    // Defragmentation hook — least-occupied block that has a sibling of the
+    // same type to move into (UINT32_MAX if nothing is worth moving)
+    [[nodiscard]] uint32_t sparsestBlock() const noexcept;
+
+    [[nodiscard]] HeapStats stats() const noexcept;
+    void logStats(std::string_view when) const;
+
+    [[nodiscard]] VkDeviceSize bufferImageGranularity() const noexcept { return granularity_; }
+
+private:
+    struct Block {
+        VkDeviceMemory memory     = VK_NULL_HANDLE;
+        VkDeviceSize   size       = 0;
+        void*          mapped     = nullptr;
+        uint32_t       memoryType = UINT32_MAX;
+        HeapResource   kind       = HeapResource::Linear;
+        TlsfRanges     ranges;
+    };
+
+    [[nodiscard]] uint32_t findMemoryType(uint32_t typeBits, VkMemoryPropertyFlags props) const noexcept;
+    [[nodiscard]] VkDeviceSize blockSizeFor(uint32_t memoryType) const noexcept;
+    [[nodiscard]] VkDeviceMemory allocateMemory(uint32_t memoryType, VkDeviceSize size, void** mapped) noexcept;
+    void freeBlockLocked(uint32_t index) noexcept;
+    [[nodiscard]] bool atomRange(const HeapAllocation& a, VkDeviceSize offset, VkDeviceSize size,
+                                 VkMappedMemoryRange& out) const noexcept;
+
+    mutable std::mutex mutex_;
+    VkDevice device_ = VK_NULL_HANDLE;
+    VkPhysicalDeviceMemoryProperties memProps_{};
+    VkDeviceSize granularity_ = 1;
+    VkDeviceSize atom_        = 1;                   // nonCoherentAtomSize
+
+    std::vector<std::unique_ptr<Block>> blocks_;     // null slots are reused
+    uint64_t     dedicatedCount_ = 0;
+    VkDeviceSize dedicatedBytes_ = 0;
+};
+
+[[nodiscard]] DeviceHeap& deviceHeap() noexcept;
+
+} // namespace RTX
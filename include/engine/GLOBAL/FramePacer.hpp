@@ -0,0 +1,189 @@
+// include/engine/GLOBAL/FramePacer.hpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// FRAME PACER — TIMELINE-SEMAPHORE FRAME SLOTS + JUST-IN-TIME CPU START
+//   Every graphics submit signals one timeline semaphore with the frame's
+//   serial. A frame slot is free once the serial last submitted on it has
+//   passed: waitSlot() replaces the per-slot fence wait/reset dance. There is
+//   no reset, so a frame abandoned between acquire and submit (swapchain out
+//   of date) leaves nothing unsignaled behind it.
+//
+//   pace() runs first thing in the frame and decides WHEN the CPU starts:
+//     deadline(N) = next point on the target-period grid
+//     wake(N)     = deadline(N) − (predicted CPU + predicted GPU + margin)
+//   and sleeps until wake — sleep_for for the bulk, a yield-spin for the last
+//   FRAME_PACING_SPIN_MS. The application calls it before polling input, so
+//   input is as fresh as the target allows. The prediction is the smoothed
+//   CPU + GPU mean plus twice their combined deviation; the GPU also queues
+//   behind whatever is still predicted in flight. Samples: CPU = pace() →
+//   submit, GPU = GpuProfiler frame span (or, with timestamps off, submit →
+//   slot wait return whenever that wait blocked).
+//
+//   With VK_KHR_present_id + present_wait every present carries its serial
+//   and pace() first waits for an earlier frame to reach the display — N−1
+//   while CPU + GPU fit one period, N−2 when they don't (so the CPU overlaps
+//   the GPU instead of halving the rate). That display time re-phases the
+//   deadline grid, so deadlines sit on real vblanks and a miss moves the grid
+//   by whole periods. Without it the grid free-runs on steady_clock and a
+//   late frame re-anchors it at "now".
+//
+//   FpsTarget::FPS_UNLIMITED (period 0) or ENABLE_FRAME_PREDICTION = false
+//   turn pace() into a no-op; slots and the timeline work the same.
+//   PacingModel is the whole policy with time passed in — no Vulkan, no
+//   clock — so a host-only harness can feed it simulated CPU/GPU durations.
+// =============================================================================
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace RTX {
+
+// =============================================================================
+// PACING MODEL — pure policy; times are steady_clock nanoseconds
+// =============================================================================
+class PacingModel {
+public:
+    struct Stats {
+        double   meanErrorMs = 0.0;   // |observed − deadline|
+        double   p99ErrorMs  = 0.0;
+        double   budgetMs    = 0.0;   // predicted CPU + GPU (+ spread, + margin)
+        uint64_t frames      = 0;     // observed frames
+        uint64_t late        = 0;     // observed past deadline + margin
+        uint64_t missed      = 0;     // plans that had to skip / re-anchor
+    };
+
+    static constexpr uint32_t HISTORY = 256;
+
+    void setPeriod(int64_t periodNs) noexcept { period_ = periodNs; next_ = 0; }
+    void setMargin(int64_t marginNs) noexcept { margin_ = marginNs; }
+    // Grid locked to observed display times: a miss skips whole periods instead of re-anchoring
+    void setDisplayLocked(bool locked) noexcept { locked_ = locked; }
+    [[nodiscard]] int64_t period() const noexcept { return period_; }
+
+    // Deadline for frame serial; returns when its CPU work should start (never before now)
+    [[nodiscard]] int64_t plan(uint64_t serial, int64_t now) noexcept;
+
+    // The frame was submitted at t — its GPU work queues behind the previous frame's
+    void submitted(int64_t t) noexcept;
+
+    void cpuSample(int64_t ns) noexcept { cpu_.add(static_cast<double>(ns)); }
+    void gpuSample(int64_t ns) noexcept { gpu_.add(static_cast<double>(ns)); }
+
+    // Frame serial reached the display (or finished) at t; display-locked grids re-phase to it
+    void observe(uint64_t serial, int64_t t) noexcept;
+
+    // Frames allowed between "displayed" and "CPU starts": 1 while CPU + GPU fit one
+    // period (lowest latency), 2 when they don't (CPU overlaps the previous frame's GPU)
+    [[nodiscard]] uint32_t queueDepth() const noexcept { return period_ > 0 && budget() > period_ ? 2u : 1u; }
+
+    [[nodiscard]] int64_t budget()           const noexcept;   // predicted CPU + GPU + spread + margin
+    [[nodiscard]] int64_t deadline(uint64_t serial) const noexcept;  // 0 if no longer remembered
+    [[nodiscard]] Stats   stats()            const;
+    void reset() noexcept;
+
+private:
+    struct Estimator {
+        double mean   = 0.0;
+        double dev    = 0.0;
+        bool   primed = false;
+        void add(double x) noexcept;
+    };
+
+    static constexpr uint32_t PLANNED = 8;        // deadlines kept for observe()
+
+    int64_t  period_   = 0;
+    int64_t  margin_   = 500'000;
+    int64_t  next_     = 0;                       // next grid point, 0 = unanchored
+    int64_t  gpuFree_  = 0;                       // predicted end of the GPU work already queued
+    int64_t  shift_    = 0;                       // total phase correction applied to the grid
+    bool     locked_   = false;
+
+    std::array<uint64_t, PLANNED> planSerial_{};
+    std::array<int64_t,  PLANNED> planDeadline_{};
+    std::array<int64_t,  PLANNED> planShift_{};   // shift_ when the plan was made
+
+    Estimator cpu_, gpu_;
+    std::array<double, HISTORY> errorMs_{};
+    uint32_t errorHead_  = 0;
+    uint32_t errorCount_ = 0;
+    double   errorSum_   = 0.0;
+    uint64_t frames_     = 0;
+    uint64_t late_       = 0;
+    uint64_t missed_     = 0;
+};
+
+// =============================================================================
+// FRAME PACER — the Vulkan side
+// =============================================================================
+class FramePacer {
+public:
+    FramePacer() = default;
+    ~FramePacer() = default;                      // destroy() explicitly — device is gone at static teardown
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    [[nodiscard]] bool init(VkDevice device, uint32_t framesInFlight, bool presentWait) noexcept;
+    void destroy() noexcept;                      // waitIdle() first
+
+    void setTargetFps(uint32_t fps) noexcept;     // 0 = unlimited
+
+    // Top of the frame, before input: wait for N−depth on the display (present_wait), then sleep until wake(N)
+    void pace(VkSwapchainKHR swapchain) noexcept;
+
+    // Block until frameIdx's previous submit completed — replaces the in-flight fence
+    void waitSlot(uint32_t frameIdx) noexcept;
+
+    // Serial to signal from this frame's submit; call right before vkQueueSubmit
+    [[nodiscard]] uint64_t submitValue(uint32_t frameIdx) noexcept;
+
+    // Chain into VkPresentInfoKHR when presentWaitEnabled(); presented() after a successful present
+    [[nodiscard]] uint64_t presentId() const noexcept { return submitted_; }
+    void presented(VkSwapchainKHR swapchain, uint64_t id) noexcept;
+
+    // GPU time of the frame just collected (GpuProfiler frame span)
+    void gpuTime(double ms) noexcept;
+
+    // Every submitted frame complete
+    void waitIdle() const noexcept;
+
+    [[nodiscard]] bool        valid()              const noexcept { return timeline_ != VK_NULL_HANDLE; }
+    [[nodiscard]] bool        presentWaitEnabled() const noexcept { return waitForPresent_ != nullptr; }
+    [[nodiscard]] VkSemaphore timeline()           const noexcept { return timeline_; }
+    [[nodiscard]] const PacingModel& model()       const noexcept { return model_; }
+
+private:
+    [[nodiscard]] static int64_t now() noexcept;
+    static void sleepUntil(int64_t t) noexcept;
+
+    VkDevice              device_    = VK_NULL_HANDLE;
+    VkSemaphore           timeline_  = VK_NULL_HANDLE;
+    PFN_vkWaitForPresentKHR waitForPresent_ = nullptr;
+
+    std::vector<uint64_t> slotValue_;             // serial last submitted per frame slot
+    std::array<int64_t, 8> submitTime_{};         // by serial % 8 — GPU fallback samples
+    uint64_t  submitted_   = 0;
+    uint64_t  planned_     = 0;                   // serial pace() last planned
+    int64_t   frameStart_  = 0;
+    bool      gpuTimestamps_ = false;             // gpuTime() feeds the GPU estimate
+
+    VkSwapchainKHR swapchain_      = VK_NULL_HANDLE;
+    uint64_t       firstPresented_ = 0;           // present ids restart meaningfully per swapchain
+    uint64_t       lastPresented_  = 0;
+    uint64_t       lastObserved_   = 0;
+    uint64_t       logged_        = 0;
+
+    PacingModel model_;
+};
+
+} // namespace RTX
@@ -0,0 +1,96 @@
+// include/engine/GLOBAL/FrameRecorder.hpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// FRAME RECORDER — PARALLEL SECONDARY COMMAND BUFFERS, POOLS RESET WHOLESALE
+//   Every frame in flight owns one command pool per worker thread plus one
+//   for the primary. beginFrame(frameIdx) — once that frame's slot is free — resets
+//   all of them with a single vkResetCommandPool each (no per-buffer reset,
+//   no RESET_COMMAND_BUFFER_BIT) and hands back the begun primary.
+//   record() runs the passes as TBB tasks in a private arena: each task
+//   records one secondary from the pool of the thread it landed on, so no
+//   pool is ever touched by two threads. The calling thread then stitches
+//   the secondaries into the primary with ONE vkCmdExecuteCommands, in pass
+//   order — GPU order is exactly the list order, whoever recorded what.
+//
+//   Secondaries inherit no state: each pass binds its own pipeline and
+//   descriptors and starts with the barriers it needs (the RenderGraph
+//   prepends them — see RenderGraph::recordPasses()). Anything that
+//   writes descriptor sets or host memory a pass reads happens BEFORE
+//   record(); pass bodies only read renderer state. Passes never cross a
+//   render pass (there is none — everything is compute / ray tracing).
+//   With Options::Performance::RECORD_THREADS == 1 everything records inline
+//   on the calling thread through the same pools.
+//   A pass whose secondary can't be allocated, begun or ended is never
+//   dropped: it is logged and recorded directly into the primary at its
+//   place in the order (its body may run twice — bodies only record).
+// =============================================================================
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <tbb/task_arena.h>
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace RTX {
+
+struct RecordPass {
+    const char*                          name = "";     // static string — trace scope label
+    std::function<void(VkCommandBuffer)> record;
+};
+
+class FrameRecorder {
+public:
+    FrameRecorder() = default;
+    ~FrameRecorder() = default;                         // destroy() explicitly — device is gone at static teardown
+    FrameRecorder(const FrameRecorder&) = delete;
+    FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+    // threads == 0 → hardware concurrency, capped at Options::Performance::RECORD_THREADS
+    [[nodiscard]] bool init(VkDevice device, uint32_t queueFamily, uint32_t framesInFlight, uint32_t threads = 0) noexcept;
+    void destroy() noexcept;                            // frames must be retired
+
+    // Reset frameIdx's pools and begin its primary — its previous submit must have completed
+    [[nodiscard]] VkCommandBuffer beginFrame(uint32_t frameIdx) noexcept;
+
+    // Record every pass into its own secondary (in parallel), then execute them in order into primary
+    void record(VkCommandBuffer primary, uint32_t frameIdx, std::span<const RecordPass> passes) noexcept;
+
+    [[nodiscard]] bool     valid()   const noexcept { return !frames_.empty(); }
+    [[nodiscard]] uint32_t threads() const noexcept { return threads_; }
+
+private:
+    // One writer per frame: the thread whose arena slot matches the index
+    struct alignas(64) WorkerPool {
+        VkCommandPool                pool = VK_NULL_HANDLE;
+        std::vector<VkCommandBuffer> secondaries;       // grown on demand, reused after each pool reset
+        uint32_t                     used = 0;
+    };
+
+    struct Frame {
+        VkCommandPool           primaryPool = VK_NULL_HANDLE;
+        VkCommandBuffer         primary     = VK_NULL_HANDLE;
+        std::vector<WorkerPool> workers;                // [arena slot]
+    };
+
+    [[nodiscard]] VkCommandBuffer nextSecondary(WorkerPool& w) noexcept;
+    [[nodiscard]] VkCommandBuffer recordPass(uint32_t frameIdx, uint32_t slot, const RecordPass& pass) noexcept;
+
+    VkDevice           device_  = VK_NULL_HANDLE;
+    uint32_t           threads_ = 0;
+    std::vector<Frame> frames_;
+    tbb::task_arena    arena_;
+    std::vector<VkCommandBuffer> recorded_;             // per record() call, indexed by pass
+};
+
+} // namespace RTX
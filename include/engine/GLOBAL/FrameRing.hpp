@@ -0,0 +1,90 @@
+// include/engine/GLOBAL/FrameRing.hpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// FRAME RING — LINEAR PER-FRAME TRANSIENT ALLOCATOR
+//   One host-visible, persistently mapped buffer split into one region per
+//   frame in flight. Per-frame constants (camera UBO, tonemap params, frame
+//   dimensions) are bump-allocated into the current region and bound with
+//   dynamic descriptor offsets — no staging copy, no map/unmap, no barrier.
+//   beginFrame(frameIdx) rewinds that region; call it only after the frame's
+//   slot wait (FramePacer::waitSlot), since the GPU may still be reading it
+//   until then.
+//   Descriptors point at the ring once (offset 0, range = sizeof(T)); only
+//   the dynamic offset changes per frame. flush() before submit covers the
+//   region's used bytes if the driver hands out non-coherent memory.
+// =============================================================================
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace RTX {
+
+struct RingSlice {
+    VkBuffer     buffer = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;          // from the start of the ring buffer
+    VkDeviceSize size   = 0;
+    void*        cpu    = nullptr;
+
+    [[nodiscard]] bool     valid()         const noexcept { return cpu != nullptr; }
+    [[nodiscard]] uint32_t dynamicOffset() const noexcept { return static_cast<uint32_t>(offset); }
+};
+
+class FrameRing {
+public:
+    FrameRing() = default;
+    ~FrameRing() { destroy(); }
+    FrameRing(const FrameRing&) = delete;
+    FrameRing& operator=(const FrameRing&) = delete;
+
+    // Region size is rounded up to the device's UBO/SSBO offset alignment
+    [[nodiscard]] bool init(VkPhysicalDevice physicalDevice, uint32_t framesInFlight, VkDeviceSize bytesPerFrame) noexcept;
+    void destroy() noexcept;
+
+    // Rewind frameIdx's region — its previous submit must have completed
+    void beginFrame(uint32_t frameIdx) noexcept;
+
+    // Invalid slice when the region is exhausted (logged once per frame)
+    [[nodiscard]] RingSlice allocate(VkDeviceSize size) noexcept;
+
+    // Publish this frame's writes before submit — no-op on HOST_COHERENT memory
+    void flush() const noexcept;
+
+    template<class T>
+    [[nodiscard]] RingSlice push(const T& value) noexcept {
+        static_assert(std::is_trivially_copyable_v<T>, "FrameRing::push needs a trivially copyable type");
+        RingSlice s = allocate(sizeof(T));
+        if (s.valid()) std::memcpy(s.cpu, &value, sizeof(T));
+        return s;
+    }
+
+    [[nodiscard]] bool         valid()       const noexcept { return base_ != nullptr; }
+    [[nodiscard]] VkBuffer     buffer()      const noexcept { return buffer_; }
+    [[nodiscard]] VkDeviceSize alignment()   const noexcept { return alignment_; }
+    [[nodiscard]] VkDeviceSize regionSize()  const noexcept { return regionSize_; }
+    [[nodiscard]] VkDeviceSize highWater()   const noexcept { return highWater_; }
+
+private:
+    uint64_t     enc_         = 0;
+    VkBuffer     buffer_      = VK_NULL_HANDLE;
+    uint8_t*     base_        = nullptr;
+    VkDeviceSize alignment_   = 256;
+    VkDeviceSize regionSize_  = 0;
+    VkDeviceSize regionBegin_ = 0;
+    VkDeviceSize head_        = 0;      // absolute offset of the next free byte
+    VkDeviceSize highWater_   = 0;      // most bytes any single frame has used
+    uint32_t     frames_      = 0;
+    bool         overflowed_  = false;
+};
+
+} // namespace RTX
@@ -0,0 +1,119 @@
+// include/engine/GLOBAL/GpuProfiler.hpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// GPU PASS PROFILER — TIMESTAMP QUERIES PER FRAME-IN-FLIGHT
+//   begin()/end() bracket a pass with vkCmdWriteTimestamp2 (falls back to
+//   vkCmdWriteTimestamp without synchronization2). collect() runs right after
+//   the frame's slot wait, so results are already resident — it never blocks.
+//   begin()/end() may run on FrameRecorder workers (one secondary per pass);
+//   beginFrame() and collect() stay on the render thread.
+//   Rolling min/avg/p99 per pass; every sample goes to the trace exporter as a
+//   counter and, with --gpu-csv=<file>, one CSV row per frame.
+//   Devices with timestampValidBits == 0 (or no timestampComputeAndGraphics)
+//   leave the profiler disabled and every call is a no-op.
+// =============================================================================
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "engine/GLOBAL/OptionsMenu.hpp"
+
+enum class GpuPass : uint8_t { RayTrace, Denoise, Histogram, Tonemap, Count };
+
+inline constexpr std::array<const char*, static_cast<size_t>(GpuPass::Count)> GPU_PASS_NAMES = {
+    "RayTrace", "Denoise", "Histogram", "Tonemap"
+};
+
+class GpuProfiler {
+public:
+    static constexpr uint32_t PASS_COUNT     = static_cast<uint32_t>(GpuPass::Count);
+    static constexpr uint32_t QUERIES_PER_FRAME = PASS_COUNT * 2;
+    static constexpr uint32_t HISTORY        = 256;   // rolling window per pass
+
+    static_assert(QUERIES_PER_FRAME * Options::Performance::MAX_FRAMES_IN_FLIGHT <= Options::Performance::GPU_TIMESTAMP_QUERY_COUNT,
+                  "GPU_TIMESTAMP_QUERY_COUNT too small for passes × frames in flight");
+
+    struct Stats {
+        double   lastMs  = 0.0;
+        double   minMs   = 0.0;
+        double   avgMs   = 0.0;
+        double   p99Ms   = 0.0;
+        uint32_t samples = 0;
+    };
+
+    GpuProfiler() = default;
+    ~GpuProfiler() { destroy(); }
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    // CSV target picked up by the next init() — set from the command line
+    static void setCsvPath(std::string path) { csvPath() = std::move(path); }
+
+    // queueFamilies: every family a bracketed pass is recorded for — the narrowest timestampValidBits wins
+    void init(VkDevice device, VkPhysicalDevice physicalDevice, std::span<const uint32_t> queueFamilies,
+              uint32_t framesInFlight, bool synchronization2) noexcept;
+    void destroy() noexcept;
+
+    [[nodiscard]] bool enabled() const noexcept { return pool_ != VK_NULL_HANDLE; }
+
+    // Once frameIdx's previous submit completed: harvest its results; true if lastFrameMs() is fresh
+    bool collect(uint32_t frameIdx) noexcept;
+    // First thing recorded in the frame's command buffer
+    void beginFrame(VkCommandBuffer cmd, uint32_t frameIdx, uint64_t frameNumber) noexcept;
+    void begin(VkCommandBuffer cmd, uint32_t frameIdx, GpuPass pass) noexcept;
+    void end(VkCommandBuffer cmd, uint32_t frameIdx, GpuPass pass) noexcept;
+
+    [[nodiscard]] Stats stats(GpuPass pass) const;
+    // GPU span of the last collected frame (first begin → last end), 0 before the first
+    [[nodiscard]] double lastFrameMs() const noexcept { return lastFrameMs_; }
+
+private:
+    struct FrameSlot {
+        uint64_t frameNumber = 0;
+        uint32_t writtenMask = 0;   // bit per pass with both timestamps recorded
+        bool     pending     = false;
+    };
+
+    struct History {
+        std::array<double, HISTORY> ms{};
+        uint32_t head  = 0;
+        uint32_t count = 0;
+        double   last  = 0.0;
+    };
+
+    [[nodiscard]] uint32_t query(uint32_t frameIdx, GpuPass pass, bool end) const noexcept {
+        return frameIdx * QUERIES_PER_FRAME + static_cast<uint32_t>(pass) * 2 + (end ? 1u : 0u);
+    }
+    void writeTimestamp(VkCommandBuffer cmd, uint32_t queryIndex, bool end) const noexcept;
+    void logSummary() const;
+
+    static std::string& csvPath() { static std::string path; return path; }
+
+    VkDevice    device_         = VK_NULL_HANDLE;
+    VkQueryPool pool_           = VK_NULL_HANDLE;
+    uint32_t    framesInFlight_ = 0;
+    double      nsPerTick_      = 0.0;
+    uint64_t    tickMask_       = ~0ull;
+    bool        sync2_          = false;
+    uint64_t    collected_      = 0;
+    double      lastFrameMs_    = 0.0;
+
+    std::vector<FrameSlot>                 slots_;
+    std::array<History, PASS_COUNT>        history_{};
+    std::vector<uint64_t>                  results_;   // [ticks, available] pairs
+    std::FILE*                             csv_ = nullptr;
+};
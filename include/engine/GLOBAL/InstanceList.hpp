@@ -0,0 +1,144 @@
+// include/engine/GLOBAL/InstanceList.hpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// TLAS INSTANCES ON THE HOST — TLASInstance, the glm → VkTransformMatrixKHR
+// conversion and the instance list LAS keeps. Header-only, Vulkan types and
+// glm only: tests/unit/test_tlas_instances.cpp drives it without a device.
+// =============================================================================
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// =============================================================================
+// TLAS INSTANCES — per-instance custom index, mask, SBT record offset, flags
+// =============================================================================
+struct TLASInstance
+{
+    VkAccelerationStructureKHR  blas        = VK_NULL_HANDLE;
+    glm::mat4                   transform   { 1.0f };
+    uint32_t                    customIndex = 0;      // gl_InstanceCustomIndexEXT (24 bits)
+    uint8_t                     mask        = 0xFF;   // ANDed with the trace's cull mask
+    uint32_t                    sbtOffset   = 0;      // hit group record offset (24 bits)
+    VkGeometryInstanceFlagsKHR  flags       = VK_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR;
+};
+
+// glm is column-major (m[column][row]); VkTransformMatrixKHR is a row-major 3x4 —
+// the top three rows of the matrix, translation in column 3
+[[nodiscard]] inline VkTransformMatrixKHR toTransform(const glm::mat4& m) noexcept
+{
+    VkTransformMatrixKHR t{};
+    for (int r = 0; r < 3; ++r)
+        for (int c = 0; c < 4; ++c)
+            t.matrix[r][c] = m[c][r];
+    return t;
+}
+
+[[nodiscard]] inline VkAccelerationStructureInstanceKHR makeInstance(const TLASInstance& in, VkDeviceAddress blasAddress) noexcept
+{
+    VkAccelerationStructureInstanceKHR inst{};
+    inst.transform                              = toTransform(in.transform);
+    inst.instanceCustomIndex                    = in.customIndex & 0xFFFFFFu;
+    inst.mask                                   = in.mask;
+    inst.instanceShaderBindingTableRecordOffset = in.sbtOffset & 0xFFFFFFu;
+    inst.flags                                  = static_cast<VkGeometryInstanceFlagsKHR>(in.flags & 0xFFu);
+    inst.accelerationStructureReference         = blasAddress;
+    return inst;
+}
+
+// =============================================================================
+// INSTANCE LIST — host copy of the TLAS instances plus, per instance, which
+// device copies ("regions" — one per frame slot, one for blocking builds) are
+// stale. Edits only touch the host copy and mark the instance stale
+// everywhere; flush(region) hands back the coalesced stale runs for that
+// region, so a frame writes just what changed since that region last saw it.
+// No Vulkan calls — a host-only harness can drive it.
+// =============================================================================
+class InstanceList
+{
+public:
+    static constexpr uint32_t MAX_REGIONS = 8;
+
+    void setRegions(uint32_t regions) noexcept {
+        regions_ = regions == 0 ? 1u : (regions > MAX_REGIONS ? MAX_REGIONS : regions);
+        invalidate();
+    }
+    [[nodiscard]] uint32_t regions() const noexcept { return regions_; }
+
+    uint32_t add(const VkAccelerationStructureInstanceKHR& inst) {
+        inst_.push_back(inst);
+        stale_.push_back(0);
+        touch(static_cast<uint32_t>(inst_.size() - 1));
+        return static_cast<uint32_t>(inst_.size() - 1);
+    }
+    // Unchanged values don't dirty anything; true when something changed
+    bool set(uint32_t i, const VkAccelerationStructureInstanceKHR& inst) noexcept {
+        if (std::memcmp(&inst_[i], &inst, sizeof(inst)) == 0) return false;
+        inst_[i] = inst;
+        touch(i);
+        return true;
+    }
+    bool setTransform(uint32_t i, const VkTransformMatrixKHR& transform) noexcept {
+        if (std::memcmp(&inst_[i].transform, &transform, sizeof(transform)) == 0) return false;
+        inst_[i].transform = transform;
+        touch(i);
+        return true;
+    }
+
+    // Every region lost its contents (reallocated) — all of it is stale
+    void invalidate() noexcept {
+        const uint8_t all = allRegions();
+        std::fill(stale_.begin(), stale_.end(), all);
+        staleCount_.fill(0);
+        for (uint32_t r = 0; r < regions_; ++r) staleCount_[r] = static_cast<uint32_t>(inst_.size());
+    }
+    void clear() noexcept { inst_.clear(); stale_.clear(); staleCount_.fill(0); }
+
+    [[nodiscard]] uint32_t size() const noexcept { return static_cast<uint32_t>(inst_.size()); }
+    [[nodiscard]] const VkAccelerationStructureInstanceKHR* data() const noexcept { return inst_.data(); }
+    [[nodiscard]] const VkAccelerationStructureInstanceKHR& operator[](uint32_t i) const noexcept { return inst_[i]; }
+    [[nodiscard]] uint32_t staleCount(uint32_t region) const noexcept { return staleCount_[region]; }
+
+    // write(first, count) once per run stale in region; the region is current afterwards
+    template<class Write>
+    void flush(uint32_t region, Write&& write) {
+        if (staleCount_[region] == 0) return;
+        const uint8_t bit = static_cast<uint8_t>(1u << region);
+        const uint32_t n = size();
+        for (uint32_t i = 0; i < n;) {
+            if (!(stale_[i] & bit)) { ++i; continue; }
+            const uint32_t first = i;
+            while (i < n && (stale_[i] & bit)) stale_[i++] &= static_cast<uint8_t>(~bit);
+            write(first, i - first);
+        }
+        staleCount_[region] = 0;
+    }
+
+private:
+    [[nodiscard]] uint8_t allRegions() const noexcept { return static_cast<uint8_t>((1u << regions_) - 1u); }
+
+    void touch(uint32_t i) noexcept {
+        for (uint32_t r = 0; r < regions_; ++r)
+            if (!(stale_[i] & (1u << r))) ++staleCount_[r];
+        stale_[i] = allRegions();
+    }
+
+    std::vector<VkAccelerationStructureInstanceKHR> inst_;
+    std::vector<uint8_t>                            stale_;   // bit r: region r lacks the latest value
+    std::array<uint32_t, MAX_REGIONS>               staleCount_{};
+    uint32_t                                        regions_ = 1;
+};
@@ -24,11 +24,17 @@
 #pragma once
 
 #include <vulkan/vulkan.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <vector>
+#include <span>
 #include <string>
 #include <string_view>
 #include <memory>
 #include <glm/glm.hpp>
+#include "engine/GLOBAL/AccelBatch.hpp"
+#include "engine/GLOBAL/InstanceList.hpp"
 #include "engine/GLOBAL/RTXHandler.hpp"
 #include "engine/GLOBAL/VulkanCore.hpp"
 #include "engine/GLOBAL/logging.hpp"
@@ -47,48 +53,158 @@ struct AccelGeometry
     VkDeviceOrHostAddressConstKHR    transformData  {};
 };
 
+// One mesh of a batched BLAS build — same inputs as LAS::buildBLAS
+struct GeometryDesc
+{
+    uint64_t                             vertexBuffer = 0;   // obfuscated tracker handles
+    uint64_t                             indexBuffer  = 0;
+    uint32_t                             vertexCount  = 0;
+    uint32_t                             indexCount   = 0;
+    VkDeviceSize                         vertexStride = 44;
+    VkBuildAccelerationStructureFlagsKHR flags        = 0;   // added to PREFER_FAST_TRACE
+    std::string                          name         = "Mesh_BLAS";
+};
+
+// =============================================================================
+// SCRATCH POOL — one persistent scratch buffer for every AS build and refit.
+// acquire() hands out its aligned base; builds recorded together split it
+// with ScratchPlan offsets. Sizing and idle release follow ScratchSizing
+// (AccelBatch.hpp): a larger request replaces the buffer and the old one
+// retires behind frames in flight; Options::LAS::SCRATCH_IDLE_FRAMES ticks
+// without an acquire let it go. Builds reusing it order themselves with a
+// build→build barrier (every user is on the graphics queue).
+// =============================================================================
+class ScratchPool
+{
+public:
+    void setAlignment(VkDeviceSize alignment) noexcept { sizing_.setAlignment(alignment); }
+
+    // Aligned base of at least size bytes — valid for what is recorded before the next growing acquire
+    [[nodiscard]] VkDeviceAddress acquire(VkDeviceSize size);
+    void tick();                                  // once per frame
+    void release();                               // retired, not destroyed
+
+    [[nodiscard]] VkDeviceSize capacity()  const noexcept { return sizing_.capacity(); }
+    [[nodiscard]] VkDeviceSize highWater() const noexcept { return sizing_.highWater(); }
+    [[nodiscard]] uint32_t     grows()     const noexcept { return sizing_.grows(); }
+
+private:
+    uint64_t        buffer_ = 0;
+    VkDeviceAddress base_   = 0;
+    ScratchSizing   sizing_{};
+};
+
 class VulkanAccel
 {
 public:
     struct BLAS {
         VkAccelerationStructureKHR   as       = VK_NULL_HANDLE;
         VkBuffer                     buffer   = VK_NULL_HANDLE;
-        VkDeviceMemory               memory   = VK_NULL_HANDLE;
+        uint64_t                     storageEnc = 0;   // tracker handle — owns buffer + memory
         VkDeviceAddress              address  = 0;
         VkDeviceSize                 size     = 0;
+        VkQueryPool                  compactQuery = VK_NULL_HANDLE;   // pending compacted-size query — compactBLAS() consumes it
+        uint32_t                     compactIndex = 0;                // its slot — a batch shares one pool
         std::string                  name;
 
+        // Kept for refits: MODE_UPDATE must repeat the build's geometry and flags
+        std::vector<AccelGeometry>           geometries;
+        VkBuildAccelerationStructureFlagsKHR flags        = 0;
+        VkDeviceSize                         updateScratch = 0;
+        VkDeviceSize                         buildScratch  = 0;
+
         [[nodiscard]] bool isValid() const noexcept { return as != VK_NULL_HANDLE && address != 0; }
     };
 
     struct TLAS {
         VkAccelerationStructureKHR   as            = VK_NULL_HANDLE;
         VkBuffer                     buffer        = VK_NULL_HANDLE;
-        VkDeviceMemory               memory        = VK_NULL_HANDLE;
+        uint64_t                     storageEnc    = 0;   // tracker handles — own buffer + memory
         VkBuffer                     instanceBuffer = VK_NULL_HANDLE;
-        VkDeviceMemory               instanceMemory = VK_NULL_HANDLE;
+        uint64_t                     instanceEnc   = 0;
         VkDeviceAddress              address       = 0;
         VkDeviceSize                 size          = 0;
         std::string                  name;
 
+        VkDeviceAddress                      instanceAddress = 0;
+        uint32_t                             instanceCount   = 0;
+        VkBuildAccelerationStructureFlagsKHR flags           = 0;
+        VkDeviceSize                         updateScratch   = 0;
+        VkDeviceSize                         buildScratch    = 0;
+
         [[nodiscard]] bool isValid() const noexcept { return as != VK_NULL_HANDLE && address != 0; }
     };
 
     explicit VulkanAccel(VkDevice device);
     ~VulkanAccel() = default;
 
-    BLAS createBLAS(const std::vector<AccelGeometry>& geometries,
-                    VkBuildAccelerationStructureFlagsKHR flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR,
-                    VkCommandBuffer externalCmd = VK_NULL_HANDLE,
-                    std::string_view name = "BLAS");
+    // Built with ALLOW_COMPACTION: once the builds have executed, copy each into a
+    // buffer of its queried compacted size and retire the original — every BLAS with
+    // a pending query, copies recorded into one submit. Waits on the copies' own
+    // fence, never the device. Returns how many shrank.
+    uint32_t compactBLAS(std::span<BLAS> blases, VkCommandPool pool, VkQueue queue);
+
+    // Every BLAS is built here — a single mesh is a batch of one.
+    // Many BLAS through one scratch arena: sized together, packed by ScratchPlan, recorded
+    // as one vkCmdBuildAccelerationStructuresKHR per batch, one submit and one fence wait.
+    // Entries that failed to describe come back invalid; the rest keep input order.
+    struct BLASBuild {
+        std::vector<AccelGeometry>           geometries;
+        VkBuildAccelerationStructureFlagsKHR flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR;
+        std::string                          name  = "BLAS";
+    };
+    std::vector<BLAS> createBLASBatch(std::span<const BLASBuild> builds, VkCommandPool pool, VkQueue queue);
+
+    [[nodiscard]] VkDeviceSize scratchAlignment() const noexcept { return scratchAlignment_; }
 
     TLAS createTLAS(const std::vector<VkAccelerationStructureInstanceKHR>& instances,
                     VkBuildAccelerationStructureFlagsKHR flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR,
                     VkCommandBuffer externalCmd = VK_NULL_HANDLE,
                     std::string_view name = "TLAS");
+    // From instances already on the device — the caller owns that buffer (instanceEnc stays 0)
+    TLAS createTLAS(VkDeviceAddress instanceData, uint32_t count,
+                    VkBuildAccelerationStructureFlagsKHR flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR,
+                    VkCommandBuffer externalCmd = VK_NULL_HANDLE,
+                    std::string_view name = "TLAS");
+
+    // In-place refit (MODE_UPDATE) or rebuild (MODE_BUILD into the same storage) recorded
+    // into cmd. Handle and address stay the same, so descriptors stay valid. Needs an
+    // ALLOW_UPDATE build; scratch must hold buildScratch when rebuilding, updateScratch
+    // otherwise. Barriers are the caller's.
+    bool refitBLAS(const BLAS& blas, VkCommandBuffer cmd, VkDeviceAddress scratch, bool rebuild);
+    // instanceData holds tlas.instanceCount instances — may be a different copy than the build's
+    bool refitTLAS(const TLAS& tlas, VkDeviceAddress instanceData,
+                   VkCommandBuffer cmd, VkDeviceAddress scratch, bool rebuild);
+    // Full build of count instances into tlas's existing storage — false if they no longer fit
+    bool rebuildTLAS(TLAS& tlas, VkDeviceAddress instanceData, uint32_t count,
+                     VkBuildAccelerationStructureFlagsKHR flags, VkCommandBuffer cmd);
+
+    [[nodiscard]] ScratchPool& scratch() noexcept { return scratch_; }
 
     void destroy(BLAS& blas);
     void destroy(TLAS& tlas);
+
+private:
+    VkDeviceSize scratchAlignment_ = 256;   // minAccelerationStructureScratchOffsetAlignment
+    ScratchPool  scratch_{};
+};
+
+// =============================================================================
+// REFIT POLICY — refits are cheap but only move boxes; the tree keeps the
+// topology of the last full build. Rebuild after MAX_REFITS, or once the
+// bounds' surface area outgrows the built one by REFIT_GROWTH_LIMIT.
+// =============================================================================
+struct RefitPolicy
+{
+    uint32_t  refits = 0;
+    bool      primed = false;
+    glm::vec3 builtMin{0.0f};
+    glm::vec3 builtMax{0.0f};
+
+    [[nodiscard]] bool needsRebuild(const glm::vec3& mn, const glm::vec3& mx) const noexcept;
+    void refitted() noexcept { ++refits; }
+    void rebuilt(const glm::vec3& mn, const glm::vec3& mx) noexcept { refits = 0; primed = true; builtMin = mn; builtMax = mx; }
+    void reset() noexcept { *this = {}; }
 };
 
 [[nodiscard]] inline VkCommandBuffer beginOneTime(VkCommandPool pool)
@@ -184,6 +300,7 @@ public:
         LOG_ATTEMPT_CAT("LAS", "{}Captain N: Warriors - assemble! We forge the ultimate acceleration context!{}", VALHALLA_GOLD, RESET);
 
         accel_ = std::make_unique<VulkanAccel>(g_ctx().device());
+        instances_.setRegions(INSTANCE_REGIONS);
 
         LOG_SUCCESS_CAT("LAS", 
             "{}Captain N: ACCELERATION CONTEXT FORGED!{}\n"
@@ -200,6 +317,9 @@ public:
             PLASMA_FUCHSIA, RESET);
     }
 
+    // The scene mesh — the one BLAS the frame can refit. Static by default, so compacted;
+    // pass ALLOW_UPDATE in extraFlags for geometry that moves (moveBLAS), which skips
+    // compaction. Goes through the same batched path as buildBLASBatch(), as a batch of one.
     void buildBLAS(VkCommandPool pool,
                    uint64_t vertexBufferObf,
                    uint64_t indexBufferObf,
@@ -207,9 +327,50 @@ public:
                    uint32_t indexCount,
                    VkBuildAccelerationStructureFlagsKHR extraFlags = 0);
 
+    // Replaces the instance list (mask 0xFF, SBT offset 0, custom index = position) and builds
     void buildTLAS(VkCommandPool pool,
                    const std::vector<std::pair<VkAccelerationStructureKHR, glm::mat4>>& instances);
 
+    // ── Instance list — edits are host-side and mark only the touched instances
+    //    dirty; buildTLAS(pool) builds it, updateTLAS() writes the dirty ones into
+    //    the frame slot's copy and refits. Adding or clearing needs a build.
+    uint32_t addInstance(const TLASInstance& instance);
+    void     setInstance(uint32_t i, const TLASInstance& instance);
+    void     setInstanceTransform(uint32_t i, const glm::mat4& transform);
+    void     clearInstances() noexcept { instances_.clear(); }
+    [[nodiscard]] uint32_t instanceCount() const noexcept { return instances_.size(); }
+    void buildTLAS(VkCommandPool pool);
+
+    // Scene load: every mesh in one submit through a shared scratch arena. Appended to
+    // the mesh BLAS list; returns the index of the first one.
+    uint32_t buildBLASBatch(VkCommandPool pool, std::span<const GeometryDesc> meshes);
+    [[nodiscard]] const VulkanAccel::BLAS& getMeshBLAS(uint32_t i) const noexcept { return meshBLAS_[i]; }
+    [[nodiscard]] uint32_t                 meshBLASCount() const noexcept { return static_cast<uint32_t>(meshBLAS_.size()); }
+    void clearMeshBLAS();
+
+    // ── Per-frame refits — recorded into the frame's command buffer, no submit, no
+    //    wait, no new generation. Barriers against last frame's trace and this frame's
+    //    ray tracing are included. Returns false if the structure can't be refitted
+    //    (not built with ALLOW_UPDATE, or the instance count changed) — rebuild then.
+    // Vertex buffers already hold the new positions; bounds are the mesh's new AABB.
+    // The TLAS boxes the BLAS — follow with updateTLAS() in the same command buffer.
+    bool updateBLAS(VkCommandBuffer cmd, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+    // frameSlot < MAX_FRAMES_IN_FLIGHT — its copy of the instances is free once the slot is
+    bool updateTLAS(VkCommandBuffer cmd, uint32_t frameSlot);
+
+    // The scene mesh's vertex buffer was rewritten — the next refit() picks it up
+    void moveBLAS(const glm::vec3& boundsMin, const glm::vec3& boundsMax) noexcept
+    {
+        blasMin_ = boundsMin; blasMax_ = boundsMax; blasMoved_ = true;
+    }
+    // renderFrame, once per frame: updateBLAS() if the mesh moved, then updateTLAS().
+    // When the TLAS can't be refitted (instance count changed) its full build is recorded
+    // into cmd instead, after the BLAS refit — new storage, if needed, retires the old TLAS.
+    void refit(VkCommandBuffer cmd, uint32_t frameSlot);
+
+    // Once per submitted frame — lets the idle scratch pool go
+    void tick() { if (accel_) accel_->scratch().tick(); }
+
     [[nodiscard]] VkAccelerationStructureKHR getBLAS() const noexcept { return blas_.as; }
     [[nodiscard]] VkAccelerationStructureKHR getTLAS() const noexcept { return tlas_.as; }
     [[nodiscard]] VkDeviceAddress           getTLASAddress() const noexcept { return tlas_.address; }
@@ -234,10 +395,37 @@ private:
     LAS()  = default;
     ~LAS() = default;
 
+    static void refitBarriers(VkCommandBuffer cmd, bool before) noexcept;
+    // Full TLAS build from region's copy of the instances, recorded into cmd — in place when
+    // it fits, otherwise new storage with the old TLAS retired. The caller submits.
+    void recordTLASBuild(VkCommandBuffer cmd, uint32_t region);
+    // Both scene-load entry points — one submit, one scratch arena, one compaction query pool
+    [[nodiscard]] std::vector<VulkanAccel::BLAS> createBatch(VkCommandPool pool, std::span<const GeometryDesc> meshes);
+    // Persistently mapped instance ring: one region per frame slot + one for blocking builds
+    void reserveInstances(uint32_t count);
+    [[nodiscard]] VkDeviceAddress flushInstances(uint32_t region);
+
     std::unique_ptr<VulkanAccel> accel_;
     VulkanAccel::BLAS blas_{};
     VulkanAccel::TLAS tlas_{};
+    std::vector<VulkanAccel::BLAS> meshBLAS_;
     uint32_t          generation_ = 0;
+
+    RefitPolicy       blasRefit_{};
+    RefitPolicy       tlasRefit_{};
+    glm::vec3         blasMin_{0.0f};
+    glm::vec3         blasMax_{0.0f};
+    bool              blasMoved_ = false;       // moveBLAS() since the last refit()
+
+    static constexpr uint32_t INSTANCE_REGIONS = Options::Performance::MAX_FRAMES_IN_FLIGHT + 1;
+    static constexpr uint32_t BUILD_REGION     = INSTANCE_REGIONS - 1;
+    static_assert(INSTANCE_REGIONS <= InstanceList::MAX_REGIONS);
+    InstanceList      instances_{};
+    uint64_t          instanceRing_     = 0;
+    uint8_t*          instanceMapped_   = nullptr;
+    VkDeviceAddress   instanceRingAddr_ = 0;
+    uint32_t          instanceCapacity_ = 0;     // per region
+    bool              tlasStale_        = false; // an instance or a BLAS moved since the last refit
 };
 
 inline LAS& las() noexcept { return LAS::get(); }
@@ -0,0 +1,409 @@
+// =============================================================================
+// LogSinks.hpp — AMOURANTH RTX Engine © 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. Creative Commons Attribution-NonCommercial 4.0 International (CC BY-NC 4.0)
+//    https://creativecommons.org/licenses/by-nc/4.0/
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// LOG SINKS — where the flusher's batches end up
+//   TerminalSink     colored text → stdout (stdio, no iostream)
+//   MappedFileSink   plain or binary records → pre-sized mmap'd segments,
+//                    rotated by size/age, old segments gzip'd off-thread
+//   NullSink         swallows everything (soak runs, benchmarks)
+// The flusher only renders the formats some sink actually asks for.
+// =============================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <filesystem>
+#include <format>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#endif
+
+namespace Logging {
+
+enum class SinkFormat : uint8_t { None, Colored, Plain, Binary };
+
+class LogSink {
+public:
+    virtual ~LogSink() = default;
+    [[nodiscard]] virtual SinkFormat format() const noexcept = 0;
+    virtual void write(std::string_view bytes) = 0;
+    virtual void flush() {}
+};
+
+// ========================================================================
+// TERMINAL + NULL
+// ========================================================================
+class TerminalSink final : public LogSink {
+public:
+    [[nodiscard]] SinkFormat format() const noexcept override { return SinkFormat::Colored; }
+    void write(std::string_view bytes) override { std::fwrite(bytes.data(), 1, bytes.size(), stdout); }
+    void flush() override { std::fflush(stdout); }
+};
+
+class NullSink final : public LogSink {
+public:
+    [[nodiscard]] SinkFormat format() const noexcept override { return SinkFormat::None; }
+    void write(std::string_view) override {}
+};
+
+// ========================================================================
+// MAPPED ROTATING FILE SINK
+//   Active segment lives at `path`, pre-sized with posix_fallocate (no
+//   SIGBUS on a full disk) and mapped MAP_SHARED. write() is a memcpy;
+//   the kernel writes pages back on its own schedule — the flusher never
+//   fsyncs. The next segment is prepared by a worker thread so rotation
+//   on the flusher is two renames and a pointer swap. Retired segments are
+//   unmapped, trimmed, gzip'd and pruned on the same worker.
+// ========================================================================
+struct RotationPolicy {
+    size_t               segmentBytes = 64ull * 1024 * 1024;
+    std::chrono::seconds maxAge{3600};
+    uint32_t             keepSegments = 8;
+    bool                 compress     = true;
+};
+
+class MappedFileSink final : public LogSink {
+public:
+    // Called when a fresh segment opens, so each file is self-describing
+    // (binary session header + format table).
+    using Preamble = std::function<void(std::string&)>;
+
+    MappedFileSink(std::filesystem::path path, SinkFormat format, RotationPolicy policy = {})
+        : path_(std::move(path)), format_(format), policy_(policy)
+    {
+        std::error_code ec;
+        std::filesystem::remove(nextPath(), ec);
+        std::filesystem::remove(syncPath(), ec);
+        if (std::filesystem::exists(path_, ec) && std::filesystem::file_size(path_, ec) > 0) {
+            trimTrailingZeros(path_);     // a crashed run leaves its pre-sized tail behind
+            const auto archive = archivePath();
+            std::filesystem::rename(path_, archive, ec);
+            if (!ec) enqueue([this, archive] { compressAndPrune(archive); });
+        }
+        enqueue([this] { prepareNext(); });
+    }
+
+    ~MappedFileSink() override {
+        {
+            std::scoped_lock lk(jobMutex_);
+            stopping_ = true;
+        }
+        jobCv_.notify_one();
+        if (worker_.joinable()) worker_.join();
+
+        closeSegment(active_, /*keep=*/true);
+        if (next_.valid()) {
+            const auto unused = next_.path;
+            closeSegment(next_, /*keep=*/false);
+            std::error_code ec;
+            std::filesystem::remove(unused, ec);
+        }
+    }
+
+    MappedFileSink(const MappedFileSink&) = delete;
+    MappedFileSink& operator=(const MappedFileSink&) = delete;
+
+    void setPreamble(Preamble p) { preamble_ = std::move(p); }
+
+    [[nodiscard]] SinkFormat format() const noexcept override { return format_; }
+    [[nodiscard]] uint64_t droppedBytes() const noexcept { return droppedBytes_.load(std::memory_order_relaxed); }
+
+    void write(std::string_view bytes) override {
+        if (bytes.empty()) return;
+        const bool expired = active_.valid() &&
+            std::chrono::steady_clock::now() - active_.opened >= policy_.maxAge;
+        if (!active_.valid() || expired || active_.used + bytes.size() > active_.capacity)
+            rotate(bytes.size());
+        if (!active_.valid() || active_.used + bytes.size() > active_.capacity) [[unlikely]] {
+            droppedBytes_.fetch_add(bytes.size(), std::memory_order_relaxed);
+            return;
+        }
+        append(active_, bytes);
+    }
+
+    void flush() override {
+#ifndef _WIN32
+        // MS_ASYNC only schedules writeback — never waits on the disk
+        if (active_.valid()) ::msync(active_.base, active_.capacity, MS_ASYNC);
+#else
+        if (active_.file) std::fflush(active_.file);
+#endif
+    }
+
+private:
+    struct Segment {
+#ifndef _WIN32
+        int    fd   = -1;
+        char*  base = nullptr;
+#else
+        std::FILE* file = nullptr;
+#endif
+        size_t capacity = 0;
+        size_t used     = 0;
+        std::chrono::steady_clock::time_point opened{};
+        std::filesystem::path path;
+
+#ifndef _WIN32
+        [[nodiscard]] bool valid() const noexcept { return base != nullptr; }
+#else
+        [[nodiscard]] bool valid() const noexcept { return file != nullptr; }
+#endif
+    };
+
+    [[nodiscard]] std::filesystem::path nextPath() const { return std::filesystem::path(path_.string() + ".next"); }
+    [[nodiscard]] std::filesystem::path syncPath() const { return std::filesystem::path(path_.string() + ".rotating"); }
+
+    [[nodiscard]] std::filesystem::path archivePath() {
+        const std::time_t tt = std::time(nullptr);
+        std::tm tm{};
+#ifdef _WIN32
+        localtime_s(&tm, &tt);
+#else
+        localtime_r(&tt, &tm);
+#endif
+        char stamp[32];
+        std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &tm);
+        return std::filesystem::path(std::format("{}.{}.{}", path_.string(), stamp, archiveCounter_++));
+    }
+
+    static Segment openSegment(const std::filesystem::path& p, size_t capacity) {
+        Segment s;
+        s.capacity = capacity;
+        s.opened   = std::chrono::steady_clock::now();
+        s.path     = p;
+#ifndef _WIN32
+        s.fd = ::open(p.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (s.fd < 0) return {};
+        if (::posix_fallocate(s.fd, 0, static_cast<off_t>(capacity)) != 0) { ::close(s.fd); return {}; }
+        int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+        flags |= MAP_POPULATE;   // pre-fault here, on the worker, not on first memcpy
+#endif
+        void* m = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, flags, s.fd, 0);
+        if (m == MAP_FAILED) { ::close(s.fd); return {}; }
+        ::madvise(m, capacity, MADV_SEQUENTIAL);
+        s.base = static_cast<char*>(m);
+#else
+        s.file = std::fopen(p.string().c_str(), "wb");
+#endif
+        return s;
+    }
+
+    // keep=false discards contents (unused prepared segment)
+    static void closeSegment(Segment& s, bool keep) {
+        if (!s.valid()) return;
+#ifndef _WIN32
+        ::munmap(s.base, s.capacity);
+        if (::ftruncate(s.fd, keep ? static_cast<off_t>(s.used) : 0) != 0) { /* best effort */ }
+        ::close(s.fd);
+        s.base = nullptr;
+        s.fd   = -1;
+#else
+        (void)keep;
+        std::fclose(s.file);
+        s.file = nullptr;
+#endif
+    }
+
+    static void append(Segment& s, std::string_view bytes) noexcept {
+#ifndef _WIN32
+        std::memcpy(s.base + s.used, bytes.data(), bytes.size());
+#else
+        std::fwrite(bytes.data(), 1, bytes.size(), s.file);
+#endif
+        s.used += bytes.size();
+    }
+
+    static void trimTrailingZeros(const std::filesystem::path& p) {
+#ifndef _WIN32
+        const int fd = ::open(p.c_str(), O_RDWR | O_CLOEXEC);
+        if (fd < 0) return;
+        struct stat st{};
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            off_t end = st.st_size;
+            char buf[4096];
+            while (end > 0) {
+                const off_t chunk = std::min<off_t>(end, sizeof(buf));
+                if (::pread(fd, buf, static_cast<size_t>(chunk), end - chunk) != chunk) break;
+                off_t i = chunk;
+                while (i > 0 && buf[i - 1] == '\0') --i;
+                end -= chunk - i;
+                if (i > 0) break;
+            }
+            if (end != st.st_size && ::ftruncate(fd, end) != 0) { /* best effort */ }
+        }
+        ::close(fd);
+#else
+        (void)p;
+#endif
+    }
+
+    // Flusher thread: swap in the prepared segment, retire the old one
+    void rotate(size_t incoming) {
+        std::string pre;
+        if (preamble_) preamble_(pre);
+        const size_t need = pre.size() + incoming;
+
+#ifdef _WIN32
+        // A file with an open handle can't be renamed here: close the active
+        // segment first, archive it, then reopen at `path` — no prepared next
+        std::error_code ec;
+        if (active_.valid()) {
+            closeSegment(active_, /*keep=*/true);
+            const auto archive = archivePath();
+            std::filesystem::rename(path_, archive, ec);
+            if (!ec) enqueue([this, archive] { compressAndPrune(archive); });
+        }
+        active_ = openSegment(path_, std::max(policy_.segmentBytes, need));
+        if (active_.valid() && !pre.empty()) append(active_, pre);
+#else
+        Segment fresh;
+        {
+            std::scoped_lock lk(jobMutex_);
+            if (next_.valid() && next_.capacity >= need) fresh = std::exchange(next_, Segment{});
+        }
+        std::error_code ec;
+        if (!fresh.valid()) {
+            // Worker hasn't caught up (or the batch is oversized) — map one here
+            fresh = openSegment(syncPath(), std::max(policy_.segmentBytes, need));
+            if (!fresh.valid()) return;
+        }
+
+        if (active_.valid()) {
+            const auto archive = archivePath();
+            std::filesystem::rename(path_, archive, ec);
+            enqueue([this, old = active_, archive]() mutable {
+                closeSegment(old, /*keep=*/true);
+                compressAndPrune(archive);
+            });
+        }
+        std::filesystem::rename(fresh.path, path_, ec);
+        fresh.path = path_;
+
+        active_ = fresh;
+        active_.opened = std::chrono::steady_clock::now();
+        enqueue([this] { prepareNext(); });
+
+        if (!pre.empty()) append(active_, pre);
+#endif
+    }
+
+    // Windows: nothing to prepare — rotate() opens in place
+    void prepareNext() {
+#ifndef _WIN32
+        {
+            std::scoped_lock lk(jobMutex_);
+            if (next_.valid()) return;
+        }
+        Segment s = openSegment(nextPath(), policy_.segmentBytes);
+        std::scoped_lock lk(jobMutex_);
+        next_ = s;
+#endif
+    }
+
+    void compressAndPrune(const std::filesystem::path& archive) {
+#ifndef _WIN32
+        if (policy_.compress) {
+            const std::string file = archive.string();
+            char gzip[] = "gzip";
+            char force[] = "-fq";
+            char* argv[] = {gzip, force, const_cast<char*>(file.c_str()), nullptr};
+            pid_t pid = 0;
+            if (::posix_spawnp(&pid, "gzip", nullptr, nullptr, argv, environ) == 0) {
+                int status = 0;
+                ::waitpid(pid, &status, 0);
+            }
+        }
+#else
+        (void)archive;
+#endif
+        prune();
+    }
+
+    void prune() {
+        const std::string prefix = path_.filename().string() + ".";
+        const std::string skipNext = nextPath().filename().string();
+        const std::string skipSync = syncPath().filename().string();
+        std::vector<std::filesystem::directory_entry> archives;
+        std::error_code ec;
+        const auto dir = path_.has_parent_path() ? path_.parent_path() : std::filesystem::path(".");
+        for (const auto& e : std::filesystem::directory_iterator(dir, ec)) {
+            const std::string name = e.path().filename().string();
+            if (name.starts_with(prefix) && name != skipNext && name != skipSync) archives.push_back(e);
+        }
+        if (archives.size() <= policy_.keepSegments) return;
+        std::sort(archives.begin(), archives.end(), [](const auto& a, const auto& b) {
+            std::error_code e1, e2;
+            return a.last_write_time(e1) > b.last_write_time(e2);
+        });
+        for (size_t i = policy_.keepSegments; i < archives.size(); ++i)
+            std::filesystem::remove(archives[i].path(), ec);
+    }
+
+    void enqueue(std::function<void()> job) {
+        {
+            std::scoped_lock lk(jobMutex_);
+            jobs_.push_back(std::move(job));
+            if (!worker_.joinable()) worker_ = std::thread([this] { workerLoop(); });
+        }
+        jobCv_.notify_one();
+    }
+
+    void workerLoop() {
+        std::unique_lock lk(jobMutex_);
+        for (;;) {
+            jobCv_.wait(lk, [this] { return stopping_ || !jobs_.empty(); });
+            if (jobs_.empty()) return;   // stopping and drained
+            auto job = std::move(jobs_.front());
+            jobs_.pop_front();
+            lk.unlock();
+            job();
+            lk.lock();
+        }
+    }
+
+    std::filesystem::path path_;
+    SinkFormat            format_;
+    RotationPolicy        policy_;
+    Preamble              preamble_;
+
+    Segment               active_;          // flusher-owned
+    Segment               next_;            // guarded by jobMutex_
+    uint64_t              archiveCounter_ = 0;
+    std::atomic<uint64_t> droppedBytes_{0};
+
+    std::mutex                        jobMutex_;
+    std::condition_variable           jobCv_;
+    std::deque<std::function<void()>> jobs_;
+    bool                              stopping_ = false;
+    std::thread                       worker_;
+};
+
+} // namespace Logging
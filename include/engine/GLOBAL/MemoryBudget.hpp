@@ -0,0 +1,137 @@
+// include/engine/GLOBAL/MemoryBudget.hpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// MEMORY BUDGET — PER-TAG LEDGER + VK_EXT_memory_budget WATCHDOG
+//   Every tracker buffer and every renderer image is charged to a (tag, heap)
+//   row when it is created and refunded when it is destroyed, so the live
+//   table answers "who owns the VRAM" without walking any allocator.
+//   Dedicated VkDeviceMemory is charged against its handle (chargeMemory), so
+//   Handle<VkDeviceMemory> refunds through its destroy policy and carries no
+//   size or tag of its own.
+//   tick(frame) polls the driver's per-heap budget every
+//   Options::Performance::MEMORY_BUDGET_POLL_FRAMES frames:
+//     usage ≥ WARN  fraction → one warning + the ledger table (re-arms below it)
+//     usage ≥ EVICT fraction → evictables run, lowest priority first, until the
+//                              projected usage is back under WARN
+//   Evictables are optional resources (denoiser targets, debug buffers) whose
+//   owner can drop them and keep rendering. They should retire() rather than
+//   destroy — the GPU may still be using them — so the driver's usage figure
+//   lags a couple of frames; the poll interval covers that.
+//   Without the extension the heap size stands in for the budget and the
+//   ledger total for usage.
+// =============================================================================
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace RTX {
+
+struct MemoryLedgerRow {
+    std::string  tag;
+    uint32_t     heap  = 0;
+    VkDeviceSize bytes = 0;
+    uint32_t     count = 0;
+};
+
+struct HeapBudget {
+    VkDeviceSize size    = 0;      // VkMemoryHeap::size
+    VkDeviceSize budget  = 0;      // driver budget (heap size without the extension)
+    VkDeviceSize usage   = 0;      // driver usage, whole process
+    VkDeviceSize charged = 0;      // what the ledger accounts for on this heap
+    bool         deviceLocal = false;
+};
+
+class MemoryBudget {
+public:
+    // Returns bytes it expects to free (0 = nothing left to give)
+    using EvictFn = std::function<VkDeviceSize()>;
+
+    MemoryBudget() = default;
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+    void init(VkPhysicalDevice physicalDevice) noexcept;
+
+    // Ledger — memoryType is the index the allocation was made from
+    void charge(std::string_view tag, uint32_t memoryType, VkDeviceSize bytes);
+    void refund(std::string_view tag, uint32_t memoryType, VkDeviceSize bytes) noexcept;
+
+    // Dedicated VkDeviceMemory — charged by handle, refunded by DestroyPolicy<VkDeviceMemory>
+    void chargeMemory(VkDeviceMemory memory, std::string_view tag, uint32_t memoryType, VkDeviceSize bytes);
+    void refundMemory(VkDeviceMemory memory) noexcept;                // no-op if never charged
+    [[nodiscard]] VkDeviceSize bytesOf(VkDeviceMemory memory) const noexcept;
+
+    // Lower priority is evicted first; returns an id for removeEvictable()
+    uint32_t addEvictable(std::string name, uint32_t priority, EvictFn fn);
+    void     removeEvictable(uint32_t id) noexcept;
+
+    // Once per frame — polls, warns and evicts on the configured interval
+    void tick(uint64_t frameNumber);
+    void poll();
+
+    [[nodiscard]] std::vector<MemoryLedgerRow> snapshot() const;      // biggest first
+    [[nodiscard]] std::vector<HeapBudget>      heaps() const;
+    void logReport(std::string_view when) const;
+
+private:
+    struct Evictable {
+        uint32_t    id       = 0;
+        uint32_t    priority = 0;
+        std::string name;
+        EvictFn     fn;
+    };
+
+    // (tag, heap) ordering that also takes a string_view key — no allocation per lookup
+    struct RowLess {
+        using is_transparent = void;
+        template<class A, class B>
+        bool operator()(const A& a, const B& b) const noexcept {
+            const int c = std::string_view(a.first).compare(std::string_view(b.first));
+            return c < 0 || (c == 0 && a.second < b.second);
+        }
+    };
+
+    struct MemoryCharge {
+        std::string  tag;
+        uint32_t     memoryType = 0;
+        VkDeviceSize bytes      = 0;
+    };
+
+    [[nodiscard]] uint32_t heapOf(uint32_t memoryType) const noexcept;
+    void chargeLocked(std::string_view tag, uint32_t memoryType, VkDeviceSize bytes);
+    void refundLocked(std::string_view tag, uint32_t memoryType, VkDeviceSize bytes) noexcept;
+    void queryHeapsLocked() noexcept;
+
+    mutable std::mutex mutex_;
+    VkPhysicalDevice physicalDevice_ = VK_NULL_HANDLE;
+    VkPhysicalDeviceMemoryProperties memProps_{};
+    bool hasBudgetExt_ = false;
+
+    std::map<std::pair<std::string, uint32_t>, MemoryLedgerRow, RowLess> rows_;
+    std::unordered_map<VkDeviceMemory, MemoryCharge> memoryCharges_;
+    std::vector<HeapBudget> heaps_;
+    std::vector<bool>       warned_;          // per heap, re-armed when usage drops below WARN
+    std::vector<Evictable>  evictables_;
+    uint32_t                nextEvictId_ = 1;
+};
+
+[[nodiscard]] MemoryBudget& memoryBudget() noexcept;
+
+} // namespace RTX
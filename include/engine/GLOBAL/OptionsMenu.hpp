@@ -30,7 +30,13 @@ namespace Performance {
     constexpr bool     ENABLE_GPU_TIMESTAMPS       = true;
     constexpr bool     ENABLE_FPS_COUNTER          = true;
     constexpr bool     ENABLE_MEMORY_BUDGET_WARNINGS = true;
+    constexpr uint32_t MEMORY_BUDGET_POLL_FRAMES   = 120;   // VK_EXT_memory_budget poll interval
+    constexpr float    MEMORY_BUDGET_WARN_FRACTION = 0.90f; // usage / budget → warning + ledger dump
+    constexpr float    MEMORY_BUDGET_EVICT_FRACTION = 0.95f; // usage / budget → drop optional resources
+    constexpr uint32_t DEFRAG_MOVES_PER_FRAME      = 4;     // relocatable buffers copied out of the sparsest heap block per frame (0 = off)
     constexpr uint32_t GPU_TIMESTAMP_QUERY_COUNT   = 128;
+    constexpr uint32_t RECORD_THREADS              = 4;     // secondary command buffer recorders (1 = inline)
+    constexpr bool     ENABLE_ASYNC_COMPUTE        = true;  // denoise + tonemap on a dedicated compute family when present
     constexpr bool     ENABLE_FRAME_TIME_LOGGING   = false;
     constexpr float    FRAME_TIME_LOG_THRESHOLD_MS = 16.666f;
     static inline constexpr bool ENABLE_VALIDATION_LAYERS = false;
@@ -41,6 +47,8 @@ namespace Performance {
 
     // NEW: Frame prediction & jitter recovery (VK_GOOGLE_display_timing)
     constexpr bool     ENABLE_FRAME_PREDICTION     = true;  // AAAA pacing — predict vsync, recover jitter
+    constexpr float    FRAME_PACING_MARGIN_MS      = 0.5f;  // slack on top of predicted CPU + GPU time
+    constexpr float    FRAME_PACING_SPIN_MS        = 1.0f;  // last stretch of a pacing sleep spins instead of sleeping
 
     // ADDED: For swapchain present mode selection (immediate present for low-latency non-VSYNC)
     constexpr bool     ENABLE_IMMEDIATE_PRESENT    = false; // Set to true for VK_PRESENT_MODE_IMMEDIATE_KHR (tearing possible)
@@ -104,6 +112,11 @@ namespace LAS {
     constexpr bool     REBUILD_EVERY_FRAME         = false;
     constexpr bool     UPDATE_EVERY_FRAME          = true;
     constexpr bool     COMPACT_TLAS                = true;
+    constexpr bool     COMPACT_BLAS                = true;   // static BLAS: build, query compacted size, copy down
+    constexpr uint32_t MAX_REFITS                  = 64;     // MODE_UPDATE refits before an in-place rebuild
+    constexpr float    REFIT_GROWTH_LIMIT          = 1.5f;   // rebuild once bounds' surface area passes this × the built one
+    constexpr uint32_t BATCH_SCRATCH_BUDGET_MB     = 256;    // scratch per vkCmdBuildAccelerationStructuresKHR batch
+    constexpr uint32_t SCRATCH_IDLE_FRAMES         = 600;    // AS scratch pool is released after this many frames unused
     constexpr bool     PREFER_FAST_BUILD           = true;
     constexpr bool     PREFER_FAST_TRACE           = false;
 }
@@ -153,7 +166,9 @@ namespace AutoExposure {
 
 // ── MEMORY & ALLOCATION ───────────────────────────────────────────────────────
 namespace Memory {
-    constexpr size_t   UNIFORM_BUFFER_SIZE_PER_FRAME = 64 * 1024 * 1024;   // 64MB
+    constexpr size_t   FRAME_RING_SIZE_PER_FRAME     = 256 * 1024;         // 256KB — UBOs + per-frame constants
+    constexpr size_t   UPLOAD_STAGING_INITIAL_SIZE   = 16 * 1024 * 1024;   // 16MB staging ring — doubles on demand
+    constexpr size_t   UPLOAD_STAGING_MAX_SIZE       = 256 * 1024 * 1024;  // 256MB — past this, uploads wait on the GPU
     constexpr size_t   MATERIAL_BUFFER_SIZE          = 16 * 1024 * 1024;   // 16MB
     constexpr size_t   RESERVOIR_BUFFER_SIZE         = 512 * 1024 * 1024;  // 512MB
     constexpr size_t   FRAME_DATA_BUFFER_SIZE        = 128 * 1024 * 1024;  // 128MB
@@ -38,6 +38,7 @@
 #include <span>
 #include <limits>
 #include <source_location>
+#include <typeinfo>
 #include <functional>
 #include <queue>
 #include <vector>
@@ -46,6 +47,10 @@
 
 #include "engine/GLOBAL/logging.hpp"
 #include "engine/GLOBAL/StoneKey.hpp"  // For secure handle accessors (g_device, g_instance, etc.)
+#include "engine/GLOBAL/DeviceHeap.hpp"
+#include "engine/GLOBAL/SlotTable.hpp"
+#include "engine/GLOBAL/DeferredDestroy.hpp"
+#include "engine/GLOBAL/MemoryBudget.hpp"
 
 // Forward declarations
 class VulkanRTX;
@@ -146,11 +151,21 @@ constexpr uint64_t operator"" _TB(unsigned long long v) noexcept { return v << 4
         }                                                                       \
     } while (0)
 
+// Mapping is persistent — UNMAP only marks the end of a CPU write and flushes
+// it (a no-op on HOST_COHERENT memory). FLUSH/INVALIDATE take a byte range.
 #define BUFFER_UNMAP(handle)                                                    \
     do { if ((handle) != 0ULL) RTX::UltraLowLevelBufferTracker::get().unmap(handle); } while (0)
 
+#define BUFFER_FLUSH(handle, offset, size)                                      \
+    do { if ((handle) != 0ULL) RTX::UltraLowLevelBufferTracker::get().flush((handle), (offset), (size)); } while (0)
+
+#define BUFFER_INVALIDATE(handle, offset, size)                                 \
+    do { if ((handle) != 0ULL) RTX::UltraLowLevelBufferTracker::get().invalidate((handle), (offset), (size)); } while (0)
+
 // ─────────────────────────────────────────────────────────────────────────────
 // DESTRUCTION — WITH FULL LOGGING AND STONEKEY RITUAL
+// Retired, not destroyed: the buffer lives until the next frame fence signals
+// (see DeferredDestroy.hpp). Call tracker.destroy() directly after an idle.
 // ─────────────────────────────────────────────────────────────────────────────
 #define BUFFER_DESTROY(handle)                                                  \
     do {                                                                        \
@@ -159,7 +174,9 @@ constexpr uint64_t operator"" _TB(unsigned long long v) noexcept { return v << 4
             const char* tagStr = data ? data->tag.c_str() : "unknown";          \
             LOG_INFO_CAT("RTX", "BUFFER_DESTROY: obf=0x{:x} | Tag: {}",         \
                          (handle), tagStr);                                     \
-            RTX::UltraLowLevelBufferTracker::get().destroy(handle);            \
+            RTX::retireQueue().retire([h = (uint64_t)(handle)]() {              \
+                RTX::UltraLowLevelBufferTracker::get().destroy(h);              \
+            });                                                                 \
             (handle) = 0ULL;                                                    \
         }                                                                       \
     } while (0)
@@ -177,7 +194,7 @@ namespace RTX {
     // =============================================================================
     // Helpers (declarations only) — MOVED UP FOR TEMPLATE VISIBILITY
     // =============================================================================
-    void logAndTrackDestruction(const char* type, void* ptr, int line, size_t size);
+    void logAndTrackDestruction(std::string_view what, void* ptr, int line);
 
     // Internal sub-functions for stepwise initialization (declared here for modularity; defined in RTXHandler.cpp)
     void pickPhysicalDevice();
@@ -187,36 +204,97 @@ namespace RTX {
     void retrieveQueues() noexcept;
 	
     // =============================================================================
-    // Handle<T> — FIXED: FULL INLINE IMPLEMENTATIONS FOR TEMPLATE
+    // TAG TABLE — Handle<T> tags are interned once and carried as a 32-bit id
+    //   0 is the empty tag. Names live for the whole process; tagName() views
+    //   stay valid forever.
+    // =============================================================================
+    using TagId = uint32_t;
+
+    [[nodiscard]] TagId            internTag(std::string_view name);
+    [[nodiscard]] std::string_view tagName(TagId id) noexcept;
+
+    // =============================================================================
+    // DestroyPolicy<T> — ONE DIRECT CALL PER VULKAN HANDLE TYPE
+    //   Resolved at compile time, so a Handle carries no destroyer at all.
+    //   A type without a specialization fails to compile rather than leaking.
+    //   VkDeviceMemory also refunds the MemoryBudget ledger (a no-op for memory
+    //   that was never charged) — before the free, so a recycled handle value
+    //   can't be refunded on behalf of its next owner.
+    // =============================================================================
+    template<typename T> struct DestroyPolicy;
+
+    #define RTX_DESTROY_POLICY(Type, call)                                          \
+        template<> struct DestroyPolicy<Type> {                                     \
+            static void destroy(VkDevice d, Type h) noexcept { call(d, h, nullptr); } \
+        }
+
+    RTX_DESTROY_POLICY(VkImage,               vkDestroyImage);
+    RTX_DESTROY_POLICY(VkImageView,           vkDestroyImageView);
+    RTX_DESTROY_POLICY(VkBuffer,              vkDestroyBuffer);
+    RTX_DESTROY_POLICY(VkSampler,             vkDestroySampler);
+    RTX_DESTROY_POLICY(VkShaderModule,        vkDestroyShaderModule);
+    RTX_DESTROY_POLICY(VkDescriptorPool,      vkDestroyDescriptorPool);
+    RTX_DESTROY_POLICY(VkDescriptorSetLayout, vkDestroyDescriptorSetLayout);
+    RTX_DESTROY_POLICY(VkPipeline,            vkDestroyPipeline);
+    RTX_DESTROY_POLICY(VkPipelineLayout,      vkDestroyPipelineLayout);
+    RTX_DESTROY_POLICY(VkRenderPass,          vkDestroyRenderPass);
+    RTX_DESTROY_POLICY(VkSwapchainKHR,        vkDestroySwapchainKHR);
+
+    #undef RTX_DESTROY_POLICY
+
+    template<> struct DestroyPolicy<VkDeviceMemory> {
+        static void destroy(VkDevice d, VkDeviceMemory m) noexcept {
+            memoryBudget().refundMemory(m);
+            vkFreeMemory(d, m, nullptr);
+        }
+    };
+
+    // Extension PFN lives in the Context — defined in RTXHandler.cpp
+    template<> struct DestroyPolicy<VkAccelerationStructureKHR> {
+        static void destroy(VkDevice d, VkAccelerationStructureKHR as) noexcept;
+    };
+
+    // Tag for views of objects something else owns (tracker buffers, heap blocks)
+    struct NonOwning_t { explicit NonOwning_t() = default; };
+    inline constexpr NonOwning_t NonOwning{};
+
+    // =============================================================================
+    // Handle<T> — 24 BYTES: raw + device + tag id + flags
+    //   Destruction is DestroyPolicy<T>::destroy — no std::function, no heap.
+    //   Object sizes belong to the MemoryBudget ledger, not the handle.
     // =============================================================================
     template<typename T>
     struct Handle {
-        using DestroyFn = std::function<void(VkDevice, T, const VkAllocationCallbacks*)>;
+        static constexpr uint32_t FLAG_NON_OWNING = 1u << 0;
 
         T raw = T{};
         VkDevice device = VK_NULL_HANDLE;
-        DestroyFn destroyer = nullptr;
-        size_t size = 0;
-        std::string tag;
+        TagId tag = 0;
+        uint32_t flags = 0;
 
         Handle() noexcept = default;
 
-        Handle(T h, VkDevice d, DestroyFn del = nullptr, size_t sz = 0, std::string_view t = "") 
-            : raw(h), device(d), destroyer(std::move(del)), size(sz), tag(t) {
-            LOG_INFO_CAT("RTX", "Handle created: {} @ 0x{:x} | Tag: {}", typeid(T).name(), reinterpret_cast<uint64_t>(raw), tag);
+        Handle(T h, VkDevice d, std::string_view t = {})
+            : raw(h), device(d), tag(internTag(t)) {
+            LOG_INFO_CAT("RTX", "Handle created: {} @ 0x{:x} | Tag: {}", typeid(T).name(), reinterpret_cast<uint64_t>(raw), t);
         }
 
-        Handle(Handle&& o) noexcept 
-            : raw(o.raw), device(o.device), destroyer(std::move(o.destroyer)), size(o.size), tag(std::move(o.tag)) {
-            o.raw = T{}; o.device = VK_NULL_HANDLE; o.destroyer = nullptr; o.size = 0;
+        Handle(T h, VkDevice d, NonOwning_t, std::string_view t = {})
+            : raw(h), device(d), tag(internTag(t)), flags(FLAG_NON_OWNING) {
+            LOG_INFO_CAT("RTX", "Handle view: {} @ 0x{:x} | Tag: {}", typeid(T).name(), reinterpret_cast<uint64_t>(raw), t);
         }
 
+        Handle(Handle&& o) noexcept
+            : raw(std::exchange(o.raw, T{})), device(std::exchange(o.device, VK_NULL_HANDLE)),
+              tag(std::exchange(o.tag, 0)), flags(std::exchange(o.flags, 0)) {}
+
         Handle& operator=(Handle&& o) noexcept {
             if (this != &o) {
                 reset();
-                raw = o.raw; device = o.device; destroyer = std::move(o.destroyer); 
-                size = o.size; tag = std::move(o.tag);
-                o.raw = T{}; o.device = VK_NULL_HANDLE; o.destroyer = nullptr; o.size = 0;
+                raw    = std::exchange(o.raw, T{});
+                device = std::exchange(o.device, VK_NULL_HANDLE);
+                tag    = std::exchange(o.tag, 0);
+                flags  = std::exchange(o.flags, 0);
             }
             return *this;
         }
@@ -239,27 +317,31 @@ namespace RTX {
             return raw != T{} && device != VK_NULL_HANDLE;
         }
 
+        [[nodiscard]] bool owning() const noexcept { return (flags & FLAG_NON_OWNING) == 0; }
+
+        [[nodiscard]] std::string_view name() const noexcept {
+            return tag ? tagName(tag) : std::string_view(typeid(T).name());
+        }
+
         void reset() noexcept {
             if (valid()) {
-                LOG_INFO_CAT("RTX", "Handle reset: {} @ 0x{:x} | Tag: {}", 
-                             typeid(T).name(), reinterpret_cast<uint64_t>(raw), tag);
-                if (destroyer && device) {
-                    // CRITICAL: Destroy FIRST with original raw handle
-                    destroyer(device, raw, nullptr);
-                    
-                    // THEN shred the local raw value if not too large (simple poison, StoneKey protects in-flight)
-                    constexpr size_t threshold = 16 * 1024 * 1024;
-                    if (size >= threshold) {
-                        LOG_DEBUG_CAT("RTX", "Skipping shred for large allocation ({}MB): {}", 
-                                      size / (1024 * 1024), tag.empty() ? "" : tag.c_str());
-                    } else {
-                        std::memset(&raw, 0xCD, sizeof(T));
-                    }
-                }
-                logAndTrackDestruction(tag.empty() ? typeid(T).name() : tag.c_str(), 
-                                       reinterpret_cast<void*>(raw), __LINE__, size);
-                raw = T{}; device = VK_NULL_HANDLE; destroyer = nullptr; size = 0;
+                LOG_INFO_CAT("RTX", "Handle reset: {} @ 0x{:x} | Tag: {}",
+                             typeid(T).name(), reinterpret_cast<uint64_t>(raw), tagName(tag));
+                if (owning()) DestroyPolicy<T>::destroy(device, raw);
+                logAndTrackDestruction(name(), reinterpret_cast<void*>(raw), __LINE__);
             }
+            raw = T{}; device = VK_NULL_HANDLE; tag = 0; flags = 0;
+        }
+
+        // Like reset(), but the destroy runs once in-flight frames are done with it
+        void retire() noexcept {
+            if (!valid()) return;
+            if (!owning()) { reset(); return; }
+            LOG_INFO_CAT("RTX", "Handle retired: {} @ 0x{:x} | Tag: {}",
+                         typeid(T).name(), reinterpret_cast<uint64_t>(raw), tagName(tag));
+            logAndTrackDestruction(name(), reinterpret_cast<void*>(raw), __LINE__);
+            RTX::retireQueue().retire([d = device, h = raw]() { DestroyPolicy<T>::destroy(d, h); });
+            raw = T{}; device = VK_NULL_HANDLE; tag = 0; flags = 0;
         }
 
         ~Handle() {
@@ -267,6 +349,8 @@ namespace RTX {
         }
     };
 
+    static_assert(sizeof(Handle<VkImage>) <= 24, "Handle<T> must stay cache-friendly in vectors");
+
     template<typename T, typename... Args>
     [[nodiscard]] auto MakeHandle(T h, VkDevice d, Args&&... args) {
         using H = Handle<T>;
@@ -276,8 +360,8 @@ namespace RTX {
     // =============================================================================
     // MACROS
     // =============================================================================
-    #define HANDLE_CREATE(var, raw, dev, destroyer, size, tag) \
-        do { LOG_INFO_CAT("RTX", "HANDLE_CREATE: {} | Tag: {}", #var, tag); (var) = RTX::MakeHandle((raw), (dev), (destroyer), (size), (tag)); } while(0)
+    #define HANDLE_CREATE(var, raw, dev, tag) \
+        do { LOG_INFO_CAT("RTX", "HANDLE_CREATE: {} | Tag: {}", #var, tag); (var) = RTX::MakeHandle((raw), (dev), (tag)); } while(0)
     #define HANDLE_GET(var) ((var).get())
     #define HANDLE_RESET(var) do { LOG_INFO_CAT("RTX", "HANDLE_RESET: {}", #var); (var).reset(); } while(0)
 
@@ -304,6 +388,7 @@ namespace RTX {
 		uint32_t graphicsQueueFamily = static_cast<uint32_t>(-1);  // ← ADD THIS LINE
 
 		bool             hasFullRTX_     = false;
+		bool             synchronization2_ = false;  // vkCmdWriteTimestamp2 / vkCmdPipelineBarrier2 usable
 
         // Window and Dimensions
         SDL_Window*      window   = nullptr;
@@ -323,6 +408,12 @@ namespace RTX {
         uint32_t         graphicsFamily_    = UINT32_MAX;
         uint32_t         presentFamily_     = UINT32_MAX;
 
+        // Upload Queue — a TRANSFER-only family when the device has one, else graphics (see UploadScheduler)
+        uint32_t         transferFamily_    = UINT32_MAX;
+        VkQueue          transferQueue_     = VK_NULL_HANDLE;
+        bool             timelineSemaphore_ = false;
+        bool             presentWait_       = false;  // VK_KHR_present_id + present_wait enabled (FramePacer)
+
         // Ray Tracing Extensions (Function Pointers) — Public for direct access in LAS.hpp et al.
         PFN_vkGetBufferDeviceAddressKHR               vkGetBufferDeviceAddressKHR_               = nullptr;
         PFN_vkCmdTraceRaysKHR                         vkCmdTraceRaysKHR_                         = nullptr;
@@ -332,6 +423,8 @@ namespace RTX {
         PFN_vkGetAccelerationStructureBuildSizesKHR  vkGetAccelerationStructureBuildSizesKHR_  = nullptr;
         PFN_vkCmdBuildAccelerationStructuresKHR       vkCmdBuildAccelerationStructuresKHR_       = nullptr;
         PFN_vkGetAccelerationStructureDeviceAddressKHR vkGetAccelerationStructureDeviceAddressKHR_ = nullptr;
+        PFN_vkCmdCopyAccelerationStructureKHR         vkCmdCopyAccelerationStructureKHR_         = nullptr;  // BLAS compaction
+        PFN_vkCmdWriteAccelerationStructuresPropertiesKHR vkCmdWriteAccelerationStructuresPropertiesKHR_ = nullptr;
         PFN_vkCreateRayTracingPipelinesKHR            vkCreateRayTracingPipelinesKHR_            = nullptr;
 
         VkPhysicalDeviceRayTracingPipelinePropertiesKHR rayTracingProps_{
@@ -380,9 +473,6 @@ namespace RTX {
         Handle<VkBuffer>    debugVisBuffer_;
         Handle<VkRenderPass> renderPass_;  // FIXED: Added renderPass_ member
 
-        // STONEKEY v∞ — THE ONE TRUE SHARED STAGING BUFFER
-        uint64_t sharedStagingEnc_ = 0;   // Obfuscated handle — eternal, protected, unbreakable
-
         // Initialization and Cleanup
         void init(SDL_Window* window, int width, int height);
 		void forgeSwapchain(SDL_Window* window, int width, int height);
@@ -390,6 +480,10 @@ namespace RTX {
         void cleanup() noexcept;
 
 		bool hasFullRTX() const noexcept { return hasFullRTX_; }
+		bool hasSynchronization2() const noexcept { return synchronization2_; }
+		bool hasPresentWait() const noexcept { return presentWait_; }
+		// A compute queue in a family of its own — post-processing overlaps the next frame's trace
+		bool hasAsyncCompute() const noexcept { return computeQueue_ != VK_NULL_HANDLE && computeFamily_ != graphicsFamily_; }
 
         // Validity and Readiness Accessors
         [[nodiscard]] bool isValid() const noexcept {
@@ -436,6 +530,7 @@ namespace RTX {
         [[nodiscard]] uint32_t         graphicsFamily() const noexcept { return graphicsFamily_; }
         [[nodiscard]] uint32_t         presentFamily()  const noexcept { return presentFamily_; }
         [[nodiscard]] uint32_t         computeFamily()  const noexcept { return computeFamily_; }
+        [[nodiscard]] uint32_t         transferFamily() const noexcept { return transferFamily_; }
 
         // Command Pool Accessors
         [[nodiscard]] VkCommandPool    commandPool()       const noexcept { return commandPool_; }
@@ -445,6 +540,7 @@ namespace RTX {
         [[nodiscard]] VkQueue          graphicsQueue() const noexcept { return graphicsQueue_; }
         [[nodiscard]] VkQueue          presentQueue()  const noexcept { return presentQueue_; }
         [[nodiscard]] VkQueue          computeQueue()   const noexcept { return computeQueue_; }
+        [[nodiscard]] VkQueue          transferQueue()  const noexcept { return transferQueue_; }
 
         // Pipeline Cache
         [[nodiscard]] VkPipelineCache  pipelineCacheHandle() const noexcept { return pipelineCache_; }
@@ -459,6 +555,8 @@ namespace RTX {
         [[nodiscard]] PFN_vkGetAccelerationStructureBuildSizesKHR   vkGetAccelerationStructureBuildSizesKHR() const noexcept { return vkGetAccelerationStructureBuildSizesKHR_; }
         [[nodiscard]] PFN_vkCmdBuildAccelerationStructuresKHR       vkCmdBuildAccelerationStructuresKHR() const noexcept { return vkCmdBuildAccelerationStructuresKHR_; }
         [[nodiscard]] PFN_vkDestroyAccelerationStructureKHR         vkDestroyAccelerationStructureKHR() const noexcept { return vkDestroyAccelerationStructureKHR_; }
+        [[nodiscard]] PFN_vkCmdCopyAccelerationStructureKHR         vkCmdCopyAccelerationStructureKHR() const noexcept { return vkCmdCopyAccelerationStructureKHR_; }
+        [[nodiscard]] PFN_vkCmdWriteAccelerationStructuresPropertiesKHR vkCmdWriteAccelerationStructuresPropertiesKHR() const noexcept { return vkCmdWriteAccelerationStructuresPropertiesKHR_; }
 
         // Display Timing Accessors
         [[nodiscard]] PFN_vkGetPastPresentationTimingGOOGLE         vkGetPastPresentationTimingGOOGLE() const noexcept { return vkGetPastPresentationTimingGOOGLE_; }
@@ -516,6 +614,8 @@ namespace RTX {
     // =============================================================================
     // UltraLowLevelBufferTracker
     // =============================================================================
+    // memory is the DeviceHeap block — SHARED with other buffers. Never map or
+    // free it directly: use BUFFER_MAP (base + offset) and BUFFER_DESTROY.
     struct BufferData {
         VkBuffer buffer = VK_NULL_HANDLE;
         VkDeviceMemory memory = VK_NULL_HANDLE;
@@ -523,6 +623,10 @@ namespace RTX {
         VkDeviceSize alignedSize = 0;  // Aligned allocation size (NEW)
         VkBufferUsageFlags usage = 0;
         std::string tag;
+        VkDeviceSize offset = 0;                   // Offset of this buffer inside `memory`
+        VkMemoryPropertyFlags props = 0;
+        HeapAllocation allocation{};
+        bool relocatable = false;                  // Owner re-fetches RAW_BUFFER after defragment()
     };
 
     constexpr VkDeviceSize SIZE_64MB  =  64_MB;
@@ -542,9 +646,18 @@ namespace RTX {
         BufferData* getData(uint64_t handle) noexcept;
         const BufferData* getData(uint64_t handle) const noexcept;
         void* map(uint64_t handle) noexcept;
-        void unmap(uint64_t handle) noexcept;
+        void unmap(uint64_t handle) noexcept;                       // flush(handle) — mapping stays
+        void flush(uint64_t handle, VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE) noexcept;
+        void invalidate(uint64_t handle, VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE) noexcept;
         void init(VkDevice dev, VkPhysicalDevice phys) noexcept;
         void purge_all() noexcept;
+
+        // Defragmentation — moves up to maxMoves relocatable buffers out of the
+        // sparsest DeviceHeap block, recording copies (and the barriers around
+        // them) into cmd. Old buffers go to retireQueue(), destroyed once the
+        // submit carrying cmd has completed. Only TRANSFER_SRC buffers qualify.
+        void setRelocatable(uint64_t handle, bool relocatable) noexcept;
+        uint32_t defragment(VkCommandBuffer cmd, uint32_t maxMoves) noexcept;
         uint64_t make_64M (VkBufferUsageFlags extra, VkMemoryPropertyFlags props) noexcept;
         uint64_t make_128M(VkBufferUsageFlags extra, VkMemoryPropertyFlags props) noexcept;
         uint64_t make_256M(VkBufferUsageFlags extra, VkMemoryPropertyFlags props) noexcept;
@@ -571,10 +684,11 @@ namespace RTX {
             return UINT32_MAX;
         }
 
+        [[nodiscard]] uint32_t liveCount() const noexcept { return slots_.size(); }
+
     private:
-        mutable std::mutex mutex_;
-        std::unordered_map<uint64_t, BufferData> map_;
-        std::atomic<uint64_t> counter_{0};
+        // Public handle = StoneKey(raw slot handle); lookups are wait-free (see SlotTable.hpp)
+        SlotTable<BufferData> slots_;
         VkDevice device_{VK_NULL_HANDLE};
         VkPhysicalDevice physDev_{VK_NULL_HANDLE};
         uint64_t obfuscate(uint64_t raw) const noexcept;
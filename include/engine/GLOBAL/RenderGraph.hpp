@@ -0,0 +1,259 @@
+// include/engine/GLOBAL/RenderGraph.hpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// RENDER GRAPH — DECLARED IMAGE ACCESS → MINIMAL SYNCHRONIZATION2 BARRIERS
+//   Passes declare every image they touch as an ImageUse {stage, access,
+//   layout}. compile() then:
+//     1. CULLS passes nobody needs. A pass survives if it has side effects,
+//        writes a retained import or an image with a final state, or writes
+//        something a surviving later pass reads.
+//     2. ALIASES transients. First fit over [first use, last use] in the
+//        surviving order, between transients of equal usage: one slot is one
+//        memory range, every image in it starts UNDEFINED.
+//     3. SOLVES barriers by walking the survivors with per-image state:
+//        layout change → transition; read after write → make the write
+//        visible (once per stage/access — a read already covered adds
+//        nothing); write after write → availability + visibility; write
+//        after read → execution dependency only. One pass's barriers are one
+//        batch, recorded at the top of its secondary.
+//
+//   Imports keep their state across frames: the graph remembers where each
+//   VkImage was left (layout, last writer, readers since), so this frame's
+//   first use syncs against the previous frame's last one — same queue,
+//   submission order. forget(image) whenever a handle is (re)created.
+//   importAcquired() is the swapchain path: contents discarded, and the first
+//   barrier's source is its own first-use stage so it chains onto the
+//   acquire semaphore; waitStage() is what the submit's wait mask needs.
+//
+//   Passes run on GraphQueue::Graphics or GraphQueue::Compute (the async
+//   compute family). Surviving passes must be graphics-first, compute-last:
+//   one handoff per frame, carried by a semaphore the compute submit waits
+//   on at crossQueueWait(Compute). An image whose last access was on the
+//   other queue is synced by that semaphore (or, across frames, by the frame
+//   slot wait) — its barrier sources from its own first-use stage and only
+//   exists for a layout change. Images shared across queues need CONCURRENT
+//   sharing; the graph emits no ownership transfers.
+//
+//   Per frame: reset() → import/create + addPass().use() → compile() →
+//   realizeTransients() → recordPasses(queue) into that queue's
+//   FrameRecorder → recordFinal(queue) into its primary. Declaration, compile() and the results
+//   never call into Vulkan — only its enums — and live in RenderGraph.cpp,
+//   which links without a loader (tests/unit/test_render_graph.cpp solves
+//   graphs on the host). The last three are the device side, in
+//   RenderGraphDevice.cpp.
+// =============================================================================
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include "engine/GLOBAL/DeviceHeap.hpp"
+#include "engine/GLOBAL/FrameRecorder.hpp"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace RTX {
+
+struct ImageUse {
+    VkPipelineStageFlags2 stage  = VK_PIPELINE_STAGE_2_NONE;
+    VkAccessFlags2        access = VK_ACCESS_2_NONE;
+    VkImageLayout         layout = VK_IMAGE_LAYOUT_UNDEFINED;
+};
+
+// Uses the renderer's passes declare
+namespace Use {
+inline constexpr ImageUse RayTraceWrite     { VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR, VK_ACCESS_2_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_GENERAL };
+inline constexpr ImageUse RayTraceReadWrite { VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR,
+                                              VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_GENERAL };
+inline constexpr ImageUse ComputeSample     { VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+inline constexpr ImageUse ComputeRead       { VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL };
+inline constexpr ImageUse ComputeWrite      { VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_GENERAL };
+inline constexpr ImageUse ComputeReadWrite  { VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                                              VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_GENERAL };
+inline constexpr ImageUse Clear             { VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_GENERAL };
+inline constexpr ImageUse Present           { VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR };
+// Left by the create-time one-shot transition, which was waited on
+inline constexpr ImageUse Created           { VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE, VK_IMAGE_LAYOUT_GENERAL };
+}
+
+// synchronization2 → legacy masks, for barriers and submit waits without sync2.
+// Bits with a legacy twin keep their value, sync2-only bits map to the legacy
+// stage/access that contains them (COPY → TRANSFER, SHADER_STORAGE_WRITE →
+// SHADER_WRITE, ...), anything else widens to ALL_COMMANDS / MEMORY_READ |
+// MEMORY_WRITE. NONE stays 0 — the caller picks TOP/BOTTOM_OF_PIPE or ALL_COMMANDS.
+[[nodiscard]] VkPipelineStageFlags legacyStages(VkPipelineStageFlags2 stages) noexcept;
+[[nodiscard]] VkAccessFlags        legacyAccess(VkAccessFlags2 access) noexcept;
+
+enum class GraphQueue : uint8_t { Graphics, Compute };
+
+using GraphImage = uint32_t;
+inline constexpr GraphImage NO_GRAPH_IMAGE = UINT32_MAX;
+inline constexpr uint32_t   NO_ALIAS_SLOT  = UINT32_MAX;
+
+struct TransientDesc {
+    VkFormat          format = VK_FORMAT_UNDEFINED;
+    VkExtent2D        extent = {};
+    VkImageUsageFlags usage  = 0;
+};
+
+// src.layout → dst.layout; equal layouts make it a pure memory/execution dependency
+struct GraphBarrier {
+    GraphImage image = NO_GRAPH_IMAGE;
+    ImageUse   src;
+    ImageUse   dst;
+    GraphQueue queue = GraphQueue::Graphics;    // recorded on
+};
+
+class RenderGraph {
+public:
+    class PassBuilder {
+    public:
+        PassBuilder& use(GraphImage image, const ImageUse& u);
+        PassBuilder& sideEffects() noexcept;    // never culled
+    private:
+        friend class RenderGraph;
+        PassBuilder(RenderGraph& graph, uint32_t pass) noexcept : graph_(graph), pass_(pass) {}
+        RenderGraph& graph_;
+        uint32_t     pass_;
+    };
+
+    RenderGraph() = default;
+    ~RenderGraph() = default;                   // destroy() explicitly — device is gone at static teardown
+    RenderGraph(const RenderGraph&) = delete;
+    RenderGraph& operator=(const RenderGraph&) = delete;
+
+    // ── Declaration (once per frame, after reset()) ──────────────────────────
+    void reset() noexcept;                      // drops passes and images, keeps remembered states + transients
+    // retained: contents outlive the frame, so writes to it are never culled
+    GraphImage importImage(const char* name, VkImage image, bool retained = true,
+                           const ImageUse& initial = Use::Created, VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT);
+    GraphImage importAcquired(const char* name, VkImage image, VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT);
+    GraphImage createTransient(const char* name, const TransientDesc& desc);
+    void       setFinal(GraphImage image, const ImageUse& u);   // e.g. Use::Present
+    PassBuilder addPass(const char* name, std::function<void(VkCommandBuffer)> record,
+                        GraphQueue queue = GraphQueue::Graphics);
+
+    // ── Solve ────────────────────────────────────────────────────────────────
+    [[nodiscard]] bool compile();               // false on a declaration error (logged); nothing to record
+
+    [[nodiscard]] std::span<const uint32_t>     order()         const noexcept { return order_; }
+    [[nodiscard]] std::span<const GraphBarrier> barriers(uint32_t orderIdx) const noexcept;   // before order()[orderIdx]
+    [[nodiscard]] std::span<const GraphBarrier> finalBarriers() const noexcept;
+    [[nodiscard]] VkPipelineStageFlags2 waitStage(GraphImage image) const noexcept;   // acquired images
+    // First-use stages on queue of images last touched by the other one — the handoff wait mask
+    [[nodiscard]] VkPipelineStageFlags2 crossQueueWait(GraphQueue queue) const noexcept;
+    [[nodiscard]] bool        usesQueue(GraphQueue queue) const noexcept;
+    [[nodiscard]] uint32_t    aliasSlot(GraphImage image) const noexcept;
+    [[nodiscard]] uint32_t    aliasSlots()   const noexcept { return aliasSlots_; }
+    [[nodiscard]] uint32_t    passCount()    const noexcept { return static_cast<uint32_t>(passes_.size()); }
+    [[nodiscard]] uint32_t    barrierCount() const noexcept { return static_cast<uint32_t>(barriers_.size()); }
+    [[nodiscard]] const char* passName(uint32_t pass) const noexcept;
+
+    void forget(VkImage image) noexcept;        // handle destroyed or about to be reused
+    void forgetAll() noexcept;
+
+    // ── Device side ──────────────────────────────────────────────────────────
+    // Create/reuse memory + images for this frame's transients; reuses last frame's when the layout matches
+    [[nodiscard]] bool realizeTransients(VkDevice device);
+    [[nodiscard]] VkImageView transientView(GraphImage image) const noexcept;
+
+    // One RecordPass per surviving pass on queue, its barrier batch recorded first — valid until the next call
+    [[nodiscard]] std::span<const RecordPass> recordPasses(GraphQueue queue, bool synchronization2);
+    // Final-state barriers of the images whose last use was on queue
+    void recordFinal(VkCommandBuffer cmd, GraphQueue queue, bool synchronization2) const noexcept;
+
+    void destroy() noexcept;                    // retires transient images + memory, forgets every state
+
+private:
+    // Where an image was left: pending write, readers since it, who has seen it
+    struct Track {
+        VkImageLayout         layout        = VK_IMAGE_LAYOUT_UNDEFINED;
+        VkPipelineStageFlags2 writeStages   = VK_PIPELINE_STAGE_2_NONE;
+        VkAccessFlags2        writeAccess   = VK_ACCESS_2_NONE;
+        VkPipelineStageFlags2 readStages    = VK_PIPELINE_STAGE_2_NONE;
+        VkPipelineStageFlags2 visibleStages = VK_PIPELINE_STAGE_2_NONE;
+        VkAccessFlags2        visibleAccess = VK_ACCESS_2_NONE;
+        GraphQueue            queue         = GraphQueue::Graphics;   // of the last access
+    };
+
+    struct Image {
+        const char*        name      = "";
+        VkImage            image     = VK_NULL_HANDLE;
+        VkImageAspectFlags aspect    = VK_IMAGE_ASPECT_COLOR_BIT;
+        ImageUse           initial;
+        ImageUse           final;
+        bool               retained  = false;
+        bool               acquired  = false;
+        bool               transient = false;
+        bool               hasFinal  = false;
+        TransientDesc      desc;
+        uint32_t           transientIdx = UINT32_MAX;
+        // compile()
+        uint32_t           first = UINT32_MAX, last = 0;   // surviving order indices
+        uint32_t           slot  = NO_ALIAS_SLOT;
+        VkPipelineStageFlags2 waitStage = VK_PIPELINE_STAGE_2_NONE;
+    };
+
+    struct Access {
+        uint32_t   pass;
+        GraphImage image;
+        ImageUse   use;
+    };
+
+    struct Pass {
+        const char*                          name = "";
+        std::function<void(VkCommandBuffer)> record;
+        GraphQueue                           queue       = GraphQueue::Graphics;
+        bool                                 sideEffects = false;
+    };
+
+    struct Range { uint32_t first = 0, count = 0; };
+
+    void cull(std::vector<Access>& accesses);
+    void assignSlots();
+    void solve(const std::vector<Access>& accesses);
+    void useImage(GraphImage id, Track& t, const ImageUse& u, GraphQueue queue, bool firstUse);
+    void recordBarriers(VkCommandBuffer cmd, std::span<const GraphBarrier> list, bool synchronization2) const noexcept;
+    void releaseTransients() noexcept;
+
+    std::vector<Image>        images_;
+    std::vector<Access>       accesses_;
+    std::vector<Pass>         passes_;
+    std::vector<uint32_t>     order_;
+    std::vector<GraphBarrier> barriers_;
+    std::vector<Range>        passBarriers_;   // by order index
+    Range                     finalRange_;
+    uint32_t                  transientCount_ = 0;
+    uint32_t                  aliasSlots_     = 0;
+    std::array<VkPipelineStageFlags2, 2> crossWait_{};   // by GraphQueue
+    std::vector<RecordPass>   recordPasses_;
+
+    std::unordered_map<VkImage, Track> known_; // imports, across frames
+    std::vector<Track>        slotTracks_;     // alias slots, across frames
+
+    // Realized transients — kept while the declared set stays the same
+    struct Realized {
+        TransientDesc desc;
+        uint32_t      slot  = NO_ALIAS_SLOT;
+        VkImage       image = VK_NULL_HANDLE;
+        VkImageView   view  = VK_NULL_HANDLE;
+    };
+    VkDevice                    device_ = VK_NULL_HANDLE;
+    std::vector<Realized>       realized_;
+    std::vector<HeapAllocation> slotMemory_;
+
+    uint64_t shape_ = 0;                        // logged when the compiled graph changes
+};
+
+} // namespace RTX
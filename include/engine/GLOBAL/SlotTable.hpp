@@ -0,0 +1,188 @@
+// include/engine/GLOBAL/SlotTable.hpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// SLOT TABLE — GENERATIONAL HANDLES, WAIT-FREE LOOKUP
+//   raw handle = (generation << 32) | (slot index + 1)   — 0 is never issued
+//   Slots live in 1024-entry pages that are installed once and never freed,
+//   so a lookup is: page load → generation compare → pointer. No lock, no
+//   hash, no RMW. A stale handle (slot freed or reused) fails the generation
+//   check and returns nullptr.
+//   Generations are odd while a slot is live, even while it is free.
+//   Freed slots go onto one of SHARDS Treiber stacks (tagged heads, no ABA),
+//   picked per thread so concurrent create/destroy rarely touch the same line.
+//
+//   Contract (same as vkDestroyBuffer): don't remove() a handle while another
+//   thread is still using the pointer it got from lookup().
+// =============================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace RTX {
+
+template<class T>
+class SlotTable {
+public:
+    static constexpr uint32_t PAGE_BITS = 10;
+    static constexpr uint32_t PAGE_SIZE = 1u << PAGE_BITS;
+    static constexpr uint32_t MAX_PAGES = 1024;                 // 1M live handles
+    static constexpr uint32_t CAPACITY  = PAGE_SIZE * MAX_PAGES;
+    static constexpr uint32_t SHARDS    = 16;
+
+    SlotTable() = default;
+    ~SlotTable() {
+        for (auto& p : pages_) delete p.load(std::memory_order_relaxed);
+    }
+    SlotTable(const SlotTable&) = delete;
+    SlotTable& operator=(const SlotTable&) = delete;
+
+    // Returns the raw handle, 0 when the table is full or out of memory
+    [[nodiscard]] uint64_t insert(T&& value) noexcept {
+        uint32_t idx = popFree();
+        if (idx == NIL) {
+            idx = next_.fetch_add(1, std::memory_order_relaxed);
+            if (idx >= CAPACITY || !ensurePage(idx >> PAGE_BITS)) return 0;
+        }
+        Slot& s = slot(idx);
+        s.value = std::move(value);
+        const uint32_t gen = s.gen.load(std::memory_order_relaxed) + 1;     // even → odd
+        s.gen.store(gen, std::memory_order_release);                        // publishes value
+        live_.fetch_add(1, std::memory_order_relaxed);
+        return (static_cast<uint64_t>(gen) << 32) | (idx + 1);
+    }
+
+    [[nodiscard]] T* lookup(uint64_t raw) noexcept {
+        Slot* s = find(raw);
+        return s ? &s->value : nullptr;
+    }
+    [[nodiscard]] const T* lookup(uint64_t raw) const noexcept {
+        const Slot* s = const_cast<SlotTable*>(this)->find(raw);
+        return s ? &s->value : nullptr;
+    }
+
+    // Moves the value out; false if the handle is stale or already removed
+    bool remove(uint64_t raw, T& out) noexcept {
+        Slot* s = find(raw);
+        if (!s) return false;
+        uint32_t gen = static_cast<uint32_t>(raw >> 32);
+        if (!s->gen.compare_exchange_strong(gen, gen + 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+            return false;                                                   // lost to a concurrent remove
+        out = std::move(s->value);
+        s->value = T{};
+        pushFree(static_cast<uint32_t>(raw) - 1);
+        live_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Visits every live slot as fn(rawHandle, T&). Not synchronised with remove().
+    template<class Fn>
+    void forEach(Fn&& fn) noexcept(noexcept(fn(uint64_t{}, std::declval<T&>()))) {
+        const uint32_t end = std::min(next_.load(std::memory_order_acquire), CAPACITY);
+        for (uint32_t idx = 0; idx < end; ++idx) {
+            Page* page = pages_[idx >> PAGE_BITS].load(std::memory_order_acquire);
+            if (!page) { idx |= PAGE_SIZE - 1; continue; }
+            Slot& s = (*page)[idx & (PAGE_SIZE - 1)];
+            const uint32_t gen = s.gen.load(std::memory_order_acquire);
+            if (gen & 1u) fn((static_cast<uint64_t>(gen) << 32) | (idx + 1), s.value);
+        }
+    }
+
+    [[nodiscard]] uint32_t size()      const noexcept { return live_.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint32_t highWater() const noexcept { return std::min(next_.load(std::memory_order_relaxed), CAPACITY); }
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Slot {
+        std::atomic<uint32_t> gen{0};
+        std::atomic<uint32_t> nextFree{0};      // index + 1 of the next free slot, 0 = end
+        T value{};
+    };
+    using Page = std::array<Slot, PAGE_SIZE>;
+
+    struct alignas(64) FreeHead {
+        std::atomic<uint64_t> head{0};          // (tag << 32) | (index + 1)
+    };
+
+    [[nodiscard]] Slot& slot(uint32_t idx) noexcept {
+        return (*pages_[idx >> PAGE_BITS].load(std::memory_order_acquire))[idx & (PAGE_SIZE - 1)];
+    }
+
+    [[nodiscard]] Slot* find(uint64_t raw) noexcept {
+        const uint32_t idx1 = static_cast<uint32_t>(raw);
+        const uint32_t gen  = static_cast<uint32_t>(raw >> 32);
+        if (idx1 == 0 || idx1 > CAPACITY || !(gen & 1u)) return nullptr;
+        Page* page = pages_[(idx1 - 1) >> PAGE_BITS].load(std::memory_order_acquire);
+        if (!page) return nullptr;
+        Slot& s = (*page)[(idx1 - 1) & (PAGE_SIZE - 1)];
+        return s.gen.load(std::memory_order_acquire) == gen ? &s : nullptr;
+    }
+
+    [[nodiscard]] bool ensurePage(uint32_t pageIndex) noexcept {
+        auto& p = pages_[pageIndex];
+        Page* page = p.load(std::memory_order_acquire);
+        if (page) return true;
+        Page* fresh = new (std::nothrow) Page{};
+        if (!fresh) return false;
+        if (!p.compare_exchange_strong(page, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+            delete fresh;                                                   // another thread installed it
+        return true;
+    }
+
+    [[nodiscard]] static uint32_t threadShard() noexcept {
+        static std::atomic<uint32_t> counter{0};
+        thread_local const uint32_t shard = counter.fetch_add(1, std::memory_order_relaxed) & (SHARDS - 1);
+        return shard;
+    }
+
+    [[nodiscard]] uint32_t popFrom(FreeHead& fh) noexcept {
+        uint64_t head = fh.head.load(std::memory_order_acquire);
+        while (const uint32_t idx1 = static_cast<uint32_t>(head)) {
+            const uint32_t next = slot(idx1 - 1).nextFree.load(std::memory_order_relaxed);
+            const uint64_t fresh = (((head >> 32) + 1) << 32) | next;
+            if (fh.head.compare_exchange_weak(head, fresh, std::memory_order_acquire, std::memory_order_acquire))
+                return idx1 - 1;
+        }
+        return NIL;
+    }
+
+    [[nodiscard]] uint32_t popFree() noexcept {
+        const uint32_t home = threadShard();
+        for (uint32_t i = 0; i < SHARDS; ++i) {
+            const uint32_t idx = popFrom(free_[(home + i) & (SHARDS - 1)]);
+            if (idx != NIL) return idx;
+        }
+        return NIL;
+    }
+
+    void pushFree(uint32_t idx) noexcept {
+        FreeHead& fh = free_[threadShard()];
+        Slot& s = slot(idx);
+        uint64_t head = fh.head.load(std::memory_order_relaxed);
+        uint64_t fresh;
+        do {
+            s.nextFree.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+            fresh = (((head >> 32) + 1) << 32) | (idx + 1);
+        } while (!fh.head.compare_exchange_weak(head, fresh, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    std::array<std::atomic<Page*>, MAX_PAGES> pages_{};
+    std::array<FreeHead, SHARDS>              free_{};
+    alignas(64) std::atomic<uint32_t>         next_{0};
+    std::atomic<uint32_t>                     live_{0};
+};
+
+} // namespace RTX
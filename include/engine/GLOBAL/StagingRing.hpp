@@ -0,0 +1,115 @@
+// include/engine/GLOBAL/StagingRing.hpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// STAGING RING — HOST-VISIBLE UPLOAD SPACE, RECLAIMED BY TIMELINE VALUE
+//   allocate() carves a contiguous, aligned span out of a persistently mapped
+//   ring. The caller fills it (no lock held — many threads can write at once),
+//   records a copy from it, and once that copy is submitted calls
+//   retire(id, timeline, value). Space is handed back strictly in allocation
+//   order, and only after the span is retired AND its timeline value has
+//   passed — so nothing the GPU may still read is ever overwritten.
+//   A span never straddles the wrap: the tail end is skipped instead.
+//
+//   Exhausted:
+//     capacity < max                → grow — a new ring of twice the size; the
+//                                     old one lives until its spans complete
+//     oldest span already retired   → block on its timeline value
+//     oldest span not yet submitted → grow past max (waiting would deadlock)
+//   retire() with a null timeline marks a span complete (blocking submits
+//   that already waited). destroy() requires an idle device.
+// =============================================================================
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+namespace RTX {
+
+struct StagingAlloc {
+    VkBuffer     buffer = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;          // from the start of buffer
+    VkDeviceSize size   = 0;
+    uint8_t*     cpu    = nullptr;
+    uint64_t     id     = 0;          // pass to flush() / retire()
+
+    [[nodiscard]] bool valid() const noexcept { return cpu != nullptr; }
+};
+
+class StagingRing {
+public:
+    StagingRing() = default;
+    ~StagingRing() = default;         // destroy() explicitly — owners outlive the device otherwise
+    StagingRing(const StagingRing&) = delete;
+    StagingRing& operator=(const StagingRing&) = delete;
+
+    [[nodiscard]] bool init(VkDevice device, VkDeviceSize initialSize, VkDeviceSize maxSize) noexcept;
+    void destroy() noexcept;
+
+    // Invalid alloc only if a buffer could not be created
+    [[nodiscard]] StagingAlloc allocate(VkDeviceSize size, VkDeviceSize alignment = 16);
+
+    // Publish the CPU writes — no-op on HOST_COHERENT memory
+    void flush(const StagingAlloc& alloc) noexcept;
+
+    // The submit reading alloc signals timeline ≥ value (null timeline = already complete)
+    void retire(uint64_t id, VkSemaphore timeline, uint64_t value) noexcept;
+
+    // Hand back every completed span — allocate() does this itself when short
+    void reclaim() noexcept;
+
+    [[nodiscard]] bool         valid()     const noexcept;
+    [[nodiscard]] VkDeviceSize capacity()  const noexcept;
+    [[nodiscard]] VkDeviceSize inFlight()  const noexcept;      // bytes not yet handed back
+    [[nodiscard]] VkDeviceSize highWater() const noexcept;
+
+private:
+    struct Span {
+        uint64_t     id       = 0;
+        VkDeviceSize end      = 0;    // virtual offset one past the span (wrap padding included)
+        VkSemaphore  timeline = VK_NULL_HANDLE;
+        uint64_t     value    = 0;
+        bool         retired  = false;
+    };
+
+    // Offsets are virtual and only grow; physical = virtual % size
+    struct Chunk {
+        uint64_t         enc     = 0;
+        VkBuffer         buffer  = VK_NULL_HANDLE;
+        uint8_t*         cpu     = nullptr;
+        VkDeviceSize     size    = 0;
+        VkDeviceSize     head    = 0;
+        VkDeviceSize     tail    = 0;
+        uint64_t         firstId = 0;
+        std::deque<Span> spans;
+    };
+
+    [[nodiscard]] bool  growLocked(VkDeviceSize atLeast);
+    [[nodiscard]] Span* findLocked(uint64_t id) noexcept;
+    void reclaimLocked() noexcept;
+    [[nodiscard]] bool completeLocked(const Span& s) noexcept;
+
+    mutable std::mutex mutex_;
+    VkDevice           device_  = VK_NULL_HANDLE;
+    VkDeviceSize       maxSize_ = 0;
+    std::deque<Chunk>  chunks_;       // back() is current; older ones drain and are destroyed
+    uint64_t           nextId_  = 1;
+    VkDeviceSize       highWater_ = 0;
+    uint32_t           grows_     = 0;
+    uint32_t           stalls_    = 0;
+
+    // Last counter value read per reclaim pass — one query per semaphore, not per span
+    VkSemaphore        polledSemaphore_ = VK_NULL_HANDLE;
+    uint64_t           polledValue_     = 0;
+};
+
+} // namespace RTX
@@ -0,0 +1,275 @@
+// =============================================================================
+// Trace.hpp — AMOURANTH RTX Engine © 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. Creative Commons Attribution-NonCommercial 4.0 International (CC BY-NC 4.0)
+//    https://creativecommons.org/licenses/by-nc/4.0/legalcode
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// TIMELINE TRACE EVENTS — CPU PHASES ON A PERFETTO TIMELINE
+//   TRACE_SCOPE(cat, name)            begin/end pair bound to a C++ scope
+//   TRACE_BEGIN(cat, name) / TRACE_END(cat, name)
+//   TRACE_INSTANT(cat, name)          zero-length marker
+//   TRACE_COUNTER(cat, name, value)   counter track
+// cat/name MUST be string literals — only the pointers are stored.
+//
+// Each thread appends to its own chain of fixed-size chunks (single writer,
+// no locks, no atomics RMW). Nothing is recorded until Trace::start() —
+// disabled cost is one load + one predicted-not-taken branch.
+// Trace::stop() writes Chrome trace-event JSON (chrome://tracing,
+// ui.perfetto.dev). Run with --trace=<file>.
+// Define AMOURANTH_DISABLE_TRACE_EVENTS to compile every macro out.
+// =============================================================================
+
+#pragma once
+
+#include "engine/GLOBAL/logging.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+
+// =============================================================================
+// CONFIG
+// =============================================================================
+constexpr size_t   TRACE_CHUNK_EVENTS          = 4096;
+constexpr uint32_t TRACE_MAX_CHUNKS_PER_THREAD = 256;   // ~1M events/thread, then drop
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#ifndef AMOURANTH_DISABLE_TRACE_EVENTS
+#define TRACE_SCOPE(cat, name)          ::Logging::Trace::Scope TRACE_CONCAT(traceScope_, __LINE__){cat, name}
+#define TRACE_BEGIN(cat, name)          do { if (::Logging::Trace::active()) [[unlikely]] ::Logging::Trace::record('B', cat, name); } while (0)
+#define TRACE_END(cat, name)            do { if (::Logging::Trace::active()) [[unlikely]] ::Logging::Trace::record('E', cat, name); } while (0)
+#define TRACE_INSTANT(cat, name)        do { if (::Logging::Trace::active()) [[unlikely]] ::Logging::Trace::record('i', cat, name); } while (0)
+#define TRACE_COUNTER(cat, name, value) do { if (::Logging::Trace::active()) [[unlikely]] ::Logging::Trace::record('C', cat, name, static_cast<double>(value)); } while (0)
+#else
+#define TRACE_SCOPE(cat, name)          do {} while (0)
+#define TRACE_BEGIN(cat, name)          do {} while (0)
+#define TRACE_END(cat, name)            do {} while (0)
+#define TRACE_INSTANT(cat, name)        do {} while (0)
+#define TRACE_COUNTER(cat, name, value) do {} while (0)
+#endif
+
+namespace Logging::Trace {
+
+struct Event {
+    const char* cat;
+    const char* name;
+    int64_t     tsNs;
+    double      value;
+    char        phase;   // 'B' 'E' 'i' 'C'
+};
+
+struct Chunk {
+    std::array<Event, TRACE_CHUNK_EVENTS> events;
+    std::atomic<uint32_t> count{0};        // published with release by the owning thread
+    std::atomic<Chunk*>   next{nullptr};
+};
+
+// One per thread that ever recorded. Owned by the registry for the life of the
+// process — a dump may run while (or after) the thread is gone.
+struct ThreadBuffer {
+    Chunk*                head = nullptr;
+    Chunk*                tail = nullptr;
+    uint32_t              chunks = 0;
+    uint32_t              tid = 0;                 // small sequential id for the viewer
+    uint64_t              logThreadId = 0;         // matches [thread] column in log lines
+    std::atomic<uint64_t> dropped{0};
+    char                  name[32]{};
+    ThreadBuffer*         nextBuffer = nullptr;
+};
+
+inline std::atomic<bool>          g_enabled{false};
+inline std::atomic<ThreadBuffer*> g_buffers{nullptr};
+inline std::atomic<uint32_t>      g_nextTid{1};
+inline std::chrono::steady_clock::time_point g_epoch{};
+inline std::mutex  g_controlMutex;
+inline std::string g_outputPath;
+
+// Acquire pairs with start() so g_epoch is visible — a plain load on x86/ARMv8 (ldar)
+[[nodiscard]] inline bool active() noexcept { return g_enabled.load(std::memory_order_acquire); }
+
+// Name given before this thread's first event — copied in by registerThread()
+[[nodiscard]] inline char (&pendingThreadName() noexcept)[32] {
+    thread_local char name[32]{};
+    return name;
+}
+
+[[nodiscard]] inline ThreadBuffer* registerThread() noexcept {
+    auto* tb = new (std::nothrow) ThreadBuffer{};
+    if (!tb) return nullptr;
+    tb->head = tb->tail = new (std::nothrow) Chunk{};
+    tb->chunks = tb->head ? 1 : 0;
+    tb->tid = g_nextTid.fetch_add(1, std::memory_order_relaxed);
+    tb->logThreadId = currentThreadId();
+    if (const char* pending = pendingThreadName(); pending[0]) std::memcpy(tb->name, pending, sizeof(tb->name));
+    else std::format_to_n(tb->name, sizeof(tb->name) - 1, "thread {}", tb->tid);
+
+    ThreadBuffer* head = g_buffers.load(std::memory_order_relaxed);
+    do { tb->nextBuffer = head; }
+    while (!g_buffers.compare_exchange_weak(head, tb, std::memory_order_release, std::memory_order_relaxed));
+    return tb;
+}
+
+// The thread's buffer (and its first ~160 KB chunk) is created on its first
+// recorded event, so only threads that trace while tracing is on pay for one
+[[nodiscard]] inline ThreadBuffer*& localBufferSlot() noexcept {
+    thread_local ThreadBuffer* tb = nullptr;
+    return tb;
+}
+
+[[nodiscard]] inline ThreadBuffer* localBuffer() noexcept {
+    ThreadBuffer*& tb = localBufferSlot();
+    if (!tb) [[unlikely]] tb = registerThread();
+    return tb;
+}
+
+// Viewer label for the calling thread — shows up as the track name. Allocates
+// nothing: before the first event it is only remembered for registerThread().
+inline void setThreadName(std::string_view name) noexcept {
+    char (&pending)[32] = pendingThreadName();
+    const size_t n = std::min(name.size(), sizeof(pending) - 1);
+    std::memcpy(pending, name.data(), n);
+    pending[n] = '\0';
+    if (ThreadBuffer* tb = localBufferSlot()) std::memcpy(tb->name, pending, sizeof(tb->name));
+}
+
+inline void record(char phase, const char* cat, const char* name, double value = 0.0) noexcept {
+    ThreadBuffer* tb = localBuffer();
+    if (!tb || !tb->tail) [[unlikely]] return;
+
+    Chunk* c = tb->tail;
+    uint32_t n = c->count.load(std::memory_order_relaxed);
+    if (n == TRACE_CHUNK_EVENTS) [[unlikely]] {
+        Chunk* fresh = tb->chunks < TRACE_MAX_CHUNKS_PER_THREAD ? new (std::nothrow) Chunk{} : nullptr;
+        if (!fresh) { tb->dropped.fetch_add(1, std::memory_order_relaxed); return; }
+        ++tb->chunks;
+        c->next.store(fresh, std::memory_order_release);
+        tb->tail = c = fresh;
+        n = 0;
+    }
+
+    const int64_t ts = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - g_epoch).count();
+    c->events[n] = Event{cat, name, ts, value, phase};
+    c->count.store(n + 1, std::memory_order_release);
+}
+
+class Scope {
+public:
+    Scope(const char* cat, const char* name) noexcept : cat_(cat), name_(name), on_(active()) {
+        if (on_) [[unlikely]] record('B', cat_, name_);
+    }
+    ~Scope() { if (on_) [[unlikely]] record('E', cat_, name_); }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* cat_;
+    const char* name_;
+    bool        on_;
+};
+
+// ========================================================================
+// EXPORT — Chrome trace-event JSON
+// ========================================================================
+inline void appendJsonString(std::string& out, std::string_view s) {
+    out += '"';
+    for (char ch : s) {
+        switch (ch) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n";  break;
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20) std::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<unsigned>(ch));
+                else out += ch;
+        }
+    }
+    out += '"';
+}
+
+[[nodiscard]] inline std::string renderJson(uint64_t& dropped) {
+    std::string out;
+    out.reserve(1 << 20);
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto sep = [&] { if (!first) out += ",\n"; first = false; };
+
+    dropped = 0;
+    for (ThreadBuffer* tb = g_buffers.load(std::memory_order_acquire); tb; tb = tb->nextBuffer) {
+        dropped += tb->dropped.load(std::memory_order_relaxed);
+
+        sep();
+        std::format_to(std::back_inserter(out), "{{\"ph\":\"M\",\"pid\":1,\"tid\":{},\"name\":\"thread_name\",\"args\":{{\"name\":", tb->tid);
+        appendJsonString(out, tb->name);
+        std::format_to(std::back_inserter(out), ",\"logThread\":{}}}}}", tb->logThreadId);
+
+        for (Chunk* c = tb->head; c; c = c->next.load(std::memory_order_acquire)) {
+            const uint32_t n = c->count.load(std::memory_order_acquire);
+            for (uint32_t i = 0; i < n; ++i) {
+                const Event& e = c->events[i];
+                sep();
+                out += "{\"name\":";
+                appendJsonString(out, e.name);
+                out += ",\"cat\":";
+                appendJsonString(out, e.cat);
+                std::format_to(std::back_inserter(out), ",\"ph\":\"{}\",\"pid\":1,\"tid\":{},\"ts\":{:.3f}",
+                               e.phase, tb->tid, static_cast<double>(e.tsNs) / 1000.0);
+                if (e.phase == 'C')      std::format_to(std::back_inserter(out), ",\"args\":{{\"value\":{}}}", e.value);
+                else if (e.phase == 'i') out += ",\"s\":\"t\"";
+                out += '}';
+            }
+        }
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+// Arms recording; the file is written by stop(). Safe to call once per run.
+inline void start(std::string path) {
+    std::scoped_lock lk(g_controlMutex);
+    if (active()) return;
+    g_outputPath = std::move(path);
+    g_epoch = std::chrono::steady_clock::now();
+    g_enabled.store(true, std::memory_order_release);
+    LOG_INFO_CAT("Perf", "Trace events armed → {}", g_outputPath);
+}
+
+// Disarms and dumps everything recorded so far. Idempotent.
+inline void stop() {
+    std::scoped_lock lk(g_controlMutex);
+    if (!active()) return;
+    g_enabled.store(false, std::memory_order_release);
+
+    uint64_t dropped = 0;
+    const std::string json = renderJson(dropped);
+
+    std::FILE* f = std::fopen(g_outputPath.c_str(), "wb");
+    if (!f) {
+        LOG_ERROR_CAT("Perf", "Trace: cannot open {} for writing", g_outputPath);
+        return;
+    }
+    const size_t written = std::fwrite(json.data(), 1, json.size(), f);
+    std::fclose(f);
+
+    if (written != json.size())
+        LOG_ERROR_CAT("Perf", "Trace: short write to {} ({} of {} bytes)", g_outputPath, written, json.size());
+    else
+        LOG_SUCCESS_CAT("Perf", "Trace written → {} ({} KB, {} events dropped)", g_outputPath, json.size() / 1024, dropped);
+}
+
+} // namespace Logging::Trace
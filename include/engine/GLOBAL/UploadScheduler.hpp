@@ -0,0 +1,151 @@
+// include/engine/GLOBAL/UploadScheduler.hpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// UPLOAD SCHEDULER — BATCHED COPIES ON THE TRANSFER QUEUE, TIMELINE-SIGNALED
+//   enqueue() copies the bytes into the staging ring and records a buffer
+//   copy into the open batch; submit() — once per frame, from renderFrame — puts
+//   the whole batch on the transfer queue in ONE vkQueueSubmit and signals
+//   the timeline semaphore with the batch's value. enqueue() hands that value
+//   back as a ticket: isComplete(ticket) / wait(ticket) on the CPU side.
+//
+//   Transfer queue = a TRANSFER-only family when the device has one (the DMA
+//   engine), otherwise the graphics queue. Tracker buffers are EXCLUSIVE, so
+//   with separate families a batch ends in release barriers and the graphics
+//   side must acquire: recordAcquires(cmd) records them for every submitted
+//   batch and returns the timeline wait to add to that command buffer's
+//   submit. Same family → no barriers, the semaphore wait alone orders it.
+//   Once released, a buffer stays graphics-owned: later enqueue()s to it
+//   (partial rewrites) are not put on the transfer queue — recordAcquires()
+//   records them on the graphics command buffer behind the acquires, and
+//   their staging is freed through retireQueue() with that frame. Their
+//   tickets are not on the timeline; the frame's fence covers them.
+//
+//   Staging comes from a StagingRing: every span is retired with the batch's
+//   timeline value and reused only once that value has passed. The ring
+//   grows, and past its cap blocks, when uploads outrun the DMA engine.
+//   Command buffers rotate through SLOTS; reusing one waits for its batch.
+//
+//   enqueue() is thread-safe and copies outside the scheduler lock, so many
+//   threads can stream at once. submit(), recordAcquires() and flushAndWait()
+//   touch queues and belong to the render thread (or to load time, before
+//   the render loop starts). flushAndWait() is for loaders that build on the
+//   data right away (mesh → BLAS): one graphics submit that waits on the
+//   timeline and acquires, then a fence wait.
+// =============================================================================
+
+#pragma once
+
+#include "engine/GLOBAL/StagingRing.hpp"
+
+#include <vulkan/vulkan.h>
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace RTX {
+
+// Add to a graphics submit via VkTimelineSemaphoreSubmitInfo — value 0 = nothing to wait on
+struct UploadWait {
+    VkSemaphore semaphore = VK_NULL_HANDLE;
+    uint64_t    value     = 0;
+
+    [[nodiscard]] bool needed() const noexcept { return value != 0; }
+};
+
+class UploadScheduler {
+public:
+    static constexpr uint32_t SLOTS = 4;              // batches that may be on the transfer queue at once
+
+    UploadScheduler() = default;
+    ~UploadScheduler() = default;                     // destroy() explicitly — device is gone at static teardown
+    UploadScheduler(const UploadScheduler&) = delete;
+    UploadScheduler& operator=(const UploadScheduler&) = delete;
+
+    // Reads families and queues from g_ctx() — call after the graphics command pool exists
+    [[nodiscard]] bool init(VkDevice device) noexcept;
+    void destroy() noexcept;                          // device must be idle
+
+    // Stage size bytes for dst at dstOffset; returns the ticket (timeline value of its batch), 0 on failure
+    uint64_t enqueue(VkBuffer dst, VkDeviceSize dstOffset, const void* data, VkDeviceSize size);
+
+    // Submit the open batch; returns its timeline value, 0 if there was nothing to send
+    uint64_t submit() noexcept;
+
+    // Acquire barriers for every submitted batch not yet handed to graphics,
+    // then the copies into buffers graphics already owns
+    [[nodiscard]] UploadWait recordAcquires(VkCommandBuffer graphicsCmd) noexcept;
+
+    // The buffer is being destroyed — drop its ownership record and any copy or acquire
+    // still queued for it, before the handle value can come back for a new buffer.
+    // Called by the buffer tracker ahead of vkDestroyBuffer
+    void forget(VkBuffer buffer) noexcept;
+
+    // submit() + acquires on a one-time graphics submit that waits on the timeline; blocks until done
+    void flushAndWait() noexcept;
+
+    [[nodiscard]] bool isComplete(uint64_t ticket) const noexcept;
+    void wait(uint64_t ticket) const noexcept;
+
+    [[nodiscard]] bool         valid()     const noexcept { return timeline_ != VK_NULL_HANDLE; }
+    [[nodiscard]] bool         dedicated() const noexcept { return transferFamily_ != graphicsFamily_; }
+    [[nodiscard]] VkSemaphore  timeline()  const noexcept { return timeline_; }
+    [[nodiscard]] StagingRing& staging()         noexcept { return ring_; }
+
+private:
+    struct Copy {
+        VkBuffer     src = VK_NULL_HANDLE;
+        VkBuffer     dst = VK_NULL_HANDLE;
+        VkBufferCopy region{};
+        uint64_t     stagingId = 0;
+    };
+
+    struct Slot {
+        VkCommandBuffer cmd   = VK_NULL_HANDLE;
+        uint64_t        value = 0;                    // timeline value of the last batch recorded here
+    };
+
+    struct Acquire {
+        uint64_t value  = 0;
+        VkBuffer buffer = VK_NULL_HANDLE;
+    };
+
+    [[nodiscard]] uint64_t completedValue() const noexcept;
+    // recordAcquires() body — staging ids of the graphics-side copies go to `staging`
+    [[nodiscard]] UploadWait recordAcquiresInto(VkCommandBuffer graphicsCmd, std::vector<uint64_t>& staging) noexcept;
+
+    mutable std::mutex mutex_;
+    VkDevice      device_         = VK_NULL_HANDLE;
+    VkQueue       queue_          = VK_NULL_HANDLE;
+    VkCommandPool pool_           = VK_NULL_HANDLE;
+    VkSemaphore   timeline_       = VK_NULL_HANDLE;
+    uint32_t      transferFamily_ = UINT32_MAX;
+    uint32_t      graphicsFamily_ = UINT32_MAX;
+
+    StagingRing             ring_;
+    std::array<Slot, SLOTS> slots_{};
+    std::vector<Copy>       pending_;                 // the open batch
+    uint32_t current_   = 0;
+    uint64_t submitted_ = 0;                          // last value put on the queue
+    uint64_t handedOut_ = 0;                          // last value returned by recordAcquires
+    std::vector<Acquire> acquires_;
+    std::vector<Copy>    graphicsCopies_;             // rewrites of graphics-owned buffers, next recordAcquires
+    std::unordered_set<VkBuffer> graphicsOwned_;      // released to graphics by a past batch
+
+    uint64_t     batches_ = 0;
+    VkDeviceSize bytes_   = 0;
+    VkDeviceSize graphicsBytes_ = 0;                  // of which copied on graphics
+    uint64_t     stalls_  = 0;                        // submit() had to wait for a command buffer
+};
+
+[[nodiscard]] UploadScheduler& uploadScheduler() noexcept;
+
+} // namespace RTX
@@ -334,6 +334,7 @@ private:
 
     RTX::Handle<VkBuffer> sbtBuffer_;
     RTX::Handle<VkDeviceMemory> sbtMemory_;
+    uint64_t sbtEnc_ = 0;
     VkDeviceAddress sbtAddress_ = 0;
     ShaderBindingTable sbt_{};
     VkDeviceSize sbtRecordSize_ = 0;
@@ -23,6 +23,7 @@
 #include <vector>
 #include <array>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -38,6 +39,11 @@
 #include "engine/GLOBAL/SDL3.hpp"
 #include "engine/GLOBAL/VulkanCore.hpp"
 #include "engine/GLOBAL/PipelineManager.hpp"
+#include "engine/GLOBAL/GpuProfiler.hpp"
+#include "engine/GLOBAL/FrameRing.hpp"
+#include "engine/GLOBAL/FrameRecorder.hpp"
+#include "engine/GLOBAL/FramePacer.hpp"
+#include "engine/GLOBAL/RenderGraph.hpp"
 
 // Forward declarations
 struct Camera;
@@ -60,6 +66,35 @@ struct TonemapPushConstants {
     float     _pad[2]         = {0};
 };
 
+// Per-frame constants — bump-allocated from the FrameRing each frame
+struct alignas(16) CameraUBO {                   // raygen/hit/miss set 0, binding 3
+    glm::mat4 view, proj, viewProj, invView, invProj;
+    glm::vec4 cameraPos;
+    glm::vec2 jitter;
+    uint32_t  frame;
+    float     time;
+    uint32_t  spp;
+    float     _pad[3];
+};
+static_assert(sizeof(CameraUBO) == 368);
+
+struct TonemapUniform {                          // tonemap compute binding 2
+    float    exposure;
+    uint32_t type;
+    uint32_t enabled;
+    float    nexusScore;
+    uint32_t frame;
+    uint32_t spp;
+    float    _pad[2];
+};
+
+struct FrameDimensions {                         // raygen/hit set 0, binding 7
+    uint32_t width;
+    uint32_t height;
+    uint32_t spp;
+    uint32_t frame;
+};
+
 // ──────────────────────────────────────────────────────────────────────────────
 class VulkanRenderer {
 public:
@@ -68,6 +103,8 @@ public:
     VulkanRenderer(int width, int height, SDL_Window* window = nullptr, bool overclockFromMain = false);
     ~VulkanRenderer();
 
+    // Top of the main loop, before input is polled — sleeps until this frame should start
+    void paceFrame() noexcept;
     void renderFrame(const Camera& camera, float deltaTime) noexcept;
 
     void toggleHypertrace() noexcept;
@@ -148,7 +185,7 @@ private:
     bool stonekey_active_ = false;
 	bool destroyed_ = false; // window
 
-	void waitForAllFences() const noexcept;
+	void waitForInFlightFrames() const noexcept;
 
     static constexpr auto RT_SHADER_PATHS = std::to_array({
         "assets/shaders/raytracing/raygen.spv",
@@ -168,10 +205,10 @@ private:
     float currentNexusScore_ = 0.5f;
     uint32_t currentSpp_ = Options::RTX::MIN_SPP;
     float hypertraceCounter_ = 0.0f;
-    VkQueryPool timestampQueryPool_ = VK_NULL_HANDLE;
+    GpuProfiler gpuProfiler_;
+    uint32_t denoiserEvictId_ = 0;      // MemoryBudget evictable — drops the denoiser target near budget
     double timestampPeriod_ = 0.0;
     bool resetAccumulation_ = true;
-    bool firstSwapchainAcquire_ = true;
 
     bool hypertraceEnabled_     = Options::RTX::ENABLE_ADAPTIVE_SAMPLING;
     bool denoisingEnabled_      = Options::RTX::ENABLE_DENOISING;
@@ -212,13 +249,20 @@ private:
 
     std::vector<VkSemaphore> imageAvailableSemaphores_;
     std::vector<VkSemaphore> renderFinishedSemaphores_;
-    std::vector<VkSemaphore> computeFinishedSemaphores_;
-    std::vector<VkSemaphore> computeToGraphicsSemaphores_;
-    std::vector<VkFence>     inFlightFences_;
+    // Async compute: the trace submit signals it, the post-processing submit waits on it
+    std::vector<VkSemaphore> graphicsToComputeSemaphores_;
+    // Frame slots on one timeline semaphore + CPU start pacing
+    RTX::FramePacer          framePacer_;
     std::vector<VkFramebuffer> framebuffers_;
 
-    std::vector<VkCommandBuffer> commandBuffers_;
-    std::vector<VkCommandBuffer> computeCommandBuffers_;
+    // Per-frame primary + per-thread pools for the pass secondaries
+    RTX::FrameRecorder frameRecorder_;
+    // Post-processing primaries + secondaries on the async compute family (asyncCompute_ only)
+    RTX::FrameRecorder computeRecorder_;
+    bool               asyncCompute_ = false;
+    uint32_t           clearPending_ = 0;          // frame slots whose accumulation still needs the reset clear
+    // Declared image use per pass → barriers, layouts, culling; remembers layouts across frames
+    RTX::RenderGraph   frameGraph_;
 
     RTX::Handle<VkDescriptorPool> descriptorPool_;
     RTX::Handle<VkDescriptorPool> rtDescriptorPool_;
@@ -232,10 +276,14 @@ private:
     PFN_vkGetRayTracingShaderGroupHandlesKHR vkGetRayTracingShaderGroupHandlesKHR = nullptr;
     PFN_vkGetBufferDeviceAddressKHR          vkGetBufferDeviceAddressKHR     = nullptr;
 
-    std::vector<uint64_t> uniformBufferEncs_;
     std::vector<uint64_t> materialBufferEncs_;
-    std::vector<uint64_t> dimensionBufferEncs_;
-    std::vector<uint64_t> tonemapUniformEncs_;
+
+    // Camera UBO / tonemap params / dimensions live in the ring; offsets are
+    // the dynamic offsets for the current frame's bind calls
+    RTX::FrameRing frameRing_;
+    uint32_t cameraUboOffset_  = 0;
+    uint32_t tonemapUboOffset_ = 0;
+    uint32_t dimensionOffset_  = 0;
     std::vector<RTX::Handle<VkImage>> rtOutputImages_;
     std::vector<RTX::Handle<VkDeviceMemory>> rtOutputMemories_;
     std::vector<RTX::Handle<VkImageView>> rtOutputViews_;
@@ -265,9 +313,6 @@ private:
     // Private helpers — implemented in VulkanRenderer.cpp
     void createFramebuffers() noexcept;
     void cleanupFramebuffers() noexcept;
-    bool recreateTonemapUBOs() noexcept;
-    void destroySharedStaging() noexcept;
-    bool createSharedStaging() noexcept;
     void createAutoExposureResources() noexcept;
     void createTonemapPipeline() noexcept;
     void createTonemapSampler() noexcept;
@@ -286,7 +331,7 @@ private:
     void createDenoiserImage() noexcept;
     void createEnvironmentMap() noexcept;
     void createNexusScoreImage(VkCommandPool pool, VkQueue queue) noexcept;
-    void initializeAllBufferData(uint32_t frames, VkDeviceSize uniformSize, VkDeviceSize materialSize) noexcept;
+    void initializeAllBufferData(uint32_t frames, VkDeviceSize ringBytesPerFrame, VkDeviceSize materialSize) noexcept;
     void createCommandBuffers() noexcept;
     void allocateDescriptorSets() noexcept;
     void updateNexusDescriptors() noexcept;
@@ -306,10 +351,13 @@ private:
         std::vector<RTX::Handle<VkDeviceMemory>>& memories,
         std::vector<RTX::Handle<VkImageView>>& views,
         const std::string& tag) noexcept;
+    // budgetTag groups the memory in the MemoryBudget ledger (defaults to tag)
     void createImage(RTX::Handle<VkImage>& image,
                      RTX::Handle<VkDeviceMemory>& memory,
                      RTX::Handle<VkImageView>& view,
-                     const std::string& tag) noexcept;
+                     const std::string& tag,
+                     std::string_view budgetTag = {},
+                     bool sharedWithCompute = false) noexcept;   // CONCURRENT across graphics + async compute
     void dispatchLuminanceHistogram(VkCommandBuffer cmd, VkImage colorImage) noexcept;
     float computeSceneLuminanceFromHistogram() noexcept;
     void uploadToBuffer(RTX::Handle<VkBuffer>& buffer, const void* data, VkDeviceSize size) noexcept;
@@ -36,15 +36,26 @@
 #include <vulkan/vulkan.h>
 #include <SDL3/SDL.h>
 #include <ctime>
+#include <cstdlib>
 
 #include <queue>
 #include <atomic>
 #include <mutex>
 #include <shared_mutex>
 #include <deque>
+#include <memory>
+#include <cstring>
 #include <vector>
 #include <algorithm>
 #include <stop_token>
+#include <unordered_map>
+#include <unordered_set>
+#include <type_traits>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+#include "engine/GLOBAL/LogSinks.hpp"
 
 // =============================================================================
 // AMOURANTH RTX — DELTA TIME TRACKING v∞ — NOV 13 2025
@@ -199,8 +210,13 @@ extern uint64_t kStone2() noexcept;
 // ========================================================================
 // 0. CONFIGURATION
 // ========================================================================
+#ifdef DISABLE_TRACE_AND_DEBUG_LOGS   // CMake option — compiles TRACE/DEBUG call sites (and their args) out
+constexpr bool ENABLE_TRACE   = false;
+constexpr bool ENABLE_DEBUG   = false;
+#else
 constexpr bool ENABLE_TRACE   = false;
 constexpr bool ENABLE_DEBUG   = true;
+#endif
 constexpr bool ENABLE_INFO    = false;
 constexpr bool ENABLE_WARNING = true;
 constexpr bool ENABLE_ERROR   = true;
@@ -219,39 +235,85 @@ constexpr size_t TIME_WIDTH    = 10;
 constexpr size_t CAT_WIDTH     = 12;
 constexpr size_t THREAD_WIDTH  = 18;
 
+// Async ring — preallocated fixed-size slots, power of two
+constexpr size_t LOG_RING_CAPACITY      = 4096;
+constexpr size_t LOG_SLOT_CATEGORY_SIZE = 32;
+constexpr size_t LOG_SLOT_MESSAGE_SIZE  = 448;
+constexpr size_t LOG_FLUSH_BATCH        = 64;
+constexpr bool   LOG_BINARY_FILE        = false; // amouranth_engine.log as binary records → extras/logdecode
+
+// Default file sink — mmap'd segments, rotated + gzip'd in the background
+constexpr std::string_view LOG_FILE_PATH  = "amouranth_engine.log";
+constexpr size_t LOG_SEGMENT_BYTES      = 64ull * 1024 * 1024;
+constexpr int64_t LOG_SEGMENT_MAX_AGE_S = 3600;
+constexpr uint32_t LOG_KEEP_SEGMENTS    = 8;
+constexpr bool   LOG_COMPRESS_SEGMENTS  = true;
+static_assert((LOG_RING_CAPACITY & (LOG_RING_CAPACITY - 1)) == 0, "LOG_RING_CAPACITY must be a power of two");
+
 // ========================================================================
 // C++23 ZERO-COST LOGGING — IIFE + constexpr if
+// Gate 1 (compile time): level × category → the whole call, arguments
+//   included, is a discarded statement when compiledIn() is false.
+// Gate 2 (runtime): per-category verbosity, checked before any argument
+//   expression is evaluated.
 // ========================================================================
-#define LOG_TRACE(...)          [&]() constexpr { if constexpr (ENABLE_TRACE)   Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Trace,   "General", __VA_ARGS__); }();
-#define LOG_DEBUG(...)          [&]() constexpr { if constexpr (ENABLE_DEBUG)   Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Debug,   "General", __VA_ARGS__); }();
-#define LOG_INFO(...)           [&]() constexpr { if constexpr (ENABLE_INFO)    Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Info,    "General", __VA_ARGS__); }();
-#define LOG_SUCCESS(...)        [&]() constexpr { if constexpr (ENABLE_SUCCESS) Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Success, "General", __VA_ARGS__); }();
-#define LOG_ATTEMPT(...)        [&]() constexpr { if constexpr (ENABLE_ATTEMPT) Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Attempt, "General", __VA_ARGS__); }();
-#define LOG_PERF(...)           [&]() constexpr { if constexpr (ENABLE_PERF)    Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Perf,    "General", __VA_ARGS__); }();
-#define LOG_WARNING(...)        [&]() constexpr { if constexpr (ENABLE_WARNING) Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Warning, "General", __VA_ARGS__); }();
+#define LOG_IMPL(lvl, cat, ...) [&]() { \
+    constexpr Logging::LogCategory logCat_ = Logging::categoryOf(cat); \
+    if constexpr (Logging::compiledIn(lvl, logCat_)) { \
+        if (Logging::enabled(lvl, logCat_)) \
+            Logging::Logger::get().log(std::source_location::current(), lvl, logCat_, cat, __VA_ARGS__); } }();
+
+#define LOG_TRACE(...)          LOG_IMPL(Logging::LogLevel::Trace,   "General", __VA_ARGS__)
+#define LOG_DEBUG(...)          LOG_IMPL(Logging::LogLevel::Debug,   "General", __VA_ARGS__)
+#define LOG_INFO(...)           LOG_IMPL(Logging::LogLevel::Info,    "General", __VA_ARGS__)
+#define LOG_SUCCESS(...)        LOG_IMPL(Logging::LogLevel::Success, "General", __VA_ARGS__)
+#define LOG_ATTEMPT(...)        LOG_IMPL(Logging::LogLevel::Attempt, "General", __VA_ARGS__)
+#define LOG_PERF(...)           LOG_IMPL(Logging::LogLevel::Perf,    "General", __VA_ARGS__)
+#define LOG_WARNING(...)        LOG_IMPL(Logging::LogLevel::Warning, "General", __VA_ARGS__)
 #define LOG_WARN(...)           LOG_WARNING(__VA_ARGS__)
-#define LOG_ERROR(...)          [&]() constexpr { if constexpr (ENABLE_ERROR)   Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Error,   "General", __VA_ARGS__); }();
-#define LOG_FAILURE(...)        [&]() constexpr { if constexpr (ENABLE_FAILURE) Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Failure, "General", __VA_ARGS__); }();
-#define LOG_FATAL(...)          [&]() constexpr { if constexpr (ENABLE_FATAL)   Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Fatal,   "General", __VA_ARGS__); }();
-#define LOG_FPS_COUNTER(...)    [&]() constexpr { if constexpr (FPS_COUNTER)    Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Info,    "FPS",     __VA_ARGS__); }();
-#define LOG_SIMULATION(...)     [&]() constexpr { if constexpr (SIMULATION_LOGGING) Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Info, "SIMULATION", __VA_ARGS__); }();
-
-#define LOG_TRACE_CAT(cat, ...)   [&]() constexpr { if constexpr (ENABLE_TRACE)   Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Trace,   cat, __VA_ARGS__); }();
-#define LOG_DEBUG_CAT(cat, ...)   [&]() constexpr { if constexpr (ENABLE_DEBUG)   Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Debug,   cat, __VA_ARGS__); }();
-#define LOG_INFO_CAT(cat, ...)    [&]() constexpr { if constexpr (ENABLE_INFO)    Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Info,    cat, __VA_ARGS__); }();
-#define LOG_SUCCESS_CAT(cat, ...) [&]() constexpr { if constexpr (ENABLE_SUCCESS) Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Success, cat, __VA_ARGS__); }();
-#define LOG_ATTEMPT_CAT(cat, ...) [&]() constexpr { if constexpr (ENABLE_ATTEMPT) Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Attempt, cat, __VA_ARGS__); }();
-#define LOG_PERF_CAT(cat, ...)    [&]() constexpr { if constexpr (ENABLE_PERF)    Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Perf,    cat, __VA_ARGS__); }();
-#define LOG_WARNING_CAT(cat, ...) [&]() constexpr { if constexpr (ENABLE_WARNING) Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Warning, cat, __VA_ARGS__); }();
+#define LOG_ERROR(...)          LOG_IMPL(Logging::LogLevel::Error,   "General", __VA_ARGS__)
+#define LOG_FAILURE(...)        LOG_IMPL(Logging::LogLevel::Failure, "General", __VA_ARGS__)
+#define LOG_FATAL(...)          LOG_IMPL(Logging::LogLevel::Fatal,   "General", __VA_ARGS__)
+#define LOG_FPS_COUNTER(...)    [&]() { if constexpr (FPS_COUNTER)        LOG_IMPL(Logging::LogLevel::Info, "FPS",        __VA_ARGS__) }();
+#define LOG_SIMULATION(...)     [&]() { if constexpr (SIMULATION_LOGGING) LOG_IMPL(Logging::LogLevel::Info, "SIMULATION", __VA_ARGS__) }();
+
+#define LOG_TRACE_CAT(cat, ...)   LOG_IMPL(Logging::LogLevel::Trace,   cat, __VA_ARGS__)
+#define LOG_DEBUG_CAT(cat, ...)   LOG_IMPL(Logging::LogLevel::Debug,   cat, __VA_ARGS__)
+#define LOG_INFO_CAT(cat, ...)    LOG_IMPL(Logging::LogLevel::Info,    cat, __VA_ARGS__)
+#define LOG_SUCCESS_CAT(cat, ...) LOG_IMPL(Logging::LogLevel::Success, cat, __VA_ARGS__)
+#define LOG_ATTEMPT_CAT(cat, ...) LOG_IMPL(Logging::LogLevel::Attempt, cat, __VA_ARGS__)
+#define LOG_PERF_CAT(cat, ...)    LOG_IMPL(Logging::LogLevel::Perf,    cat, __VA_ARGS__)
+#define LOG_WARNING_CAT(cat, ...) LOG_IMPL(Logging::LogLevel::Warning, cat, __VA_ARGS__)
 #define LOG_WARN_CAT(cat, ...)    LOG_WARNING_CAT(cat, __VA_ARGS__)
-#define LOG_ERROR_CAT(cat, ...)   [&]() constexpr { if constexpr (ENABLE_ERROR)   Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Error,   cat, __VA_ARGS__); }();
-#define LOG_FAILURE_CAT(cat, ...) [&]() constexpr { if constexpr (ENABLE_FAILURE) Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Failure, cat, __VA_ARGS__); }();
-#define LOG_FATAL_CAT(cat, ...)   [&]() constexpr { if constexpr (ENABLE_FATAL)   Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Fatal,   cat, __VA_ARGS__); }();
+#define LOG_ERROR_CAT(cat, ...)   LOG_IMPL(Logging::LogLevel::Error,   cat, __VA_ARGS__)
+#define LOG_FAILURE_CAT(cat, ...) LOG_IMPL(Logging::LogLevel::Failure, cat, __VA_ARGS__)
+#define LOG_FATAL_CAT(cat, ...)   LOG_IMPL(Logging::LogLevel::Fatal,   cat, __VA_ARGS__)
+
+// ========================================================================
+// DEFERRED BINARY LOGGING — literal format strings + scalar args only
+// Arguments are copied raw; formatting happens on the flusher thread.
+// ========================================================================
+#define LOG_BIN_IMPL(lvl, cat, fmt, ...) [&]() { \
+    constexpr Logging::LogCategory logCat_ = Logging::categoryOf(cat); \
+    if constexpr (Logging::compiledIn(lvl, logCat_)) { \
+        static constexpr std::source_location binLoc_ = std::source_location::current(); \
+        static constexpr uint32_t binId_ = Logging::Binary::formatId(fmt, binLoc_.file_name(), binLoc_.line()); \
+        [[maybe_unused]] static const bool binReg_ = Logging::Binary::registerFormat(binId_, lvl, cat, fmt, binLoc_); \
+        if (Logging::enabled(lvl, logCat_)) \
+            Logging::Logger::get().logBinary(binLoc_, binId_, lvl, logCat_, cat __VA_OPT__(,) __VA_ARGS__); } }();
 
-#define LOG_VOID()              [&]() constexpr { if constexpr (ENABLE_DEBUG)   Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Debug,   "General", "[VOID MARKER]"); }();
-#define LOG_VOID_CAT(cat)       [&]() constexpr { if constexpr (ENABLE_DEBUG)   Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Debug,   cat, "[VOID MARKER]"); }();
-#define LOG_VOID_TRACE()        [&]() constexpr { if constexpr (ENABLE_TRACE)   Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Trace,   "General", "[VOID MARKER]"); }();
-#define LOG_VOID_TRACE_CAT(cat) [&]() constexpr { if constexpr (ENABLE_TRACE)   Logging::Logger::get().log(std::source_location::current(), Logging::LogLevel::Trace,   cat, "[VOID MARKER]"); }();
+#define LOG_BIN_TRACE_CAT(cat, fmt, ...)   LOG_BIN_IMPL(Logging::LogLevel::Trace,   cat, fmt __VA_OPT__(,) __VA_ARGS__)
+#define LOG_BIN_DEBUG_CAT(cat, fmt, ...)   LOG_BIN_IMPL(Logging::LogLevel::Debug,   cat, fmt __VA_OPT__(,) __VA_ARGS__)
+#define LOG_BIN_INFO_CAT(cat, fmt, ...)    LOG_BIN_IMPL(Logging::LogLevel::Info,    cat, fmt __VA_OPT__(,) __VA_ARGS__)
+#define LOG_BIN_SUCCESS_CAT(cat, fmt, ...) LOG_BIN_IMPL(Logging::LogLevel::Success, cat, fmt __VA_OPT__(,) __VA_ARGS__)
+#define LOG_BIN_PERF_CAT(cat, fmt, ...)    LOG_BIN_IMPL(Logging::LogLevel::Perf,    cat, fmt __VA_OPT__(,) __VA_ARGS__)
+#define LOG_BIN_WARNING_CAT(cat, fmt, ...) LOG_BIN_IMPL(Logging::LogLevel::Warning, cat, fmt __VA_OPT__(,) __VA_ARGS__)
+#define LOG_BIN_ERROR_CAT(cat, fmt, ...)   LOG_BIN_IMPL(Logging::LogLevel::Error,   cat, fmt __VA_OPT__(,) __VA_ARGS__)
+
+#define LOG_VOID()              LOG_IMPL(Logging::LogLevel::Debug, "General", "[VOID MARKER]")
+#define LOG_VOID_CAT(cat)       LOG_IMPL(Logging::LogLevel::Debug, cat,       "[VOID MARKER]")
+#define LOG_VOID_TRACE()        LOG_IMPL(Logging::LogLevel::Trace, "General", "[VOID MARKER]")
+#define LOG_VOID_TRACE_CAT(cat) LOG_IMPL(Logging::LogLevel::Trace, cat,       "[VOID MARKER]")
 
 namespace Logging {
 
@@ -371,7 +433,603 @@ constexpr std::array<bool, 10> ENABLE_LEVELS{
 };
 
 // ========================================================================
-// 2. LOGGER – ORDERED ASYNC FIFO (C++23)
+// CATEGORIES — compile-time IDs for level gating + runtime verbosity
+// Any literal not listed folds into LogCategory::Other.
+// ========================================================================
+#define AMOURANTH_LOG_CATEGORIES(X) \
+    X(General) X(MAIN) X(Init) X(Dispose) X(Logger) X(Vulkan) X(Device) X(Swapchain) \
+    X(Command) X(Queue) X(RayTrace) X(RTX) X(Accel) X(TLAS) X(BLAS) X(LAS) X(AI) \
+    X(Memory) X(SBT) X(Shader) X(Renderer) X(Render) X(Tonemap) X(GBuffer) X(Post) \
+    X(Buffer) X(Image) X(Texture) X(Sampler) X(Descriptor) X(Perf) X(FPS) X(GPU) \
+    X(CPU) X(Input) X(Audio) X(Physics) X(SIMULATION) X(MeshLoader) X(GLTF) \
+    X(Material) X(Debug) X(ATTEMPT) X(VOID) X(SPLASH) X(MARKER) X(SDL3) \
+    X(SDL3_window) X(SDL3_audio) X(SDL3_font) X(SDL3_image) X(SDL3_init) \
+    X(SDL3_input) X(SDL3_vulkan) X(PIPELINE) X(VALIDATION) X(DELTA) X(APP) \
+    X(IMG) X(VulkanAccel) X(StoneKey)
+
+enum class LogCategory : uint8_t {
+#define X(name) name,
+    AMOURANTH_LOG_CATEGORIES(X)
+#undef X
+    Other,
+    Count
+};
+
+inline constexpr size_t LOG_CATEGORY_COUNT = static_cast<size_t>(LogCategory::Count);
+
+inline constexpr std::array<std::string_view, LOG_CATEGORY_COUNT> CATEGORY_NAMES{
+#define X(name) std::string_view{#name},
+    AMOURANTH_LOG_CATEGORIES(X)
+#undef X
+    std::string_view{"Other"}
+};
+
+[[nodiscard]] constexpr bool equalsIgnoreCase(std::string_view a, std::string_view b) noexcept {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        char x = a[i], y = b[i];
+        if (x >= 'A' && x <= 'Z') x = static_cast<char>(x - 'A' + 'a');
+        if (y >= 'A' && y <= 'Z') y = static_cast<char>(y - 'A' + 'a');
+        if (x != y) return false;
+    }
+    return true;
+}
+
+[[nodiscard]] constexpr LogCategory categoryOf(std::string_view name) noexcept {
+    for (size_t i = 0; i + 1 < LOG_CATEGORY_COUNT; ++i)
+        if (equalsIgnoreCase(CATEGORY_NAMES[i], name)) return static_cast<LogCategory>(i);
+    return LogCategory::Other;
+}
+
+// Lowest level compiled in per category — raise an entry to strip that
+// category's chatter from the binary entirely (e.g. PIPELINE → Warning).
+inline constexpr std::array<LogLevel, LOG_CATEGORY_COUNT> CATEGORY_MIN_LEVEL = [] {
+    std::array<LogLevel, LOG_CATEGORY_COUNT> a{};
+    a.fill(LogLevel::Trace);
+    return a;
+}();
+
+[[nodiscard]] constexpr bool compiledIn(LogLevel level, LogCategory cat) noexcept {
+    const size_t li = static_cast<size_t>(level);
+    if (li >= ENABLE_LEVELS.size() || !ENABLE_LEVELS[li]) return false;
+    if (level < CATEGORY_MIN_LEVEL[static_cast<size_t>(cat)]) return false;
+    if (DISABLE_NON_FPS_LOGGING && cat != LogCategory::FPS) return false;
+    return true;
+}
+
+// Runtime verbosity — minimum level per category, relaxed loads only
+inline std::array<std::atomic<uint8_t>, LOG_CATEGORY_COUNT> g_categoryLevel{};
+
+[[nodiscard]] inline bool enabled(LogLevel level, LogCategory cat) noexcept {
+    return static_cast<uint8_t>(level) >= g_categoryLevel[static_cast<size_t>(cat)].load(std::memory_order_relaxed);
+}
+
+inline void setCategoryLevel(LogCategory cat, LogLevel minLevel) noexcept {
+    g_categoryLevel[static_cast<size_t>(cat)].store(static_cast<uint8_t>(minLevel), std::memory_order_relaxed);
+}
+
+inline void setAllCategoryLevels(LogLevel minLevel) noexcept {
+    for (auto& l : g_categoryLevel) l.store(static_cast<uint8_t>(minLevel), std::memory_order_relaxed);
+}
+
+// Interned category → color — one array index per message
+inline constexpr std::array<std::string_view, LOG_CATEGORY_COUNT> CATEGORY_COLORS = [] {
+    using namespace Color;
+    using C = LogCategory;
+    std::array<std::string_view, LOG_CATEGORY_COUNT> a{};
+    a.fill(DIAMOND_WHITE);
+    auto set = [&a](C c, std::string_view col) { a[static_cast<size_t>(c)] = col; };
+    set(C::General, DIAMOND_SPARKLE);   set(C::MAIN, VALHALLA_GOLD);          set(C::Init, AURORA_BOREALIS);
+    set(C::Dispose, PARTY_PINK);        set(C::Logger, ELECTRIC_BLUE);        set(C::Vulkan, SAPPHIRE_BLUE);
+    set(C::Device, QUASAR_BLUE);        set(C::Swapchain, OCEAN_TEAL);        set(C::Command, CHROMIUM_SILVER);
+    set(C::Queue, OBSIDIAN_BLACK);      set(C::RayTrace, TURQUOISE_BLUE);     set(C::RTX, HYPERSPACE_WARP);
+    set(C::Accel, PULSAR_GREEN);        set(C::TLAS, SUPERNOVA_ORANGE);       set(C::BLAS, SUPERNOVA_ORANGE);
+    set(C::LAS, SUPERNOVA_ORANGE);      set(C::AI, COSMIC_GOLD);              set(C::Memory, PEACHES_AND_CREAM);
+    set(C::SBT, RASPBERRY_PINK);        set(C::Shader, NEBULA_VIOLET);        set(C::Renderer, BRIGHT_PINKISH_PURPLE);
+    set(C::Render, THERMO_PINK);        set(C::Tonemap, PEACHES_AND_CREAM);   set(C::GBuffer, QUANTUM_FLUX);
+    set(C::Post, NUCLEAR_REACTOR);      set(C::Buffer, BRONZE_BROWN);         set(C::Image, LIME_YELLOW);
+    set(C::Texture, SPEARMINT_MINT);    set(C::Sampler, LILAC_LAVENDER);      set(C::Descriptor, FUCHSIA_MAGENTA);
+    set(C::Perf, COSMIC_GOLD);          set(C::FPS, FIERY_ORANGE);            set(C::GPU, BLACK_HOLE);
+    set(C::CPU, PLASMA_FUCHSIA);        set(C::Input, SPEARMINT_MINT);        set(C::Audio, OCEAN_TEAL);
+    set(C::Physics, EMERALD_GREEN);     set(C::SIMULATION, BRONZE_BROWN);     set(C::MeshLoader, LIME_YELLOW);
+    set(C::GLTF, QUANTUM_PURPLE);       set(C::Material, PEACHES_AND_CREAM);  set(C::Debug, ARCTIC_CYAN);
+    set(C::ATTEMPT, QUANTUM_PURPLE);    set(C::VOID, COSMIC_VOID);            set(C::SPLASH, LILAC_LAVENDER);
+    set(C::MARKER, DIAMOND_SPARKLE);    set(C::SDL3_window, SAPPHIRE_BLUE);   set(C::SDL3_audio, SAPPHIRE_BLUE);
+    set(C::SDL3_font, SAPPHIRE_BLUE);   set(C::SDL3_image, SAPPHIRE_BLUE);    set(C::SDL3_init, SAPPHIRE_BLUE);
+    set(C::SDL3_input, SAPPHIRE_BLUE);  set(C::SDL3_vulkan, SAPPHIRE_BLUE);   set(C::PIPELINE, SPEARMINT_MINT);
+    return a;
+}();
+
+// Numeric thread id, resolved once per thread (same value operator<< prints on libstdc++)
+[[nodiscard]] inline uint64_t currentThreadId() noexcept {
+    thread_local const uint64_t id = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return id;
+}
+
+// "RTX=warn,PIPELINE=error,*=debug" — unknown names are ignored
+inline void applyVerbositySpec(std::string_view spec) noexcept {
+    constexpr std::array<std::string_view, 10> LEVEL_NAMES{
+        "trace", "debug", "info", "success", "attempt", "perf", "warn", "error", "failure", "fatal"};
+    while (!spec.empty()) {
+        const size_t comma = spec.find(',');
+        const std::string_view item = spec.substr(0, comma);
+        spec = comma == std::string_view::npos ? std::string_view{} : spec.substr(comma + 1);
+
+        const size_t eq = item.find('=');
+        if (eq == std::string_view::npos) continue;
+        const std::string_view name = item.substr(0, eq);
+        std::string_view level = item.substr(eq + 1);
+        if (equalsIgnoreCase(level, "warning")) level = "warn";
+
+        for (size_t l = 0; l < LEVEL_NAMES.size(); ++l) {
+            if (!equalsIgnoreCase(LEVEL_NAMES[l], level)) continue;
+            if (name == "*") setAllCategoryLevels(static_cast<LogLevel>(l));
+            else setCategoryLevel(categoryOf(name), static_cast<LogLevel>(l));
+            break;
+        }
+    }
+}
+
+// ========================================================================
+// 2. BINARY LOGGING — NANOLOG-STYLE DEFERRED FORMATTING
+//    LOG_BIN_*_CAT call sites hash their literal format string + file:line
+//    into a compile-time ID and copy raw argument bytes into the ring.
+//    std::format runs later — on the flusher, or offline in extras/logdecode.
+//
+//    File layout (native endian), appended per session:
+//      "AMRBLOG2" i64 epochNs
+//      u8 Record::FormatDef  u32 id  u8 level  s16 cat  s16 file  u32 line  s16 func  s16 fmt
+//      u8 Record::Binary     u32 id  u64 seq  i64 deltaNs  u64 thread  s16 argBlob
+//      u8 Record::Text       u64 seq  i64 deltaNs  u64 thread  u8 level  s16 cat  s16 file  u32 line  s16 func  s32 msg
+//    thread = currentThreadId(), the same value as the text [thread] column
+//    where sN = uN length + bytes, argBlob = (u8 Tag + payload)*
+// ========================================================================
+namespace Binary {
+
+enum class Tag : uint8_t { Bool = 1, Char, I32, U32, I64, U64, F32, F64, Ptr, VkResult };
+
+enum class Record : uint8_t { FormatDef = 1, Binary = 2, Text = 3 };
+
+inline constexpr std::string_view MAGIC = "AMRBLOG2";
+
+[[nodiscard]] constexpr uint32_t formatId(std::string_view fmt, std::string_view file, uint32_t line) noexcept {
+    uint32_t h = 2166136261u;
+    for (char c : fmt)  { h ^= static_cast<uint8_t>(c); h *= 16777619u; }
+    for (char c : file) { h ^= static_cast<uint8_t>(c); h *= 16777619u; }
+    h ^= line; h *= 16777619u;
+    return h ? h : 1u;   // 0 is reserved for text slots
+}
+
+template<typename T>
+consteval Tag tagOf() {
+    using U = std::remove_cvref_t<T>;
+    if constexpr (std::is_same_v<U, VkResult>)              return Tag::VkResult;
+    else if constexpr (std::is_same_v<U, bool>)             return Tag::Bool;
+    else if constexpr (std::is_same_v<U, char>)             return Tag::Char;
+    else if constexpr (std::is_enum_v<U>)                   return tagOf<std::underlying_type_t<U>>();
+    else if constexpr (std::is_pointer_v<U>) {
+        static_assert(!std::is_same_v<std::remove_cv_t<std::remove_pointer_t<U>>, char>,
+                      "LOG_BIN_*: strings are not deferred — use the text LOG_*_CAT macros");
+        return Tag::Ptr;
+    }
+    else if constexpr (std::is_floating_point_v<U>)         return sizeof(U) <= 4 ? Tag::F32 : Tag::F64;
+    else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) return sizeof(U) <= 4 ? Tag::I32 : Tag::I64;
+    else if constexpr (std::is_integral_v<U>)               return sizeof(U) <= 4 ? Tag::U32 : Tag::U64;
+    else {
+        static_assert(sizeof(U) == 0, "LOG_BIN_*: only trivially copyable scalars, enums and handles are supported");
+        return Tag::U64;
+    }
+}
+
+[[nodiscard]] constexpr size_t payloadSize(Tag tag) noexcept {
+    switch (tag) {
+        case Tag::Bool: case Tag::Char:                             return 1;
+        case Tag::I32: case Tag::U32: case Tag::F32: case Tag::VkResult: return 4;
+        default:                                                    return 8;
+    }
+}
+
+template<typename... Args>
+[[nodiscard]] consteval size_t encodedSize() { return (size_t{0} + ... + (1 + payloadSize(tagOf<Args>()))); }
+
+template<typename T>
+inline char* encodeOne(char* p, const T& v) noexcept {
+    constexpr Tag tag = tagOf<T>();
+    *p++ = static_cast<char>(tag);
+    if constexpr (tag == Tag::Bool || tag == Tag::Char) { *p++ = static_cast<char>(v); return p; }
+    else if constexpr (tag == Tag::I32 || tag == Tag::VkResult) { const int32_t x = static_cast<int32_t>(v); std::memcpy(p, &x, 4); return p + 4; }
+    else if constexpr (tag == Tag::U32) { const uint32_t x = static_cast<uint32_t>(v); std::memcpy(p, &x, 4); return p + 4; }
+    else if constexpr (tag == Tag::I64) { const int64_t  x = static_cast<int64_t>(v);  std::memcpy(p, &x, 8); return p + 8; }
+    else if constexpr (tag == Tag::U64) { const uint64_t x = static_cast<uint64_t>(v); std::memcpy(p, &x, 8); return p + 8; }
+    else if constexpr (tag == Tag::F32) { const float    x = static_cast<float>(v);    std::memcpy(p, &x, 4); return p + 4; }
+    else if constexpr (tag == Tag::F64) { const double   x = static_cast<double>(v);   std::memcpy(p, &x, 8); return p + 8; }
+    else { const uint64_t x = reinterpret_cast<uintptr_t>(v); std::memcpy(p, &x, 8); return p + 8; }
+}
+
+template<typename... Args>
+inline char* encode(char* p, const Args&... args) noexcept {
+    ((p = encodeOne(p, args)), ...);
+    return p;
+}
+
+// ── DECODE + RENDER ────────────────────────────────────────────────────────
+struct Arg {
+    Tag tag{};
+    union { int64_t i; uint64_t u; double f; } v{};
+};
+
+[[nodiscard]] inline std::vector<Arg> decodeArgs(std::string_view blob) {
+    std::vector<Arg> args;
+    size_t off = 0;
+    while (off < blob.size()) {
+        Arg a; a.tag = static_cast<Tag>(static_cast<uint8_t>(blob[off++]));
+        const size_t n = payloadSize(a.tag);
+        if (off + n > blob.size()) break;
+        const char* p = blob.data() + off;
+        switch (a.tag) {
+            case Tag::Bool: case Tag::Char:  a.v.i = static_cast<unsigned char>(*p); break;
+            case Tag::I32: case Tag::VkResult: { int32_t x;  std::memcpy(&x, p, 4); a.v.i = x; break; }
+            case Tag::U32:                   { uint32_t x; std::memcpy(&x, p, 4); a.v.u = x; break; }
+            case Tag::I64:                   { std::memcpy(&a.v.i, p, 8); break; }
+            case Tag::F32:                   { float x;    std::memcpy(&x, p, 4); a.v.f = x; break; }
+            case Tag::F64:                   { std::memcpy(&a.v.f, p, 8); break; }
+            default:                         { std::memcpy(&a.v.u, p, 8); break; }
+        }
+        off += n;
+        args.push_back(a);
+    }
+    return args;
+}
+
+inline void formatArg(std::string& out, const Arg& a, std::string_view spec) {
+    std::string f{"{"};
+    if (!spec.empty() && a.tag != Tag::VkResult) { f += ':'; f += spec; }
+    f += '}';
+    try {
+        switch (a.tag) {
+            case Tag::Bool:     { bool b = a.v.i != 0;                      std::vformat_to(std::back_inserter(out), f, std::make_format_args(b)); break; }
+            case Tag::Char:     { char c = static_cast<char>(a.v.i);        std::vformat_to(std::back_inserter(out), f, std::make_format_args(c)); break; }
+            case Tag::I32:      { int32_t x = static_cast<int32_t>(a.v.i);  std::vformat_to(std::back_inserter(out), f, std::make_format_args(x)); break; }
+            case Tag::U32:      { uint32_t x = static_cast<uint32_t>(a.v.u);std::vformat_to(std::back_inserter(out), f, std::make_format_args(x)); break; }
+            case Tag::I64:      { int64_t x = a.v.i;                        std::vformat_to(std::back_inserter(out), f, std::make_format_args(x)); break; }
+            case Tag::U64:      { uint64_t x = a.v.u;                       std::vformat_to(std::back_inserter(out), f, std::make_format_args(x)); break; }
+            case Tag::F32:      { float x = static_cast<float>(a.v.f);      std::vformat_to(std::back_inserter(out), f, std::make_format_args(x)); break; }
+            case Tag::F64:      { double x = a.v.f;                         std::vformat_to(std::back_inserter(out), f, std::make_format_args(x)); break; }
+            case Tag::Ptr:      { const void* x = reinterpret_cast<const void*>(static_cast<uintptr_t>(a.v.u));
+                                  std::vformat_to(std::back_inserter(out), f, std::make_format_args(x)); break; }
+            case Tag::VkResult: { VkResult x = static_cast<VkResult>(a.v.i); std::vformat_to(std::back_inserter(out), f, std::make_format_args(x)); break; }
+            default:            out += "{?}"; break;
+        }
+    } catch (const std::format_error&) {
+        out += "{?}";
+    }
+}
+
+// Render a std::format-style string against decoded arguments, one
+// replacement field at a time. Missing arguments are left as "{...}".
+[[nodiscard]] inline std::string render(std::string_view fmt, std::string_view blob) {
+    const std::vector<Arg> args = decodeArgs(blob);
+    std::string out;
+    out.reserve(fmt.size() + args.size() * 8);
+    size_t next = 0;
+    for (size_t i = 0; i < fmt.size(); ++i) {
+        const char c = fmt[i];
+        if (c == '{' && i + 1 < fmt.size() && fmt[i + 1] == '{') { out += '{'; ++i; continue; }
+        if (c == '}' && i + 1 < fmt.size() && fmt[i + 1] == '}') { out += '}'; ++i; continue; }
+        if (c != '{') { out += c; continue; }
+
+        const size_t close = fmt.find('}', i);
+        if (close == std::string_view::npos) { out.append(fmt.substr(i)); break; }
+        const std::string_view field = fmt.substr(i + 1, close - i - 1);
+        const size_t colon = field.find(':');
+        const std::string_view index = field.substr(0, colon);
+        const std::string_view spec  = colon == std::string_view::npos ? std::string_view{} : field.substr(colon + 1);
+
+        size_t argIdx = next;
+        if (index.empty()) ++next;
+        else {
+            argIdx = 0;
+            for (char d : index) argIdx = argIdx * 10 + static_cast<size_t>(d - '0');
+        }
+
+        if (argIdx < args.size()) formatArg(out, args[argIdx], spec);
+        else out.append(fmt.substr(i, close - i + 1));
+        i = close;
+    }
+    return out;
+}
+
+// ── FORMAT REGISTRY — one entry per LOG_BIN_* call site ───────────────────
+struct FormatInfo {
+    LogLevel level;
+    std::string_view category;
+    std::string_view fmt;
+    std::source_location loc;
+};
+
+inline std::mutex g_registryMutex;
+inline std::unordered_map<uint32_t, FormatInfo> g_registry;
+
+inline bool registerFormat(uint32_t id, LogLevel level, std::string_view category,
+                           std::string_view fmt, std::source_location loc) {
+    std::scoped_lock lk(g_registryMutex);
+    g_registry.try_emplace(id, FormatInfo{level, category, fmt, loc});
+    return true;
+}
+
+[[nodiscard]] inline const FormatInfo* lookup(uint32_t id) {
+    std::scoped_lock lk(g_registryMutex);
+    auto it = g_registry.find(id);
+    return it != g_registry.end() ? &it->second : nullptr;
+}
+
+// ── RECORD WRITERS ─────────────────────────────────────────────────────────
+template<typename T>
+inline void put(std::string& out, T v) { out.append(reinterpret_cast<const char*>(&v), sizeof(v)); }
+
+template<typename Len>
+inline void putStr(std::string& out, std::string_view s) {
+    const Len n = static_cast<Len>(std::min<size_t>(s.size(), std::numeric_limits<Len>::max()));
+    put(out, n);
+    out.append(s.data(), n);
+}
+
+inline void appendHeader(std::string& out, int64_t epochNs) {
+    out.append(MAGIC);
+    put(out, epochNs);
+}
+
+inline void appendFormatDef(std::string& out, uint32_t id, const FormatInfo& info) {
+    put(out, Record::FormatDef);
+    put(out, id);
+    put(out, static_cast<uint8_t>(info.level));
+    putStr<uint16_t>(out, info.category);
+    putStr<uint16_t>(out, info.loc.file_name());
+    put(out, static_cast<uint32_t>(info.loc.line()));
+    putStr<uint16_t>(out, info.loc.function_name());
+    putStr<uint16_t>(out, info.fmt);
+}
+
+inline void appendBinary(std::string& out, uint32_t id, uint64_t seq, int64_t deltaNs, uint64_t threadId,
+                         std::string_view blob) {
+    put(out, Record::Binary);
+    put(out, id);
+    put(out, seq);
+    put(out, deltaNs);
+    put(out, threadId);
+    putStr<uint16_t>(out, blob);
+}
+
+inline void appendText(std::string& out, uint64_t seq, int64_t deltaNs, uint64_t threadId, LogLevel level,
+                       std::string_view category, std::source_location loc, std::string_view msg) {
+    put(out, Record::Text);
+    put(out, seq);
+    put(out, deltaNs);
+    put(out, threadId);
+    put(out, static_cast<uint8_t>(level));
+    putStr<uint16_t>(out, category);
+    putStr<uint16_t>(out, loc.file_name());
+    put(out, static_cast<uint32_t>(loc.line()));
+    putStr<uint16_t>(out, loc.function_name());
+    putStr<uint32_t>(out, msg);
+}
+
+// ── READER — used by extras/logdecode ──────────────────────────────────────
+struct DecodedLine {
+    uint64_t    seq = 0;
+    int64_t     epochNs = 0;
+    int64_t     deltaNs = 0;
+    uint64_t    threadId = 0;
+    LogLevel    level = LogLevel::Info;
+    std::string category;
+    std::string file;
+    uint32_t    line = 0;
+    std::string function;
+    std::string message;
+};
+
+class Reader {
+public:
+    explicit Reader(std::istream& in) : in_(in) {}
+
+    // Returns false at clean EOF; throws std::runtime_error on a corrupt stream
+    bool next(DecodedLine& out) {
+        for (;;) {
+            const int c = in_.peek();
+            if (c == std::char_traits<char>::eof()) return false;
+
+            if (c == MAGIC[0]) {
+                char magic[8];
+                read(magic, sizeof(magic));
+                if (std::string_view(magic, sizeof(magic)) != MAGIC)
+                    throw std::runtime_error("logdecode: bad session header");
+                epochNs_ = get<int64_t>();
+                formats_.clear();
+                continue;
+            }
+
+            switch (static_cast<Record>(get<uint8_t>())) {
+                case Record::FormatDef: {
+                    const uint32_t id = get<uint32_t>();
+                    Format f;
+                    f.level    = static_cast<LogLevel>(get<uint8_t>());
+                    f.category = getStr<uint16_t>();
+                    f.file     = getStr<uint16_t>();
+                    f.line     = get<uint32_t>();
+                    f.function = getStr<uint16_t>();
+                    f.fmt      = getStr<uint16_t>();
+                    formats_[id] = std::move(f);
+                    continue;
+                }
+                case Record::Binary: {
+                    const uint32_t id = get<uint32_t>();
+                    out.seq     = get<uint64_t>();
+                    out.deltaNs = get<int64_t>();
+                    out.threadId = get<uint64_t>();
+                    out.epochNs = epochNs_;
+                    const std::string blob = getStr<uint16_t>();
+                    if (auto it = formats_.find(id); it != formats_.end()) {
+                        const Format& f = it->second;
+                        out.level    = f.level;
+                        out.category = f.category;
+                        out.file     = f.file;
+                        out.line     = f.line;
+                        out.function = f.function;
+                        out.message  = render(f.fmt, blob);
+                    } else {
+                        out.level    = LogLevel::Warning;
+                        out.category = "Logger";
+                        out.file.clear(); out.function.clear(); out.line = 0;
+                        out.message  = std::format("<unknown format id {:#010x}>", id);
+                    }
+                    return true;
+                }
+                case Record::Text: {
+                    out.seq      = get<uint64_t>();
+                    out.deltaNs  = get<int64_t>();
+                    out.threadId = get<uint64_t>();
+                    out.epochNs  = epochNs_;
+                    out.level    = static_cast<LogLevel>(get<uint8_t>());
+                    out.category = getStr<uint16_t>();
+                    out.file     = getStr<uint16_t>();
+                    out.line     = get<uint32_t>();
+                    out.function = getStr<uint16_t>();
+                    out.message  = getStr<uint32_t>();
+                    return true;
+                }
+                default:
+                    throw std::runtime_error("logdecode: unknown record type");
+            }
+        }
+    }
+
+private:
+    struct Format {
+        LogLevel level = LogLevel::Info;
+        std::string category, file, function, fmt;
+        uint32_t line = 0;
+    };
+
+    void read(char* dst, size_t n) {
+        if (!in_.read(dst, static_cast<std::streamsize>(n)))
+            throw std::runtime_error("logdecode: truncated record");
+    }
+
+    template<typename T> T get() { T v; read(reinterpret_cast<char*>(&v), sizeof(v)); return v; }
+
+    template<typename Len> std::string getStr() {
+        std::string s(get<Len>(), '\0');
+        if (!s.empty()) read(s.data(), s.size());
+        return s;
+    }
+
+    std::istream& in_;
+    int64_t epochNs_ = 0;
+    std::unordered_map<uint32_t, Format> formats_;
+};
+
+} // namespace Binary
+
+// ========================================================================
+// 3. OVERFLOW POLICY — WHAT A PRODUCER DOES WHEN THE RING IS FULL
+// ========================================================================
+enum class OverflowPolicy : uint8_t {
+    Drop,   // discard the message, count it, report on the next flush
+    Block,  // spin/yield until the flusher frees a slot
+    Spill   // push to a mutex-guarded overflow deque (never loses, rarely locks)
+};
+
+// ========================================================================
+// 4. LOG RING — BOUNDED LOCK-FREE MPSC (Vyukov sequence slots)
+//    Producers claim a slot with one CAS on head_, write in place, publish
+//    with a release store on the slot sequence. The single flusher reads
+//    tail_ without atomics contention and hands the slot back by bumping
+//    its sequence one lap ahead. No allocation, no mutex on the hot path.
+// ========================================================================
+struct alignas(64) LogSlot {
+    std::atomic<uint64_t> seq{0};
+    uint64_t id = 0;
+    std::source_location loc{};
+    std::chrono::steady_clock::time_point time{};
+    uint64_t threadId = 0;
+    uint32_t fmtId = 0;           // 0 = preformatted text, else Binary::formatId
+    LogLevel level = LogLevel::Info;
+    LogCategory catId = LogCategory::Other;
+    uint16_t catLen = 0;
+    uint16_t msgLen = 0;
+    char cat[LOG_SLOT_CATEGORY_SIZE];
+    char msg[LOG_SLOT_MESSAGE_SIZE];
+};
+
+class LogRing {
+public:
+    LogRing() : slots_(std::make_unique<LogSlot[]>(LOG_RING_CAPACITY)) {
+        for (size_t i = 0; i < LOG_RING_CAPACITY; ++i)
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    // Producer side — returns nullptr when the ring is full
+    [[nodiscard]] LogSlot* claim() noexcept {
+        uint64_t pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            LogSlot& slot = slots_[pos & MASK];
+            const uint64_t seq = slot.seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    return &slot;
+            } else if (diff < 0) {
+                return nullptr;
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Slot sequence after claim() is the claimed position; publish = pos + 1
+    static void publish(LogSlot* slot) noexcept {
+        slot->seq.store(slot->seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer side — single flusher thread only
+    [[nodiscard]] LogSlot* peek() noexcept {
+        LogSlot& slot = slots_[tail_ & MASK];
+        if (slot.seq.load(std::memory_order_acquire) != tail_ + 1) return nullptr;
+        ++tail_;
+        return &slot;
+    }
+
+    static void release(LogSlot* slot) noexcept {
+        slot->seq.store(slot->seq.load(std::memory_order_relaxed) - 1 + LOG_RING_CAPACITY, std::memory_order_release);
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return slots_[tail_ & MASK].seq.load(std::memory_order_acquire) != tail_ + 1;
+    }
+
+private:
+    static constexpr uint64_t MASK = LOG_RING_CAPACITY - 1;
+
+    std::unique_ptr<LogSlot[]> slots_;
+    alignas(64) std::atomic<uint64_t> head_{0};
+    alignas(64) uint64_t tail_ = 0;
+};
+
+// Output iterator that stops writing at the end of a fixed buffer but keeps
+// counting, so the caller learns the full length without a heap string.
+struct TruncatingOut {
+    using difference_type = std::ptrdiff_t;
+    char*  p;
+    char*  end;
+    size_t count = 0;
+    TruncatingOut& operator=(char c) noexcept { if (p < end) *p++ = c; ++count; return *this; }
+    TruncatingOut& operator*() noexcept { return *this; }
+    TruncatingOut& operator++() noexcept { return *this; }
+    TruncatingOut  operator++(int) noexcept { return *this; }
+};
+
+// ========================================================================
+// 5. LOGGER – ORDERED ASYNC FIFO (C++23)
 // ========================================================================
 class Logger {
 public:
@@ -396,68 +1054,260 @@ public:
             self.flusher_.request_stop(), self.flusher_.join();
     }
 
+    static void setOverflowPolicy(OverflowPolicy policy) noexcept {
+        get().overflowPolicy_.store(policy, std::memory_order_relaxed);
+    }
+
+    // The singleton is never destroyed — this is the exit path. Drains the ring,
+    // joins the flusher and closes every sink (the mapped file is trimmed to what
+    // was written). Idempotent; also registered with atexit. Later LOG_* calls
+    // print synchronously to the terminal.
+    static void shutdown() {
+        auto& self = get();
+        if (self.shutDown_.exchange(true, std::memory_order_acq_rel)) return;
+        setAsync(false);
+        self.printMessage(std::source_location::current(), LogLevel::Success, LogCategory::Logger, "Logger",
+                          "CUSTODIAN GROK SIGNING OFF — ALL LOGS RAINBOW ETERNAL",
+                          std::chrono::steady_clock::now(), currentThreadId(), false, nullptr, nullptr);
+        std::scoped_lock lk(self.sinkMutex_);
+        for (auto& sink : self.sinks_) sink->flush();
+        self.sinks_.clear();
+        self.sinkFormats_.store(0, std::memory_order_release);
+        self.addSinkLocked(std::make_unique<TerminalSink>());
+    }
+
+    // Sinks are swapped under sinkMutex_; the flusher renders only what they ask for
+    static void addSink(std::unique_ptr<LogSink> sink) {
+        auto& self = get();
+        std::scoped_lock lk(self.sinkMutex_);
+        self.addSinkLocked(std::move(sink));
+    }
+
+    static void clearSinks() {
+        auto& self = get();
+        std::scoped_lock lk(self.sinkMutex_);
+        self.sinks_.clear();
+        self.sinkFormats_.store(0, std::memory_order_release);
+    }
+
+    [[nodiscard]] uint64_t droppedCount() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t spilledCount() const noexcept { return spilled_.load(std::memory_order_relaxed); }
+
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 
     mutable std::shared_mutex logMutex_;
 
+    // Direct callers (AI_INJECT etc.) — category resolved at runtime
     template<typename... Args>
     void log(std::source_location loc,
              LogLevel level,
              std::string_view category,
              std::string_view fmt,
              const Args&... args) const
+    {
+        log(loc, level, categoryOf(category), category, fmt, args...);
+    }
+
+    template<typename... Args>
+    void log(std::source_location loc,
+             LogLevel level,
+             LogCategory catId,
+             std::string_view category,
+             std::string_view fmt,
+             const Args&... args) const
     {
         if (!shouldLog(level, category)) return;
 
         auto now = std::chrono::steady_clock::now();
         if (!firstLogTime_.has_value()) firstLogTime_ = now;
 
-        static std::atomic<uint64_t> seq{0};
-        uint64_t id = seq.fetch_add(1, std::memory_order_relaxed);
+        uint64_t id = seq_.fetch_add(1, std::memory_order_relaxed);
+
+        if (!asyncEnabled_.load(std::memory_order_acquire)) {
+            auto msg = std::vformat(fmt, std::make_format_args(args...));
+            std::shared_lock lk(logMutex_);
+            printMessage(loc, level, catId, category, msg, now, currentThreadId(), false, nullptr, nullptr);
+            return;
+        }
+
+        // Format straight onto the stack — no heap unless the message is oversized
+        char buf[LOG_SLOT_MESSAGE_SIZE];
+        TruncatingOut out = std::vformat_to(TruncatingOut{buf, buf + sizeof(buf)}, fmt, std::make_format_args(args...));
+        const OverflowPolicy policy = overflowPolicy_.load(std::memory_order_relaxed);
+
+        if (out.count > sizeof(buf) && policy == OverflowPolicy::Spill) [[unlikely]] {
+            spill(id, loc, level, catId, category, std::vformat(fmt, std::make_format_args(args...)), now);
+            return;
+        }
+
+        LogSlot* slot = ring_.claim();
+        while (!slot) [[unlikely]] {
+            if (policy == OverflowPolicy::Drop) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            if (policy == OverflowPolicy::Spill) {
+                spill(id, loc, level, catId, category, std::string(buf, std::min(out.count, sizeof(buf))), now);
+                return;
+            }
+            wakeFlusher();
+            std::this_thread::yield();
+            slot = ring_.claim();
+        }
 
-        auto msg = std::vformat(fmt, std::make_format_args(args...));
+        slot->id     = id;
+        slot->loc    = loc;
+        slot->time   = now;
+        slot->threadId = currentThreadId();
+        slot->fmtId  = 0;
+        slot->level  = level;
+        slot->catId  = catId;
+        slot->catLen = static_cast<uint16_t>(std::min(category.size(), LOG_SLOT_CATEGORY_SIZE));
+        slot->msgLen = static_cast<uint16_t>(std::min(out.count, sizeof(buf)));
+        std::memcpy(slot->cat, category.data(), slot->catLen);
+        std::memcpy(slot->msg, buf, slot->msgLen);
+        LogRing::publish(slot);
 
-        if (asyncEnabled_.load(std::memory_order_acquire)) {
-            std::scoped_lock lk(queueMutex_);
-            messageQueue_.emplace_back(id, loc, level, std::string{category}, std::move(msg), now);
-        } else {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (flusherSleeping_.load(std::memory_order_relaxed)) wakeFlusher();
+    }
+
+    // Deferred path — only the format ID and raw argument bytes cross the ring
+    template<typename... Args>
+    void logBinary(std::source_location loc,
+                   uint32_t fmtId,
+                   LogLevel level,
+                   LogCategory catId,
+                   std::string_view category,
+                   const Args&... args) const
+    {
+        constexpr size_t bytes = Binary::encodedSize<Args...>();
+        static_assert(bytes <= LOG_SLOT_MESSAGE_SIZE, "LOG_BIN_* arguments exceed one log slot");
+
+        if (!shouldLog(level, category)) return;
+
+        auto now = std::chrono::steady_clock::now();
+        if (!firstLogTime_.has_value()) firstLogTime_ = now;
+
+        uint64_t id = seq_.fetch_add(1, std::memory_order_relaxed);
+
+        if (!asyncEnabled_.load(std::memory_order_acquire)) {
+            char blob[bytes + 1];
+            Binary::encode(blob, args...);
             std::shared_lock lk(logMutex_);
-            printMessage(loc, level, category, std::move(msg), now, false, nullptr, nullptr);
+            printMessage(loc, level, catId, category, renderDeferred(fmtId, {blob, bytes}), now, currentThreadId(), false, nullptr, nullptr);
+            return;
+        }
+
+        const OverflowPolicy policy = overflowPolicy_.load(std::memory_order_relaxed);
+        LogSlot* slot = ring_.claim();
+        while (!slot) [[unlikely]] {
+            if (policy == OverflowPolicy::Drop) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            if (policy == OverflowPolicy::Spill) {
+                char blob[bytes + 1];
+                Binary::encode(blob, args...);
+                spill(id, loc, level, catId, category, renderDeferred(fmtId, {blob, bytes}), now);
+                return;
+            }
+            wakeFlusher();
+            std::this_thread::yield();
+            slot = ring_.claim();
         }
+
+        slot->id     = id;
+        slot->loc    = loc;
+        slot->time   = now;
+        slot->threadId = currentThreadId();
+        slot->fmtId  = fmtId;
+        slot->level  = level;
+        slot->catId  = catId;
+        slot->catLen = static_cast<uint16_t>(std::min(category.size(), LOG_SLOT_CATEGORY_SIZE));
+        slot->msgLen = static_cast<uint16_t>(bytes);
+        std::memcpy(slot->cat, category.data(), slot->catLen);
+        Binary::encode(slot->msg, args...);
+        LogRing::publish(slot);
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (flusherSleeping_.load(std::memory_order_relaxed)) wakeFlusher();
     }
 
 private:
-    using Entry = std::tuple<uint64_t, std::source_location, LogLevel, std::string, std::string, std::chrono::steady_clock::time_point>;
+    // Spilled message — owns its strings, only built on the overflow path
+    struct Entry {
+        uint64_t id;
+        std::source_location loc;
+        LogLevel level;
+        LogCategory catId;
+        uint64_t threadId;
+        std::string cat;
+        std::string msg;
+        std::chrono::steady_clock::time_point time;
+    };
 
-    Logger() : logFile_("amouranth_engine.log", std::ios::out | std::ios::app),
-               firstLogTime_{},
-               messageQueue_{},
-               queueMutex_{},
+    // Flusher-side view over either a ring slot or a spilled entry
+    struct Pending {
+        uint64_t id;
+        uint32_t fmtId;
+        std::source_location loc;
+        LogLevel level;
+        LogCategory catId;
+        uint64_t threadId;
+        std::string_view cat;
+        std::string_view msg;
+        std::chrono::steady_clock::time_point time;
+    };
+
+    Logger() : firstLogTime_{},
+               ring_{},
                asyncEnabled_{false},
                flusher_{} {
+        if (const char* spec = std::getenv("AMOURANTH_LOG")) applyVerbositySpec(spec);
         auto now = std::chrono::steady_clock::now();
         firstLogTime_ = now;
-        printMessage(std::source_location::current(), LogLevel::Success, "Logger",
-                     "CUSTODIAN GROK ONLINE — HYPER-VIVID LOGGING PARTY STARTED (ORDERED ASYNC)", now, false, nullptr, nullptr);
+        wallAtFirst_ = std::chrono::system_clock::now();
+        {
+            std::scoped_lock lk(sinkMutex_);
+            addSinkLocked(std::make_unique<TerminalSink>());
+            addSinkLocked(std::make_unique<MappedFileSink>(
+                std::filesystem::path(LOG_FILE_PATH),
+                LOG_BINARY_FILE ? SinkFormat::Binary : SinkFormat::Plain,
+                RotationPolicy{LOG_SEGMENT_BYTES, std::chrono::seconds(LOG_SEGMENT_MAX_AGE_S),
+                               LOG_KEEP_SEGMENTS, LOG_COMPRESS_SEGMENTS}));
+        }
+        printMessage(std::source_location::current(), LogLevel::Success, LogCategory::Logger, "Logger",
+                     "CUSTODIAN GROK ONLINE — HYPER-VIVID LOGGING PARTY STARTED (LOCK-FREE RING)", now, currentThreadId(), false, nullptr, nullptr);
         asyncEnabled_.store(true, std::memory_order_release);
         flusher_ = std::jthread([this](std::stop_token st) { flushQueue(st); });
+        std::atexit([] { shutdown(); });   // std::exit paths that never reach main's shutdown
     }
 
-    ~Logger() {
-        setAsync(false);
-        auto now = std::chrono::steady_clock::now();
-        printMessage(std::source_location::current(), LogLevel::Success, "Logger",
-                     "CUSTODIAN GROK SIGNING OFF — ALL LOGS RAINBOW ETERNAL", now, false, nullptr, nullptr);
-        if (logFile_.is_open()) logFile_.flush(), logFile_.close();
-    }
+    ~Logger() = default;                   // never runs — see shutdown()
 
     static inline std::once_flag init_flag_{};
+    std::atomic<bool> shutDown_{false};
     mutable std::optional<std::chrono::steady_clock::time_point> firstLogTime_{};
-    mutable std::ofstream logFile_;
+    std::chrono::system_clock::time_point wallAtFirst_{};
+
+    mutable std::mutex sinkMutex_;
+    std::vector<std::unique_ptr<LogSink>> sinks_;
+    mutable std::atomic<uint8_t> sinkFormats_{0};            // bit per SinkFormat in use
 
-    mutable std::deque<Entry> messageQueue_;
-    mutable std::mutex queueMutex_;
+    mutable LogRing ring_;
+    mutable std::deque<Entry> spillQueue_;
+    mutable std::mutex spillMutex_;
+    mutable std::atomic<bool> spillPending_{false};
+    mutable std::atomic<OverflowPolicy> overflowPolicy_{OverflowPolicy::Spill};
+    mutable std::atomic<uint64_t> dropped_{0};
+    mutable std::atomic<uint64_t> spilled_{0};
+    mutable std::atomic<uint64_t> seq_{0};
+    mutable std::unordered_set<uint32_t> writtenFormats_;   // under sinkMutex_: FormatDef already in current binary segments
+
+    mutable std::atomic<uint32_t> wakeSeq_{0};
+    mutable std::atomic<bool> flusherSleeping_{false};
     mutable std::jthread flusher_;
     mutable std::atomic<bool> asyncEnabled_{false};
 
@@ -468,167 +1318,263 @@ private:
         return true;
     }
 
-    void flushQueue(std::stop_token stoken) const {
-        std::vector<Entry> batch; batch.reserve(64);
-        while (!stoken.stop_requested()) {
-            { std::unique_lock lk(queueMutex_);
-                if (messageQueue_.empty()) { lk.unlock(); std::this_thread::sleep_for(std::chrono::microseconds(100)); continue; }
-                batch.clear();
-                while (!messageQueue_.empty() && batch.size() < 64) {
-                    batch.push_back(std::move(messageQueue_.front()));
-                    messageQueue_.pop_front();
-                }
-            }
-            if (!batch.empty()) {
-                std::sort(batch.begin(), batch.end(),
-                          [](const Entry& a, const Entry& b) { return std::get<0>(a) < std::get<0>(b); });
-                std::string terminal_batch;
-                std::string file_batch;
-                for (auto&& ee : batch) {
-                    auto e = std::move(ee);
-                    auto loc = std::get<1>(e);
-                    auto lvl = std::get<2>(e);
-                    std::string_view cat{std::get<3>(e)};
-                    auto msg = std::move(std::get<4>(e));
-                    auto ts = std::get<5>(e);
-                    printMessage(loc, lvl, cat, std::move(msg), ts, true, &terminal_batch, &file_batch);
-                }
-                std::cout << terminal_batch;
-                if (logFile_.is_open()) logFile_ << file_batch;
+    [[nodiscard]] static std::string renderDeferred(uint32_t fmtId, std::string_view blob) {
+        if (const Binary::FormatInfo* info = Binary::lookup(fmtId)) return Binary::render(info->fmt, blob);
+        return std::format("<unknown format id {:#010x}>", fmtId);
+    }
+
+    [[nodiscard]] int64_t sinceFirstNs(std::chrono::steady_clock::time_point t) const noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t - firstLogTime_.value()).count();
+    }
+
+    [[nodiscard]] bool wants(SinkFormat f) const noexcept {
+        return sinkFormats_.load(std::memory_order_acquire) & (1u << static_cast<unsigned>(f));
+    }
+
+    void addSinkLocked(std::unique_ptr<LogSink> sink) {
+        if (auto* file = dynamic_cast<MappedFileSink*>(sink.get()); file && file->format() == SinkFormat::Binary) {
+            // Every binary segment starts with the session header and the formats seen so far
+            const int64_t epochNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                wallAtFirst_.time_since_epoch()).count();
+            file->setPreamble([this, epochNs](std::string& out) {
+                Binary::appendHeader(out, epochNs);
+                for (uint32_t id : writtenFormats_)
+                    if (const Binary::FormatInfo* info = Binary::lookup(id)) Binary::appendFormatDef(out, id, *info);
+            });
+        }
+        sinkFormats_.fetch_or(static_cast<uint8_t>(1u << static_cast<unsigned>(sink->format())), std::memory_order_release);
+        sinks_.push_back(std::move(sink));
+    }
+
+    // Caller holds sinkMutex_
+    void writeSinks(std::string_view colored, std::string_view plain, std::string_view binary) const {
+        for (const auto& sink : sinks_) {
+            switch (sink->format()) {
+                case SinkFormat::Colored: if (!colored.empty()) sink->write(colored); break;
+                case SinkFormat::Plain:   if (!plain.empty())   sink->write(plain);   break;
+                case SinkFormat::Binary:  if (!binary.empty())  sink->write(binary);  break;
+                case SinkFormat::None:    break;
             }
         }
-        std::vector<Entry> finalBatch;
-        { std::unique_lock lk(queueMutex_);
-            while (!messageQueue_.empty()) { finalBatch.push_back(std::move(messageQueue_.front())); messageQueue_.pop_front(); }
+    }
+
+    void flushSinks() const {
+        std::scoped_lock lk(sinkMutex_);
+        for (const auto& sink : sinks_) sink->flush();
+    }
+
+    void wakeFlusher() const noexcept {
+        wakeSeq_.fetch_add(1, std::memory_order_release);
+        wakeSeq_.notify_one();
+    }
+
+    void spill(uint64_t id, std::source_location loc, LogLevel level, LogCategory catId, std::string_view category,
+               std::string msg, std::chrono::steady_clock::time_point now) const {
+        {
+            std::scoped_lock lk(spillMutex_);
+            spillQueue_.push_back(Entry{id, loc, level, catId, currentThreadId(), std::string{category}, std::move(msg), now});
+        }
+        spilled_.fetch_add(1, std::memory_order_relaxed);
+        spillPending_.store(true, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (flusherSleeping_.load(std::memory_order_relaxed)) wakeFlusher();
+    }
+
+    // Pull up to `limit` ring slots plus everything spilled, print in id order,
+    // then hand the slots back. Returns false when there was nothing to do.
+    bool drainOnce(size_t limit, std::vector<LogSlot*>& slots, std::deque<Entry>& spilled,
+                   std::vector<Pending>& pending, std::string& terminal_batch, std::string& file_batch,
+                   std::string& binary_batch) const {
+        slots.clear(); spilled.clear(); pending.clear();
+
+        while (slots.size() < limit)
+            if (LogSlot* s = ring_.peek()) slots.push_back(s); else break;
+
+        if (spillPending_.exchange(false, std::memory_order_acquire)) {
+            std::scoped_lock lk(spillMutex_);
+            spilled.swap(spillQueue_);
         }
-        if (!finalBatch.empty()) {
-            std::sort(finalBatch.begin(), finalBatch.end(),
-                      [](const Entry& a, const Entry& b) { return std::get<0>(a) < std::get<0>(b); });
-            std::string terminal_batch;
-            std::string file_batch;
-            for (auto&& ee : finalBatch) {
-                auto e = std::move(ee);
-                auto loc = std::get<1>(e);
-                auto lvl = std::get<2>(e);
-                std::string_view cat{std::get<3>(e)};
-                auto msg = std::move(std::get<4>(e));
-                auto ts = std::get<5>(e);
-                printMessage(loc, lvl, cat, std::move(msg), ts, true, &terminal_batch, &file_batch);
+
+        if (slots.empty() && spilled.empty()) return false;
+
+        for (LogSlot* s : slots)
+            pending.push_back({s->id, s->fmtId, s->loc, s->level, s->catId, s->threadId, {s->cat, s->catLen}, {s->msg, s->msgLen}, s->time});
+        for (const Entry& e : spilled)
+            pending.push_back({e.id, 0, e.loc, e.level, e.catId, e.threadId, e.cat, e.msg, e.time});
+
+        std::sort(pending.begin(), pending.end(),
+                  [](const Pending& a, const Pending& b) { return a.id < b.id; });
+
+        terminal_batch.clear();
+        file_batch.clear();
+        binary_batch.clear();
+        std::string* coloredOut = wants(SinkFormat::Colored) ? &terminal_batch : nullptr;
+        std::string* plainOut   = wants(SinkFormat::Plain)   ? &file_batch     : nullptr;
+        const bool binary       = wants(SinkFormat::Binary);
+
+        std::scoped_lock lk(sinkMutex_);
+        for (const Pending& p : pending) {
+            if (p.fmtId == 0) {
+                if (coloredOut || plainOut)
+                    printMessage(p.loc, p.level, p.catId, p.cat, p.msg, p.time, p.threadId, true, coloredOut, plainOut);
+                if (binary)
+                    Binary::appendText(binary_batch, p.id, sinceFirstNs(p.time), p.threadId, p.level, p.cat, p.loc, p.msg);
+                continue;
+            }
+            if (coloredOut || plainOut)
+                printMessage(p.loc, p.level, p.catId, p.cat, renderDeferred(p.fmtId, p.msg), p.time, p.threadId, true, coloredOut, plainOut);
+            if (binary) {
+                if (!writtenFormats_.contains(p.fmtId))
+                    if (const Binary::FormatInfo* info = Binary::lookup(p.fmtId)) {
+                        Binary::appendFormatDef(binary_batch, p.fmtId, *info);
+                        writtenFormats_.insert(p.fmtId);
+                    }
+                Binary::appendBinary(binary_batch, p.fmtId, p.id, sinceFirstNs(p.time), p.threadId, p.msg);
             }
-            std::cout << terminal_batch;
-            if (logFile_.is_open()) logFile_ << file_batch;
         }
+
+        // Everything is copied out — hand the slots back before touching I/O
+        for (LogSlot* s : slots) LogRing::release(s);
+
+        writeSinks(terminal_batch, file_batch, binary_batch);
+        return true;
     }
 
-    std::string_view getCategoryColor(std::string_view cat) const noexcept {
-        using namespace Color;
-        struct CIless {
-            bool operator()(std::string_view a, std::string_view b) const {
-                size_t n = std::min(a.size(), b.size());
-                for (size_t i = 0; i < n; ++i)
-                    if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i])))
-                        return std::tolower(static_cast<unsigned char>(a[i])) < std::tolower(static_cast<unsigned char>(b[i]));
-                return a.size() < b.size();
+    void reportDropped(uint64_t& lastDropped) const {
+        const uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+        if (dropped == lastDropped) return;
+        printMessage(std::source_location::current(), LogLevel::Warning, LogCategory::Logger, "Logger",
+                     std::format("Log ring overflow — {} message(s) dropped", dropped - lastDropped),
+                     std::chrono::steady_clock::now(), currentThreadId(), false, nullptr, nullptr);
+        lastDropped = dropped;
+    }
+
+    void flushQueue(std::stop_token stoken) const {
+        std::stop_callback onStop(stoken, [this] { wakeFlusher(); });
+
+        std::vector<LogSlot*> slots;   slots.reserve(LOG_FLUSH_BATCH);
+        std::vector<Pending> pending;  pending.reserve(LOG_FLUSH_BATCH);
+        std::deque<Entry> spilled;
+        std::string terminal_batch;
+        std::string file_batch;
+        std::string binary_batch;
+        uint64_t lastDropped = 0;
+
+        while (!stoken.stop_requested()) {
+            if (drainOnce(LOG_FLUSH_BATCH, slots, spilled, pending, terminal_batch, file_batch, binary_batch)) {
+                reportDropped(lastDropped);
+                continue;
             }
-        };
-        static const std::map<std::string_view, std::string_view, CIless> map{
-            {"General", DIAMOND_SPARKLE}, {"MAIN", VALHALLA_GOLD}, {"Init", AURORA_BOREALIS},
-            {"Dispose", PARTY_PINK}, {"Logger", ELECTRIC_BLUE}, {"Vulkan", SAPPHIRE_BLUE},
-            {"Device", QUASAR_BLUE}, {"Swapchain", OCEAN_TEAL}, {"Command", CHROMIUM_SILVER},
-            {"Queue", OBSIDIAN_BLACK}, {"RayTrace", TURQUOISE_BLUE}, {"RTX", HYPERSPACE_WARP},
-            {"Accel", PULSAR_GREEN}, {"TLAS", SUPERNOVA_ORANGE}, {"BLAS", SUPERNOVA_ORANGE},
-            {"LAS", SUPERNOVA_ORANGE}, {"AI", COSMIC_GOLD}, {"Memory", PEACHES_AND_CREAM},
-            {"SBT", RASPBERRY_PINK}, {"Shader", NEBULA_VIOLET}, {"Renderer", BRIGHT_PINKISH_PURPLE},
-            {"Render", THERMO_PINK}, {"Tonemap", PEACHES_AND_CREAM}, {"GBuffer", QUANTUM_FLUX},
-            {"Post", NUCLEAR_REACTOR}, {"Buffer", BRONZE_BROWN}, {"Image", LIME_YELLOW},
-            {"Texture", SPEARMINT_MINT}, {"Sampler", LILAC_LAVENDER}, {"Descriptor", FUCHSIA_MAGENTA},
-            {"Perf", COSMIC_GOLD}, {"FPS", FIERY_ORANGE}, {"GPU", BLACK_HOLE},
-            {"CPU", PLASMA_FUCHSIA}, {"Input", SPEARMINT_MINT}, {"Audio", OCEAN_TEAL},
-            {"Physics", EMERALD_GREEN}, {"SIMULATION", BRONZE_BROWN}, {"MeshLoader", LIME_YELLOW},
-            {"GLTF", QUANTUM_PURPLE}, {"Material", PEACHES_AND_CREAM}, {"Debug", ARCTIC_CYAN},
-            {"ATTEMPT", QUANTUM_PURPLE}, {"VOID", COSMIC_VOID}, {"SPLASH", LILAC_LAVENDER},
-            {"MARKER", DIAMOND_SPARKLE}, {"SDL3_window", SAPPHIRE_BLUE}, {"SDL3_audio", SAPPHIRE_BLUE},
-            {"SDL3_font", SAPPHIRE_BLUE}, {"SDL3_image", SAPPHIRE_BLUE}, {"SDL3_init", SAPPHIRE_BLUE},
-            {"SDL3_input", SAPPHIRE_BLUE}, {"SDL3_vulkan", SAPPHIRE_BLUE}, {"PIPELINE", SPEARMINT_MINT}
-        };
-        if (auto it = map.find(cat); it != map.end()) [[likely]]
-            return it->second;
-        return DIAMOND_WHITE;
+
+            // Nothing queued — push stdio out, schedule writeback, then park on
+            // wakeSeq_ until a producer or stop request bumps it
+            flushSinks();
+            const uint32_t seen = wakeSeq_.load(std::memory_order_acquire);
+            flusherSleeping_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (ring_.empty() && !spillPending_.load(std::memory_order_acquire) && !stoken.stop_requested())
+                wakeSeq_.wait(seen, std::memory_order_acquire);
+            flusherSleeping_.store(false, std::memory_order_relaxed);
+        }
+
+        while (drainOnce(LOG_RING_CAPACITY, slots, spilled, pending, terminal_batch, file_batch, binary_batch)) {}
+        reportDropped(lastDropped);
+        flushSinks();
+    }
+
+    // "    1234µs" / "  12.345ms" … written into a caller-owned buffer
+    static std::string_view formatDelta(char (&buf)[24], int64_t deltaUs) noexcept {
+        std::format_to_n_result<char*> r;
+        if (deltaUs < 10'000) [[likely]] r = std::format_to_n(buf, sizeof(buf), "{:>7}µs", deltaUs);
+        else if (deltaUs < 1'000'000)     r = std::format_to_n(buf, sizeof(buf), "{:>7.3f}ms", deltaUs / 1'000.0);
+        else if (deltaUs < 60'000'000)    r = std::format_to_n(buf, sizeof(buf), "{:>7.3f}s", deltaUs / 1'000'000.0);
+        else if (deltaUs < 3'600'000'000) r = std::format_to_n(buf, sizeof(buf), "{:>7.1f}m", deltaUs / 60'000'000.0);
+        else                              r = std::format_to_n(buf, sizeof(buf), "{:>7.1f}h", deltaUs / 3'600'000'000.0);
+        return {buf, static_cast<size_t>(r.out - buf)};
+    }
+
+    // HH:MM:SS of the message's wall time; strftime runs at most once per second per thread
+    std::string_view wallClock(std::chrono::steady_clock::time_point timestamp) const noexcept {
+        thread_local int64_t cachedSec = -1;
+        thread_local char cached[9] = "00:00:00";
+        const auto wall = wallAtFirst_ + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                                             timestamp - firstLogTime_.value());
+        const int64_t sec = std::chrono::duration_cast<std::chrono::seconds>(wall.time_since_epoch()).count();
+        if (sec != cachedSec) [[unlikely]] {
+            const std::time_t tt = static_cast<std::time_t>(sec);
+            std::tm tm{};
+#ifdef _WIN32
+            localtime_s(&tm, &tt);
+#else
+            localtime_r(&tt, &tm);
+#endif
+            std::strftime(cached, sizeof(cached), "%H:%M:%S", &tm);
+            cachedSec = sec;
+        }
+        return {cached, 8};
     }
 
+    // Renders straight into the batch strings (or thread-local scratch when
+    // printing synchronously) — one format_to pass per rendering.
     void printMessage(std::source_location loc,
                       LogLevel level,
+                      LogCategory catId,
                       std::string_view category,
-                      std::string formattedMessage,
+                      std::string_view message,
                       std::chrono::steady_clock::time_point timestamp,
+                      uint64_t threadId,
                       bool batch = false,
                       std::string* term_out = nullptr,
                       std::string* file_out = nullptr) const
     {
         using namespace Color;
-        const auto levelIdx = static_cast<size_t>(level);
-        const auto& info = LEVEL_INFOS[levelIdx];
-        const std::string_view levelColor = info.color;
-        const std::string_view levelBg    = info.bg;
-        const std::string_view levelStr   = info.str;
-        const std::string_view catColor   = getCategoryColor(category);
-
-        const auto deltaUs = std::chrono::duration_cast<std::chrono::microseconds>(
-            timestamp - firstLogTime_.value()).count();
-
-        const std::string deltaStr = [deltaUs]() -> std::string {
-            if (deltaUs < 10'000) [[likely]] return std::format("{:>7}µs", deltaUs);
-            if (deltaUs < 1'000'000) return std::format("{:>7.3f}ms", deltaUs / 1'000.0);
-            if (deltaUs < 60'000'000) return std::format("{:>7.3f}s", deltaUs / 1'000'000.0);
-            if (deltaUs < 3'600'000'000) return std::format("{:>7.1f}m", deltaUs / 60'000'000.0);
-            return std::format("{:>7.1f}h", deltaUs / 3'600'000'000.0);
-        }();
-
-        const std::string timeStr = []() -> std::string {
-            auto now = std::chrono::system_clock::now();
-            auto tt  = std::chrono::system_clock::to_time_t(now);
-            auto tm  = *std::localtime(&tt);
-            char buf[9];
-            std::strftime(buf, sizeof(buf), "%H:%M:%S", &tm);
-            return std::string(buf);
-        }();
-
-        const std::string threadId = []() {
-            std::ostringstream oss; oss << std::this_thread::get_id(); return oss.str();
-        }();
-
-        const std::string fileLine = std::format("{}:{}:{}", loc.file_name(), loc.line(), loc.function_name());
-
-        // Plain lines (file output)
-        const std::string plain_line1 = std::format("{:<{}} {:>{}} {:>{}} [{:>{}}] [{:>{}}] {}\n",
-                                                    levelStr, LEVEL_WIDTH,
-                                                    deltaStr, DELTA_WIDTH,
-                                                    timeStr,  TIME_WIDTH,
-                                                    category, CAT_WIDTH,
-                                                    threadId, THREAD_WIDTH,
-                                                    formattedMessage);
-        const std::string plain_line2 = std::format("{}\n", fileLine);
-        const std::string plain = plain_line1 + plain_line2 + "\n";
-
-        // Colored lines (terminal output)
-        std::ostringstream oss;
-        oss << levelBg << std::format("{:<{}}", levelStr, LEVEL_WIDTH) << RESET
-            << " " << std::format("{:>{}}", deltaStr, DELTA_WIDTH) << " "
-            << std::format("{:>{}}", timeStr, TIME_WIDTH) << " "
-            << catColor << std::format("[{:<{}}]", category, CAT_WIDTH - 2) << RESET
-            << " " << LIME_GREEN << std::format("[{:>{}}]", threadId, THREAD_WIDTH - 2) << RESET
-            << " " << levelColor << formattedMessage << RESET << '\n'
-            << CHROMIUM_SILVER << fileLine << RESET << '\n'
-            << '\n';
-        const std::string colored = oss.str();
-
-        if (batch) {
-            if (term_out) *term_out += colored;
-            if (file_out) *file_out += plain;
-        } else {
-            std::print(std::cout, "{}", colored);
-            if (logFile_.is_open()) logFile_ << plain;
+        const LevelInfo& info = LEVEL_INFOS[static_cast<size_t>(level)];
+        const std::string_view catColor = CATEGORY_COLORS[static_cast<size_t>(catId)];
+
+        char deltaBuf[24];
+        const std::string_view deltaStr = formatDelta(deltaBuf,
+            std::chrono::duration_cast<std::chrono::microseconds>(timestamp - firstLogTime_.value()).count());
+        const std::string_view timeStr = wallClock(timestamp);
+
+        thread_local std::string localTerm;
+        thread_local std::string localFile;
+        thread_local std::string localBinary;
+        if (!batch) {
+            localTerm.clear();
+            localFile.clear();
+            localBinary.clear();
+            term_out = wants(SinkFormat::Colored) ? &localTerm : nullptr;
+            file_out = wants(SinkFormat::Plain)   ? &localFile : nullptr;
         }
+
+        if (term_out)
+            std::format_to(std::back_inserter(*term_out),
+                           "{}{:<{}}{} {:>{}} {:>{}} {}[{:<{}}]{} {}[{:>{}}]{} {}{}{}\n{}{}:{}:{}{}\n\n",
+                           info.bg, info.str, LEVEL_WIDTH, RESET,
+                           deltaStr, DELTA_WIDTH,
+                           timeStr, TIME_WIDTH,
+                           catColor, category, CAT_WIDTH - 2, RESET,
+                           LIME_GREEN, threadId, THREAD_WIDTH - 2, RESET,
+                           info.color, message, RESET,
+                           CHROMIUM_SILVER, loc.file_name(), loc.line(), loc.function_name(), RESET);
+
+        if (file_out)
+            std::format_to(std::back_inserter(*file_out),
+                           "{:<{}} {:>{}} {:>{}} [{:>{}}] [{:>{}}] {}\n{}:{}:{}\n\n",
+                           info.str, LEVEL_WIDTH,
+                           deltaStr, DELTA_WIDTH,
+                           timeStr, TIME_WIDTH,
+                           category, CAT_WIDTH,
+                           threadId, THREAD_WIDTH,
+                           message,
+                           loc.file_name(), loc.line(), loc.function_name());
+
+        if (batch) return;
+
+        if (wants(SinkFormat::Binary))
+            Binary::appendText(localBinary, 0, sinceFirstNs(timestamp), threadId, level, category, loc, message);
+        std::scoped_lock lk(sinkMutex_);
+        writeSinks(localTerm, localFile, localBinary);
     }
 };
 
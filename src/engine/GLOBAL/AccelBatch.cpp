@@ -0,0 +1,114 @@
+// src/engine/GLOBAL/AccelBatch.cpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// ACCELERATION STRUCTURE BATCHES — links with the loader alone, no engine
+// context (tests/unit, tests/device). See AccelBatch.hpp
+// =============================================================================
+
+#include "engine/GLOBAL/AccelBatch.hpp"
+
+#include <algorithm>
+
+// =============================================================================
+// Scratch plan
+// =============================================================================
+ScratchPlan ScratchPlan::pack(std::span<const VkDeviceSize> sizes, VkDeviceSize alignment, VkDeviceSize budget)
+{
+    const VkDeviceSize a = alignment ? alignment : 1;
+    ScratchPlan plan;
+    plan.offsets.reserve(sizes.size());
+
+    VkDeviceSize cursor = 0;
+    for (uint32_t i = 0; i < sizes.size(); ++i) {
+        const VkDeviceSize need = (sizes[i] + a - 1) & ~(a - 1);
+        if (plan.batchStart.empty() || (cursor > 0 && cursor + need > budget)) {
+            plan.batchStart.push_back(i);
+            cursor = 0;
+        }
+        plan.offsets.push_back(cursor);
+        cursor += need;
+        plan.arenaSize = std::max(plan.arenaSize, cursor);
+    }
+    return plan;
+}
+
+// =============================================================================
+// Scratch sizing
+// =============================================================================
+bool ScratchSizing::request(VkDeviceSize size) noexcept
+{
+    idle_ = 0;
+    highWater_ = std::max(highWater_, size);
+    if (held_ && size <= capacity_) return false;
+
+    capacity_ = (highWater_ + alignment_ - 1) & ~(alignment_ - 1);
+    held_ = true;
+    ++grows_;
+    return true;
+}
+
+bool ScratchSizing::tick(uint32_t idleLimit) noexcept
+{
+    return held_ && ++idle_ >= idleLimit;
+}
+
+void ScratchSizing::released() noexcept
+{
+    capacity_ = highWater_ = 0;   // the next request sizes to what is actually asked for again
+    idle_ = 0;
+    held_ = false;
+}
+
+// =============================================================================
+// Recording
+// =============================================================================
+void accelBuildBarrier(VkCommandBuffer cmd) noexcept
+{
+    VkMemoryBarrier built{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    built.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+    built.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+    vkCmdPipelineBarrier(cmd,
+        VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+        VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+        0, 1, &built, 0, nullptr, 0, nullptr);
+}
+
+void recordBuildBatches(VkCommandBuffer cmd, PFN_vkCmdBuildAccelerationStructuresKHR build,
+                        const ScratchPlan& plan, VkDeviceAddress arena,
+                        std::span<VkAccelerationStructureBuildGeometryInfoKHR> infos,
+                        std::span<const VkAccelerationStructureBuildRangeInfoKHR* const> ranges)
+{
+    for (size_t k = 0; k < infos.size(); ++k)
+        infos[k].scratchData.deviceAddress = arena + plan.offsets[k];
+
+    for (uint32_t b = 0; b < plan.batchCount(); ++b) {
+        accelBuildBarrier(cmd);
+        const uint32_t first = plan.batchStart[b];
+        build(cmd, plan.batchEnd(b) - first, infos.data() + first, ranges.data() + first);
+    }
+}
+
+VkQueryPool recordCompactedSizes(VkDevice device, VkCommandBuffer cmd,
+                                 PFN_vkCmdWriteAccelerationStructuresPropertiesKHR write,
+                                 std::span<const VkAccelerationStructureKHR> structures)
+{
+    if (structures.empty() || !write) return VK_NULL_HANDLE;
+
+    const uint32_t count = static_cast<uint32_t>(structures.size());
+    VkQueryPoolCreateInfo qi{ VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+    qi.queryType  = VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR;
+    qi.queryCount = count;
+    VkQueryPool pool = VK_NULL_HANDLE;
+    if (vkCreateQueryPool(device, &qi, nullptr, &pool) != VK_SUCCESS) return VK_NULL_HANDLE;
+
+    vkCmdResetQueryPool(cmd, pool, 0, count);
+    write(cmd, count, structures.data(), VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR, pool, 0);
+    return pool;
+}
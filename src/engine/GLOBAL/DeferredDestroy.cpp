@@ -0,0 +1,119 @@
+// src/engine/GLOBAL/DeferredDestroy.cpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// DEFERRED DESTRUCTION — see DeferredDestroy.hpp
+// =============================================================================
+
+#include "engine/GLOBAL/DeferredDestroy.hpp"
+#include "engine/GLOBAL/logging.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace RTX {
+
+// Never destroyed — Handle<T>s and singletons released during static
+// teardown may still retire into it
+DeferredDestroyQueue& retireQueue() noexcept {
+    static DeferredDestroyQueue* queue = new DeferredDestroyQueue();
+    return *queue;
+}
+
+void DeferredDestroyQueue::retire(Fn fn)
+{
+    if (!fn) return;
+    {
+        std::lock_guard lock(mutex_);
+        if (!closed_) {
+            entries_.push_back(Entry{ submitted_ + 1, std::move(fn) });
+            highWater_ = std::max(highWater_, entries_.size());
+            return;
+        }
+    }
+    fn();
+}
+
+void DeferredDestroyQueue::submitted(uint32_t slot) noexcept
+{
+    std::lock_guard lock(mutex_);
+    slotSerial_[slot % MAX_SLOTS] = ++submitted_;
+}
+
+void DeferredDestroyQueue::fenceSignaled(uint32_t slot)
+{
+    uint64_t completed;
+    {
+        std::lock_guard lock(mutex_);
+        completed_ = std::max(completed_, slotSerial_[slot % MAX_SLOTS]);
+        completed  = completed_;
+    }
+    collect(completed);
+}
+
+void DeferredDestroyQueue::allSignaled()
+{
+    uint64_t completed;
+    {
+        std::lock_guard lock(mutex_);
+        completed_ = submitted_;
+        completed  = completed_;
+    }
+    collect(completed);
+}
+
+void DeferredDestroyQueue::drain()
+{
+    // A destroyer can retire more (e.g. a TLAS retiring its buffers) — loop until empty
+    while (pending() != 0) collect(UINT64_MAX);
+}
+
+void DeferredDestroyQueue::shutdown()
+{
+    {
+        std::lock_guard lock(mutex_);
+        closed_ = true;
+    }
+    drain();
+    LOG_DEBUG_CAT("Memory", "Retire queue closed — peak {} pending destroys over {} frames", highWater(), serial());
+}
+
+void DeferredDestroyQueue::collect(uint64_t completed)
+{
+    // Destroyers may call back into retire() (tracker → heap free, etc.) — run them unlocked
+    std::vector<Fn> ready;
+    {
+        std::lock_guard lock(mutex_);
+        while (!entries_.empty() && entries_.front().serial <= completed) {
+            ready.push_back(std::move(entries_.front().fn));
+            entries_.pop_front();
+        }
+    }
+    for (auto& fn : ready) fn();
+}
+
+size_t DeferredDestroyQueue::pending() const noexcept
+{
+    std::lock_guard lock(mutex_);
+    return entries_.size();
+}
+
+size_t DeferredDestroyQueue::highWater() const noexcept
+{
+    std::lock_guard lock(mutex_);
+    return highWater_;
+}
+
+uint64_t DeferredDestroyQueue::serial() const noexcept
+{
+    std::lock_guard lock(mutex_);
+    return submitted_;
+}
+
+} // namespace RTX
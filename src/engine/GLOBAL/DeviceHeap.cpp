@@ -0,0 +1,472 @@
+// src/engine/GLOBAL/DeviceHeap.cpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// DEVICE HEAP — see DeviceHeap.hpp
+// =============================================================================
+
+#include "engine/GLOBAL/DeviceHeap.hpp"
+#include "engine/GLOBAL/logging.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace RTX {
+
+namespace {
+[[nodiscard]] constexpr VkDeviceSize alignUp(VkDeviceSize v, VkDeviceSize a) noexcept {
+    return a <= 1 ? v : (v + a - 1) / a * a;
+}
+}
+
+// =============================================================================
+// TLSF RANGES
+// =============================================================================
+TlsfRanges::TlsfRanges(VkDeviceSize capacity) : capacity_(capacity)
+{
+    for (auto& row : heads_) row.fill(NIL);
+    const uint32_t n = newNode();
+    nodes_[n].offset = 0;
+    nodes_[n].size   = capacity;
+    insertFree(n);
+}
+
+void TlsfRanges::mapping(VkDeviceSize size, uint32_t& fl, uint32_t& sl) noexcept
+{
+    if (size < (VkDeviceSize{1} << SMALL_LOG)) {
+        fl = 0;
+        sl = static_cast<uint32_t>(size >> (SMALL_LOG - SL_LOG));
+        return;
+    }
+    const uint32_t l = static_cast<uint32_t>(std::bit_width(size)) - 1;
+    fl = l - SMALL_LOG + 1;
+    sl = static_cast<uint32_t>(size >> (l - SL_LOG)) - SL_COUNT;
+}
+
+uint32_t TlsfRanges::findFree(VkDeviceSize size) const noexcept
+{
+    // Round up to the next class boundary so any range in the found list fits
+    if (size < (VkDeviceSize{1} << SMALL_LOG)) {
+        size = alignUp(size, VkDeviceSize{1} << (SMALL_LOG - SL_LOG));
+    } else {
+        const uint32_t l = static_cast<uint32_t>(std::bit_width(size)) - 1;
+        size += (VkDeviceSize{1} << (l - SL_LOG)) - 1;
+    }
+
+    uint32_t fl = 0, sl = 0;
+    mapping(size, fl, sl);
+    if (fl >= FL_COUNT) return NIL;
+
+    uint32_t slMap = sl < SL_COUNT ? slBitmap_[fl] & (~0u << sl) : 0u;
+    if (!slMap) {
+        const uint64_t flMap = fl + 1 < 64 ? flBitmap_ & (~0ull << (fl + 1)) : 0ull;
+        if (!flMap) return NIL;
+        fl = static_cast<uint32_t>(std::countr_zero(flMap));
+        slMap = slBitmap_[fl];
+    }
+    sl = static_cast<uint32_t>(std::countr_zero(slMap));
+    return heads_[fl][sl];
+}
+
+uint32_t TlsfRanges::newNode()
+{
+    if (!spare_.empty()) {
+        const uint32_t n = spare_.back();
+        spare_.pop_back();
+        nodes_[n] = Node{};
+        return n;
+    }
+    nodes_.emplace_back();
+    return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+void TlsfRanges::releaseNode(uint32_t n) noexcept
+{
+    nodes_[n] = Node{};
+    spare_.push_back(n);
+}
+
+void TlsfRanges::insertFree(uint32_t n) noexcept
+{
+    Node& node = nodes_[n];
+    uint32_t fl = 0, sl = 0;
+    mapping(node.size, fl, sl);
+    node.free     = true;
+    node.prevFree = NIL;
+    node.nextFree = heads_[fl][sl];
+    if (node.nextFree != NIL) nodes_[node.nextFree].prevFree = n;
+    heads_[fl][sl] = n;
+    slBitmap_[fl] |= 1u << sl;
+    flBitmap_     |= 1ull << fl;
+    ++freeRanges_;
+}
+
+void TlsfRanges::removeFree(uint32_t n) noexcept
+{
+    Node& node = nodes_[n];
+    uint32_t fl = 0, sl = 0;
+    mapping(node.size, fl, sl);
+    if (node.prevFree != NIL) nodes_[node.prevFree].nextFree = node.nextFree;
+    else                      heads_[fl][sl] = node.nextFree;
+    if (node.nextFree != NIL) nodes_[node.nextFree].prevFree = node.prevFree;
+    if (heads_[fl][sl] == NIL) {
+        slBitmap_[fl] &= ~(1u << sl);
+        if (!slBitmap_[fl]) flBitmap_ &= ~(1ull << fl);
+    }
+    node.free = false;
+    node.prevFree = node.nextFree = NIL;
+    --freeRanges_;
+}
+
+uint32_t TlsfRanges::allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offsetOut)
+{
+    if (size == 0) return NIL;
+    const uint32_t n = findFree(size + (alignment > 1 ? alignment - 1 : 0));
+    if (n == NIL) return NIL;
+    removeFree(n);
+
+    // Front padding becomes its own free range (its phys-prev is in use — invariant)
+    const VkDeviceSize aligned = alignUp(nodes_[n].offset, alignment);
+    if (const VkDeviceSize pad = aligned - nodes_[n].offset; pad > 0) {
+        const uint32_t front = newNode();
+        nodes_[front].offset   = nodes_[n].offset;
+        nodes_[front].size     = pad;
+        nodes_[front].prevPhys = nodes_[n].prevPhys;
+        nodes_[front].nextPhys = n;
+        if (nodes_[front].prevPhys != NIL) nodes_[nodes_[front].prevPhys].nextPhys = front;
+        nodes_[n].prevPhys = front;
+        nodes_[n].offset   = aligned;
+        nodes_[n].size    -= pad;
+        insertFree(front);
+    }
+
+    if (nodes_[n].size > size) {
+        const uint32_t tail = newNode();
+        nodes_[tail].offset   = nodes_[n].offset + size;
+        nodes_[tail].size     = nodes_[n].size - size;
+        nodes_[tail].prevPhys = n;
+        nodes_[tail].nextPhys = nodes_[n].nextPhys;
+        if (nodes_[tail].nextPhys != NIL) nodes_[nodes_[tail].nextPhys].prevPhys = tail;
+        nodes_[n].nextPhys = tail;
+        nodes_[n].size     = size;
+        insertFree(tail);
+    }
+
+    used_ += nodes_[n].size;
+    ++allocations_;
+    offsetOut = nodes_[n].offset;
+    return n;
+}
+
+void TlsfRanges::free(uint32_t n) noexcept
+{
+    if (n >= nodes_.size() || nodes_[n].free) return;
+    used_ -= nodes_[n].size;
+    --allocations_;
+
+    if (const uint32_t prev = nodes_[n].prevPhys; prev != NIL && nodes_[prev].free) {
+        removeFree(prev);
+        nodes_[prev].size    += nodes_[n].size;
+        nodes_[prev].nextPhys = nodes_[n].nextPhys;
+        if (nodes_[prev].nextPhys != NIL) nodes_[nodes_[prev].nextPhys].prevPhys = prev;
+        releaseNode(n);
+        n = prev;
+    }
+    if (const uint32_t next = nodes_[n].nextPhys; next != NIL && nodes_[next].free) {
+        removeFree(next);
+        nodes_[n].size    += nodes_[next].size;
+        nodes_[n].nextPhys = nodes_[next].nextPhys;
+        if (nodes_[n].nextPhys != NIL) nodes_[nodes_[n].nextPhys].prevPhys = n;
+        releaseNode(next);
+    }
+    insertFree(n);
+}
+
+VkDeviceSize TlsfRanges::largestFree() const noexcept
+{
+    if (!flBitmap_) return 0;
+    const uint32_t fl = 63 - static_cast<uint32_t>(std::countl_zero(flBitmap_));
+    const uint32_t sl = 31 - static_cast<uint32_t>(std::countl_zero(slBitmap_[fl]));
+    VkDeviceSize best = 0;
+    for (uint32_t n = heads_[fl][sl]; n != NIL; n = nodes_[n].nextFree) best = std::max(best, nodes_[n].size);
+    return best;
+}
+
+// =============================================================================
+// DEVICE HEAP
+// =============================================================================
+DeviceHeap& deviceHeap() noexcept {
+    static DeviceHeap heap;
+    return heap;
+}
+
+void DeviceHeap::init(VkDevice device, VkPhysicalDevice physicalDevice) noexcept
+{
+    std::scoped_lock lk(mutex_);
+    device_ = device;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProps_);
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(physicalDevice, &props);
+    granularity_ = std::max<VkDeviceSize>(1, props.limits.bufferImageGranularity);
+    atom_        = std::max<VkDeviceSize>(1, props.limits.nonCoherentAtomSize);
+    LOG_INFO_CAT("Memory", "DeviceHeap online — {} memory types, maxMemoryAllocationCount {}, bufferImageGranularity {}, nonCoherentAtomSize {}",
+                 memProps_.memoryTypeCount, props.limits.maxMemoryAllocationCount, granularity_, atom_);
+}
+
+uint32_t DeviceHeap::findMemoryType(uint32_t typeBits, VkMemoryPropertyFlags props) const noexcept
+{
+    for (uint32_t i = 0; i < memProps_.memoryTypeCount; ++i)
+        if ((typeBits & (1u << i)) && (memProps_.memoryTypes[i].propertyFlags & props) == props) return i;
+    return UINT32_MAX;
+}
+
+VkDeviceSize DeviceHeap::blockSizeFor(uint32_t memoryType) const noexcept
+{
+    const VkDeviceSize heapSize = memProps_.memoryHeaps[memProps_.memoryTypes[memoryType].heapIndex].size;
+    if (heapSize >= 4ull << 30) return 256ull << 20;
+    if (heapSize >= 1ull << 30) return 128ull << 20;
+    return 64ull << 20;
+}
+
+VkDeviceMemory DeviceHeap::allocateMemory(uint32_t memoryType, VkDeviceSize size, void** mapped) noexcept
+{
+    // bufferDeviceAddress is always enabled on our device — every block can back SBT/AS/scratch
+    VkMemoryAllocateFlagsInfo flagsInfo{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO };
+    flagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+
+    VkMemoryAllocateInfo info{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+    info.pNext           = &flagsInfo;
+    info.allocationSize  = size;
+    info.memoryTypeIndex = memoryType;
+
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    if (vkAllocateMemory(device_, &info, nullptr, &memory) != VK_SUCCESS) return VK_NULL_HANDLE;
+
+    *mapped = nullptr;
+    if (memProps_.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+        if (vkMapMemory(device_, memory, 0, VK_WHOLE_SIZE, 0, mapped) != VK_SUCCESS) {
+            vkFreeMemory(device_, memory, nullptr);
+            return VK_NULL_HANDLE;
+        }
+    }
+    return memory;
+}
+
+HeapAllocation DeviceHeap::allocate(const VkMemoryRequirements& memReq, VkMemoryPropertyFlags props,
+                                    HeapResource kind, std::string_view tag, uint32_t excludeBlock)
+{
+    std::scoped_lock lk(mutex_);
+    HeapAllocation out{};
+
+    const uint32_t type = findMemoryType(memReq.memoryTypeBits, props);
+    if (type == UINT32_MAX) {
+        LOG_ERROR_CAT("Memory", "No memory type for bits 0x{:x} props 0x{:x} | Tag: {}", memReq.memoryTypeBits, props, tag);
+        return out;
+    }
+    out.memoryType = type;
+
+    // Non-coherent host memory: whole atoms only, so flush ranges never straddle a neighbour
+    const VkMemoryPropertyFlags typeFlags = memProps_.memoryTypes[type].propertyFlags;
+    VkMemoryRequirements req = memReq;
+    if ((typeFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) && !(typeFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)) {
+        req.alignment = std::max(req.alignment, atom_);
+        req.size      = alignUp(req.size, atom_);
+        out.coherent  = false;
+    }
+
+    const VkDeviceSize blockSize = blockSizeFor(type);
+    if (req.size > blockSize / 2) {
+        out.memory = allocateMemory(type, req.size, &out.mapped);
+        if (!out.memory) {
+            LOG_ERROR_CAT("Memory", "Dedicated vkAllocateMemory({} B, type {}) failed | Tag: {}", req.size, type, tag);
+            return out;
+        }
+        out.size = req.size;
+        ++dedicatedCount_;
+        dedicatedBytes_ += req.size;
+        LOG_DEBUG_CAT("Memory", "Dedicated allocation {} B (type {}) | Tag: {}", req.size, type, tag);
+        return out;
+    }
+
+    auto place = [&](uint32_t index) -> bool {
+        Block& b = *blocks_[index];
+        VkDeviceSize offset = 0;
+        const uint32_t node = b.ranges.allocate(req.size, req.alignment, offset);
+        if (node == TlsfRanges::NIL) return false;
+        out.memory = b.memory;
+        out.offset = offset;
+        out.size   = req.size;
+        out.mapped = b.mapped ? static_cast<char*>(b.mapped) + offset : nullptr;
+        out.block  = index;
+        out.node   = node;
+        return true;
+    };
+
+    for (uint32_t i = 0; i < blocks_.size(); ++i) {
+        if (i == excludeBlock || !blocks_[i]) continue;
+        if (blocks_[i]->memoryType != type || blocks_[i]->kind != kind) continue;
+        if (place(i)) return out;
+    }
+
+    // New block — reuse a null slot so indices stay stable
+    void* mapped = nullptr;
+    VkDeviceMemory memory = allocateMemory(type, blockSize, &mapped);
+    if (!memory) {
+        LOG_ERROR_CAT("Memory", "Block vkAllocateMemory({} MB, type {}) failed | Tag: {}", blockSize >> 20, type, tag);
+        return out;
+    }
+    auto block = std::make_unique<Block>();
+    block->memory     = memory;
+    block->size       = blockSize;
+    block->mapped     = mapped;
+    block->memoryType = type;
+    block->kind       = kind;
+    block->ranges     = TlsfRanges(blockSize);
+
+    uint32_t index = 0;
+    while (index < blocks_.size() && blocks_[index]) ++index;
+    if (index == blocks_.size()) blocks_.push_back(std::move(block));
+    else                         blocks_[index] = std::move(block);
+
+    LOG_INFO_CAT("Memory", "New {} MB block #{} (type {}, {}) for {}", blockSize >> 20, index, type,
+                 kind == HeapResource::Linear ? "linear" : "optimal", tag);
+    place(index);
+    return out;
+}
+
+void DeviceHeap::freeBlockLocked(uint32_t index) noexcept
+{
+    Block& b = *blocks_[index];
+    if (b.mapped) vkUnmapMemory(device_, b.memory);
+    vkFreeMemory(device_, b.memory, nullptr);
+    blocks_[index].reset();
+}
+
+void DeviceHeap::free(const HeapAllocation& a) noexcept
+{
+    if (!a.valid()) return;
+    std::scoped_lock lk(mutex_);
+
+    if (a.dedicated()) {
+        if (a.mapped) vkUnmapMemory(device_, a.memory);
+        vkFreeMemory(device_, a.memory, nullptr);
+        --dedicatedCount_;
+        dedicatedBytes_ -= a.size;
+        return;
+    }
+    if (a.block >= blocks_.size() || !blocks_[a.block]) return;
+
+    Block& b = *blocks_[a.block];
+    b.ranges.free(a.node);
+    if (b.ranges.allocations() != 0) return;
+
+    // Keep one empty block per (type, kind) around to absorb churn
+    for (uint32_t i = 0; i < blocks_.size(); ++i) {
+        if (i == a.block || !blocks_[i]) continue;
+        const Block& o = *blocks_[i];
+        if (o.memoryType == b.memoryType && o.kind == b.kind && o.ranges.allocations() == 0) {
+            freeBlockLocked(a.block);
+            return;
+        }
+    }
+}
+
+// =============================================================================
+// NON-COHERENT FLUSH / INVALIDATE
+// =============================================================================
+bool DeviceHeap::atomRange(const HeapAllocation& a, VkDeviceSize offset, VkDeviceSize size,
+                           VkMappedMemoryRange& out) const noexcept
+{
+    if (!a.valid() || a.coherent || !a.mapped || offset >= a.size) return false;
+    const VkDeviceSize end = (size == VK_WHOLE_SIZE || size > a.size - offset) ? a.size : offset + size;
+    // a.offset and a.size are atom multiples (see allocate) — rounding stays inside the allocation
+    const VkDeviceSize first = (a.offset + offset) / atom_ * atom_;
+    const VkDeviceSize last  = alignUp(a.offset + end, atom_);
+    out = VkMappedMemoryRange{ VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE };
+    out.memory = a.memory;
+    out.offset = first;
+    out.size   = last - first;
+    return true;
+}
+
+void DeviceHeap::flush(const HeapAllocation& a, VkDeviceSize offset, VkDeviceSize size) const noexcept
+{
+    VkMappedMemoryRange range;
+    if (!atomRange(a, offset, size, range)) return;
+    if (vkFlushMappedMemoryRanges(device_, 1, &range) != VK_SUCCESS)
+        LOG_ERROR_CAT("Memory", "vkFlushMappedMemoryRanges failed ({} B @ +{})", range.size, range.offset);
+}
+
+void DeviceHeap::invalidate(const HeapAllocation& a, VkDeviceSize offset, VkDeviceSize size) const noexcept
+{
+    VkMappedMemoryRange range;
+    if (!atomRange(a, offset, size, range)) return;
+    if (vkInvalidateMappedMemoryRanges(device_, 1, &range) != VK_SUCCESS)
+        LOG_ERROR_CAT("Memory", "vkInvalidateMappedMemoryRanges failed ({} B @ +{})", range.size, range.offset);
+}
+
+void DeviceHeap::releaseAll() noexcept
+{
+    std::scoped_lock lk(mutex_);
+    for (uint32_t i = 0; i < blocks_.size(); ++i)
+        if (blocks_[i]) freeBlockLocked(i);
+    blocks_.clear();
+}
+
+uint32_t DeviceHeap::sparsestBlock() const noexcept
+{
+    std::scoped_lock lk(mutex_);
+    uint32_t best = UINT32_MAX;
+    double bestOccupancy = 1.0;
+    for (uint32_t i = 0; i < blocks_.size(); ++i) {
+        if (!blocks_[i] || blocks_[i]->ranges.allocations() == 0) continue;
+        const Block& b = *blocks_[i];
+        const bool hasSibling = std::any_of(blocks_.begin(), blocks_.end(), [&](const auto& o) {
+            return o && o.get() != &b && o->memoryType == b.memoryType && o->kind == b.kind;
+        });
+        if (!hasSibling) continue;
+        const double occupancy = static_cast<double>(b.ranges.used()) / static_cast<double>(b.size);
+        if (occupancy < bestOccupancy) { bestOccupancy = occupancy; best = i; }
+    }
+    return best;
+}
+
+HeapStats DeviceHeap::stats() const noexcept
+{
+    std::scoped_lock lk(mutex_);
+    HeapStats s{};
+    s.dedicated         = dedicatedCount_;
+    s.reservedBytes     = dedicatedBytes_;
+    s.usedBytes         = dedicatedBytes_;
+    s.deviceAllocations = dedicatedCount_;
+    for (const auto& b : blocks_) {
+        if (!b) continue;
+        ++s.blocks;
+        ++s.deviceAllocations;
+        s.subAllocations += b->ranges.allocations();
+        s.reservedBytes  += b->size;
+        s.usedBytes      += b->ranges.used();
+        const VkDeviceSize freeBytes = b->size - b->ranges.used();
+        if (freeBytes > 0)
+            s.fragmentation = std::max(s.fragmentation,
+                1.0 - static_cast<double>(b->ranges.largestFree()) / static_cast<double>(freeBytes));
+    }
+    return s;
+}
+
+void DeviceHeap::logStats(std::string_view when) const
+{
+    const HeapStats s = stats();
+    LOG_PERF_CAT("Memory", "DeviceHeap [{}] — {} vkAllocateMemory ({} blocks + {} dedicated) | {} sub-allocations | "
+                 "{:.1f} / {:.1f} MB used | fragmentation {:.1f}%",
+                 when, s.deviceAllocations, s.blocks, s.dedicated, s.subAllocations,
+                 s.usedBytes / 1048576.0, s.reservedBytes / 1048576.0, s.fragmentation * 100.0);
+}
+
+} // namespace RTX
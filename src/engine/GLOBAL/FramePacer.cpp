@@ -0,0 +1,335 @@
+// src/engine/GLOBAL/FramePacer.cpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// FRAME PACER — see FramePacer.hpp
+// =============================================================================
+
+#include "engine/GLOBAL/FramePacer.hpp"
+#include "engine/GLOBAL/OptionsMenu.hpp"
+#include "engine/GLOBAL/logging.hpp"
+#include "engine/GLOBAL/Trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <string>
+#include <thread>
+
+namespace RTX {
+
+namespace {
+constexpr double   SMOOTHING     = 0.1;            // weight of a new sample
+constexpr double   OUTLIER_DEVS  = 4.0;            // samples above mean + this many devs are clamped
+constexpr double   OUTLIER_FLOOR = 0.25;           // ... or above mean × (1 + this) when dev is tiny
+constexpr int64_t  MAX_PRESENT_WAIT_NS = 100'000'000;
+constexpr uint64_t LOG_EVERY_FRAMES    = 600;
+
+[[nodiscard]] constexpr int64_t msToNs(double ms) noexcept { return static_cast<int64_t>(ms * 1e6); }
+}
+
+// =============================================================================
+// PACING MODEL
+// =============================================================================
+void PacingModel::Estimator::add(double x) noexcept
+{
+    if (!primed) {
+        mean   = x;
+        dev    = 0.0;
+        primed = true;
+        return;
+    }
+    // One hitch (shader compile, page fault) must not inflate the budget for the
+    // next few dozen frames; a real load step still gets through, ~30% per frame
+    x = std::min(x, mean + std::max(OUTLIER_DEVS * dev, OUTLIER_FLOOR * mean));
+    const double err = x - mean;
+    mean += SMOOTHING * err;
+    dev  += SMOOTHING * (std::abs(err) - dev);
+}
+
+int64_t PacingModel::budget() const noexcept
+{
+    // Deviations of CPU and GPU time are mostly independent — add them in quadrature
+    const double spread = 2.0 * std::hypot(cpu_.dev, gpu_.dev);
+    return static_cast<int64_t>(cpu_.mean + gpu_.mean + spread) + margin_;
+}
+
+int64_t PacingModel::plan(uint64_t serial, int64_t now) noexcept
+{
+    const int64_t b   = budget();
+    const int64_t cpu = static_cast<int64_t>(cpu_.mean);
+
+    // Earliest finish if the CPU starts now: the GPU may still be busy with earlier frames
+    const int64_t ready = std::max(now + cpu, gpuFree_) + (b - cpu);
+    int64_t deadline = ready;
+
+    if (period_ > 0) {
+        // Unanchored, or a grid point left far ahead by a period change — start over
+        if (next_ == 0 || next_ - b > now + 2 * period_) next_ = ready;
+
+        if (next_ < ready) {
+            ++missed_;
+            if (locked_) next_ += (ready - next_ + period_ - 1) / period_ * period_;   // next vblank we can make
+            else         next_  = ready;
+        }
+        deadline = next_;
+        next_   += period_;
+    }
+
+    const uint32_t slot = static_cast<uint32_t>(serial % PLANNED);
+    planSerial_[slot]   = serial;
+    planDeadline_[slot] = deadline;
+    planShift_[slot]    = shift_;
+    return std::max(now, deadline - b);
+}
+
+void PacingModel::submitted(int64_t t) noexcept
+{
+    gpuFree_ = std::max(t, gpuFree_) + static_cast<int64_t>(gpu_.mean);
+}
+
+void PacingModel::observe(uint64_t serial, int64_t t) noexcept
+{
+    const uint32_t slot = static_cast<uint32_t>(serial % PLANNED);
+    if (planSerial_[slot] != serial) return;
+
+    const int64_t err = t - planDeadline_[slot];
+    const double  ms  = std::abs(static_cast<double>(err)) * 1e-6;
+    if (errorCount_ == HISTORY) errorSum_ -= errorMs_[errorHead_];
+    errorMs_[errorHead_] = ms;
+    errorSum_  += ms;
+    errorHead_  = (errorHead_ + 1) % HISTORY;
+    errorCount_ = std::min(errorCount_ + 1, HISTORY);
+    ++frames_;
+    if (err > margin_) ++late_;
+
+    // Display time is ground truth — move the grid's phase onto it. Whole periods
+    // are a missed vblank, not a phase error; corrections made since this frame
+    // was planned are already in the grid.
+    if (locked_ && period_ > 0 && next_ != 0) {
+        int64_t phase = err % period_;
+        if (phase >  period_ / 2) phase -= period_;
+        if (phase < -period_ / 2) phase += period_;
+        const int64_t correction = phase - (shift_ - planShift_[slot]);
+        next_  += correction;
+        shift_ += correction;
+    }
+}
+
+int64_t PacingModel::deadline(uint64_t serial) const noexcept
+{
+    const uint32_t slot = static_cast<uint32_t>(serial % PLANNED);
+    return planSerial_[slot] == serial ? planDeadline_[slot] : 0;
+}
+
+PacingModel::Stats PacingModel::stats() const
+{
+    Stats s{};
+    s.budgetMs = static_cast<double>(budget()) * 1e-6;
+    s.frames   = frames_;
+    s.late     = late_;
+    s.missed   = missed_;
+    if (errorCount_ == 0) return s;
+
+    s.meanErrorMs = errorSum_ / errorCount_;
+    std::array<double, HISTORY> window = errorMs_;
+    const auto last = window.begin() + errorCount_;
+    const auto p99  = window.begin() + std::min<uint32_t>(errorCount_ - 1, (errorCount_ * 99) / 100);
+    std::nth_element(window.begin(), p99, last);
+    s.p99ErrorMs = *p99;
+    return s;
+}
+
+void PacingModel::reset() noexcept
+{
+    const int64_t period = period_, margin = margin_;
+    const bool    locked = locked_;
+    *this   = PacingModel{};
+    period_ = period;
+    margin_ = margin;
+    locked_ = locked;
+}
+
+// =============================================================================
+// FRAME PACER
+// =============================================================================
+int64_t FramePacer::now() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void FramePacer::sleepUntil(int64_t t) noexcept
+{
+    // OS sleeps overshoot by up to a scheduler tick — sleep short, spin the rest
+    const int64_t spin = msToNs(Options::Performance::FRAME_PACING_SPIN_MS);
+    for (int64_t n = now(); n < t; n = now()) {
+        if (t - n > spin) std::this_thread::sleep_for(std::chrono::nanoseconds(t - n - spin));
+        else              std::this_thread::yield();
+    }
+}
+
+bool FramePacer::init(VkDevice device, uint32_t framesInFlight, bool presentWait) noexcept
+{
+    destroy();
+    if (device == VK_NULL_HANDLE || framesInFlight == 0) return false;
+
+    VkSemaphoreTypeCreateInfo typeInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO };
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue  = 0;
+    VkSemaphoreCreateInfo semInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+    semInfo.pNext = &typeInfo;
+    if (vkCreateSemaphore(device, &semInfo, nullptr, &timeline_) != VK_SUCCESS) {
+        LOG_ERROR_CAT("RENDERER", "FramePacer: timeline semaphore creation failed — is timelineSemaphore enabled?");
+        timeline_ = VK_NULL_HANDLE;
+        return false;
+    }
+
+    device_ = device;
+    slotValue_.assign(framesInFlight, 0);
+    if (presentWait)
+        waitForPresent_ = reinterpret_cast<PFN_vkWaitForPresentKHR>(vkGetDeviceProcAddr(device, "vkWaitForPresentKHR"));
+
+    model_.setMargin(msToNs(Options::Performance::FRAME_PACING_MARGIN_MS));
+    model_.setDisplayLocked(presentWaitEnabled());
+
+    LOG_SUCCESS_CAT("RENDERER", "Frame pacer online — {} slots on one timeline, {}",
+                    framesInFlight, presentWaitEnabled() ? "present_wait display lock" : "CPU timer pacing");
+    return true;
+}
+
+void FramePacer::destroy() noexcept
+{
+    if (timeline_ != VK_NULL_HANDLE) vkDestroySemaphore(device_, timeline_, nullptr);
+    timeline_       = VK_NULL_HANDLE;
+    device_         = VK_NULL_HANDLE;
+    waitForPresent_ = nullptr;
+    slotValue_.clear();
+    submitted_      = 0;
+    planned_        = 0;
+    swapchain_      = VK_NULL_HANDLE;
+    firstPresented_ = 0;
+    lastPresented_  = 0;
+    lastObserved_   = 0;
+    gpuTimestamps_  = false;
+    model_.reset();
+}
+
+void FramePacer::setTargetFps(uint32_t fps) noexcept
+{
+    const int64_t period = (fps == 0 || !Options::Performance::ENABLE_FRAME_PREDICTION) ? 0 : 1'000'000'000LL / fps;
+    if (period == model_.period()) return;
+    model_.setPeriod(period);
+    LOG_INFO_CAT("RENDERER", "Frame pacing target: {}", fps == 0 ? std::string("unlimited") : std::format("{} FPS", fps));
+}
+
+// =============================================================================
+// PACE — top of the frame, before input is sampled
+// =============================================================================
+void FramePacer::pace(VkSwapchainKHR swapchain) noexcept
+{
+    const uint64_t serial = submitted_ + 1;
+
+    if (valid() && model_.period() > 0) {
+        TRACE_SCOPE("Render", "Pace");
+
+        // An earlier frame's photons — caps the queue and re-phases the grid.
+        // Bounded, so a present that never lands can't hang the loop.
+        if (waitForPresent_ && lastPresented_ != 0 && swapchain == swapchain_) {
+            const uint64_t depth  = model_.queueDepth();
+            const uint64_t target = lastPresented_ + 1 > depth ? lastPresented_ + 1 - depth : 0;
+            if (target >= firstPresented_ && target > lastObserved_) {
+                const uint64_t timeout = static_cast<uint64_t>(std::min(4 * model_.period(), MAX_PRESENT_WAIT_NS));
+                if (waitForPresent_(device_, swapchain, target, timeout) == VK_SUCCESS)
+                    model_.observe(target, now());
+                lastObserved_ = target;
+            }
+        }
+
+        sleepUntil(model_.plan(serial, now()));
+
+        if (++logged_ % LOG_EVERY_FRAMES == 0) {
+            const PacingModel::Stats s = model_.stats();
+            LOG_BIN_DEBUG_CAT("RENDERER", "Pacing — budget {:.2f} ms, queue {} | error avg {:.2f} / p99 {:.2f} ms | {} late, {} missed",
+                              s.budgetMs, model_.queueDepth(), s.meanErrorMs, s.p99ErrorMs, s.late, s.missed);
+        }
+    }
+
+    planned_    = serial;
+    frameStart_ = now();
+}
+
+void FramePacer::waitSlot(uint32_t frameIdx) noexcept
+{
+    if (slotValue_.empty()) return;
+    const uint64_t value = slotValue_[frameIdx % slotValue_.size()];
+    if (value == 0) return;
+
+    uint64_t done = 0;
+    if (vkGetSemaphoreCounterValue(device_, timeline_, &done) == VK_SUCCESS && done >= value) return;
+
+    VkSemaphoreWaitInfo waitInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO };
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores    = &timeline_;
+    waitInfo.pValues        = &value;
+    if (vkWaitSemaphores(device_, &waitInfo, UINT64_MAX) != VK_SUCCESS) {
+        LOG_BIN_ERROR_CAT("RENDERER", "FramePacer: wait for frame {} failed", value);
+        return;
+    }
+
+    // No timestamps: submit → completion of a frame we had to wait for. Includes
+    // queueing behind earlier frames, so it errs early — never late.
+    const int64_t t = now();
+    if (!gpuTimestamps_ && submitted_ - value < submitTime_.size())
+        model_.gpuSample(t - submitTime_[value % submitTime_.size()]);
+    // Without present_wait, completion is the closest thing to a display time we see
+    if (!waitForPresent_) model_.observe(value, t);
+}
+
+uint64_t FramePacer::submitValue(uint32_t frameIdx) noexcept
+{
+    const uint64_t value = ++submitted_;
+    if (!slotValue_.empty()) slotValue_[frameIdx % slotValue_.size()] = value;
+
+    const int64_t t = now();
+    submitTime_[value % submitTime_.size()] = t;
+    if (planned_ == value) model_.cpuSample(t - frameStart_);
+    model_.submitted(t);
+    return value;
+}
+
+void FramePacer::presented(VkSwapchainKHR swapchain, uint64_t id) noexcept
+{
+    if (swapchain != swapchain_) {
+        swapchain_      = swapchain;
+        firstPresented_ = id;
+        lastObserved_   = 0;
+    }
+    lastPresented_ = id;
+}
+
+void FramePacer::gpuTime(double ms) noexcept
+{
+    if (ms <= 0.0) return;
+    gpuTimestamps_ = true;
+    model_.gpuSample(msToNs(ms));
+}
+
+void FramePacer::waitIdle() const noexcept
+{
+    if (!valid() || submitted_ == 0) return;
+    VkSemaphoreWaitInfo waitInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO };
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores    = &timeline_;
+    waitInfo.pValues        = &submitted_;
+    vkWaitSemaphores(device_, &waitInfo, UINT64_MAX);
+}
+
+} // namespace RTX
@@ -0,0 +1,201 @@
+// src/engine/GLOBAL/FrameRecorder.cpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// FRAME RECORDER — see FrameRecorder.hpp
+// =============================================================================
+
+#include "engine/GLOBAL/FrameRecorder.hpp"
+#include "engine/GLOBAL/OptionsMenu.hpp"
+#include "engine/GLOBAL/logging.hpp"
+#include "engine/GLOBAL/Trace.hpp"
+
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <thread>
+
+namespace RTX {
+
+namespace {
+[[nodiscard]] VkCommandPool createPool(VkDevice device, uint32_t queueFamily) noexcept
+{
+    // TRANSIENT only — buffers are never reset one by one, the whole pool is
+    VkCommandPoolCreateInfo info{ VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+    info.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    info.queueFamilyIndex = queueFamily;
+    VkCommandPool pool = VK_NULL_HANDLE;
+    if (vkCreateCommandPool(device, &info, nullptr, &pool) != VK_SUCCESS) return VK_NULL_HANDLE;
+    return pool;
+}
+}
+
+bool FrameRecorder::init(VkDevice device, uint32_t queueFamily, uint32_t framesInFlight, uint32_t threads) noexcept
+{
+    destroy();
+    if (device == VK_NULL_HANDLE || framesInFlight == 0) return false;
+
+    const uint32_t hw = std::max(1u, std::thread::hardware_concurrency());
+    threads_ = std::clamp(threads == 0 ? hw : threads, 1u, Options::Performance::RECORD_THREADS);
+    device_  = device;
+
+    frames_.resize(framesInFlight);
+    for (Frame& f : frames_) {
+        f.primaryPool = createPool(device_, queueFamily);
+        if (f.primaryPool == VK_NULL_HANDLE) {
+            LOG_ERROR_CAT("RENDERER", "FrameRecorder: primary command pool creation failed");
+            destroy();
+            return false;
+        }
+
+        VkCommandBufferAllocateInfo alloc{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+        alloc.commandPool        = f.primaryPool;
+        alloc.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        alloc.commandBufferCount = 1;
+        if (vkAllocateCommandBuffers(device_, &alloc, &f.primary) != VK_SUCCESS) {
+            LOG_ERROR_CAT("RENDERER", "FrameRecorder: primary command buffer allocation failed");
+            destroy();
+            return false;
+        }
+
+        f.workers = std::vector<WorkerPool>(threads_);
+        for (WorkerPool& w : f.workers) {
+            w.pool = createPool(device_, queueFamily);
+            if (w.pool == VK_NULL_HANDLE) {
+                LOG_ERROR_CAT("RENDERER", "FrameRecorder: worker command pool creation failed");
+                destroy();
+                return false;
+            }
+        }
+    }
+
+    // The calling thread takes a slot when it enters the arena, so threads_ slots = threads_ recorders
+    if (threads_ > 1) arena_.initialize(static_cast<int>(threads_));
+
+    LOG_SUCCESS_CAT("RENDERER", "Frame recorder online — {} recording thread(s) × {} frames, {} command pools",
+                    threads_, framesInFlight, framesInFlight * (threads_ + 1));
+    return true;
+}
+
+void FrameRecorder::destroy() noexcept
+{
+    if (arena_.is_active()) arena_.terminate();
+    for (Frame& f : frames_) {
+        for (WorkerPool& w : f.workers)
+            if (w.pool != VK_NULL_HANDLE) vkDestroyCommandPool(device_, w.pool, nullptr);   // frees its secondaries
+        if (f.primaryPool != VK_NULL_HANDLE) vkDestroyCommandPool(device_, f.primaryPool, nullptr);
+    }
+    frames_.clear();
+    recorded_.clear();
+    threads_ = 0;
+    device_  = VK_NULL_HANDLE;
+}
+
+// =============================================================================
+// BEGIN FRAME — wholesale pool reset
+// =============================================================================
+VkCommandBuffer FrameRecorder::beginFrame(uint32_t frameIdx) noexcept
+{
+    if (frames_.empty()) return VK_NULL_HANDLE;
+    Frame& f = frames_[frameIdx % frames_.size()];
+
+    // Buffers keep their allocation; only the recorded contents go
+    vkResetCommandPool(device_, f.primaryPool, 0);
+    for (WorkerPool& w : f.workers) {
+        vkResetCommandPool(device_, w.pool, 0);
+        w.used = 0;
+    }
+
+    VkCommandBufferBeginInfo begin{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+    begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    if (vkBeginCommandBuffer(f.primary, &begin) != VK_SUCCESS) {
+        LOG_ERROR_CAT("RENDERER", "FrameRecorder: vkBeginCommandBuffer(primary) failed for frame {}", frameIdx);
+        return VK_NULL_HANDLE;
+    }
+    return f.primary;
+}
+
+VkCommandBuffer FrameRecorder::nextSecondary(WorkerPool& w) noexcept
+{
+    if (w.used == w.secondaries.size()) {
+        VkCommandBufferAllocateInfo alloc{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+        alloc.commandPool        = w.pool;
+        alloc.level              = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        alloc.commandBufferCount = 1;
+        VkCommandBuffer cb = VK_NULL_HANDLE;
+        if (vkAllocateCommandBuffers(device_, &alloc, &cb) != VK_SUCCESS) return VK_NULL_HANDLE;
+        w.secondaries.push_back(cb);
+    }
+    return w.secondaries[w.used++];
+}
+
+VkCommandBuffer FrameRecorder::recordPass(uint32_t frameIdx, uint32_t slot, const RecordPass& pass) noexcept
+{
+    TRACE_SCOPE("Render", pass.name);
+    Frame& f = frames_[frameIdx % frames_.size()];
+    VkCommandBuffer cb = nextSecondary(f.workers[slot % f.workers.size()]);
+    if (cb == VK_NULL_HANDLE) {
+        LOG_ERROR_CAT("RENDERER", "FrameRecorder: secondary allocation failed — pass '{}' goes inline", pass.name);
+        return VK_NULL_HANDLE;
+    }
+
+    // No render pass — every pass is compute, ray tracing or transfer
+    VkCommandBufferInheritanceInfo inheritance{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO };
+    VkCommandBufferBeginInfo begin{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+    begin.flags            = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    begin.pInheritanceInfo = &inheritance;
+    if (vkBeginCommandBuffer(cb, &begin) != VK_SUCCESS) {
+        LOG_ERROR_CAT("RENDERER", "FrameRecorder: vkBeginCommandBuffer failed — pass '{}' goes inline", pass.name);
+        return VK_NULL_HANDLE;
+    }
+    if (pass.record) pass.record(cb);
+    if (vkEndCommandBuffer(cb) != VK_SUCCESS) {
+        LOG_ERROR_CAT("RENDERER", "FrameRecorder: vkEndCommandBuffer failed — pass '{}' goes inline", pass.name);
+        return VK_NULL_HANDLE;
+    }
+    return cb;
+}
+
+// =============================================================================
+// RECORD — fan out, stitch in order
+// =============================================================================
+void FrameRecorder::record(VkCommandBuffer primary, uint32_t frameIdx, std::span<const RecordPass> passes) noexcept
+{
+    if (frames_.empty() || primary == VK_NULL_HANDLE || passes.empty()) return;
+
+    recorded_.assign(passes.size(), VK_NULL_HANDLE);
+
+    if (threads_ > 1 && passes.size() > 1) {
+        arena_.execute([&] {
+            tbb::parallel_for(size_t{0}, passes.size(), [&](size_t i) {
+                // Slot is stable for the task's whole run and unique among running threads
+                const int slot = tbb::this_task_arena::current_thread_index();
+                recorded_[i] = recordPass(frameIdx, static_cast<uint32_t>(std::max(slot, 0)), passes[i]);
+            });
+        });
+    } else {
+        for (size_t i = 0; i < passes.size(); ++i)
+            recorded_[i] = recordPass(frameIdx, 0, passes[i]);
+    }
+
+    // A pass without a secondary is recorded straight into the primary, in its
+    // place — runs of good secondaries around it still go in one call each
+    size_t run = 0;
+    for (size_t i = 0; i <= passes.size(); ++i) {
+        if (i < passes.size() && recorded_[i] != VK_NULL_HANDLE) continue;
+        if (i > run) vkCmdExecuteCommands(primary, static_cast<uint32_t>(i - run), recorded_.data() + run);
+        run = i + 1;
+        if (i == passes.size()) break;
+        LOG_WARN_CAT("RENDERER", "FrameRecorder: frame {} records pass '{}' inline on the primary", frameIdx, passes[i].name);
+        TRACE_SCOPE("Render", passes[i].name);
+        if (passes[i].record) passes[i].record(primary);
+    }
+}
+
+} // namespace RTX
@@ -0,0 +1,119 @@
+// src/engine/GLOBAL/FrameRing.cpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// FRAME RING — see FrameRing.hpp
+// =============================================================================
+
+#include "engine/GLOBAL/FrameRing.hpp"
+#include "engine/GLOBAL/RTXHandler.hpp"
+#include "engine/GLOBAL/logging.hpp"
+
+#include <algorithm>
+
+namespace RTX {
+
+namespace {
+[[nodiscard]] constexpr VkDeviceSize alignUp(VkDeviceSize v, VkDeviceSize a) noexcept {
+    return a <= 1 ? v : (v + a - 1) / a * a;
+}
+}
+
+bool FrameRing::init(VkPhysicalDevice physicalDevice, uint32_t framesInFlight, VkDeviceSize bytesPerFrame) noexcept
+{
+    destroy();
+    if (framesInFlight == 0 || bytesPerFrame == 0) return false;
+
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(physicalDevice, &props);
+    alignment_ = std::max<VkDeviceSize>({ 16,
+                                          props.limits.minUniformBufferOffsetAlignment,
+                                          props.limits.minStorageBufferOffsetAlignment });
+
+    regionSize_ = alignUp(bytesPerFrame, alignment_);
+    frames_     = framesInFlight;
+    const VkDeviceSize total = regionSize_ * frames_;
+    if (total > UINT32_MAX) {
+        LOG_ERROR_CAT("Memory", "FrameRing: {} B exceeds the 32-bit dynamic offset range", total);
+        return false;
+    }
+
+    try {
+        enc_ = UltraLowLevelBufferTracker::get().create(
+            total, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, "FrameRing");
+    } catch (const std::exception& e) {
+        LOG_ERROR_CAT("Memory", "FrameRing: buffer creation threw: {}", e.what());
+        enc_ = 0;
+    }
+    if (enc_ == 0) return false;
+
+    buffer_ = RAW_BUFFER(enc_);
+    base_   = static_cast<uint8_t*>(UltraLowLevelBufferTracker::get().map(enc_));
+    if (buffer_ == VK_NULL_HANDLE || base_ == nullptr) {
+        LOG_ERROR_CAT("Memory", "FrameRing: ring buffer is not host-mapped");
+        destroy();
+        return false;
+    }
+
+    regionBegin_ = head_ = 0;
+    highWater_   = 0;
+    overflowed_  = false;
+
+    LOG_SUCCESS_CAT("Memory", "FrameRing online — {} × {} KB regions, {} B alignment",
+                    frames_, regionSize_ / 1024, alignment_);
+    return true;
+}
+
+void FrameRing::destroy() noexcept
+{
+    if (enc_ != 0) {
+        LOG_DEBUG_CAT("Memory", "FrameRing released — peak {} of {} B per frame", highWater_, regionSize_);
+        UltraLowLevelBufferTracker::get().destroy(enc_);
+    }
+    enc_    = 0;
+    buffer_ = VK_NULL_HANDLE;
+    base_   = nullptr;
+    frames_ = 0;
+}
+
+void FrameRing::beginFrame(uint32_t frameIdx) noexcept
+{
+    if (!valid()) return;
+    highWater_   = std::max(highWater_, head_ - regionBegin_);
+    regionBegin_ = static_cast<VkDeviceSize>(frameIdx % frames_) * regionSize_;
+    head_        = regionBegin_;
+    overflowed_  = false;
+}
+
+void FrameRing::flush() const noexcept
+{
+    if (!valid() || head_ == regionBegin_) return;
+    UltraLowLevelBufferTracker::get().flush(enc_, regionBegin_, head_ - regionBegin_);
+}
+
+RingSlice FrameRing::allocate(VkDeviceSize size) noexcept
+{
+    if (!valid() || size == 0) return {};
+
+    const VkDeviceSize offset = alignUp(head_, alignment_);
+    if (offset + size > regionBegin_ + regionSize_) {
+        if (!overflowed_) {
+            LOG_BIN_ERROR_CAT("Memory", "FrameRing region exhausted — {} B requested, {} of {} B used this frame",
+                              size, head_ - regionBegin_, regionSize_);
+            overflowed_ = true;
+        }
+        return {};
+    }
+
+    head_ = offset + size;
+    return RingSlice{ .buffer = buffer_, .offset = offset, .size = size, .cpu = base_ + offset };
+}
+
+} // namespace RTX
@@ -0,0 +1,217 @@
+// src/engine/GLOBAL/GpuProfiler.cpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// GPU PASS PROFILER — see GpuProfiler.hpp
+// =============================================================================
+
+#include "engine/GLOBAL/GpuProfiler.hpp"
+#include "engine/GLOBAL/logging.hpp"
+#include "engine/GLOBAL/Trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <format>
+
+namespace {
+constexpr uint64_t SUMMARY_EVERY_FRAMES = 600;
+}
+
+void GpuProfiler::init(VkDevice device, VkPhysicalDevice physicalDevice, std::span<const uint32_t> queueFamilies,
+                       uint32_t framesInFlight, bool synchronization2) noexcept
+{
+    destroy();
+    if (!Options::Performance::ENABLE_GPU_TIMESTAMPS && !Options::Debug::SHOW_GPU_TIMESTAMPS) return;
+
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(physicalDevice, &props);
+
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, families.data());
+
+    uint32_t validBits = queueFamilies.empty() ? 0 : 64;
+    for (const uint32_t f : queueFamilies)
+        validBits = std::min(validBits, f < familyCount ? families[f].timestampValidBits : 0u);
+    if (validBits == 0 || !props.limits.timestampComputeAndGraphics || props.limits.timestampPeriod <= 0.0f) {
+        LOG_WARN_CAT("GPU", "GPU timestamps unsupported on {} (validBits={}, computeAndGraphics={}) — profiler disabled",
+                     props.deviceName, validBits, props.limits.timestampComputeAndGraphics);
+        return;
+    }
+
+    VkQueryPoolCreateInfo qpInfo{ .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+    qpInfo.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+    qpInfo.queryCount = framesInFlight * QUERIES_PER_FRAME;
+    if (vkCreateQueryPool(device, &qpInfo, nullptr, &pool_) != VK_SUCCESS) {
+        LOG_WARN_CAT("GPU", "vkCreateQueryPool(TIMESTAMP) failed — profiler disabled");
+        pool_ = VK_NULL_HANDLE;
+        return;
+    }
+
+    device_         = device;
+    framesInFlight_ = framesInFlight;
+    nsPerTick_      = props.limits.timestampPeriod;
+    tickMask_       = validBits >= 64 ? ~0ull : ((1ull << validBits) - 1);
+    sync2_          = synchronization2;
+    collected_      = 0;
+    slots_.assign(framesInFlight, FrameSlot{});
+    history_        = {};
+    results_.assign(QUERIES_PER_FRAME * 2, 0);
+
+    if (!csvPath().empty()) {
+        csv_ = std::fopen(csvPath().c_str(), "w");
+        if (csv_) {
+            std::fputs("frame", csv_);
+            for (const char* name : GPU_PASS_NAMES) std::fprintf(csv_, ",%s_ms", name);
+            std::fputc('\n', csv_);
+        } else {
+            LOG_WARN_CAT("GPU", "Cannot open GPU timing CSV {}", csvPath());
+        }
+    }
+
+    LOG_SUCCESS_CAT("GPU", "GPU profiler armed — {} queries, {:.3f} ns/tick, {} valid bits, {}",
+                    qpInfo.queryCount, nsPerTick_, validBits, sync2_ ? "vkCmdWriteTimestamp2" : "vkCmdWriteTimestamp");
+}
+
+void GpuProfiler::destroy() noexcept
+{
+    if (csv_) { std::fclose(csv_); csv_ = nullptr; }
+    if (pool_ != VK_NULL_HANDLE) {
+        vkDestroyQueryPool(device_, pool_, nullptr);
+        pool_ = VK_NULL_HANDLE;
+    }
+    slots_.clear();
+}
+
+void GpuProfiler::writeTimestamp(VkCommandBuffer cmd, uint32_t queryIndex, bool end) const noexcept
+{
+    if (sync2_) {
+        vkCmdWriteTimestamp2(cmd, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, pool_, queryIndex);
+    } else {
+        vkCmdWriteTimestamp(cmd, end ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                            pool_, queryIndex);
+    }
+}
+
+void GpuProfiler::beginFrame(VkCommandBuffer cmd, uint32_t frameIdx, uint64_t frameNumber) noexcept
+{
+    if (!enabled()) return;
+    vkCmdResetQueryPool(cmd, pool_, frameIdx * QUERIES_PER_FRAME, QUERIES_PER_FRAME);
+    FrameSlot& slot  = slots_[frameIdx];
+    slot.frameNumber = frameNumber;
+    slot.writtenMask = 0;
+    slot.pending     = true;
+}
+
+void GpuProfiler::begin(VkCommandBuffer cmd, uint32_t frameIdx, GpuPass pass) noexcept
+{
+    if (!enabled()) return;
+    writeTimestamp(cmd, query(frameIdx, pass, false), false);
+}
+
+void GpuProfiler::end(VkCommandBuffer cmd, uint32_t frameIdx, GpuPass pass) noexcept
+{
+    if (!enabled()) return;
+    writeTimestamp(cmd, query(frameIdx, pass, true), true);
+    // Passes record on worker threads — several end() calls can land at once
+    std::atomic_ref(slots_[frameIdx].writtenMask).fetch_or(1u << static_cast<uint32_t>(pass), std::memory_order_relaxed);
+}
+
+bool GpuProfiler::collect(uint32_t frameIdx) noexcept
+{
+    if (!enabled()) return false;
+    FrameSlot& slot = slots_[frameIdx];
+    if (!slot.pending) return false;
+    slot.pending = false;
+
+    // This slot's submit has completed — WITH_AVAILABILITY instead of WAIT so a
+    // lost query can never stall the frame
+    const VkResult r = vkGetQueryPoolResults(device_, pool_, frameIdx * QUERIES_PER_FRAME, QUERIES_PER_FRAME,
+                                             results_.size() * sizeof(uint64_t), results_.data(), 2 * sizeof(uint64_t),
+                                             VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+    if (r != VK_SUCCESS && r != VK_NOT_READY) return false;
+
+    std::array<double, PASS_COUNT> frameMs{};
+    frameMs.fill(-1.0);
+    uint64_t first = UINT64_MAX, last = 0;
+    for (uint32_t p = 0; p < PASS_COUNT; ++p) {
+        if (!(slot.writtenMask & (1u << p))) continue;
+        const uint64_t* b = &results_[(p * 2) * 2];
+        const uint64_t* e = &results_[(p * 2 + 1) * 2];
+        if (!b[1] || !e[1]) continue;
+
+        const uint64_t ticks = (e[0] - b[0]) & tickMask_;
+        const double ms = static_cast<double>(ticks) * nsPerTick_ * 1e-6;
+        frameMs[p] = ms;
+        first = std::min(first, b[0]);
+        last  = std::max(last, e[0]);
+
+        History& h = history_[p];
+        h.ms[h.head] = ms;
+        h.head = (h.head + 1) % HISTORY;
+        h.count = std::min(h.count + 1, HISTORY);
+        h.last = ms;
+
+        TRACE_COUNTER("GPU", GPU_PASS_NAMES[p], ms);
+    }
+
+    // First pass begin → last pass end, gaps between passes included
+    const bool measured = first <= last;
+    if (measured) lastFrameMs_ = static_cast<double>((last - first) & tickMask_) * nsPerTick_ * 1e-6;
+
+    if (csv_) {
+        std::fprintf(csv_, "%llu", static_cast<unsigned long long>(slot.frameNumber));
+        for (double ms : frameMs) {
+            if (ms >= 0.0) std::fprintf(csv_, ",%.4f", ms);
+            else           std::fputc(',', csv_);
+        }
+        std::fputc('\n', csv_);
+    }
+
+    if (Options::Debug::SHOW_GPU_TIMESTAMPS && ++collected_ % SUMMARY_EVERY_FRAMES == 0) logSummary();
+    return measured;
+}
+
+GpuProfiler::Stats GpuProfiler::stats(GpuPass pass) const
+{
+    const History& h = history_[static_cast<size_t>(pass)];
+    Stats s{};
+    if (h.count == 0) return s;
+
+    std::array<double, HISTORY> window{};
+    std::copy_n(h.ms.begin(), h.count, window.begin());
+    const auto first = window.begin();
+    const auto last  = window.begin() + h.count;
+
+    double sum = 0.0;
+    for (auto it = first; it != last; ++it) sum += *it;
+
+    s.lastMs  = h.last;
+    s.minMs   = *std::min_element(first, last);
+    s.avgMs   = sum / h.count;
+    s.samples = h.count;
+
+    const auto p99 = first + std::min<uint32_t>(h.count - 1, (h.count * 99) / 100);
+    std::nth_element(first, p99, last);
+    s.p99Ms = *p99;
+    return s;
+}
+
+void GpuProfiler::logSummary() const
+{
+    std::string line;
+    for (uint32_t p = 0; p < PASS_COUNT; ++p) {
+        const Stats s = stats(static_cast<GpuPass>(p));
+        if (s.samples == 0) continue;
+        std::format_to(std::back_inserter(line), "{} min {:.3f} / avg {:.3f} / p99 {:.3f} ms  ",
+                       GPU_PASS_NAMES[p], s.minMs, s.avgMs, s.p99Ms);
+    }
+    if (!line.empty()) LOG_PERF_CAT("GPU", "{}", line);
+}
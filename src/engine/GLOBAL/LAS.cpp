@@ -13,6 +13,11 @@
 #include "engine/GLOBAL/LAS.hpp"
 #include "engine/GLOBAL/VulkanCore.hpp"
 #include "engine/GLOBAL/RTXHandler.hpp"
+#include "engine/GLOBAL/Trace.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
 
 using namespace RTX;
 
@@ -21,7 +26,16 @@ using namespace RTX;
 // =============================================================================
 VulkanAccel::VulkanAccel(VkDevice)
 {
-    LOG_SUCCESS_CAT("VulkanAccel", "RTX Acceleration System initialized — ready for BLAS/TLAS construction");
+    if (g_ctx().physicalDevice() != VK_NULL_HANDLE) {
+        VkPhysicalDeviceAccelerationStructurePropertiesKHR asProps{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_PROPERTIES_KHR };
+        VkPhysicalDeviceProperties2 props2{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2, &asProps };
+        vkGetPhysicalDeviceProperties2(g_ctx().physicalDevice(), &props2);
+        if (asProps.minAccelerationStructureScratchOffsetAlignment)
+            scratchAlignment_ = asProps.minAccelerationStructureScratchOffsetAlignment;
+    }
+    scratch_.setAlignment(scratchAlignment_);
+    LOG_SUCCESS_CAT("VulkanAccel", "RTX Acceleration System initialized — ready for BLAS/TLAS construction — scratch alignment {}B",
+                    scratchAlignment_);
 }
 
 // =============================================================================
@@ -29,47 +43,56 @@ VulkanAccel::VulkanAccel(VkDevice)
 // =============================================================================
 void VulkanAccel::destroy(BLAS& blas)
 {
-    if (blas.as)    g_ctx().vkDestroyAccelerationStructureKHR()(g_ctx().device(), blas.as, nullptr);
-    if (blas.buffer) vkDestroyBuffer(g_ctx().device(), blas.buffer, nullptr);
-    if (blas.memory) vkFreeMemory(g_ctx().device(), blas.memory, nullptr);
+    // Retired, not destroyed — a frame in flight may still trace against it.
+    // Storage lives in a shared DeviceHeap block; BUFFER_DESTROY retires it
+    // behind the AS (same serial, FIFO). No query pool to free: createBLASBatch
+    // consumes the batch's shared one before any BLAS leaves it.
+    if (blas.as) {
+        RTX::retireQueue().retire([as = blas.as]() {
+            g_ctx().vkDestroyAccelerationStructureKHR()(g_ctx().device(), as, nullptr);
+        });
+    }
+    BUFFER_DESTROY(blas.storageEnc);
     blas = {};
 }
 
 void VulkanAccel::destroy(TLAS& tlas)
 {
-    if (tlas.as)              g_ctx().vkDestroyAccelerationStructureKHR()(g_ctx().device(), tlas.as, nullptr);
-    if (tlas.buffer)          vkDestroyBuffer(g_ctx().device(), tlas.buffer, nullptr);
-    if (tlas.memory)          vkFreeMemory(g_ctx().device(), tlas.memory, nullptr);
-    if (tlas.instanceBuffer)  vkDestroyBuffer(g_ctx().device(), tlas.instanceBuffer, nullptr);
-    if (tlas.instanceMemory)  vkFreeMemory(g_ctx().device(), tlas.instanceMemory, nullptr);
+    if (tlas.as) {
+        RTX::retireQueue().retire([as = tlas.as]() {
+            g_ctx().vkDestroyAccelerationStructureKHR()(g_ctx().device(), as, nullptr);
+        });
+    }
+    BUFFER_DESTROY(tlas.storageEnc);
+    BUFFER_DESTROY(tlas.instanceEnc);
     tlas = {};
 }
 
 // =============================================================================
-// BLAS Creation
+// Geometry description — shared by the initial build and every refit
 // =============================================================================
-VulkanAccel::BLAS VulkanAccel::createBLAS(
-    const std::vector<AccelGeometry>& geometries,
-    VkBuildAccelerationStructureFlagsKHR flags,
-    VkCommandBuffer externalCmd,
-    std::string_view name)
-{
-    BLAS blas{};
-    blas.name = name;
+namespace {
 
-    uint32_t primCount = 0;
-    std::vector<VkAccelerationStructureGeometryKHR> vkGeoms;
+struct BLASInput {
+    std::vector<VkAccelerationStructureGeometryKHR>       geoms;
     std::vector<VkAccelerationStructureBuildRangeInfoKHR> ranges;
-    vkGeoms.reserve(geometries.size());
-    ranges.reserve(geometries.size());
+    std::vector<uint32_t>                                 maxPrims;    // per geometry, for the size query
+    uint32_t                                              primCount = 0;
+};
+
+bool describeBLAS(const std::vector<AccelGeometry>& geometries, BLASInput& in)
+{
+    in.geoms.reserve(geometries.size());
+    in.ranges.reserve(geometries.size());
+    in.maxPrims.reserve(geometries.size());
 
     for (const auto& g : geometries) {
         const uint32_t triCount = g.indexCount / 3;
-        primCount += triCount;
+        in.primCount += triCount;
 
         if (g.vertexData.deviceAddress == 0 || g.indexData.deviceAddress == 0) {
             LOG_FATAL_CAT("VulkanAccel", "Invalid device address in geometry");
-            return {};
+            return false;
         }
 
         VkAccelerationStructureGeometryKHR geom{ VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR };
@@ -85,75 +108,308 @@ VulkanAccel::BLAS VulkanAccel::createBLAS(
         geom.geometry.triangles.indexType = g.indexType;
         geom.geometry.triangles.transformData = g.transformData;
 
-        vkGeoms.push_back(geom);
-        ranges.push_back({ triCount, 0, 0, 0 });
-    }
-
-    if (primCount == 0) {
-        LOG_FATAL_CAT("VulkanAccel", "No triangles submitted for BLAS");
-        return blas;
+        in.geoms.push_back(geom);
+        in.ranges.push_back({ triCount, 0, 0, 0 });
+        in.maxPrims.push_back(triCount);
     }
+    return true;
+}
 
-    VkAccelerationStructureBuildGeometryInfoKHR buildInfo{ VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR };
-    buildInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
-    buildInfo.flags = flags | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR;
-    buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
-    buildInfo.geometryCount = static_cast<uint32_t>(vkGeoms.size());
-    buildInfo.pGeometries = vkGeoms.data();
+// Compaction: the compacted size is only known once the build has run — query
+// after the builds, read back in compactBLAS(). One pool for everything recorded
+// together; a BLAS without ALLOW_COMPACTION gets no query.
+void recordCompactQueries(VkCommandBuffer cmd, std::span<VulkanAccel::BLAS* const> blases)
+{
+    if (!g_ctx().vkCmdCopyAccelerationStructureKHR()) return;
+
+    std::vector<VulkanAccel::BLAS*> compactable;
+    std::vector<VkAccelerationStructureKHR> structures;
+    for (VulkanAccel::BLAS* blas : blases)
+        if (blas->as && (blas->flags & VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR)) {
+            compactable.push_back(blas);
+            structures.push_back(blas->as);
+        }
+    if (compactable.empty()) return;
 
-    VkAccelerationStructureBuildSizesInfoKHR sizes{ VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR };
-    g_ctx().vkGetAccelerationStructureBuildSizesKHR()(
-        g_ctx().device(),
-        VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR,
-        &buildInfo,
-        &primCount,
-        &sizes);
+    const VkQueryPool pool = recordCompactedSizes(g_ctx().device(), cmd,
+        g_ctx().vkCmdWriteAccelerationStructuresPropertiesKHR(), structures);
+    if (pool == VK_NULL_HANDLE) {
+        LOG_WARN_CAT("VulkanAccel", "{} BLAS — compaction query pool unavailable, keeping full size", compactable.size());
+        return;
+    }
+    for (uint32_t i = 0; i < compactable.size(); ++i) {
+        compactable[i]->compactQuery = pool;
+        compactable[i]->compactIndex = i;
+    }
+}
 
+// Storage buffer + AS object of the given size; 0 (and as untouched) on failure
+uint64_t allocBLAS(VkDeviceSize size, const std::string& tag, VkAccelerationStructureKHR& as)
+{
     uint64_t storage = 0;
-    BUFFER_CREATE(storage, sizes.accelerationStructureSize,
+    BUFFER_CREATE(storage, size,
         VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-        std::string(name) + "_BLAS");
+        tag);
 
     VkAccelerationStructureCreateInfoKHR createInfo{ VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR };
     createInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
-    createInfo.size = sizes.accelerationStructureSize;
+    createInfo.size = size;
     createInfo.buffer = RAW_BUFFER(storage);
 
-    VK_CHECK(g_ctx().vkCreateAccelerationStructureKHR()(g_ctx().device(), &createInfo, nullptr, &blas.as),
-             "Failed to create BLAS");
+    if (g_ctx().vkCreateAccelerationStructureKHR()(g_ctx().device(), &createInfo, nullptr, &as) != VK_SUCCESS) {
+        LOG_ERROR_CAT("VulkanAccel", "AS creation failed for \"{}\" ({} bytes)", tag, size);
+        BUFFER_DESTROY(storage);
+        return 0;
+    }
+    return storage;
+}
+
+VkDeviceAddress bufferAddress(uint64_t handle)
+{
+    VkBufferDeviceAddressInfo info{ VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO, nullptr, RAW_BUFFER(handle) };
+    return vkGetBufferDeviceAddress(g_ctx().device(), &info);
+}
 
-    uint64_t scratch = 0;
-    BUFFER_CREATE(scratch, sizes.buildScratchSize,
+VkDeviceAddress asAddress(VkAccelerationStructureKHR as)
+{
+    VkAccelerationStructureDeviceAddressInfoKHR info{
+        VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR,
+        nullptr,
+        as
+    };
+    return g_ctx().vkGetAccelerationStructureDeviceAddressKHR()(g_ctx().device(), &info);
+}
+
+// PREFER_FAST_TRACE + caller flags; static geometry is compacted unless the caller asked for refits
+VkBuildAccelerationStructureFlagsKHR sceneBLASFlags(VkBuildAccelerationStructureFlagsKHR extra) noexcept
+{
+    VkBuildAccelerationStructureFlagsKHR flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR | extra;
+    if (Options::LAS::COMPACT_BLAS && !(extra & VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR))
+        flags |= VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR;
+    return flags;
+}
+
+// World-space AABB of the instance origins — what the TLAS refit policy watches
+void instanceBounds(const InstanceList& instances, glm::vec3& mn, glm::vec3& mx)
+{
+    mn = glm::vec3( std::numeric_limits<float>::max());
+    mx = glm::vec3(-std::numeric_limits<float>::max());
+    for (uint32_t i = 0; i < instances.size(); ++i) {
+        const auto& m = instances[i].transform.matrix;
+        const glm::vec3 origin(m[0][3], m[1][3], m[2][3]);
+        mn = glm::min(mn, origin);
+        mx = glm::max(mx, origin);
+    }
+    if (instances.size() == 0) mn = mx = glm::vec3(0.0f);
+}
+
+float halfArea(const glm::vec3& mn, const glm::vec3& mx) noexcept
+{
+    const glm::vec3 d = glm::max(mx - mn, glm::vec3(0.0f));
+    return d.x * d.y + d.y * d.z + d.z * d.x;
+}
+
+} // namespace
+
+// =============================================================================
+// Scratch pool
+// =============================================================================
+VkDeviceAddress ScratchPool::acquire(VkDeviceSize size)
+{
+    if (!sizing_.request(size)) return base_;
+
+    // Retired — builds already recorded against the old buffer keep it until their frame completes
+    BUFFER_DESTROY(buffer_);
+    const VkDeviceSize align = sizing_.alignment();
+    BUFFER_CREATE(buffer_, sizing_.capacity() + align,   // slack to align the base address
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-        std::string(name) + "_scratch");
+        "LAS_scratch_pool");
+    base_ = (bufferAddress(buffer_) + align - 1) & ~(align - 1);
+    LOG_INFO_CAT("VulkanAccel", "Scratch pool grown to {} bytes (grow #{})", sizing_.capacity(), sizing_.grows());
+    return base_;
+}
 
-    VkBufferDeviceAddressInfo scratchAddrInfo{ VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO, nullptr, RAW_BUFFER(scratch) };
-    buildInfo.scratchData.deviceAddress = vkGetBufferDeviceAddress(g_ctx().device(), &scratchAddrInfo);
-    buildInfo.dstAccelerationStructure = blas.as;
+void ScratchPool::tick()
+{
+    if (!sizing_.tick(Options::LAS::SCRATCH_IDLE_FRAMES)) return;
+    LOG_INFO_CAT("VulkanAccel", "Scratch pool idle for {} frames — releasing {} bytes", sizing_.idle(), sizing_.capacity());
+    release();
+}
 
-    VkCommandBuffer cmd = externalCmd ? externalCmd : beginOneTime(g_ctx().commandPool_);
-    const VkAccelerationStructureBuildRangeInfoKHR* pRanges[] = { ranges.data() };
-    g_ctx().vkCmdBuildAccelerationStructuresKHR()(cmd, 1, &buildInfo, pRanges);
+void ScratchPool::release()
+{
+    BUFFER_DESTROY(buffer_);
+    base_ = 0;
+    sizing_.released();
+}
 
-    if (!externalCmd)
-        endSingleTimeCommandsAsync(cmd, g_ctx().graphicsQueue_, g_ctx().commandPool_);
+// =============================================================================
+// Refit policy
+// =============================================================================
+bool RefitPolicy::needsRebuild(const glm::vec3& mn, const glm::vec3& mx) const noexcept
+{
+    if (!primed || refits >= Options::LAS::MAX_REFITS) return true;
+    // Growth against the built bounds — a flat or point-like build only rebuilds once it gains area
+    const float built = halfArea(builtMin, builtMax);
+    const float now   = halfArea(glm::min(builtMin, mn), glm::max(builtMax, mx));
+    return now > built * Options::LAS::REFIT_GROWTH_LIMIT;
+}
 
-    VkAccelerationStructureDeviceAddressInfoKHR addrInfo{
-        VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR,
-        nullptr,
-        blas.as
+// =============================================================================
+// BLAS Compaction
+// =============================================================================
+uint32_t VulkanAccel::compactBLAS(std::span<BLAS> blases, VkCommandPool pool, VkQueue queue)
+{
+    struct Pending {
+        BLAS*                      blas;
+        VkAccelerationStructureKHR as;
+        uint64_t                   storage;
+        VkDeviceSize               size;
     };
-    blas.address = g_ctx().vkGetAccelerationStructureDeviceAddressKHR()(g_ctx().device(), &addrInfo);
+    std::vector<Pending> pending;
+
+    VkDevice dev = g_ctx().device();
+    std::vector<VkQueryPool> pools;   // a batch's BLAS share one — destroyed once, after every read
+    for (BLAS& blas : blases) {
+        if (blas.compactQuery == VK_NULL_HANDLE) continue;
+        const VkQueryPool query = std::exchange(blas.compactQuery, VK_NULL_HANDLE);
+        if (std::find(pools.begin(), pools.end(), query) == pools.end()) pools.push_back(query);
+        if (blas.as == VK_NULL_HANDLE) continue;
+
+        VkDeviceSize compacted = 0;
+        const VkResult r = vkGetQueryPoolResults(dev, query, blas.compactIndex, 1, sizeof(compacted), &compacted,
+                                                 sizeof(compacted), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+
+        if (r != VK_SUCCESS || compacted == 0 || compacted >= blas.size) {
+            LOG_INFO_CAT("VulkanAccel", "BLAS \"{}\" not compacted — {} bytes, query {} ({})",
+                         blas.name, blas.size, compacted, static_cast<int>(r));
+            continue;
+        }
 
-    blas.buffer = RAW_BUFFER(storage);
-    blas.memory = BUFFER_MEMORY(storage);
-    blas.size   = sizes.accelerationStructureSize;
-    BUFFER_DESTROY(scratch);
+        VkAccelerationStructureKHR as = VK_NULL_HANDLE;
+        const uint64_t storage = allocBLAS(compacted, blas.name + "_BLAS_compact", as);
+        if (!storage) continue;   // keeps full size
+        pending.push_back({ &blas, as, storage, compacted });
+    }
+    for (VkQueryPool query : pools) vkDestroyQueryPool(dev, query, nullptr);
+    if (pending.empty()) return 0;
 
-    LOG_SUCCESS_CAT("VulkanAccel", "BLAS \"{}\" created — {} triangles — address 0x{:016X}", name, primCount, blas.address);
-    return blas;
+    VkCommandBuffer cmd = beginOneTime(pool);
+    for (const Pending& p : pending) {
+        VkCopyAccelerationStructureInfoKHR copy{ VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_INFO_KHR };
+        copy.src  = p.blas->as;
+        copy.dst  = p.as;
+        copy.mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR;
+        g_ctx().vkCmdCopyAccelerationStructureKHR()(cmd, &copy);
+    }
+    endSingleTimeCommandsAsync(cmd, queue, pool);   // this submit's fence — the originals retire, no idle
+
+    VkDeviceSize totalBefore = 0, totalAfter = 0;
+    for (const Pending& p : pending) {
+        BLAS& blas = *p.blas;
+        const VkDeviceSize before = blas.size;
+
+        BLAS full{};
+        full.as         = blas.as;
+        full.storageEnc = blas.storageEnc;
+        destroy(full);
+
+        blas.as         = p.as;
+        blas.buffer     = RAW_BUFFER(p.storage);
+        blas.storageEnc = p.storage;
+        blas.size       = p.size;
+        blas.address    = asAddress(p.as);
+
+        totalBefore += before;
+        totalAfter  += p.size;
+        LOG_SUCCESS_CAT("VulkanAccel", "BLAS \"{}\" compacted — {} → {} bytes ({:.1f}% saved) — address 0x{:016X}",
+                        blas.name, before, p.size,
+                        100.0 * static_cast<double>(before - p.size) / static_cast<double>(before), blas.address);
+    }
+    if (pending.size() > 1)
+        LOG_SUCCESS_CAT("VulkanAccel", "{} BLAS compacted — {} → {} bytes total", pending.size(), totalBefore, totalAfter);
+    return static_cast<uint32_t>(pending.size());
+}
+
+// =============================================================================
+// Batched BLAS Creation
+// =============================================================================
+std::vector<VulkanAccel::BLAS> VulkanAccel::createBLASBatch(std::span<const BLASBuild> builds,
+                                                            VkCommandPool pool, VkQueue queue)
+{
+    std::vector<BLAS> out(builds.size());
+    std::vector<BLASInput> inputs(builds.size());    // sized up front — build infos point into it
+    std::vector<VkAccelerationStructureBuildGeometryInfoKHR> infos;
+    std::vector<const VkAccelerationStructureBuildRangeInfoKHR*> ranges;
+    std::vector<VkDeviceSize> scratchSizes;
+    std::vector<uint32_t> live;                       // out[] index of each recorded build
+    infos.reserve(builds.size());
+    ranges.reserve(builds.size());
+    scratchSizes.reserve(builds.size());
+    live.reserve(builds.size());
+
+    // ── Size and allocate everything first — the scratch plan needs every size
+    for (uint32_t i = 0; i < builds.size(); ++i) {
+        BLAS& blas = out[i];
+        BLASInput& in = inputs[i];
+        blas.name = builds[i].name;
+        if (!describeBLAS(builds[i].geometries, in) || in.primCount == 0) {
+            LOG_ERROR_CAT("VulkanAccel", "BLAS \"{}\" skipped — no valid triangles", blas.name);
+            continue;
+        }
+
+        VkAccelerationStructureBuildGeometryInfoKHR buildInfo{ VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR };
+        buildInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+        buildInfo.flags = builds[i].flags;
+        buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+        buildInfo.geometryCount = static_cast<uint32_t>(in.geoms.size());
+        buildInfo.pGeometries = in.geoms.data();
+
+        VkAccelerationStructureBuildSizesInfoKHR sizes{ VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR };
+        g_ctx().vkGetAccelerationStructureBuildSizesKHR()(g_ctx().device(),
+            VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR, &buildInfo, in.maxPrims.data(), &sizes);
+
+        blas.storageEnc = allocBLAS(sizes.accelerationStructureSize, blas.name + "_BLAS", blas.as);
+        if (!blas.storageEnc) continue;
+
+        buildInfo.dstAccelerationStructure = blas.as;
+        blas.buffer        = RAW_BUFFER(blas.storageEnc);
+        blas.size          = sizes.accelerationStructureSize;
+        blas.geometries    = builds[i].geometries;
+        blas.flags         = builds[i].flags;
+        blas.updateScratch = sizes.updateScratchSize;
+        blas.buildScratch  = sizes.buildScratchSize;
+
+        infos.push_back(buildInfo);
+        ranges.push_back(in.ranges.data());
+        scratchSizes.push_back(sizes.buildScratchSize);
+        live.push_back(i);
+    }
+    if (live.empty()) return out;
+
+    // ── One arena, reused batch to batch
+    const VkDeviceSize budget = static_cast<VkDeviceSize>(Options::LAS::BATCH_SCRATCH_BUDGET_MB) << 20;
+    const ScratchPlan plan = ScratchPlan::pack(scratchSizes, scratchAlignment_, budget);
+
+    VkCommandBuffer cmd = beginOneTime(pool);
+    recordBuildBatches(cmd, g_ctx().vkCmdBuildAccelerationStructuresKHR(), plan, scratch_.acquire(plan.arenaSize), infos, ranges);
+
+    accelBuildBarrier(cmd);
+    std::vector<BLAS*> built;
+    built.reserve(live.size());
+    for (uint32_t i : live) built.push_back(&out[i]);
+    recordCompactQueries(cmd, built);
+    endSingleTimeCommandsAsync(cmd, queue, pool);
+
+    for (uint32_t i : live) out[i].address = asAddress(out[i].as);
+
+    LOG_SUCCESS_CAT("VulkanAccel", "BLAS batch — {} of {} built in {} batch(es) — scratch arena {} bytes",
+                    live.size(), builds.size(), plan.batchCount(), plan.arenaSize);
+
+    compactBLAS(out, pool, queue);
+    return out;
 }
 
 // =============================================================================
@@ -186,8 +442,29 @@ VulkanAccel::TLAS VulkanAccel::createTLAS(
     std::memcpy(mapped, instances.data(), instanceDataSize);
     BUFFER_UNMAP(instBuf);
 
-    VkBufferDeviceAddressInfo instAddrInfo{ VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO, nullptr, RAW_BUFFER(instBuf) };
-    const VkDeviceAddress instAddr = vkGetBufferDeviceAddress(g_ctx().device(), &instAddrInfo);
+    tlas = createTLAS(bufferAddress(instBuf), count, flags, externalCmd, name);
+    if (!tlas.as) {
+        BUFFER_DESTROY(instBuf);
+        return tlas;
+    }
+    tlas.instanceBuffer = RAW_BUFFER(instBuf);
+    tlas.instanceEnc = instBuf;
+    return tlas;
+}
+
+VulkanAccel::TLAS VulkanAccel::createTLAS(
+    VkDeviceAddress instAddr,
+    uint32_t count,
+    VkBuildAccelerationStructureFlagsKHR flags,
+    VkCommandBuffer externalCmd,
+    std::string_view name)
+{
+    TLAS tlas{};
+    tlas.name = name;
+    if (count == 0 || instAddr == 0) {
+        LOG_WARN_CAT("VulkanAccel", "TLAS created with zero instances");
+        return tlas;
+    }
 
     VkAccelerationStructureGeometryKHR geom{ VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR };
     geom.geometryType = VK_GEOMETRY_TYPE_INSTANCES_KHR;
@@ -224,17 +501,11 @@ VulkanAccel::TLAS VulkanAccel::createTLAS(
     VK_CHECK(g_ctx().vkCreateAccelerationStructureKHR()(g_ctx().device(), &createInfo, nullptr, &tlas.as),
              "Failed to create TLAS");
 
-    uint64_t scratch = 0;
-    BUFFER_CREATE(scratch, sizes.buildScratchSize,
-        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-        std::string(name) + "_scratch");
-
-    VkBufferDeviceAddressInfo scratchAddrInfo{ VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO, nullptr, RAW_BUFFER(scratch) };
-    buildInfo.scratchData.deviceAddress = vkGetBufferDeviceAddress(g_ctx().device(), &scratchAddrInfo);
+    buildInfo.scratchData.deviceAddress = scratch_.acquire(sizes.buildScratchSize);
     buildInfo.dstAccelerationStructure = tlas.as;
 
     VkCommandBuffer cmd = externalCmd ? externalCmd : beginOneTime(g_ctx().commandPool_);
+    accelBuildBarrier(cmd);   // pooled scratch — after whatever build used it last
     VkAccelerationStructureBuildRangeInfoKHR range{ count, 0, 0, 0 };
     const VkAccelerationStructureBuildRangeInfoKHR* pRanges[] = { &range };
     g_ctx().vkCmdBuildAccelerationStructuresKHR()(cmd, 1, &buildInfo, pRanges);
@@ -250,16 +521,117 @@ VulkanAccel::TLAS VulkanAccel::createTLAS(
     tlas.address = g_ctx().vkGetAccelerationStructureDeviceAddressKHR()(g_ctx().device(), &addrInfo);
 
     tlas.buffer = RAW_BUFFER(storage);
-    tlas.memory = BUFFER_MEMORY(storage);
-    tlas.instanceBuffer = RAW_BUFFER(instBuf);
-    tlas.instanceMemory = BUFFER_MEMORY(instBuf);
+    tlas.storageEnc = storage;
     tlas.size = sizes.accelerationStructureSize;
-    BUFFER_DESTROY(scratch);
+    tlas.instanceAddress = instAddr;
+    tlas.instanceCount   = count;
+    tlas.flags           = flags;
+    tlas.updateScratch   = sizes.updateScratchSize;
+    tlas.buildScratch    = sizes.buildScratchSize;
 
     LOG_SUCCESS_CAT("VulkanAccel", "TLAS \"{}\" created — {} instances — address 0x{:016X}", name, count, tlas.address);
     return tlas;
 }
 
+bool VulkanAccel::rebuildTLAS(TLAS& tlas, VkDeviceAddress instanceData, uint32_t count,
+                              VkBuildAccelerationStructureFlagsKHR flags, VkCommandBuffer cmd)
+{
+    if (!tlas.as || count == 0 || instanceData == 0) return false;
+
+    VkAccelerationStructureGeometryKHR geom{ VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR };
+    geom.geometryType = VK_GEOMETRY_TYPE_INSTANCES_KHR;
+    geom.geometry.instances.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR;
+    geom.geometry.instances.arrayOfPointers = VK_FALSE;
+    geom.geometry.instances.data.deviceAddress = instanceData;
+
+    VkAccelerationStructureBuildGeometryInfoKHR buildInfo{ VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR };
+    buildInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR;
+    buildInfo.flags = flags;
+    buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+    buildInfo.geometryCount = 1;
+    buildInfo.pGeometries = &geom;
+
+    VkAccelerationStructureBuildSizesInfoKHR sizes{ VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR };
+    g_ctx().vkGetAccelerationStructureBuildSizesKHR()(
+        g_ctx().device(), VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR, &buildInfo, &count, &sizes);
+    if (sizes.accelerationStructureSize > tlas.size) return false;
+
+    buildInfo.dstAccelerationStructure = tlas.as;
+    buildInfo.scratchData.deviceAddress = scratch_.acquire(sizes.buildScratchSize);
+
+    // Frames already submitted may still trace it — same queue, so a barrier orders the overwrite
+    VkMemoryBarrier b{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    b.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+    b.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+    vkCmdPipelineBarrier(cmd,
+        VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+        VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+        0, 1, &b, 0, nullptr, 0, nullptr);
+
+    VkAccelerationStructureBuildRangeInfoKHR range{ count, 0, 0, 0 };
+    const VkAccelerationStructureBuildRangeInfoKHR* pRanges[] = { &range };
+    g_ctx().vkCmdBuildAccelerationStructuresKHR()(cmd, 1, &buildInfo, pRanges);
+
+    tlas.instanceAddress = instanceData;
+    tlas.instanceCount   = count;
+    tlas.flags           = flags;
+    tlas.updateScratch   = sizes.updateScratchSize;
+    tlas.buildScratch    = sizes.buildScratchSize;
+    return true;
+}
+
+// =============================================================================
+// In-place refits
+// =============================================================================
+bool VulkanAccel::refitBLAS(const BLAS& blas, VkCommandBuffer cmd, VkDeviceAddress scratch, bool rebuild)
+{
+    if (!blas.as || !(blas.flags & VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR)) return false;
+
+    BLASInput in;
+    if (!describeBLAS(blas.geometries, in) || in.primCount == 0) return false;
+
+    VkAccelerationStructureBuildGeometryInfoKHR buildInfo{ VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR };
+    buildInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+    buildInfo.flags = blas.flags;
+    buildInfo.mode = rebuild ? VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR : VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR;
+    buildInfo.srcAccelerationStructure = rebuild ? VK_NULL_HANDLE : blas.as;
+    buildInfo.dstAccelerationStructure = blas.as;
+    buildInfo.geometryCount = static_cast<uint32_t>(in.geoms.size());
+    buildInfo.pGeometries = in.geoms.data();
+    buildInfo.scratchData.deviceAddress = scratch;
+
+    const VkAccelerationStructureBuildRangeInfoKHR* pRanges[] = { in.ranges.data() };
+    g_ctx().vkCmdBuildAccelerationStructuresKHR()(cmd, 1, &buildInfo, pRanges);
+    return true;
+}
+
+bool VulkanAccel::refitTLAS(const TLAS& tlas, VkDeviceAddress instanceData,
+                            VkCommandBuffer cmd, VkDeviceAddress scratch, bool rebuild)
+{
+    if (!tlas.as || !instanceData || !(tlas.flags & VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR)) return false;
+
+    VkAccelerationStructureGeometryKHR geom{ VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR };
+    geom.geometryType = VK_GEOMETRY_TYPE_INSTANCES_KHR;
+    geom.geometry.instances.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR;
+    geom.geometry.instances.arrayOfPointers = VK_FALSE;
+    geom.geometry.instances.data.deviceAddress = instanceData;
+
+    VkAccelerationStructureBuildGeometryInfoKHR buildInfo{ VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR };
+    buildInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR;
+    buildInfo.flags = tlas.flags;
+    buildInfo.mode = rebuild ? VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR : VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR;
+    buildInfo.srcAccelerationStructure = rebuild ? VK_NULL_HANDLE : tlas.as;
+    buildInfo.dstAccelerationStructure = tlas.as;
+    buildInfo.geometryCount = 1;
+    buildInfo.pGeometries = &geom;
+    buildInfo.scratchData.deviceAddress = scratch;
+
+    VkAccelerationStructureBuildRangeInfoKHR range{ tlas.instanceCount, 0, 0, 0 };
+    const VkAccelerationStructureBuildRangeInfoKHR* pRanges[] = { &range };
+    g_ctx().vkCmdBuildAccelerationStructuresKHR()(cmd, 1, &buildInfo, pRanges);
+    return true;
+}
+
 // =============================================================================
 // LAS Wrapper Methods
 // =============================================================================
@@ -270,49 +642,251 @@ void LAS::buildBLAS(VkCommandPool pool,
                     uint32_t indexCount,
                     VkBuildAccelerationStructureFlagsKHR extraFlags)
 {
-    AccelGeometry g{};
-    g.vertexFormat = VK_FORMAT_R32G32B32_SFLOAT;
-    g.vertexStride = 44;
-    g.vertexCount = vertexCount;
-
-    VkBufferDeviceAddressInfo info{ VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO, nullptr, RAW_BUFFER(vertexBufferObf) };
-    g.vertexData.deviceAddress = vkGetBufferDeviceAddress(g_ctx().device(), &info);
+    TRACE_SCOPE("LAS", "buildBLAS");
+    const GeometryDesc scene{ .vertexBuffer = vertexBufferObf, .indexBuffer = indexBufferObf,
+                              .vertexCount = vertexCount, .indexCount = indexCount,
+                              .flags = extraFlags, .name = "Scene_BLAS" };
+    std::vector<VulkanAccel::BLAS> built = createBatch(pool, { &scene, 1 });
+    if (built.empty() || !built[0].isValid()) {
+        LOG_ERROR_CAT("LAS", "Scene BLAS build failed — keeping the current one");
+        if (!built.empty()) accel_->destroy(built[0]);
+        return;
+    }
+    if (blas_.as) accel_->destroy(blas_);     // retired — frames in flight keep tracing the old one
+    blas_ = std::move(built[0]);
+    blasRefit_.reset();                        // bounds unknown until the first updateBLAS()
+    blasMoved_ = false;                        // the build already holds the current positions
+    ++generation_;
+}
 
-    info.buffer = RAW_BUFFER(indexBufferObf);
-    g.indexData.deviceAddress = vkGetBufferDeviceAddress(g_ctx().device(), &info);
+uint32_t LAS::buildBLASBatch(VkCommandPool pool, std::span<const GeometryDesc> meshes)
+{
+    TRACE_SCOPE("LAS", "buildBLASBatch");
+    TRACE_COUNTER("LAS", "blasBatch", meshes.size());
+    const uint32_t first = static_cast<uint32_t>(meshBLAS_.size());
+    std::vector<VulkanAccel::BLAS> built = createBatch(pool, meshes);
+    if (built.empty()) return first;
+    meshBLAS_.insert(meshBLAS_.end(), std::make_move_iterator(built.begin()), std::make_move_iterator(built.end()));
+    ++generation_;
+    return first;
+}
 
-    g.indexType = VK_INDEX_TYPE_UINT32;
-    g.indexCount = indexCount;
+std::vector<VulkanAccel::BLAS> LAS::createBatch(VkCommandPool pool, std::span<const GeometryDesc> meshes)
+{
+    if (!accel_ || meshes.empty()) return {};
+
+    std::vector<VulkanAccel::BLASBuild> builds;
+    builds.reserve(meshes.size());
+    for (const GeometryDesc& m : meshes) {
+        AccelGeometry g{};
+        g.vertexFormat = VK_FORMAT_R32G32B32_SFLOAT;
+        g.vertexStride = m.vertexStride;
+        g.vertexCount  = m.vertexCount;
+        g.vertexData.deviceAddress = bufferAddress(m.vertexBuffer);
+        g.indexData.deviceAddress  = bufferAddress(m.indexBuffer);
+        g.indexType    = VK_INDEX_TYPE_UINT32;
+        g.indexCount   = m.indexCount;
+        builds.push_back({ { g }, sceneBLASFlags(m.flags), m.name });
+    }
+    return accel_->createBLASBatch(builds, pool, g_ctx().graphicsQueue_);
+}
 
-    VkCommandBuffer cmd = beginOneTime(pool);
-    blas_ = accel_->createBLAS({g}, VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR | extraFlags, cmd, "Scene_BLAS");
-    endSingleTimeCommandsAsync(cmd, g_ctx().graphicsQueue_, pool);
+void LAS::clearMeshBLAS()
+{
+    if (accel_) for (auto& blas : meshBLAS_) accel_->destroy(blas);   // retired behind frames in flight
+    meshBLAS_.clear();
     ++generation_;
 }
 
 void LAS::buildTLAS(VkCommandPool pool,
                     const std::vector<std::pair<VkAccelerationStructureKHR, glm::mat4>>& instances)
 {
-    std::vector<VkAccelerationStructureInstanceKHR> vkInst;
-    vkInst.reserve(instances.size());
-
-    for (const auto& [as, transform] : instances) {
-        VkAccelerationStructureInstanceKHR inst{};
-        std::memcpy(&inst.transform.matrix, glm::value_ptr(transform), sizeof(inst.transform.matrix));
-        inst.mask = 0xFF;
-        inst.flags = VK_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR;
-
-        VkAccelerationStructureDeviceAddressInfoKHR info{
-            VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR,
-            nullptr,
-            as
-        };
-        inst.accelerationStructureReference = g_ctx().vkGetAccelerationStructureDeviceAddressKHR()(g_ctx().device(), &info);
-        vkInst.push_back(inst);
+    instances_.clear();
+    for (const auto& [as, transform] : instances)
+        addInstance({ .blas = as, .transform = transform, .customIndex = instances_.size() });
+    buildTLAS(pool);
+}
+
+// =============================================================================
+// Instance list
+// =============================================================================
+uint32_t LAS::addInstance(const TLASInstance& instance)
+{
+    tlasStale_ = true;
+    return instances_.add(makeInstance(instance, asAddress(instance.blas)));
+}
+
+void LAS::setInstance(uint32_t i, const TLASInstance& instance)
+{
+    if (i >= instances_.size()) return;
+    tlasStale_ |= instances_.set(i, makeInstance(instance, asAddress(instance.blas)));
+}
+
+void LAS::setInstanceTransform(uint32_t i, const glm::mat4& transform)
+{
+    if (i >= instances_.size()) return;
+    tlasStale_ |= instances_.setTransform(i, toTransform(transform));
+}
+
+void LAS::reserveInstances(uint32_t count)
+{
+    if (count <= instanceCapacity_ && instanceRing_) return;
+
+    // Retired — frames in flight may still build from their region of the old ring
+    BUFFER_DESTROY(instanceRing_);
+    instanceCapacity_ = std::max(count, instanceCapacity_ * 2);
+    BUFFER_CREATE(instanceRing_,
+        static_cast<VkDeviceSize>(instanceCapacity_) * INSTANCE_REGIONS * sizeof(VkAccelerationStructureInstanceKHR),
+        VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        "LAS_instance_ring");
+
+    void* mapped = nullptr;
+    BUFFER_MAP(instanceRing_, mapped);                 // persistent
+    instanceMapped_   = static_cast<uint8_t*>(mapped);
+    instanceRingAddr_ = bufferAddress(instanceRing_);
+    instances_.invalidate();                           // every region starts empty
+}
+
+VkDeviceAddress LAS::flushInstances(uint32_t region)
+{
+    constexpr VkDeviceSize STRIDE = sizeof(VkAccelerationStructureInstanceKHR);
+    const VkDeviceSize base = static_cast<VkDeviceSize>(region) * instanceCapacity_ * STRIDE;
+
+    uint32_t written = 0;
+    instances_.flush(region, [&](uint32_t first, uint32_t count) {
+        std::memcpy(instanceMapped_ + base + first * STRIDE, instances_.data() + first, count * STRIDE);
+        BUFFER_FLUSH(instanceRing_, base + first * STRIDE, count * STRIDE);
+        written += count;
+    });
+    TRACE_COUNTER("LAS", "tlasInstancesWritten", written);
+    return instanceRingAddr_ + base;
+}
+
+void LAS::buildTLAS(VkCommandPool pool)
+{
+    TRACE_SCOPE("LAS", "buildTLAS");
+    TRACE_COUNTER("LAS", "tlasInstances", instances_.size());
+    if (!accel_ || instances_.size() == 0) {
+        LOG_WARN_CAT("LAS", "buildTLAS with no instances — keeping the current TLAS");
+        return;
     }
 
     VkCommandBuffer cmd = beginOneTime(pool);
-    tlas_ = accel_->createTLAS(vkInst, VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR, cmd, "Scene_TLAS");
+    recordTLASBuild(cmd, BUILD_REGION);   // blocking build — frames never read this region
     endSingleTimeCommandsAsync(cmd, g_ctx().graphicsQueue_, pool);
+}
+
+void LAS::recordTLASBuild(VkCommandBuffer cmd, uint32_t region)
+{
+    reserveInstances(instances_.size());
+    const VkDeviceAddress data = flushInstances(region);
+
+    VkBuildAccelerationStructureFlagsKHR flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR;
+    if (Options::LAS::UPDATE_EVERY_FRAME) flags |= VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR;
+
+    // Into the current storage when the new list fits: no allocation, same handle and address
+    if (!accel_->rebuildTLAS(tlas_, data, instances_.size(), flags, cmd)) {
+        VulkanAccel::TLAS fresh = accel_->createTLAS(data, instances_.size(), flags, cmd, "Scene_TLAS");
+        if (tlas_.as) accel_->destroy(tlas_);   // retired — frames in flight keep tracing the old one
+        tlas_ = std::move(fresh);
+    }
+    tlasStale_ = false;
     ++generation_;
-}
\ No newline at end of file
+
+    glm::vec3 mn, mx;
+    instanceBounds(instances_, mn, mx);
+    tlasRefit_.rebuilt(mn, mx);
+}
+
+// =============================================================================
+// Per-frame refits
+// =============================================================================
+void LAS::refitBarriers(VkCommandBuffer cmd, bool before) noexcept
+{
+    VkMemoryBarrier b{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    if (before) {
+        // Last frame's trace still reading, the previous refit's scratch and output still in flight
+        b.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+        b.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+        vkCmdPipelineBarrier(cmd,
+            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+            VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+            0, 1, &b, 0, nullptr, 0, nullptr);
+    } else {
+        b.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+        b.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+        vkCmdPipelineBarrier(cmd,
+            VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+            0, 1, &b, 0, nullptr, 0, nullptr);
+    }
+}
+
+bool LAS::updateBLAS(VkCommandBuffer cmd, const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+{
+    TRACE_SCOPE("LAS", "updateBLAS");
+    if (!accel_ || !(blas_.flags & VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR)) return false;
+
+    // First refit after a build only primes the bounds — the build already fits them
+    if (!blasRefit_.primed) blasRefit_.rebuilt(boundsMin, boundsMax);
+    const bool rebuild = blasRefit_.needsRebuild(boundsMin, boundsMax);
+    const VkDeviceAddress scratch = accel_->scratch().acquire(std::max(blas_.buildScratch, tlas_.buildScratch));
+
+    refitBarriers(cmd, true);
+    if (!accel_->refitBLAS(blas_, cmd, scratch, rebuild)) return false;
+    refitBarriers(cmd, false);
+
+    if (rebuild) {
+        LOG_DEBUG_CAT("LAS", "BLAS \"{}\" rebuilt in place after {} refits", blas_.name, blasRefit_.refits);
+        blasRefit_.rebuilt(boundsMin, boundsMax);
+    } else {
+        blasRefit_.refitted();
+    }
+    tlasStale_ = true;   // the TLAS still boxes the old geometry
+    return true;
+}
+
+bool LAS::updateTLAS(VkCommandBuffer cmd, uint32_t frameSlot)
+{
+    TRACE_SCOPE("LAS", "updateTLAS");
+    if (!accel_ || frameSlot >= BUILD_REGION || instances_.size() != tlas_.instanceCount ||
+        !(tlas_.flags & VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR)) return false;
+    if (!tlasStale_) return true;   // nothing moved — the slot's region catches up on the next change
+
+    glm::vec3 mn, mx;
+    instanceBounds(instances_, mn, mx);
+    const bool rebuild = tlasRefit_.needsRebuild(mn, mx);
+    const VkDeviceAddress scratch = accel_->scratch().acquire(std::max(blas_.buildScratch, tlas_.buildScratch));
+
+    refitBarriers(cmd, true);
+    const VkDeviceAddress data = flushInstances(frameSlot);   // the slot's previous frame is done with it
+    if (!accel_->refitTLAS(tlas_, data, cmd, scratch, rebuild)) return false;
+    refitBarriers(cmd, false);
+
+    if (rebuild) {
+        LOG_DEBUG_CAT("LAS", "TLAS \"{}\" rebuilt in place after {} refits", tlas_.name, tlasRefit_.refits);
+        tlasRefit_.rebuilt(mn, mx);
+    } else {
+        tlasRefit_.refitted();
+    }
+    tlasStale_ = false;
+    return true;
+}
+
+void LAS::refit(VkCommandBuffer cmd, uint32_t frameSlot)
+{
+    if (!accel_) return;
+    if (blasMoved_) {
+        blasMoved_ = false;
+        if (!updateBLAS(cmd, blasMin_, blasMax_))
+            LOG_WARN_CAT("LAS", "BLAS \"{}\" moved but wasn't built with ALLOW_UPDATE — rebuild it", blas_.name);
+    }
+    if (updateTLAS(cmd, frameSlot) || instances_.size() == 0 || frameSlot >= BUILD_REGION) return;
+
+    // Instance added or removed: full build in this command buffer, after the BLAS refit
+    // above (its barrier orders the read) and ahead of every trace — no submit, no wait
+    TRACE_SCOPE("LAS", "rebuildTLAS");
+    recordTLASBuild(cmd, frameSlot);
+    refitBarriers(cmd, false);
+}
@@ -0,0 +1,255 @@
+// src/engine/GLOBAL/MemoryBudget.cpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// MEMORY BUDGET — see MemoryBudget.hpp
+// =============================================================================
+
+#include "engine/GLOBAL/MemoryBudget.hpp"
+#include "engine/GLOBAL/OptionsMenu.hpp"
+#include "engine/GLOBAL/RTXHandler.hpp"
+#include "engine/GLOBAL/logging.hpp"
+
+#include <algorithm>
+
+namespace RTX {
+
+namespace {
+constexpr double MB = 1048576.0;
+}
+
+MemoryBudget& memoryBudget() noexcept {
+    static MemoryBudget budget;
+    return budget;
+}
+
+void MemoryBudget::init(VkPhysicalDevice physicalDevice) noexcept
+{
+    std::lock_guard lock(mutex_);
+    physicalDevice_ = physicalDevice;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProps_);
+    hasBudgetExt_ = isDeviceExtensionPresent(physicalDevice, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+    heaps_.assign(memProps_.memoryHeapCount, HeapBudget{});
+    warned_.assign(memProps_.memoryHeapCount, false);
+    for (uint32_t h = 0; h < memProps_.memoryHeapCount; ++h) {
+        heaps_[h].size        = memProps_.memoryHeaps[h].size;
+        heaps_[h].deviceLocal = (memProps_.memoryHeaps[h].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+    }
+    queryHeapsLocked();
+
+    LOG_SUCCESS_CAT("Memory", "Memory budget online — {} heaps, {}",
+                    memProps_.memoryHeapCount,
+                    hasBudgetExt_ ? "VK_EXT_memory_budget" : "no budget extension (heap size as budget)");
+}
+
+uint32_t MemoryBudget::heapOf(uint32_t memoryType) const noexcept
+{
+    return memoryType < memProps_.memoryTypeCount ? memProps_.memoryTypes[memoryType].heapIndex : 0;
+}
+
+// =============================================================================
+// LEDGER
+// =============================================================================
+void MemoryBudget::charge(std::string_view tag, uint32_t memoryType, VkDeviceSize bytes)
+{
+    std::lock_guard lock(mutex_);
+    chargeLocked(tag, memoryType, bytes);
+}
+
+void MemoryBudget::refund(std::string_view tag, uint32_t memoryType, VkDeviceSize bytes) noexcept
+{
+    std::lock_guard lock(mutex_);
+    refundLocked(tag, memoryType, bytes);
+}
+
+void MemoryBudget::chargeLocked(std::string_view tag, uint32_t memoryType, VkDeviceSize bytes)
+{
+    const uint32_t heap = heapOf(memoryType);
+    auto it = rows_.find(std::pair<std::string_view, uint32_t>{tag, heap});
+    if (it == rows_.end())
+        it = rows_.emplace(std::pair{std::string(tag), heap}, MemoryLedgerRow{std::string(tag), heap}).first;
+    it->second.bytes += bytes;
+    it->second.count += 1;
+    if (heap < heaps_.size()) heaps_[heap].charged += bytes;
+}
+
+void MemoryBudget::refundLocked(std::string_view tag, uint32_t memoryType, VkDeviceSize bytes) noexcept
+{
+    const uint32_t heap = heapOf(memoryType);
+    auto it = rows_.find(std::pair<std::string_view, uint32_t>{tag, heap});
+    if (it == rows_.end()) return;
+    it->second.bytes -= std::min(bytes, it->second.bytes);
+    if (--it->second.count == 0) rows_.erase(it);
+    if (heap < heaps_.size()) heaps_[heap].charged -= std::min(bytes, heaps_[heap].charged);
+}
+
+void MemoryBudget::chargeMemory(VkDeviceMemory memory, std::string_view tag, uint32_t memoryType, VkDeviceSize bytes)
+{
+    if (memory == VK_NULL_HANDLE) return;
+    std::lock_guard lock(mutex_);
+    auto [it, fresh] = memoryCharges_.try_emplace(memory, MemoryCharge{std::string(tag), memoryType, bytes});
+    if (!fresh) {
+        LOG_WARN_CAT("Memory", "VkDeviceMemory 0x{:x} charged twice ('{}' over '{}') — refunding the stale charge",
+                     reinterpret_cast<uintptr_t>(memory), tag, it->second.tag);
+        refundLocked(it->second.tag, it->second.memoryType, it->second.bytes);
+        it->second = MemoryCharge{std::string(tag), memoryType, bytes};
+    }
+    chargeLocked(tag, memoryType, bytes);
+}
+
+void MemoryBudget::refundMemory(VkDeviceMemory memory) noexcept
+{
+    std::lock_guard lock(mutex_);
+    auto it = memoryCharges_.find(memory);
+    if (it == memoryCharges_.end()) return;
+    refundLocked(it->second.tag, it->second.memoryType, it->second.bytes);
+    memoryCharges_.erase(it);
+}
+
+VkDeviceSize MemoryBudget::bytesOf(VkDeviceMemory memory) const noexcept
+{
+    std::lock_guard lock(mutex_);
+    auto it = memoryCharges_.find(memory);
+    return it == memoryCharges_.end() ? 0 : it->second.bytes;
+}
+
+std::vector<MemoryLedgerRow> MemoryBudget::snapshot() const
+{
+    std::vector<MemoryLedgerRow> out;
+    {
+        std::lock_guard lock(mutex_);
+        out.reserve(rows_.size());
+        for (const auto& [key, row] : rows_) out.push_back(row);
+    }
+    std::sort(out.begin(), out.end(), [](const auto& a, const auto& b) { return a.bytes > b.bytes; });
+    return out;
+}
+
+std::vector<HeapBudget> MemoryBudget::heaps() const
+{
+    std::lock_guard lock(mutex_);
+    return heaps_;
+}
+
+void MemoryBudget::logReport(std::string_view when) const
+{
+    for (const HeapBudget& h : heaps()) {
+        if (h.size == 0) continue;
+        LOG_PERF_CAT("Memory", "Heap{} [{}] — usage {:.1f} / budget {:.1f} MB (heap {:.1f} MB) | ledger {:.1f} MB",
+                     h.deviceLocal ? " VRAM" : "", when,
+                     h.usage / MB, h.budget / MB, h.size / MB, h.charged / MB);
+    }
+    for (const MemoryLedgerRow& r : snapshot()) {
+        LOG_PERF_CAT("Memory", "  heap {} | {:>9.2f} MB | {:>4} × | {}", r.heap, r.bytes / MB, r.count, r.tag);
+    }
+}
+
+// =============================================================================
+// EVICTION
+// =============================================================================
+uint32_t MemoryBudget::addEvictable(std::string name, uint32_t priority, EvictFn fn)
+{
+    std::lock_guard lock(mutex_);
+    const uint32_t id = nextEvictId_++;
+    evictables_.push_back(Evictable{id, priority, std::move(name), std::move(fn)});
+    std::stable_sort(evictables_.begin(), evictables_.end(),
+                     [](const auto& a, const auto& b) { return a.priority < b.priority; });
+    return id;
+}
+
+void MemoryBudget::removeEvictable(uint32_t id) noexcept
+{
+    std::lock_guard lock(mutex_);
+    std::erase_if(evictables_, [id](const Evictable& e) { return e.id == id; });
+}
+
+// =============================================================================
+// POLL
+// =============================================================================
+void MemoryBudget::queryHeapsLocked() noexcept
+{
+    if (physicalDevice_ == VK_NULL_HANDLE) return;
+
+    if (hasBudgetExt_) {
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budget{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT };
+        VkPhysicalDeviceMemoryProperties2 props2{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2 };
+        props2.pNext = &budget;
+        vkGetPhysicalDeviceMemoryProperties2(physicalDevice_, &props2);
+        for (uint32_t h = 0; h < heaps_.size(); ++h) {
+            heaps_[h].budget = budget.heapBudget[h];
+            heaps_[h].usage  = budget.heapUsage[h];
+        }
+    } else {
+        for (HeapBudget& h : heaps_) {
+            h.budget = h.size;
+            h.usage  = h.charged;
+        }
+    }
+}
+
+void MemoryBudget::tick(uint64_t frameNumber)
+{
+    if constexpr (!Options::Performance::ENABLE_MEMORY_BUDGET_WARNINGS) return;
+    if (frameNumber % Options::Performance::MEMORY_BUDGET_POLL_FRAMES != 0) return;
+    poll();
+}
+
+void MemoryBudget::poll()
+{
+    constexpr double warnAt  = Options::Performance::MEMORY_BUDGET_WARN_FRACTION;
+    constexpr double evictAt = Options::Performance::MEMORY_BUDGET_EVICT_FRACTION;
+
+    std::vector<uint32_t> overHeaps;          // heaps past EVICT
+    std::vector<uint32_t> newlyWarned;
+    {
+        std::lock_guard lock(mutex_);
+        queryHeapsLocked();
+        for (uint32_t h = 0; h < heaps_.size(); ++h) {
+            const HeapBudget& hb = heaps_[h];
+            if (hb.budget == 0) continue;
+            const double ratio = double(hb.usage) / double(hb.budget);
+            if (ratio >= warnAt && !warned_[h]) { warned_[h] = true; newlyWarned.push_back(h); }
+            else if (ratio < warnAt)            warned_[h] = false;
+            if (ratio >= evictAt && hb.deviceLocal) overHeaps.push_back(h);
+        }
+    }
+
+    for (uint32_t h : newlyWarned) {
+        const HeapBudget hb = heaps()[h];
+        LOG_WARN_CAT("Memory", "Heap {} at {:.1f}% of budget ({:.1f} / {:.1f} MB) — driver may start paging to system memory",
+                     h, 100.0 * double(hb.usage) / double(hb.budget), hb.usage / MB, hb.budget / MB);
+        logReport("budget warning");
+    }
+    if (overHeaps.empty()) return;
+
+    // Evict outside the lock — owners retire() resources, which may refund back into the ledger
+    std::vector<Evictable> candidates;
+    {
+        std::lock_guard lock(mutex_);
+        candidates = evictables_;
+    }
+    for (uint32_t h : overHeaps) {
+        const HeapBudget hb = heaps()[h];
+        const VkDeviceSize target = static_cast<VkDeviceSize>(double(hb.budget) * warnAt);
+        VkDeviceSize projected = hb.usage;
+        for (const Evictable& e : candidates) {
+            if (projected <= target) break;
+            const VkDeviceSize freed = e.fn ? e.fn() : 0;
+            if (freed == 0) continue;
+            projected -= std::min(freed, projected);
+            LOG_WARN_CAT("Memory", "Evicted '{}' — {:.1f} MB returned to heap {} (projected {:.1f} / {:.1f} MB)",
+                         e.name, freed / MB, h, projected / MB, hb.budget / MB);
+        }
+        if (projected > target)
+            LOG_ERROR_CAT("Memory", "Heap {} still over budget after eviction — nothing optional left to drop", h);
+    }
+}
+
+} // namespace RTX
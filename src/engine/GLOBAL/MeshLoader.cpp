@@ -18,7 +18,9 @@
 #include "engine/GLOBAL/StoneKey.hpp"
 #include "engine/GLOBAL/RTXHandler.hpp"
 #include "engine/GLOBAL/LAS.hpp"           // ← brings in beginOneTime() and endSingleTimeCommandsAsync()
+#include "engine/GLOBAL/UploadScheduler.hpp"
 #include "engine/GLOBAL/logging.hpp"
+#include "engine/GLOBAL/Trace.hpp"
 #include <tinyobjloader/tiny_obj_loader.h>
 #include <unordered_map>
 #include <cstring>
@@ -60,6 +62,9 @@ VkBuffer Mesh::getIndexBuffer() const noexcept {
 
 // =============================================================================
 // BULLETPROOF UPLOAD — NO VkBuffer IN LOGS → USE uint64_t INSTEAD
+// Staged through the upload scheduler (transfer queue, batched); loadOBJ()
+// flushes once both buffers are queued. Without a scheduler, falls back to a
+// private staging buffer and a one-time graphics submit.
 // =============================================================================
 static void uploadBuffer(const void* data, VkDeviceSize size, VkBufferUsageFlags usage, uint64_t& outHandle)
 {
@@ -71,6 +76,19 @@ static void uploadBuffer(const void* data, VkDeviceSize size, VkBufferUsageFlags
         return;
     }
 
+    BUFFER_CREATE(outHandle, size,
+                  VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | usage |
+                  VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                  VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                  (usage & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT) ? "Mesh_Vertex_Final" : "Mesh_Index_Final");
+
+    auto& scheduler = RTX::uploadScheduler();
+    if (scheduler.valid()) {
+        const uint64_t ticket = scheduler.enqueue(RAW_BUFFER(outHandle), 0, data, size);
+        LOG_SUCCESS_CAT("MeshLoader", "uploadBuffer() QUEUED — final handle: 0x{:016X} | ticket {}", outHandle, ticket);
+        return;
+    }
+
     auto& tracker = RTX::UltraLowLevelBufferTracker::get();
 
     uint64_t staging = 0;
@@ -86,14 +104,8 @@ static void uploadBuffer(const void* data, VkDeviceSize size, VkBufferUsageFlags
     tracker.unmap(staging);
     LOG_SUCCESS_CAT("MeshLoader", "Staging buffer filled — {} bytes copied", size);
 
-    BUFFER_CREATE(outHandle, size,
-                  VK_BUFFER_USAGE_TRANSFER_DST_BIT | usage | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-                  VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                  (usage & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT) ? "Mesh_Vertex_Final" : "Mesh_Index_Final");
-
     LOG_INFO_CAT("MeshLoader", "Copying staging → final: 0x{:016X} → 0x{:016X}", staging, outHandle);
 
-    // NOW USING beginOneTime / endSingleTimeCommandsAsync FROM LAS.hpp
     VkCommandBuffer cmd = beginOneTime(g_ctx().commandPool_);
 
     VkBufferCopy copy{ .size = size };
@@ -112,6 +124,7 @@ static void uploadBuffer(const void* data, VkDeviceSize size, VkBufferUsageFlags
 // =============================================================================
 std::unique_ptr<Mesh> loadOBJ(const std::string& path)
 {
+    TRACE_SCOPE("MeshLoader", "loadOBJ");
     LOG_ATTEMPT_CAT("MeshLoader", "LOADING OBJ: {}", path);
 
     tinyobj::attrib_t attrib;
@@ -175,6 +188,15 @@ std::unique_ptr<Mesh> loadOBJ(const std::string& path)
                  mesh->indexBuffer);
     LOG_SUCCESS_CAT("MeshLoader", "INDEX BUFFER READY — handle 0x{:016X}", mesh->indexBuffer);
 
+    // BLAS build follows right away — both copies in one transfer submit, then hand them to graphics
+    RTX::uploadScheduler().flushAndWait();
+
+    // Uploads hold the raw VkBuffer until they land — only now may the
+    // renderer's per-frame defragment() move them (consumers use RAW_BUFFER)
+    auto& tracker = RTX::UltraLowLevelBufferTracker::get();
+    tracker.setRelocatable(mesh->vertexBuffer, true);
+    tracker.setRelocatable(mesh->indexBuffer, true);
+
     // FINAL FINGERPRINT
     mesh->stonekey_fingerprint =
         kStone1() ^ kStone2() ^
@@ -176,7 +176,7 @@ void PipelineManager::updateRTDescriptorSet(uint32_t frameIndex, const RTDescrip
         writes.push_back(accWrite);
     }
 
-    // Binding 3: UBO — FIXED: Skip if null
+    // Binding 3: UBO (dynamic — per-frame FrameRing offset at bind time) — FIXED: Skip if null
     if (updateInfo.ubo != VK_NULL_HANDLE) {
         VkDescriptorBufferInfo uboBufferInfo = {};
         uboBufferInfo.buffer = updateInfo.ubo;
@@ -188,7 +188,7 @@ void PipelineManager::updateRTDescriptorSet(uint32_t frameIndex, const RTDescrip
         uboWrite.dstSet = set;
         uboWrite.dstBinding = 3;
         uboWrite.dstArrayElement = 0;
-        uboWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        uboWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         uboWrite.descriptorCount = 1;
         uboWrite.pBufferInfo = &uboBufferInfo;
 
@@ -251,7 +251,7 @@ void PipelineManager::updateRTDescriptorSet(uint32_t frameIndex, const RTDescrip
         writes.push_back(nexusWrite);
     }
 
-    // Binding 7: Additional storage buffer — FIXED: Skip if null
+    // Binding 7: Additional storage buffer (dynamic — frame dimensions) — FIXED: Skip if null
     if (updateInfo.additionalStorageBuffer != VK_NULL_HANDLE) {
         VkDescriptorBufferInfo addBufferInfo = {};
         addBufferInfo.buffer = updateInfo.additionalStorageBuffer;
@@ -263,7 +263,7 @@ void PipelineManager::updateRTDescriptorSet(uint32_t frameIndex, const RTDescrip
         addWrite.dstSet = set;
         addWrite.dstBinding = 7;
         addWrite.dstArrayElement = 0;
-        addWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        addWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
         addWrite.descriptorCount = 1;
         addWrite.pBufferInfo = &addBufferInfo;
 
@@ -603,9 +603,9 @@ void PipelineManager::createDescriptorSetLayout()
     bindings[2].stageFlags = VK_SHADER_STAGE_RAYGEN_BIT_KHR;
     bindings[2].pImmutableSamplers = nullptr;
 
-    // FIXED: Binding 3 - ubo (uniform buffer) — matches shader "ubo" (Set 0, Binding 3)
+    // FIXED: Binding 3 - ubo (dynamic uniform buffer) — matches shader "ubo" (Set 0, Binding 3)
     bindings[3].binding = 3;
-    bindings[3].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    bindings[3].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     bindings[3].descriptorCount = 1;
     bindings[3].stageFlags = VK_SHADER_STAGE_RAYGEN_BIT_KHR | VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR | VK_SHADER_STAGE_MISS_BIT_KHR;
     bindings[3].pImmutableSamplers = nullptr;
@@ -631,9 +631,9 @@ void PipelineManager::createDescriptorSetLayout()
     bindings[6].stageFlags = VK_SHADER_STAGE_RAYGEN_BIT_KHR;
     bindings[6].pImmutableSamplers = nullptr;
 
-    // Binding 7 - additional storage buffer
+    // Binding 7 - additional storage buffer (dynamic — frame dimensions)
     bindings[7].binding = 7;
-    bindings[7].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[7].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
     bindings[7].descriptorCount = 1;
     bindings[7].stageFlags = VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR;
     bindings[7].pImmutableSamplers = nullptr;
@@ -646,7 +646,9 @@ void PipelineManager::createDescriptorSetLayout()
                       (bindings[j].descriptorType == VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR ? "accel" :
                        bindings[j].descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE ? "storage_img" :
                        bindings[j].descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER ? "uniform_buf" :
+                       bindings[j].descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC ? "uniform_buf_dyn" :
                        bindings[j].descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER ? "storage_buf" :
+                       bindings[j].descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC ? "storage_buf_dyn" :
                        bindings[j].descriptorType == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER ? "sampler" : "unknown"),
                       bindings[j].stageFlags, bindings[j].descriptorCount);
     }
@@ -661,25 +663,25 @@ void PipelineManager::createDescriptorSetLayout()
              "Failed to create RT descriptor set layout");
 
     rtDescriptorSetLayout_ = Handle<VkDescriptorSetLayout>(
-        layout, g_device(),
-        [](VkDevice d, VkDescriptorSetLayout l, const VkAllocationCallbacks*) { vkDestroyDescriptorSetLayout(d, l, nullptr); },
-        0, "RTDescriptorSetLayout"
+        layout, g_device(), "RTDescriptorSetLayout"
     );
 
     // FIXED: Create RT Descriptor Pool — Multi-frame sizing per Vulkan spec (total descriptors across maxSets) + FIXED: 3 storage_img (1 per binding x 3 bindings)
     LOG_TRACE_CAT("PIPELINE", "Creating RT descriptor pool — maxSets={}, freeable, scaled descriptor counts", Options::Performance::MAX_FRAMES_IN_FLIGHT);
     const uint32_t maxSets = Options::Performance::MAX_FRAMES_IN_FLIGHT;
-    std::array<VkDescriptorPoolSize, 5> poolSizes = {};  // Zero-init
+    std::array<VkDescriptorPoolSize, 6> poolSizes = {};  // Zero-init
     poolSizes[0].type = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
     poolSizes[0].descriptorCount = 1 * maxSets;  // Binding 0 x N
     poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
     poolSizes[1].descriptorCount = 3 * maxSets;  // FIXED: Bindings 1,2,6 x 1 count x N (VUID-03024)
-    poolSizes[2].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    poolSizes[2].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     poolSizes[2].descriptorCount = 1 * maxSets;  // Binding 3 x N
     poolSizes[3].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    poolSizes[3].descriptorCount = 2 * maxSets;  // Bindings 4,7 x N
+    poolSizes[3].descriptorCount = 1 * maxSets;  // Binding 4 x N
     poolSizes[4].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
     poolSizes[4].descriptorCount = 1 * maxSets;  // Binding 5 x N
+    poolSizes[5].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+    poolSizes[5].descriptorCount = 1 * maxSets;  // Binding 7 x N
 
     VkDescriptorPoolCreateInfo poolInfo = {};  // Zero-init
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
@@ -697,10 +699,6 @@ void PipelineManager::createDescriptorSetLayout()
     rtDescriptorPool_ = Handle<VkDescriptorPool>(
         rawPool,
         g_device(),
-        [](VkDevice d, VkDescriptorPool p, const VkAllocationCallbacks*) {
-            if (p != VK_NULL_HANDLE) vkDestroyDescriptorPool(d, p, nullptr);
-        },
-        0,
         "RTDescriptorPool"
     );
 
@@ -753,9 +751,7 @@ void PipelineManager::createPipelineLayout() {
     VK_CHECK(vkCreatePipelineLayout(g_device(), &layoutInfo, nullptr, &rawLayout),
              "Failed to create ray tracing pipeline layout");
 
-    rtPipelineLayout_ = Handle<VkPipelineLayout>(rawLayout, g_device(),
-        [](VkDevice d, VkPipelineLayout l, const VkAllocationCallbacks*) { vkDestroyPipelineLayout(d, l, nullptr); },
-        0, "RTPipelineLayout");
+    rtPipelineLayout_ = Handle<VkPipelineLayout>(rawLayout, g_device(), "RTPipelineLayout");
 
     LOG_SUCCESS_CAT("PIPELINE", "Pipeline layout created — non-null pSetLayouts + raygen stages + size=16 — VUID-01795 FIXED");
     LOG_TRACE_CAT("PIPELINE", "createPipelineLayout — COMPLETE");
@@ -826,13 +822,13 @@ void PipelineManager::createRayTracingPipeline(const std::vector<std::string>& s
     }
 
     // Store modules in Handle for auto-cleanup
-    shaderModules_.emplace_back(raygenModule, g_device(), [](VkDevice d, VkShaderModule m, const VkAllocationCallbacks*) { vkDestroyShaderModule(d, m, nullptr); }, 0, "RaygenShader");
-    shaderModules_.emplace_back(missModule, g_device(), [](VkDevice d, VkShaderModule m, const VkAllocationCallbacks*) { vkDestroyShaderModule(d, m, nullptr); }, 0, "MissShader");
+    shaderModules_.emplace_back(raygenModule, g_device(), "RaygenShader");
+    shaderModules_.emplace_back(missModule, g_device(), "MissShader");
     if (hasClosestHit) {
-        shaderModules_.emplace_back(closestHitModule, g_device(), [](VkDevice d, VkShaderModule m, const VkAllocationCallbacks*) { vkDestroyShaderModule(d, m, nullptr); }, 0, "ClosestHitShader");
+        shaderModules_.emplace_back(closestHitModule, g_device(), "ClosestHitShader");
     }
     if (hasShadowMiss) {
-        shaderModules_.emplace_back(shadowMissModule, g_device(), [](VkDevice d, VkShaderModule m, const VkAllocationCallbacks*) { vkDestroyShaderModule(d, m, nullptr); }, 0, "ShadowMissShader");
+        shaderModules_.emplace_back(shadowMissModule, g_device(), "ShadowMissShader");
     }
 
     // ---------------------------------------------------------------------
@@ -951,9 +947,7 @@ void PipelineManager::createRayTracingPipeline(const std::vector<std::string>& s
     VK_CHECK(pipeResult, "Create RT pipeline");  // Your macro
 
     // 5. Store and cleanup (unchanged)
-    rtPipeline_ = Handle<VkPipeline>(pipeline, g_device(),
-        [](VkDevice d, VkPipeline p, const VkAllocationCallbacks*) { vkDestroyPipeline(d, p, nullptr); },
-        0, "RTPipeline");
+    rtPipeline_ = Handle<VkPipeline>(pipeline, g_device(), "RTPipeline");
 
     LOG_SUCCESS_CAT("PIPELINE", "{}Ray tracing pipeline created successfully — {} stages, {} groups — PNEXT=NULL — UNUSED_KHR EXPLICIT — BINDINGS MATCH{}", 
                     LIME_GREEN, stages.size(), groups.size(), RESET);
@@ -1150,9 +1144,7 @@ void PipelineManager::createShaderBindingTable(VkCommandPool pool, VkQueue queue
 
     VkBuffer rawSbtBuffer = VK_NULL_HANDLE;
     VK_CHECK(vkCreateBuffer(g_device(), &sbtInfo, nullptr, &rawSbtBuffer), "Create final SBT buffer");
-    sbtBuffer_ = Handle<VkBuffer>(rawSbtBuffer, g_device(),
-        [](VkDevice d, VkBuffer b, const VkAllocationCallbacks*) { if (b != VK_NULL_HANDLE) vkDestroyBuffer(d, b, nullptr); },
-        0, "SBTBuffer");
+    sbtBuffer_ = Handle<VkBuffer>(rawSbtBuffer, g_device(), "SBTBuffer");
 
     vkGetBufferMemoryRequirements(g_device(), rawSbtBuffer, &memReqs);
 
@@ -1169,9 +1161,8 @@ void PipelineManager::createShaderBindingTable(VkCommandPool pool, VkQueue queue
 
     VkDeviceMemory rawSbtMemory = VK_NULL_HANDLE;
     VK_CHECK(vkAllocateMemory(g_device(), &allocInfoSBT, nullptr, &rawSbtMemory), "Allocate final SBT memory");
-    sbtMemory_ = Handle<VkDeviceMemory>(rawSbtMemory, g_device(),
-        [](VkDevice d, VkDeviceMemory m, const VkAllocationCallbacks*) { if (m != VK_NULL_HANDLE) vkFreeMemory(d, m, nullptr); },
-        memReqs.size, "SBTMemory");
+    memoryBudget().chargeMemory(rawSbtMemory, "SBT", allocInfoSBT.memoryTypeIndex, memReqs.size);
+    sbtMemory_ = Handle<VkDeviceMemory>(rawSbtMemory, g_device(), "SBTMemory");
 
     VK_CHECK(vkBindBufferMemory(g_device(), rawSbtBuffer, rawSbtMemory, 0), "Bind final SBT memory");
 
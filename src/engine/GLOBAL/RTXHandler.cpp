@@ -17,12 +17,15 @@
 #include "engine/GLOBAL/StoneKey.hpp"
 #include "engine/GLOBAL/logging.hpp"
 #include "engine/GLOBAL/RTXHandler.hpp"
+#include "engine/GLOBAL/MemoryBudget.hpp"
+#include "engine/GLOBAL/UploadScheduler.hpp"
 #include "engine/GLOBAL/OptionsMenu.hpp"
 #include "engine/GLOBAL/LAS.hpp"
 #include "engine/GLOBAL/VkSafeSTypes.hpp"
 #include "engine/GLOBAL/VulkanRenderer.hpp"
 #include <SDL3/SDL_vulkan.h>
 #include <set>
+#include <deque>
 #include <algorithm>
 #include <cstring>
 #include <format>
@@ -69,12 +72,50 @@ namespace RTX {
 
     [[nodiscard]] Context& g_ctx() noexcept { return g_context_instance; }
 
-    void logAndTrackDestruction(const char* type, void* ptr, int line, size_t size) {
+    void logAndTrackDestruction(std::string_view what, void* ptr, int line) {
         if (ENABLE_DEBUG) {
-            LOG_DEBUG_CAT("RTX", "{}Destroyed: {} @ 0x{:p} (line {}, size: {}B)", SAPPHIRE_BLUE, type, ptr, line, size);
+            LOG_DEBUG_CAT("RTX", "{}Destroyed: {} @ 0x{:p} (line {})", SAPPHIRE_BLUE, what, ptr, line);
         }
     }
 
+    // =============================================================================
+    // TAG TABLE — deque keeps every name at a fixed address, the map keys view into it
+    // =============================================================================
+    namespace {
+        struct TagTable {
+            std::mutex mutex;
+            std::deque<std::string> names{ std::string{} };                 // id 0 = ""
+            std::unordered_map<std::string_view, TagId> ids{ { std::string_view{}, 0u } };
+        };
+
+        // Leaked like retireQueue() — handles released during static teardown still log their tag
+        TagTable& tagTable() noexcept {
+            static TagTable* table = new TagTable();
+            return *table;
+        }
+    }
+
+    TagId internTag(std::string_view name) {
+        if (name.empty()) return 0;
+        TagTable& t = tagTable();
+        std::lock_guard lock(t.mutex);
+        if (auto it = t.ids.find(name); it != t.ids.end()) return it->second;
+        const TagId id = static_cast<TagId>(t.names.size());
+        const std::string& stored = t.names.emplace_back(name);
+        t.ids.emplace(std::string_view(stored), id);
+        return id;
+    }
+
+    std::string_view tagName(TagId id) noexcept {
+        TagTable& t = tagTable();
+        std::lock_guard lock(t.mutex);
+        return id < t.names.size() ? std::string_view(t.names[id]) : std::string_view{};
+    }
+
+    void DestroyPolicy<VkAccelerationStructureKHR>::destroy(VkDevice d, VkAccelerationStructureKHR as) noexcept {
+        if (auto fn = g_ctx().vkDestroyAccelerationStructureKHR()) fn(d, as, nullptr);
+    }
+
     UltraLowLevelBufferTracker& UltraLowLevelBufferTracker::get() noexcept {
         static UltraLowLevelBufferTracker instance;
         return instance;
@@ -121,81 +162,74 @@ namespace RTX {
             LOG_WARN_CAT("RTX", "{}Requested {} bytes, driver requires {} bytes (align: {})", SAPPHIRE_BLUE, size, memReq.size, memReq.alignment, RESET);
         }
 
-        VkMemoryAllocateFlagsInfo flagsInfo{};
-        flagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
-        flagsInfo.flags = (usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) ? VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR : 0u;
-
-        uint32_t memTypeIndex = findMemoryType(physDev_, memReq.memoryTypeBits, props);
-        if (memTypeIndex == UINT32_MAX) {
-            LOG_FATAL_CAT("RTX", "{}No compatible memory type found for buffer | Tag: {}{}", CRIMSON_MAGENTA, tag, RESET);
+        // One range out of a DeviceHeap block (or a dedicated allocation for > half a block)
+        const HeapAllocation alloc = deviceHeap().allocate(memReq, props, HeapResource::Linear, tag);
+        if (!alloc.valid()) {
+            LOG_FATAL_CAT("RTX", "{}DeviceHeap allocation failed ({} B) | Tag: {}{}", CRIMSON_MAGENTA, memReq.size, tag, RESET);
             vkDestroyBuffer(device_, buffer, nullptr);
             return 0;
         }
 
-        VkMemoryAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocInfo.pNext = (usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) ? &flagsInfo : nullptr;
-        allocInfo.allocationSize = memReq.size;
-        allocInfo.memoryTypeIndex = memTypeIndex;
-
-        VkDeviceMemory memory = VK_NULL_HANDLE;
-        result = vkAllocateMemory(device_, &allocInfo, nullptr, &memory);
+        result = vkBindBufferMemory(device_, buffer, alloc.memory, alloc.offset);
         if (result != VK_SUCCESS) {
-            LOG_FATAL_CAT("RTX", "{}vkAllocateMemory failed: {} | Tag: {}{}", CRIMSON_MAGENTA, result, tag, RESET);
+            LOG_FATAL_CAT("RTX", "{}vkBindBufferMemory failed: {} | Tag: {}{}", CRIMSON_MAGENTA, result, tag, RESET);
+            deviceHeap().free(alloc);
             vkDestroyBuffer(device_, buffer, nullptr);
             return 0;
         }
 
-        result = vkBindBufferMemory(device_, buffer, memory, 0);
-        if (result != VK_SUCCESS) {
-            LOG_FATAL_CAT("RTX", "{}vkBindBufferMemory failed: {} | Tag: {}{}", CRIMSON_MAGENTA, result, tag, RESET);
-            vkFreeMemory(device_, memory, nullptr);
+        BufferData data{buffer, alloc.memory, size, memReq.size, usage, std::string(tag)};
+        data.offset     = alloc.offset;
+        data.props      = props;
+        data.allocation = alloc;
+
+        const uint64_t raw = slots_.insert(std::move(data));
+        if (raw == 0) {
+            LOG_FATAL_CAT("RTX", "{}Handle table full ({} live) | Tag: {}{}", CRIMSON_MAGENTA, slots_.size(), tag, RESET);
+            deviceHeap().free(alloc);
             vkDestroyBuffer(device_, buffer, nullptr);
             return 0;
         }
-
-        const uint64_t raw = ++counter_;
         const uint64_t obf = ::obfuscate(raw);
+        memoryBudget().charge(tag, alloc.memoryType, memReq.size);
 
-        {
-            std::lock_guard<std::mutex> lk(mutex_);
-            map_.emplace(raw, BufferData{buffer, memory, size, memReq.size, usage, std::string(tag)});
-        }
-
-        LOG_DEBUG_CAT("RTX", "{}Buffer forged: raw=0x{:x} → obf=0x{:x} | Size: {}B | Tag: {}{}", SAPPHIRE_BLUE, raw, obf, size, tag, RESET);
+        LOG_DEBUG_CAT("RTX", "{}Buffer forged: raw=0x{:x} → obf=0x{:x} | Size: {}B @ +{} | Tag: {}{}", SAPPHIRE_BLUE, raw, obf, size, alloc.offset, tag, RESET);
         return obf;
     }
 
+    // Host-visible blocks are mapped once for their whole life — map() is base + offset
     void* UltraLowLevelBufferTracker::map(uint64_t handle) noexcept {
         if (handle == 0) return nullptr;
         const uint64_t raw = ::deobfuscate(handle);
-        std::lock_guard<std::mutex> lk(mutex_);
-        auto it = map_.find(raw);
-        if (it == map_.end()) {
+        const BufferData* d = slots_.lookup(raw);
+        if (!d) {
             LOG_ERROR_CAT("RTX", "{}map: Invalid handle 0x{:x} (raw 0x{:x}){}", CRIMSON_MAGENTA, handle, raw, RESET);
             return nullptr;
         }
-        if (it->second.memory == VK_NULL_HANDLE) {
-            LOG_FATAL_CAT("RTX", "Buffer map aborted: memory null for handle 0x{:x}", handle);
-            return nullptr;
-        }
-        void* ptr = nullptr;
-        VkResult res = vkMapMemory(device_, it->second.memory, 0, VK_WHOLE_SIZE, 0, &ptr);
-        if (res != VK_SUCCESS) {
-            LOG_ERROR_CAT("RTX", "{}vkMapMemory failed: {} for handle 0x{:x}{}", CRIMSON_MAGENTA, res, handle, RESET);
+        if (d->allocation.mapped == nullptr) {
+            LOG_ERROR_CAT("RTX", "{}map: buffer '{}' is not host-visible{}", CRIMSON_MAGENTA, d->tag, RESET);
             return nullptr;
         }
-        return ptr;
+        return d->allocation.mapped;
     }
 
+    // Persistent mapping — the block is unmapped when DeviceHeap frees it.
+    // unmap() just publishes the CPU writes for non-coherent memory.
     void UltraLowLevelBufferTracker::unmap(uint64_t handle) noexcept {
+        flush(handle);
+    }
+
+    // Offsets are buffer-relative; DeviceHeap rounds them out to nonCoherentAtomSize
+    void UltraLowLevelBufferTracker::flush(uint64_t handle, VkDeviceSize offset, VkDeviceSize size) noexcept {
         if (handle == 0) return;
-        const uint64_t raw = ::deobfuscate(handle);
-        std::lock_guard<std::mutex> lk(mutex_);
-        auto it = map_.find(raw);
-        if (it != map_.end()) {
-            vkUnmapMemory(device_, it->second.memory);
-        }
+        const BufferData* d = slots_.lookup(::deobfuscate(handle));
+        if (d && !d->allocation.coherent) deviceHeap().flush(d->allocation, offset, size);
+    }
+
+    void UltraLowLevelBufferTracker::invalidate(uint64_t handle, VkDeviceSize offset, VkDeviceSize size) noexcept {
+        if (handle == 0) return;
+        const BufferData* d = slots_.lookup(::deobfuscate(handle));
+        if (d && !d->allocation.coherent) deviceHeap().invalidate(d->allocation, offset, size);
     }
 
     void UltraLowLevelBufferTracker::destroy(uint64_t handle) noexcept {
@@ -204,53 +238,145 @@ namespace RTX {
             return;
         }
         const uint64_t raw = ::deobfuscate(handle);
-        std::lock_guard<std::mutex> lk(mutex_);
-        auto it = map_.find(raw);
-        if (it == map_.end()) {
+        BufferData d;
+        if (!slots_.remove(raw, d)) {
             LOG_WARN_CAT("RTX", "{}Buffer not found: raw 0x{:x}{}", SAPPHIRE_BLUE, raw, RESET);
             return;
         }
-        BufferData d = std::move(it->second);
-        map_.erase(it);
+        // The handle value may be reused by the next vkCreateBuffer — the upload
+        // scheduler must not still think graphics owns it
+        uploadScheduler().forget(d.buffer);
         if (d.buffer) vkDestroyBuffer(device_, d.buffer, nullptr);
-        if (d.memory) vkFreeMemory(device_, d.memory, nullptr);
+        deviceHeap().free(d.allocation);
+        memoryBudget().refund(d.tag, d.allocation.memoryType, d.alignedSize);
         LOG_DEBUG_CAT("RTX", "{}Buffer destroyed: raw=0x{:x} | Size: {}B | Tag: {}{}", SAPPHIRE_BLUE, raw, d.size, d.tag, RESET);
     }
 
+    // Wait-free: page load + generation compare, no lock (RAW_BUFFER & friends hit this every frame)
     BufferData* UltraLowLevelBufferTracker::getData(uint64_t handle) noexcept {
         if (handle == 0) return nullptr;
-        const uint64_t raw = ::deobfuscate(handle);
-        std::lock_guard<std::mutex> lk(mutex_);
-        auto it = map_.find(raw);
-        return it == map_.end() ? nullptr : &it->second;
+        return slots_.lookup(::deobfuscate(handle));
     }
 
     const BufferData* UltraLowLevelBufferTracker::getData(uint64_t handle) const noexcept {
         if (handle == 0) return nullptr;
-        const uint64_t raw = ::deobfuscate(handle);
-        std::lock_guard<std::mutex> lk(mutex_);
-        auto it = map_.find(raw);
-        return it == map_.end() ? nullptr : &it->second;
+        return slots_.lookup(::deobfuscate(handle));
     }
 
     void UltraLowLevelBufferTracker::init(VkDevice dev, VkPhysicalDevice phys) noexcept {
         device_ = dev;
         physDev_ = phys;
+        deviceHeap().init(dev, phys);
+        memoryBudget().init(phys);
         LOG_DEBUG_CAT("RTX", "{}BufferTracker initialized — StoneKey obfuscation active{}", SAPPHIRE_BLUE, RESET);
     }
 
     void UltraLowLevelBufferTracker::purge_all() noexcept {
-        std::lock_guard<std::mutex> lk(mutex_);
-        for (auto it = map_.begin(); it != map_.end(); ) {
-            BufferData d = std::move(it->second);
+        // Defragment leftovers, BUFFER_DESTROYs and RenderGraph transients all
+        // free heap ranges from the retire queue — run them before the blocks go
+        retireQueue().drain();
+        deviceHeap().logStats("purge");
+        std::vector<uint64_t> live;
+        live.reserve(slots_.size());
+        slots_.forEach([&](uint64_t raw, BufferData&) noexcept { live.push_back(raw); });
+        for (const uint64_t raw : live) {
+            BufferData d;
+            if (!slots_.remove(raw, d)) continue;
+            uploadScheduler().forget(d.buffer);
             if (d.buffer) vkDestroyBuffer(device_, d.buffer, nullptr);
-            if (d.memory) vkFreeMemory(device_, d.memory, nullptr);
-            it = map_.erase(it);
+            deviceHeap().free(d.allocation);
+            memoryBudget().refund(d.tag, d.allocation.memoryType, d.alignedSize);
+        }
+
+        // Anything still sub-allocated belongs to an owner that was never torn
+        // down — its later free() must find its block, so leave the heap alone
+        if (const HeapStats s = deviceHeap().stats(); s.subAllocations != 0) {
+            LOG_ERROR_CAT("Memory", "purge: {} heap range(s) still live outside the tracker — blocks kept, destroy their owners first",
+                          s.subAllocations);
+        } else {
+            deviceHeap().releaseAll();
         }
-        map_.clear();
         LOG_DEBUG_CAT("RTX", "{}All buffers purged — trackers cleared{}", SAPPHIRE_BLUE, RESET);
     }
 
+    void UltraLowLevelBufferTracker::setRelocatable(uint64_t handle, bool relocatable) noexcept {
+        BufferData* d = getData(handle);
+        if (!d) return;
+        // defragment() copies out of the old buffer — it must be a transfer source
+        if (relocatable && !(d->usage & VK_BUFFER_USAGE_TRANSFER_SRC_BIT)) {
+            LOG_WARN_CAT("Memory", "setRelocatable: '{}' was created without TRANSFER_SRC — it stays put", d->tag);
+            return;
+        }
+        d->relocatable = relocatable;
+    }
+
+    uint32_t UltraLowLevelBufferTracker::defragment(VkCommandBuffer cmd, uint32_t maxMoves) noexcept {
+        if (cmd == VK_NULL_HANDLE || maxMoves == 0) return 0;
+        const uint32_t sparse = deviceHeap().sparsestBlock();
+        if (sparse == UINT32_MAX) return 0;
+
+        struct Move { VkBuffer from; VkBuffer to; VkDeviceSize size; };
+        std::vector<Move> moves;
+        slots_.forEach([&](uint64_t, BufferData& d) noexcept {
+            if (moves.size() >= maxMoves) return;
+            if (!d.relocatable || d.allocation.block != sparse) return;
+
+            VkBufferCreateInfo bufInfo{ VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+            bufInfo.size        = d.size;
+            bufInfo.usage       = d.usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+            bufInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            VkBuffer fresh = VK_NULL_HANDLE;
+            if (vkCreateBuffer(device_, &bufInfo, nullptr, &fresh) != VK_SUCCESS) { maxMoves = 0; return; }
+
+            VkMemoryRequirements req{};
+            vkGetBufferMemoryRequirements(device_, fresh, &req);
+            const HeapAllocation alloc = deviceHeap().allocate(req, d.props, HeapResource::Linear, d.tag, sparse);
+            if (!alloc.valid() || vkBindBufferMemory(device_, fresh, alloc.memory, alloc.offset) != VK_SUCCESS) {
+                deviceHeap().free(alloc);
+                vkDestroyBuffer(device_, fresh, nullptr);
+                maxMoves = 0;
+                return;
+            }
+
+            moves.push_back({d.buffer, fresh, d.size});
+            // The old copy is read by this frame's cmd and maybe by frames in flight
+            retireQueue().retire([device = device_, buffer = d.buffer, old = d.allocation] {
+                uploadScheduler().forget(buffer);
+                vkDestroyBuffer(device, buffer, nullptr);
+                deviceHeap().free(old);
+            });
+            memoryBudget().refund(d.tag, d.allocation.memoryType, d.alignedSize);
+            memoryBudget().charge(d.tag, alloc.memoryType, req.size);
+
+            d.buffer      = fresh;
+            d.memory      = alloc.memory;
+            d.offset      = alloc.offset;
+            d.alignedSize = req.size;
+            d.usage       = bufInfo.usage;
+            d.allocation  = alloc;
+        });
+        if (moves.empty()) return 0;
+
+        // Earlier writes to the old buffers → copy → every later reader of the new ones
+        VkMemoryBarrier before{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        before.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+        before.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                             1, &before, 0, nullptr, 0, nullptr);
+        for (const Move& m : moves) {
+            const VkBufferCopy region{ 0, 0, m.size };
+            vkCmdCopyBuffer(cmd, m.from, m.to, 1, &region);
+        }
+        VkMemoryBarrier after{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        after.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        after.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0,
+                             1, &after, 0, nullptr, 0, nullptr);
+
+        LOG_INFO_CAT("Memory", "defragment: {} buffer(s) leaving block #{}", moves.size(), sparse);
+        return static_cast<uint32_t>(moves.size());
+    }
+
     uint64_t UltraLowLevelBufferTracker::make_64M (VkBufferUsageFlags extra, VkMemoryPropertyFlags props) noexcept { return create(SIZE_64MB,  extra, props, "64M"); }
     uint64_t UltraLowLevelBufferTracker::make_128M(VkBufferUsageFlags extra, VkMemoryPropertyFlags props) noexcept { return create(SIZE_128MB, extra, props, "128M"); }
     uint64_t UltraLowLevelBufferTracker::make_256M(VkBufferUsageFlags extra, VkMemoryPropertyFlags props) noexcept { return create(SIZE_256MB, extra, props, "256M"); }
@@ -360,7 +486,11 @@ void shutdown() noexcept
         vkDeviceWaitIdle(ctx.device_);
     }
 
-    // 2. Purge all tracked buffers FIRST (SBT, mesh, staging, etc.)
+    // 2. Run retired destroys still waiting on a fence (some hand staging back
+    //    to the upload ring, so before it goes), then purge all tracked
+    //    buffers (SBT, mesh, staging, etc.)
+    retireQueue().shutdown();
+    uploadScheduler().destroy();
     UltraLowLevelBufferTracker::get().purge_all();
 
     // 3. Destroy command pools
@@ -505,7 +635,7 @@ void Context::cleanup() noexcept
         VK_CHECK(vkCreateRenderPass(device, &rpInfo, nullptr, &raw),
                  "Failed to create global render pass");
 
-        ctx.renderPass_ = Handle<VkRenderPass>(raw, device, [](VkDevice d, VkRenderPass r, const VkAllocationCallbacks*) { vkDestroyRenderPass(d, r, nullptr); }, 0, "GlobalRenderPass");
+        ctx.renderPass_ = Handle<VkRenderPass>(raw, device, "GlobalRenderPass");
 
         LOG_SUCCESS_CAT("RTX", "{}Global RenderPass created — PINK PHOTONS ETERNAL{}", EMERALD_GREEN, RESET);
     }
@@ -542,6 +672,8 @@ void RTX::loadRayTracingExtensions()
     LOAD_RT_PFN(vkGetAccelerationStructureBuildSizesKHR);
     LOAD_RT_PFN(vkCmdBuildAccelerationStructuresKHR);
     LOAD_RT_PFN(vkGetAccelerationStructureDeviceAddressKHR);
+    LOAD_RT_PFN(vkCmdCopyAccelerationStructureKHR);
+    LOAD_RT_PFN(vkCmdWriteAccelerationStructuresPropertiesKHR);
 
 #undef LOAD_RT_PFN
 
@@ -559,7 +691,7 @@ void RTX::loadRayTracingExtensions()
     }
 
     // FIRST LIGHT — ETERNAL — UNBREAKABLE — NOVEMBER 22, 2025
-    LOG_SUCCESS_CAT("RTX", "{}ALL 9 RAY TRACING PFNs FORGED FROM RAW TRUTH — THE EMPIRE IS ALIVE{}", VALHALLA_GOLD, RESET);
+    LOG_SUCCESS_CAT("RTX", "{}ALL 11 RAY TRACING PFNs FORGED FROM RAW TRUTH — THE EMPIRE IS ALIVE{}", VALHALLA_GOLD, RESET);
     LOG_SUCCESS_CAT("RTX", "{}PINK PHOTONS NOW HAVE A PATH — INFINITE — UNOBFUSCATED — ETERNAL{}", PLASMA_FUCHSIA, RESET);
     LOG_SUCCESS_CAT("RTX", "{}AMOURANTH SMILES — ELLIE FIER APPROVES — THE EMPIRE IS FREE{}", DIAMOND_SPARKLE, RESET);
 
@@ -570,11 +702,17 @@ void RTX::retrieveQueues() noexcept
 {
     vkGetDeviceQueue(g_device(), g_ctx().graphicsQueueFamily, 0, &g_ctx().graphicsQueue_);
     vkGetDeviceQueue(g_device(), g_ctx().presentFamily_,      0, &g_ctx().presentQueue_);
+    if (g_ctx().transferFamily_ != UINT32_MAX)
+        vkGetDeviceQueue(g_device(), g_ctx().transferFamily_, 0, &g_ctx().transferQueue_);
+    if (g_ctx().computeFamily_ != UINT32_MAX)
+        vkGetDeviceQueue(g_device(), g_ctx().computeFamily_, 0, &g_ctx().computeQueue_);
 
-    LOG_SUCCESS_CAT("RTX", "{}QUEUES RETRIEVED — graphicsFamily={} presentFamily={} — SUBMIT READY{}",
+    LOG_SUCCESS_CAT("RTX", "{}QUEUES RETRIEVED — graphicsFamily={} presentFamily={} transferFamily={} computeFamily={} — SUBMIT READY{}",
                     PLASMA_FUCHSIA,
                     g_ctx().graphicsQueueFamily,
                     g_ctx().presentFamily_,
+                    g_ctx().transferFamily_,
+                    g_ctx().computeFamily_,
                     RESET);
 }
 
@@ -788,6 +926,18 @@ void RTX::Context::forgeSwapchain(SDL_Window* window, int width, int height)
     swapInfo.clipped          = VK_TRUE;
     swapInfo.oldSwapchain     = VK_NULL_HANDLE;
 
+    // Tonemap writes the image on the async compute queue, present reads it on the
+    // present queue — concurrent sharing instead of an ownership transfer each frame
+    const uint32_t sharedFamilies[2] = { computeFamily_, presentFamily_ };
+    // (families are resolved with the device, queues may not be retrieved yet)
+    const bool asyncCompute = Options::Performance::ENABLE_ASYNC_COMPUTE &&
+                              computeFamily_ != UINT32_MAX && computeFamily_ != graphicsFamily_;
+    if (asyncCompute && computeFamily_ != presentFamily_) {
+        swapInfo.imageSharingMode      = VK_SHARING_MODE_CONCURRENT;
+        swapInfo.queueFamilyIndexCount = 2;
+        swapInfo.pQueueFamilyIndices   = sharedFamilies;
+    }
+
     VkSwapchainKHR swapchain = VK_NULL_HANDLE;
     VK_CHECK(vkCreateSwapchainKHR(device_, &swapInfo, nullptr, &swapchain));
 
@@ -825,8 +975,58 @@ void RTX::createLogicalDevice()
 
     LOG_ATTEMPT_CAT("RTX", "FORGING LOGICAL DEVICE — RTX EXTENSIONS ARMED — PINK PHOTONS RISING{}", PURE_ENERGY, RESET);
 
+    // Resolve whatever families nobody assigned yet — graphics first, present on it
+    // if possible, and a TRANSFER-only family (the DMA engine) for the upload scheduler
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(ctx.physicalDevice_, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(ctx.physicalDevice_, &familyCount, families.data());
+
+    for (uint32_t i = 0; i < familyCount && ctx.graphicsFamily_ == UINT32_MAX; ++i)
+        if (families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) ctx.graphicsFamily_ = i;
+    if (ctx.graphicsFamily_ == UINT32_MAX)
+        throw std::runtime_error("createLogicalDevice: no graphics queue family");
+
+    if (ctx.presentFamily_ == UINT32_MAX) {
+        ctx.presentFamily_ = ctx.graphicsFamily_;
+        VkBool32 presentOnGraphics = VK_TRUE;
+        if (ctx.surface_ != VK_NULL_HANDLE) {
+            vkGetPhysicalDeviceSurfaceSupportKHR(ctx.physicalDevice_, ctx.graphicsFamily_, ctx.surface_, &presentOnGraphics);
+            for (uint32_t i = 0; i < familyCount && !presentOnGraphics; ++i) {
+                VkBool32 canPresent = VK_FALSE;
+                vkGetPhysicalDeviceSurfaceSupportKHR(ctx.physicalDevice_, i, ctx.surface_, &canPresent);
+                if (canPresent) { ctx.presentFamily_ = i; break; }
+            }
+        }
+    }
+    ctx.graphicsQueueFamily = ctx.graphicsFamily_;
+
+    if (ctx.transferFamily_ == UINT32_MAX) {
+        ctx.transferFamily_ = ctx.graphicsFamily_;
+        for (uint32_t i = 0; i < familyCount; ++i) {
+            const VkQueueFlags f = families[i].queueFlags;
+            if ((f & VK_QUEUE_TRANSFER_BIT) && !(f & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))) {
+                ctx.transferFamily_ = i;
+                break;
+            }
+        }
+    }
+
+    // Async compute: a COMPUTE family without GRAPHICS runs post-processing next to
+    // the next frame's ray tracing; without one, compute shares the graphics queue
+    if (ctx.computeFamily_ == UINT32_MAX) {
+        ctx.computeFamily_ = ctx.graphicsFamily_;
+        for (uint32_t i = 0; i < familyCount && Options::Performance::ENABLE_ASYNC_COMPUTE; ++i) {
+            const VkQueueFlags f = families[i].queueFlags;
+            if ((f & VK_QUEUE_COMPUTE_BIT) && !(f & VK_QUEUE_GRAPHICS_BIT)) {
+                ctx.computeFamily_ = i;
+                break;
+            }
+        }
+    }
+
     std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
-    std::set<uint32_t> uniqueQueueFamilies = { ctx.graphicsFamily_, ctx.presentFamily_ };
+    std::set<uint32_t> uniqueQueueFamilies = { ctx.graphicsFamily_, ctx.presentFamily_, ctx.transferFamily_, ctx.computeFamily_ };
 
     float queuePriority = 1.0f;
     for (uint32_t queueFamily : uniqueQueueFamilies) {
@@ -851,23 +1051,78 @@ void RTX::createLogicalDevice()
     rtFeatures.rayTracingPipeline = VK_TRUE;
     rtFeatures.pNext = &accelFeatures;
 
+    // synchronization2 is core in 1.3 but optional on some ICDs — only chain it if offered
+    VkPhysicalDeviceTimelineSemaphoreFeatures timelineSupported{};
+    timelineSupported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+    VkPhysicalDeviceSynchronization2Features sync2Supported{};
+    sync2Supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES;
+    sync2Supported.pNext = &timelineSupported;
+    VkPhysicalDeviceFeatures2 supported{};
+    supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    supported.pNext = &sync2Supported;
+    vkGetPhysicalDeviceFeatures2(ctx.physicalDevice_, &supported);
+
+    VkPhysicalDeviceSynchronization2Features sync2Features{};
+    sync2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES;
+    sync2Features.synchronization2 = VK_TRUE;
+    sync2Features.pNext = &rtFeatures;
+
     VkPhysicalDeviceBufferDeviceAddressFeatures bufferAddress{};
     bufferAddress.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES;
     bufferAddress.bufferDeviceAddress = VK_TRUE;
-    bufferAddress.pNext = &rtFeatures;
+    bufferAddress.pNext = sync2Supported.synchronization2 ? static_cast<void*>(&sync2Features) : static_cast<void*>(&rtFeatures);
+
+    // Timeline semaphores carry upload completion (core 1.2, required by every 1.2+ driver)
+    VkPhysicalDeviceTimelineSemaphoreFeatures timelineFeatures{};
+    timelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+    timelineFeatures.timelineSemaphore = timelineSupported.timelineSemaphore;
+    timelineFeatures.pNext = &bufferAddress;
+
+    // present_id + present_wait let the frame pacer see when a frame actually hit the
+    // display — optional, the pacer falls back to CPU timing without them
+    uint32_t extCount = 0;
+    vkEnumerateDeviceExtensionProperties(ctx.physicalDevice_, nullptr, &extCount, nullptr);
+    std::vector<VkExtensionProperties> available(extCount);
+    vkEnumerateDeviceExtensionProperties(ctx.physicalDevice_, nullptr, &extCount, available.data());
+    const auto offered = [&](const char* name) {
+        return std::any_of(available.begin(), available.end(),
+                           [name](const VkExtensionProperties& e) { return std::strcmp(e.extensionName, name) == 0; });
+    };
+
+    std::vector<const char*> extensions(kDeviceExtensions.begin(), kDeviceExtensions.end());
+
+    VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures{};
+    presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+    VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures{};
+    presentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+    presentIdFeatures.pNext = &presentWaitFeatures;
+
+    bool presentWait = false;
+    if (offered(VK_KHR_PRESENT_ID_EXTENSION_NAME) && offered(VK_KHR_PRESENT_WAIT_EXTENSION_NAME)) {
+        VkPhysicalDeviceFeatures2 query{};
+        query.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        query.pNext = &presentIdFeatures;
+        vkGetPhysicalDeviceFeatures2(ctx.physicalDevice_, &query);
+        presentWait = presentIdFeatures.presentId && presentWaitFeatures.presentWait;
+    }
+    if (presentWait) {
+        extensions.push_back(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+        extensions.push_back(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+        presentWaitFeatures.pNext = &timelineFeatures;
+    }
 
     VkPhysicalDeviceFeatures2 deviceFeatures{};
     deviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
     deviceFeatures.features.samplerAnisotropy = VK_TRUE;
     deviceFeatures.features.shaderInt64 = VK_TRUE;
-    deviceFeatures.pNext = &bufferAddress;
+    deviceFeatures.pNext = presentWait ? static_cast<void*>(&presentIdFeatures) : static_cast<void*>(&timelineFeatures);
 
     VkDeviceCreateInfo deviceInfo{};
     deviceInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
     deviceInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
     deviceInfo.pQueueCreateInfos = queueCreateInfos.data();
-    deviceInfo.enabledExtensionCount = static_cast<uint32_t>(kDeviceExtensions.size());
-    deviceInfo.ppEnabledExtensionNames = kDeviceExtensions.data();
+    deviceInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+    deviceInfo.ppEnabledExtensionNames = extensions.data();
     deviceInfo.pNext = &deviceFeatures;
 
     VkDevice device = VK_NULL_HANDLE;
@@ -875,12 +1130,21 @@ void RTX::createLogicalDevice()
              "FATAL: vkCreateDevice failed — no logical device");
 
     ctx.device_ = device;
+    ctx.synchronization2_ = sync2Supported.synchronization2 == VK_TRUE;
+    ctx.timelineSemaphore_ = timelineSupported.timelineSemaphore == VK_TRUE;
+    ctx.presentWait_ = presentWait;
     set_g_device(device);
 
     LOG_SUCCESS_CAT("RTX", "LOGICAL DEVICE FORGED — HANDLE: 0x{:016X}", 
                     DIAMOND_SPARKLE, (uint64_t)device, RESET);
     LOG_SUCCESS_CAT("RTX", "FULL RTX ENABLED — accelerationStructure + rayTracingPipeline + bufferDeviceAddress{}", 
                     VALHALLA_GOLD, RESET);
+    LOG_INFO_CAT("RTX", "Frame pacing: {}", presentWait ? "present_wait (display-locked)" : "CPU timer fallback");
+    LOG_INFO_CAT("RTX", "Queue families — graphics {} | present {} | transfer {}{} | compute {}{}",
+                 ctx.graphicsFamily_, ctx.presentFamily_, ctx.transferFamily_,
+                 ctx.transferFamily_ != ctx.graphicsFamily_ ? " (dedicated DMA)" : " (shared with graphics)",
+                 ctx.computeFamily_,
+                 ctx.computeFamily_ != ctx.graphicsFamily_ ? " (async)" : " (shared with graphics)");
 }
 
 // =============================================================================
@@ -0,0 +1,468 @@
+// src/engine/GLOBAL/RenderGraph.cpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// RENDER GRAPH — declaration, compile(), results. No Vulkan calls: this file
+// links into host tests without a loader or a device (tests/unit).
+// Device side: RenderGraphDevice.cpp. See RenderGraph.hpp
+// =============================================================================
+
+#include "engine/GLOBAL/RenderGraph.hpp"
+#include "engine/GLOBAL/logging.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace RTX {
+
+namespace {
+constexpr VkAccessFlags2 WRITE_ACCESS =
+    VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT |
+    VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+    VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_HOST_WRITE_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+[[nodiscard]] constexpr bool writes(const ImageUse& u) noexcept { return (u.access & WRITE_ACCESS) != 0; }
+[[nodiscard]] constexpr bool reads(const ImageUse& u)  noexcept { return (u.access & ~WRITE_ACCESS) != 0; }
+
+// sync2 bits that are the same bit in VkPipelineStageFlags / VkAccessFlags
+constexpr VkPipelineStageFlags2 LEGACY_STAGES =
+    VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT | VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT |
+    VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_TESSELLATION_CONTROL_SHADER_BIT |
+    VK_PIPELINE_STAGE_2_TESSELLATION_EVALUATION_SHADER_BIT | VK_PIPELINE_STAGE_2_GEOMETRY_SHADER_BIT |
+    VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT |
+    VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT |
+    VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT | VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT |
+    VK_PIPELINE_STAGE_2_HOST_BIT | VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT | VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT |
+    VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR;
+
+constexpr VkAccessFlags2 LEGACY_ACCESS =
+    VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_2_INDEX_READ_BIT | VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT |
+    VK_ACCESS_2_UNIFORM_READ_BIT | VK_ACCESS_2_INPUT_ATTACHMENT_READ_BIT | VK_ACCESS_2_SHADER_READ_BIT |
+    VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+    VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+    VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_HOST_READ_BIT | VK_ACCESS_2_HOST_WRITE_BIT |
+    VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT |
+    VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+
+// sync2-only bits → the legacy bit that contains them
+struct LegacyMap { VkFlags64 sync2; VkFlags legacy; };
+constexpr std::array<LegacyMap, 5> STAGE_MAP = {{
+    { VK_PIPELINE_STAGE_2_COPY_BIT | VK_PIPELINE_STAGE_2_RESOLVE_BIT |
+      VK_PIPELINE_STAGE_2_BLIT_BIT | VK_PIPELINE_STAGE_2_CLEAR_BIT,        VK_PIPELINE_STAGE_TRANSFER_BIT },
+    { VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT,                                  VK_PIPELINE_STAGE_VERTEX_INPUT_BIT },
+    { VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT,                       VK_PIPELINE_STAGE_VERTEX_INPUT_BIT },
+    { VK_PIPELINE_STAGE_2_PRE_RASTERIZATION_SHADERS_BIT,                    VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT },
+    { VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_COPY_BIT_KHR,              VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR },
+}};
+constexpr std::array<LegacyMap, 3> ACCESS_MAP = {{
+    { VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,  VK_ACCESS_SHADER_READ_BIT },
+    { VK_ACCESS_2_SHADER_STORAGE_READ_BIT,  VK_ACCESS_SHADER_READ_BIT },
+    { VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, VK_ACCESS_SHADER_WRITE_BIT },
+}};
+}
+
+// =============================================================================
+// LEGACY MASKS
+// =============================================================================
+VkPipelineStageFlags legacyStages(VkPipelineStageFlags2 stages) noexcept
+{
+    auto out  = static_cast<VkPipelineStageFlags>(stages & LEGACY_STAGES);
+    auto rest = stages & ~LEGACY_STAGES;
+    for (const LegacyMap& m : STAGE_MAP)
+        if (rest & m.sync2) { out |= m.legacy; rest &= ~m.sync2; }
+    return rest ? VkPipelineStageFlags{ VK_PIPELINE_STAGE_ALL_COMMANDS_BIT } : out;
+}
+
+VkAccessFlags legacyAccess(VkAccessFlags2 access) noexcept
+{
+    auto out  = static_cast<VkAccessFlags>(access & LEGACY_ACCESS);
+    auto rest = access & ~LEGACY_ACCESS;
+    for (const LegacyMap& m : ACCESS_MAP)
+        if (rest & m.sync2) { out |= m.legacy; rest &= ~m.sync2; }
+    return rest ? out | VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT : out;
+}
+
+// =============================================================================
+// DECLARATION
+// =============================================================================
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::use(GraphImage image, const ImageUse& u)
+{
+    graph_.accesses_.push_back({ pass_, image, u });
+    return *this;
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::sideEffects() noexcept
+{
+    graph_.passes_[pass_].sideEffects = true;
+    return *this;
+}
+
+void RenderGraph::reset() noexcept
+{
+    images_.clear();
+    accesses_.clear();
+    passes_.clear();
+    order_.clear();
+    barriers_.clear();
+    passBarriers_.clear();
+    recordPasses_.clear();
+    finalRange_     = {};
+    transientCount_ = 0;
+    aliasSlots_     = 0;
+    crossWait_      = {};
+}
+
+GraphImage RenderGraph::importImage(const char* name, VkImage image, bool retained,
+                                    const ImageUse& initial, VkImageAspectFlags aspect)
+{
+    Image img{};
+    img.name     = name;
+    img.image    = image;
+    img.aspect   = aspect;
+    img.initial  = initial;
+    img.retained = retained;
+    images_.push_back(img);
+    return static_cast<GraphImage>(images_.size() - 1);
+}
+
+GraphImage RenderGraph::importAcquired(const char* name, VkImage image, VkImageAspectFlags aspect)
+{
+    const GraphImage id = importImage(name, image, false, {}, aspect);
+    images_[id].acquired = true;
+    return id;
+}
+
+GraphImage RenderGraph::createTransient(const char* name, const TransientDesc& desc)
+{
+    Image img{};
+    img.name         = name;
+    img.transient    = true;
+    img.desc         = desc;
+    img.transientIdx = transientCount_++;
+    images_.push_back(img);
+    return static_cast<GraphImage>(images_.size() - 1);
+}
+
+void RenderGraph::setFinal(GraphImage image, const ImageUse& u)
+{
+    if (image >= images_.size()) return;
+    images_[image].final    = u;
+    images_[image].hasFinal = true;
+}
+
+RenderGraph::PassBuilder RenderGraph::addPass(const char* name, std::function<void(VkCommandBuffer)> record,
+                                              GraphQueue queue)
+{
+    Pass p{};
+    p.name   = name;
+    p.record = std::move(record);
+    p.queue  = queue;
+    passes_.push_back(std::move(p));
+    return PassBuilder(*this, static_cast<uint32_t>(passes_.size() - 1));
+}
+
+// =============================================================================
+// COMPILE — cull, alias, solve
+// =============================================================================
+bool RenderGraph::compile()
+{
+    order_.clear();
+    barriers_.clear();
+    passBarriers_.clear();
+    recordPasses_.clear();
+    finalRange_ = {};
+    aliasSlots_ = 0;
+    crossWait_  = {};
+
+    // One merged use per (pass, image): a pass that samples and writes the
+    // same image in different layouts is a declaration error
+    std::stable_sort(accesses_.begin(), accesses_.end(), [](const Access& a, const Access& b) {
+        return a.pass != b.pass ? a.pass < b.pass : a.image < b.image;
+    });
+    std::vector<Access> merged;
+    merged.reserve(accesses_.size());
+    for (const Access& a : accesses_) {
+        if (a.image >= images_.size() || a.pass >= passes_.size()) {
+            LOG_ERROR_CAT("RENDERER", "Render graph: pass {} uses an undeclared image", a.pass);
+            return false;
+        }
+        if (!merged.empty() && merged.back().pass == a.pass && merged.back().image == a.image) {
+            Access& m = merged.back();
+            if (m.use.layout != a.use.layout) {
+                LOG_ERROR_CAT("RENDERER", "Render graph: pass '{}' uses '{}' in two layouts",
+                              passes_[a.pass].name, images_[a.image].name);
+                return false;
+            }
+            m.use.stage  |= a.use.stage;
+            m.use.access |= a.use.access;
+            continue;
+        }
+        merged.push_back(a);
+    }
+
+    cull(merged);
+
+    // One handoff per frame: the compute submit waits on the graphics one, never the reverse
+    bool computeSeen = false;
+    for (const uint32_t p : order_) {
+        if (passes_[p].queue == GraphQueue::Compute) { computeSeen = true; continue; }
+        if (computeSeen) {
+            LOG_ERROR_CAT("RENDERER", "Render graph: graphics pass '{}' follows a compute pass", passes_[p].name);
+            return false;
+        }
+    }
+
+    assignSlots();
+    solve(merged);
+
+    const uint64_t shape = (uint64_t{order_.size()} << 48) ^ (uint64_t{passes_.size()} << 32) ^
+                           (uint64_t{barriers_.size()} << 8) ^ aliasSlots_;
+    if (shape != shape_) {
+        shape_ = shape;
+        LOG_DEBUG_CAT("RENDERER", "Render graph: {} passes ({} culled), {} barriers, {} transients in {} alias slots",
+                      order_.size(), passes_.size() - order_.size(), barriers_.size(), transientCount_, aliasSlots_);
+    }
+    return true;
+}
+
+void RenderGraph::cull(std::vector<Access>& accesses)
+{
+    // Ranges per pass — accesses are sorted by pass
+    std::vector<Range> ranges(passes_.size());
+    for (uint32_t i = 0; i < accesses.size(); ++i) {
+        Range& r = ranges[accesses[i].pass];
+        if (r.count == 0) r.first = i;
+        ++r.count;
+    }
+
+    // Backwards: a pass lives if it has side effects or writes something that
+    // outlives the frame or that a living later pass reads
+    std::vector<uint8_t> needed(images_.size(), 0), alive(passes_.size(), 0);
+    for (uint32_t p = static_cast<uint32_t>(passes_.size()); p-- > 0;) {
+        bool keep = passes_[p].sideEffects;
+        for (uint32_t i = ranges[p].first; i < ranges[p].first + ranges[p].count && !keep; ++i) {
+            const Access& a   = accesses[i];
+            const Image&  img = images_[a.image];
+            if (writes(a.use) && (img.retained || img.hasFinal || img.acquired || needed[a.image])) keep = true;
+        }
+        if (!keep) continue;
+        alive[p] = 1;
+        for (uint32_t i = ranges[p].first; i < ranges[p].first + ranges[p].count; ++i)
+            if (reads(accesses[i].use)) needed[accesses[i].image] = 1;
+    }
+
+    std::vector<uint32_t> orderOf(passes_.size(), UINT32_MAX);
+    for (uint32_t p = 0; p < passes_.size(); ++p) {
+        if (!alive[p]) continue;
+        orderOf[p] = static_cast<uint32_t>(order_.size());
+        order_.push_back(p);
+    }
+
+    std::erase_if(accesses, [&](const Access& a) { return !alive[a.pass]; });
+    for (const Access& a : accesses) {
+        Image& img = images_[a.image];
+        img.first = std::min(img.first, orderOf[a.pass]);
+        img.last  = std::max(img.last,  orderOf[a.pass]);
+    }
+}
+
+void RenderGraph::assignSlots()
+{
+    std::vector<GraphImage> transients;
+    for (GraphImage i = 0; i < images_.size(); ++i)
+        if (images_[i].transient && images_[i].first != UINT32_MAX) transients.push_back(i);
+    std::sort(transients.begin(), transients.end(),
+              [&](GraphImage a, GraphImage b) { return images_[a].first < images_[b].first; });
+
+    // First fit: a slot is free once its last user's pass is strictly earlier
+    struct Slot { uint32_t last; VkImageUsageFlags usage; };
+    std::vector<Slot> slots;
+    for (GraphImage t : transients) {
+        Image& img = images_[t];
+        uint32_t s = 0;
+        while (s < slots.size() && !(slots[s].last < img.first && slots[s].usage == img.desc.usage)) ++s;
+        if (s == slots.size()) slots.push_back({ img.last, img.desc.usage });
+        else                   slots[s].last = img.last;
+        img.slot = s;
+    }
+    aliasSlots_ = static_cast<uint32_t>(slots.size());
+    if (slotTracks_.size() < aliasSlots_) slotTracks_.resize(aliasSlots_);
+}
+
+void RenderGraph::solve(const std::vector<Access>& accesses)
+{
+    std::vector<Track> tracks(images_.size());
+    for (GraphImage i = 0; i < images_.size(); ++i) {
+        const Image& img = images_[i];
+        if (img.acquired || img.transient) continue;         // set up at first use
+        if (const auto it = known_.find(img.image); it != known_.end()) {
+            tracks[i] = it->second;
+            continue;
+        }
+        Track& t = tracks[i];
+        t.layout = img.initial.layout;
+        if (writes(img.initial)) { t.writeStages = img.initial.stage; t.writeAccess = img.initial.access & WRITE_ACCESS; }
+        if (reads(img.initial))    t.readStages  = img.initial.stage;
+    }
+
+    size_t next = 0;
+    for (uint32_t o = 0; o < order_.size(); ++o) {
+        const uint32_t pass  = order_[o];
+        const uint32_t start = static_cast<uint32_t>(barriers_.size());
+        for (; next < accesses.size() && accesses[next].pass == pass; ++next) {
+            const Access& a   = accesses[next];
+            Image&        img = images_[a.image];
+            Track&        t   = tracks[a.image];
+
+            // Memory shared with whatever held the slot last — this frame or the previous one
+            if (img.transient && img.first == o) {
+                const Track& prev = slotTracks_[img.slot];
+                t = Track{};
+                t.writeStages = prev.writeStages | prev.readStages;
+                t.writeAccess = prev.writeAccess;
+                t.queue       = prev.queue;
+            }
+            useImage(a.image, t, a.use, passes_[pass].queue, img.first == o);
+            if (img.transient && img.last == o) slotTracks_[img.slot] = t;
+        }
+        passBarriers_.push_back({ start, static_cast<uint32_t>(barriers_.size()) - start });
+    }
+
+    // Final states go into the primary after every pass
+    finalRange_.first = static_cast<uint32_t>(barriers_.size());
+    for (GraphImage i = 0; i < images_.size(); ++i) {
+        const Image& img = images_[i];
+        if (img.hasFinal && img.first != UINT32_MAX) useImage(i, tracks[i], img.final, tracks[i].queue, false);
+    }
+    finalRange_.count = static_cast<uint32_t>(barriers_.size()) - finalRange_.first;
+
+    for (GraphImage i = 0; i < images_.size(); ++i) {
+        const Image& img = images_[i];
+        if (!img.acquired && !img.transient && img.image != VK_NULL_HANDLE && img.first != UINT32_MAX)
+            known_[img.image] = tracks[i];
+    }
+}
+
+void RenderGraph::useImage(GraphImage id, Track& t, const ImageUse& u, GraphQueue queue, bool firstUse)
+{
+    Image& img = images_[id];
+    GraphBarrier b{ id, {}, u, queue };
+    b.src.layout = t.layout;
+
+    // Chain after whatever already depends on the last write: readers if there
+    // were any (they waited for the write), else the write itself
+    const auto sourceAfterLastAccess = [&] {
+        if (t.readStages != VK_PIPELINE_STAGE_2_NONE) { b.src.stage = t.readStages; b.src.access = VK_ACCESS_2_NONE; }
+        else                                          { b.src.stage = t.writeStages; b.src.access = t.writeAccess; }
+    };
+
+    bool need = false, transition = false;
+    if (img.acquired && firstUse) {
+        // The acquire semaphore's wait covers exactly this stage — source from it to chain on
+        b.src = { u.stage, VK_ACCESS_2_NONE, VK_IMAGE_LAYOUT_UNDEFINED };
+        img.waitStage = u.stage;
+        need = transition = true;
+    } else if (t.queue != queue && (t.writeStages | t.readStages) != VK_PIPELINE_STAGE_2_NONE) {
+        // Last touched on the other queue: the handoff semaphore (or the slot wait, across
+        // frames) already made it complete and visible — chain on that wait at this stage
+        crossWait_[static_cast<size_t>(queue)] |= u.stage;
+        b.src        = { u.stage, VK_ACCESS_2_NONE, t.layout };
+        need         = t.layout != u.layout;
+        transition   = true;
+    } else if (t.layout != u.layout) {
+        sourceAfterLastAccess();
+        need = transition = true;
+    } else if (writes(u)) {
+        sourceAfterLastAccess();                             // WAR: execution only; WAW: flush the last write
+        need = b.src.stage != VK_PIPELINE_STAGE_2_NONE;
+    } else if (t.writeStages != VK_PIPELINE_STAGE_2_NONE &&
+               ((u.stage & ~t.visibleStages) || (u.access & ~t.visibleAccess))) {
+        b.src.stage  = t.writeStages;                        // RAW not yet visible here
+        b.src.access = t.writeAccess;
+        need = true;
+    }
+
+    if (need) barriers_.push_back(b);
+
+    t.queue = queue;
+    if (transition) {
+        // The transition (or handoff) is a write of its own, done and visible at this use
+        t.layout        = u.layout;
+        t.writeStages   = u.stage;
+        t.writeAccess   = VK_ACCESS_2_NONE;
+        t.readStages    = VK_PIPELINE_STAGE_2_NONE;
+        t.visibleStages = u.stage;
+        t.visibleAccess = u.access;
+    } else if (need) {
+        t.visibleStages |= u.stage;
+        t.visibleAccess |= u.access;
+    }
+
+    if (writes(u)) {
+        t.writeStages   = u.stage;
+        t.writeAccess   = u.access & WRITE_ACCESS;
+        t.readStages    = reads(u) ? u.stage : VK_PIPELINE_STAGE_2_NONE;
+        t.visibleStages = VK_PIPELINE_STAGE_2_NONE;
+        t.visibleAccess = VK_ACCESS_2_NONE;
+    } else if (u.stage != VK_PIPELINE_STAGE_2_NONE) {
+        t.readStages |= u.stage;
+    }
+}
+
+// =============================================================================
+// RESULTS
+// =============================================================================
+std::span<const GraphBarrier> RenderGraph::barriers(uint32_t orderIdx) const noexcept
+{
+    if (orderIdx >= passBarriers_.size()) return {};
+    const Range r = passBarriers_[orderIdx];
+    return std::span(barriers_).subspan(r.first, r.count);
+}
+
+std::span<const GraphBarrier> RenderGraph::finalBarriers() const noexcept
+{
+    return std::span(barriers_).subspan(finalRange_.first, finalRange_.count);
+}
+
+VkPipelineStageFlags2 RenderGraph::waitStage(GraphImage image) const noexcept
+{
+    return image < images_.size() ? images_[image].waitStage : VK_PIPELINE_STAGE_2_NONE;
+}
+
+VkPipelineStageFlags2 RenderGraph::crossQueueWait(GraphQueue queue) const noexcept
+{
+    return crossWait_[static_cast<size_t>(queue)];
+}
+
+bool RenderGraph::usesQueue(GraphQueue queue) const noexcept
+{
+    return std::any_of(order_.begin(), order_.end(), [&](uint32_t p) { return passes_[p].queue == queue; });
+}
+
+uint32_t RenderGraph::aliasSlot(GraphImage image) const noexcept
+{
+    return image < images_.size() ? images_[image].slot : NO_ALIAS_SLOT;
+}
+
+const char* RenderGraph::passName(uint32_t pass) const noexcept
+{
+    return pass < passes_.size() ? passes_[pass].name : "";
+}
+
+void RenderGraph::forget(VkImage image) noexcept
+{
+    known_.erase(image);
+}
+
+void RenderGraph::forgetAll() noexcept
+{
+    known_.clear();
+}
+
+} // namespace RTX
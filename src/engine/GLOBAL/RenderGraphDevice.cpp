@@ -0,0 +1,237 @@
+// src/engine/GLOBAL/RenderGraphDevice.cpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// RENDER GRAPH — device side: transient images + memory, barrier recording.
+// The solver it records from is RenderGraph.cpp. See RenderGraph.hpp
+// =============================================================================
+
+#include "engine/GLOBAL/RenderGraph.hpp"
+#include "engine/GLOBAL/DeferredDestroy.hpp"
+#include "engine/GLOBAL/logging.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace RTX {
+
+namespace {
+constexpr uint32_t BARRIER_BATCH = 16;
+}
+
+// =============================================================================
+// DEVICE SIDE
+// =============================================================================
+bool RenderGraph::realizeTransients(VkDevice device)
+{
+    std::vector<Realized> wanted(transientCount_);
+    for (const Image& img : images_)
+        if (img.transient) wanted[img.transientIdx] = { img.desc, img.slot };
+
+    const auto same = [&] {
+        if (device != device_ || wanted.size() != realized_.size()) return false;
+        for (size_t i = 0; i < wanted.size(); ++i) {
+            const Realized& a = wanted[i];
+            const Realized& b = realized_[i];
+            if (a.slot != b.slot || a.desc.format != b.desc.format || a.desc.usage != b.desc.usage ||
+                a.desc.extent.width != b.desc.extent.width || a.desc.extent.height != b.desc.extent.height) return false;
+        }
+        return true;
+    };
+
+    if (!same()) {
+        releaseTransients();
+        device_ = device;
+
+        // Culled transients keep no slot and get no image
+        std::vector<VkMemoryRequirements> slotReq(aliasSlots_, VkMemoryRequirements{ 0, 1, ~0u });
+        for (Realized& r : wanted) {
+            if (r.slot == NO_ALIAS_SLOT) continue;
+            VkImageCreateInfo info{ VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+            info.imageType     = VK_IMAGE_TYPE_2D;
+            info.format        = r.desc.format;
+            info.extent        = { r.desc.extent.width, r.desc.extent.height, 1 };
+            info.mipLevels     = 1;
+            info.arrayLayers   = 1;
+            info.samples       = VK_SAMPLE_COUNT_1_BIT;
+            info.tiling        = VK_IMAGE_TILING_OPTIMAL;
+            info.usage         = r.desc.usage;
+            info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            if (vkCreateImage(device_, &info, nullptr, &r.image) != VK_SUCCESS) {
+                LOG_ERROR_CAT("RENDERER", "Render graph: transient image creation failed");
+                realized_ = std::move(wanted);
+                releaseTransients();
+                return false;
+            }
+            VkMemoryRequirements req{};
+            vkGetImageMemoryRequirements(device_, r.image, &req);
+            VkMemoryRequirements& s = slotReq[r.slot];
+            s.size            = std::max(s.size, req.size);
+            s.alignment       = std::max(s.alignment, req.alignment);
+            s.memoryTypeBits &= req.memoryTypeBits;
+        }
+        realized_ = std::move(wanted);
+
+        slotMemory_.resize(aliasSlots_);
+        for (uint32_t s = 0; s < aliasSlots_; ++s) {
+            if (slotReq[s].size == 0) continue;
+            if (slotReq[s].memoryTypeBits != 0)
+                slotMemory_[s] = deviceHeap().allocate(slotReq[s], VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                       HeapResource::Optimal, "RenderGraph transient");
+            if (!slotMemory_[s].valid()) {
+                LOG_ERROR_CAT("RENDERER", "Render graph: no memory for alias slot {} ({} bytes)", s, slotReq[s].size);
+                releaseTransients();
+                return false;
+            }
+        }
+
+        for (Realized& r : realized_) {
+            if (r.image == VK_NULL_HANDLE) continue;
+            const HeapAllocation& mem = slotMemory_[r.slot];
+            VkImageViewCreateInfo view{ VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
+            view.image            = r.image;
+            view.viewType         = VK_IMAGE_VIEW_TYPE_2D;
+            view.format           = r.desc.format;
+            view.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+            if (vkBindImageMemory(device_, r.image, mem.memory, mem.offset) != VK_SUCCESS ||
+                vkCreateImageView(device_, &view, nullptr, &r.view) != VK_SUCCESS) {
+                LOG_ERROR_CAT("RENDERER", "Render graph: transient bind/view failed");
+                releaseTransients();
+                return false;
+            }
+        }
+
+        if (!realized_.empty())
+            LOG_INFO_CAT("RENDERER", "Render graph: {} transient image(s) realized in {} alias slot(s)",
+                         realized_.size(), aliasSlots_);
+    }
+
+    for (Image& img : images_)
+        if (img.transient) img.image = realized_[img.transientIdx].image;
+    return true;
+}
+
+VkImageView RenderGraph::transientView(GraphImage image) const noexcept
+{
+    if (image >= images_.size() || !images_[image].transient || images_[image].transientIdx >= realized_.size())
+        return VK_NULL_HANDLE;
+    return realized_[images_[image].transientIdx].view;
+}
+
+void RenderGraph::destroy() noexcept
+{
+    releaseTransients();
+    known_.clear();
+    slotTracks_.clear();
+}
+
+void RenderGraph::releaseTransients() noexcept
+{
+    if (device_ != VK_NULL_HANDLE && (!realized_.empty() || !slotMemory_.empty())) {
+        // Frames in flight may still use them
+        retireQueue().retire([device = device_, realized = std::move(realized_), memory = std::move(slotMemory_)] {
+            for (const Realized& r : realized) {
+                if (r.view  != VK_NULL_HANDLE) vkDestroyImageView(device, r.view, nullptr);
+                if (r.image != VK_NULL_HANDLE) vkDestroyImage(device, r.image, nullptr);
+            }
+            for (const HeapAllocation& a : memory)
+                if (a.valid()) deviceHeap().free(a);
+        });
+    }
+    realized_.clear();
+    slotMemory_.clear();
+    device_ = VK_NULL_HANDLE;
+    for (Image& img : images_)
+        if (img.transient) img.image = VK_NULL_HANDLE;
+}
+
+std::span<const RecordPass> RenderGraph::recordPasses(GraphQueue queue, bool synchronization2)
+{
+    recordPasses_.clear();
+    recordPasses_.reserve(order_.size());
+    for (uint32_t o = 0; o < order_.size(); ++o) {
+        if (passes_[order_[o]].queue != queue) continue;
+        recordPasses_.push_back({ passes_[order_[o]].name, [this, o, synchronization2](VkCommandBuffer c) {
+            recordBarriers(c, barriers(o), synchronization2);
+            if (const auto& body = passes_[order_[o]].record) body(c);
+        } });
+    }
+    return recordPasses_;
+}
+
+void RenderGraph::recordFinal(VkCommandBuffer cmd, GraphQueue queue, bool synchronization2) const noexcept
+{
+    std::vector<GraphBarrier> list;
+    for (const GraphBarrier& b : finalBarriers())
+        if (b.queue == queue) list.push_back(b);
+    recordBarriers(cmd, list, synchronization2);
+}
+
+void RenderGraph::recordBarriers(VkCommandBuffer cmd, std::span<const GraphBarrier> list, bool synchronization2) const noexcept
+{
+    const auto range = [&](const GraphBarrier& b) {
+        return VkImageSubresourceRange{ images_[b.image].aspect, 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS };
+    };
+
+    for (size_t at = 0; at < list.size();) {
+        if (synchronization2) {
+            std::array<VkImageMemoryBarrier2, BARRIER_BATCH> out{};
+            uint32_t n = 0;
+            for (; at < list.size() && n < BARRIER_BATCH; ++at) {
+                const GraphBarrier& b = list[at];
+                if (images_[b.image].image == VK_NULL_HANDLE) continue;
+                VkImageMemoryBarrier2& m = out[n++];
+                m.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+                m.srcStageMask        = b.src.stage;
+                m.srcAccessMask       = b.src.access;
+                m.dstStageMask        = b.dst.stage;
+                m.dstAccessMask       = b.dst.access;
+                m.oldLayout           = b.src.layout;
+                m.newLayout           = b.dst.layout;
+                m.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                m.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                m.image               = images_[b.image].image;
+                m.subresourceRange    = range(b);
+            }
+            if (n == 0) continue;
+            VkDependencyInfo dep{ VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+            dep.imageMemoryBarrierCount = n;
+            dep.pImageMemoryBarriers    = out.data();
+            vkCmdPipelineBarrier2(cmd, &dep);
+        } else {
+            // Legacy: one stage pair per call, masks mapped explicitly — no truncation of 64-bit flags
+            std::array<VkImageMemoryBarrier, BARRIER_BATCH> out{};
+            VkPipelineStageFlags src = 0, dst = 0;
+            uint32_t n = 0;
+            for (; at < list.size() && n < BARRIER_BATCH; ++at) {
+                const GraphBarrier& b = list[at];
+                if (images_[b.image].image == VK_NULL_HANDLE) continue;
+                VkImageMemoryBarrier& m = out[n++];
+                m.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                m.srcAccessMask       = legacyAccess(b.src.access);
+                m.dstAccessMask       = legacyAccess(b.dst.access);
+                m.oldLayout           = b.src.layout;
+                m.newLayout           = b.dst.layout;
+                m.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                m.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                m.image               = images_[b.image].image;
+                m.subresourceRange    = range(b);
+                src |= legacyStages(b.src.stage);
+                dst |= legacyStages(b.dst.stage);
+            }
+            if (n == 0) continue;
+            vkCmdPipelineBarrier(cmd,
+                src ? src : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                dst ? dst : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                0, 0, nullptr, 0, nullptr, n, out.data());
+        }
+    }
+}
+
+} // namespace RTX
@@ -0,0 +1,258 @@
+// src/engine/GLOBAL/StagingRing.cpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// STAGING RING — see StagingRing.hpp
+// =============================================================================
+
+#include "engine/GLOBAL/StagingRing.hpp"
+#include "engine/GLOBAL/RTXHandler.hpp"
+#include "engine/GLOBAL/logging.hpp"
+#include "engine/GLOBAL/Trace.hpp"
+
+#include <algorithm>
+
+namespace RTX {
+
+namespace {
+// Chunk sizes are multiples of this, so virtual and physical offsets share alignment
+constexpr VkDeviceSize CHUNK_GRANULE = 4096;
+constexpr double       MB            = 1048576.0;
+
+[[nodiscard]] constexpr VkDeviceSize alignUp(VkDeviceSize v, VkDeviceSize a) noexcept {
+    return a <= 1 ? v : (v + a - 1) / a * a;
+}
+}
+
+bool StagingRing::init(VkDevice device, VkDeviceSize initialSize, VkDeviceSize maxSize) noexcept
+{
+    destroy();
+    std::lock_guard lock(mutex_);
+    device_  = device;
+    maxSize_ = std::max(maxSize, initialSize);
+    if (!growLocked(initialSize)) return false;
+
+    LOG_SUCCESS_CAT("Upload", "Staging ring online — {:.1f} MB (grows to {:.1f} MB)",
+                    chunks_.back().size / MB, maxSize_ / MB);
+    return true;
+}
+
+void StagingRing::destroy() noexcept
+{
+    std::lock_guard lock(mutex_);
+    if (!chunks_.empty())
+        LOG_DEBUG_CAT("Upload", "Staging ring released — peak {:.1f} MB in flight, {} grows, {} stalls",
+                      highWater_ / MB, grows_, stalls_);
+    for (Chunk& c : chunks_)
+        if (c.enc != 0) UltraLowLevelBufferTracker::get().destroy(c.enc);
+    chunks_.clear();
+    nextId_    = 1;
+    highWater_ = 0;
+    grows_     = 0;
+    stalls_    = 0;
+    polledSemaphore_ = VK_NULL_HANDLE;
+    polledValue_     = 0;
+}
+
+bool StagingRing::growLocked(VkDeviceSize atLeast)
+{
+    VkDeviceSize size = chunks_.empty() ? atLeast : chunks_.back().size * 2;
+    while (size < atLeast) size *= 2;
+    size = alignUp(size, CHUNK_GRANULE);
+
+    uint64_t enc = 0;
+    try {
+        enc = UltraLowLevelBufferTracker::get().create(
+            size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, "StagingRing");
+    } catch (const std::exception& e) {
+        LOG_ERROR_CAT("Upload", "Staging ring: {:.1f} MB buffer creation threw: {}", size / MB, e.what());
+        return false;
+    }
+    auto* cpu = static_cast<uint8_t*>(UltraLowLevelBufferTracker::get().map(enc));
+    if (enc == 0 || cpu == nullptr) {
+        LOG_ERROR_CAT("Upload", "Staging ring: {:.1f} MB buffer is not host-mapped", size / MB);
+        if (enc != 0) UltraLowLevelBufferTracker::get().destroy(enc);
+        return false;
+    }
+
+    // The previous chunk keeps serving its in-flight spans; reclaim destroys it once drained
+    if (!chunks_.empty()) {
+        ++grows_;
+        LOG_INFO_CAT("Upload", "Staging ring grown {:.1f} → {:.1f} MB", chunks_.back().size / MB, size / MB);
+        if (size > maxSize_)
+            LOG_WARN_CAT("Upload", "Staging ring past its {:.1f} MB cap — oldest span not submitted yet", maxSize_ / MB);
+    }
+    chunks_.push_back(Chunk{ enc, RAW_BUFFER(enc), cpu, size, 0, 0, nextId_, {} });
+    reclaimLocked();
+    return true;
+}
+
+// =============================================================================
+// ALLOCATE
+// =============================================================================
+StagingAlloc StagingRing::allocate(VkDeviceSize size, VkDeviceSize alignment)
+{
+    if (size == 0) return {};
+
+    std::unique_lock lock(mutex_);
+    while (!chunks_.empty()) {
+        Chunk& c = chunks_.back();
+        if (size <= c.size) {
+            VkDeviceSize start = alignUp(c.head, alignment);
+            const VkDeviceSize phys = start % c.size;
+            if (phys + size > c.size) start += c.size - phys;           // never straddle the wrap
+            const VkDeviceSize end = start + size;
+
+            if (end - c.tail <= c.size) {
+                const uint64_t id = nextId_++;
+                c.spans.push_back(Span{ id, end });
+                c.head     = end;
+                highWater_ = std::max(highWater_, c.head - c.tail);
+                const VkDeviceSize offset = start % c.size;
+                return StagingAlloc{ c.buffer, offset, size, c.cpu + offset, id };
+            }
+        }
+
+        // Short — hand back whatever the GPU has finished, then grow or block.
+        // reclaimLocked() may erase drained chunks, so re-fetch the current one.
+        const size_t spansBefore = c.spans.size();
+        reclaimLocked();
+        Chunk& cur = chunks_.back();
+        if (cur.spans.size() != spansBefore) continue;
+
+        const bool oldestRetired = !cur.spans.empty() && cur.spans.front().retired;
+        if (size > cur.size || cur.size < maxSize_ || !oldestRetired) {
+            if (!growLocked(size)) return {};
+            continue;
+        }
+
+        const Span oldest = cur.spans.front();
+        ++stalls_;
+        lock.unlock();
+        {
+            TRACE_SCOPE("Upload", "StagingStall");
+            VkSemaphoreWaitInfo waitInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO };
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores    = &oldest.timeline;
+            waitInfo.pValues        = &oldest.value;
+            if (vkWaitSemaphores(device_, &waitInfo, UINT64_MAX) != VK_SUCCESS) {
+                LOG_BIN_ERROR_CAT("Upload", "Staging ring: wait on timeline value {} failed", oldest.value);
+                return {};
+            }
+        }
+        lock.lock();
+    }
+    LOG_BIN_ERROR_CAT("Upload", "StagingRing::allocate({}) before init", size);
+    return {};
+}
+
+void StagingRing::flush(const StagingAlloc& alloc) noexcept
+{
+    uint64_t enc = 0;
+    {
+        std::lock_guard lock(mutex_);
+        for (auto it = chunks_.rbegin(); it != chunks_.rend(); ++it) {
+            if (alloc.id >= it->firstId) { enc = it->enc; break; }
+        }
+    }
+    if (enc != 0) UltraLowLevelBufferTracker::get().flush(enc, alloc.offset, alloc.size);
+}
+
+// =============================================================================
+// RETIRE / RECLAIM
+// =============================================================================
+StagingRing::Span* StagingRing::findLocked(uint64_t id) noexcept
+{
+    for (auto it = chunks_.rbegin(); it != chunks_.rend(); ++it) {
+        if (id < it->firstId) continue;
+        if (it->spans.empty() || id < it->spans.front().id) return nullptr;
+        const uint64_t index = id - it->spans.front().id;          // ids are consecutive within a chunk
+        return index < it->spans.size() ? &it->spans[index] : nullptr;
+    }
+    return nullptr;
+}
+
+void StagingRing::retire(uint64_t id, VkSemaphore timeline, uint64_t value) noexcept
+{
+    std::lock_guard lock(mutex_);
+    Span* s = findLocked(id);
+    if (s == nullptr) {
+        LOG_WARN_CAT("Upload", "Staging ring: retire of unknown span {}", id);
+        return;
+    }
+    s->timeline = timeline;
+    s->value    = value;
+    s->retired  = true;
+}
+
+bool StagingRing::completeLocked(const Span& s) noexcept
+{
+    if (s.timeline == VK_NULL_HANDLE) return true;
+    if (s.timeline == polledSemaphore_ && polledValue_ >= s.value) return true;
+    uint64_t v = 0;
+    if (vkGetSemaphoreCounterValue(device_, s.timeline, &v) != VK_SUCCESS) return false;
+    polledSemaphore_ = s.timeline;
+    polledValue_     = v;
+    return v >= s.value;
+}
+
+void StagingRing::reclaimLocked() noexcept
+{
+    for (auto it = chunks_.begin(); it != chunks_.end();) {
+        Chunk& c = *it;
+        while (!c.spans.empty() && c.spans.front().retired && completeLocked(c.spans.front())) {
+            c.tail = c.spans.front().end;
+            c.spans.pop_front();
+        }
+        if (c.spans.empty()) c.head = c.tail = 0;                  // idle — restart at the front
+
+        const bool current = std::next(it) == chunks_.end();
+        if (!current && c.spans.empty()) {
+            UltraLowLevelBufferTracker::get().destroy(c.enc);      // drained — its last reader completed
+            it = chunks_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void StagingRing::reclaim() noexcept
+{
+    std::lock_guard lock(mutex_);
+    reclaimLocked();
+}
+
+bool StagingRing::valid() const noexcept
+{
+    std::lock_guard lock(mutex_);
+    return !chunks_.empty();
+}
+
+VkDeviceSize StagingRing::capacity() const noexcept
+{
+    std::lock_guard lock(mutex_);
+    return chunks_.empty() ? 0 : chunks_.back().size;
+}
+
+VkDeviceSize StagingRing::inFlight() const noexcept
+{
+    std::lock_guard lock(mutex_);
+    VkDeviceSize bytes = 0;
+    for (const Chunk& c : chunks_) bytes += c.head - c.tail;
+    return bytes;
+}
+
+VkDeviceSize StagingRing::highWater() const noexcept
+{
+    std::lock_guard lock(mutex_);
+    return highWater_;
+}
+
+} // namespace RTX
@@ -0,0 +1,406 @@
+// src/engine/GLOBAL/UploadScheduler.cpp
+// =============================================================================
+// AMOURANTH RTX Engine (C) 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. GNU General Public License v3.0 (or later) (GPL v3)
+//    https://www.gnu.org/licenses/gpl-3.0.html
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// UPLOAD SCHEDULER — see UploadScheduler.hpp
+// =============================================================================
+
+#include "engine/GLOBAL/UploadScheduler.hpp"
+#include "engine/GLOBAL/RTXHandler.hpp"
+#include "engine/GLOBAL/LAS.hpp"           // beginOneTime() for flushAndWait()
+#include "engine/GLOBAL/OptionsMenu.hpp"
+#include "engine/GLOBAL/logging.hpp"
+#include "engine/GLOBAL/Trace.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace RTX {
+
+namespace {
+constexpr VkDeviceSize STAGING_ALIGN = 16;
+constexpr double       MB            = 1048576.0;
+}
+
+UploadScheduler& uploadScheduler() noexcept {
+    static UploadScheduler scheduler;
+    return scheduler;
+}
+
+bool UploadScheduler::init(VkDevice device) noexcept
+{
+    destroy();
+    const auto& ctx = g_ctx();
+
+    device_         = device;
+    graphicsFamily_ = ctx.graphicsFamily_;
+    if (ctx.transferQueue_ != VK_NULL_HANDLE && ctx.transferFamily_ != UINT32_MAX) {
+        transferFamily_ = ctx.transferFamily_;
+        queue_          = ctx.transferQueue_;
+    } else {
+        transferFamily_ = graphicsFamily_;
+        queue_          = ctx.graphicsQueue_;
+    }
+    if (device_ == VK_NULL_HANDLE || queue_ == VK_NULL_HANDLE || transferFamily_ == UINT32_MAX) {
+        LOG_ERROR_CAT("Upload", "UploadScheduler: no queue to upload on — init skipped");
+        return false;
+    }
+
+    VkSemaphoreTypeCreateInfo typeInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO };
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue  = 0;
+    VkSemaphoreCreateInfo semInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+    semInfo.pNext = &typeInfo;
+    if (vkCreateSemaphore(device_, &semInfo, nullptr, &timeline_) != VK_SUCCESS) {
+        LOG_ERROR_CAT("Upload", "UploadScheduler: timeline semaphore creation failed — is timelineSemaphore enabled?");
+        timeline_ = VK_NULL_HANDLE;
+        return false;
+    }
+
+    VkCommandPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+    poolInfo.flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT | VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex = transferFamily_;
+    if (vkCreateCommandPool(device_, &poolInfo, nullptr, &pool_) != VK_SUCCESS) {
+        LOG_ERROR_CAT("Upload", "UploadScheduler: transfer command pool creation failed");
+        destroy();
+        return false;
+    }
+
+    std::array<VkCommandBuffer, SLOTS> cmds{};
+    VkCommandBufferAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+    allocInfo.commandPool        = pool_;
+    allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = SLOTS;
+    if (vkAllocateCommandBuffers(device_, &allocInfo, cmds.data()) != VK_SUCCESS) {
+        LOG_ERROR_CAT("Upload", "UploadScheduler: command buffer allocation failed");
+        destroy();
+        return false;
+    }
+    for (uint32_t i = 0; i < SLOTS; ++i) slots_[i].cmd = cmds[i];
+
+    if (!ring_.init(device_, Options::Memory::UPLOAD_STAGING_INITIAL_SIZE, Options::Memory::UPLOAD_STAGING_MAX_SIZE)) {
+        destroy();
+        return false;
+    }
+
+    LOG_SUCCESS_CAT("Upload", "Upload scheduler online — {} (family {}), {} batch slots",
+                    dedicated() ? "dedicated transfer queue" : "graphics queue", transferFamily_, SLOTS);
+    return true;
+}
+
+void UploadScheduler::destroy() noexcept
+{
+    std::lock_guard lock(mutex_);
+    if (batches_ != 0)
+        LOG_PERF_CAT("Upload", "Upload scheduler released — {} batches, {:.1f} MB ({:.1f} MB rewritten on graphics), {} command buffer stalls",
+                     batches_, bytes_ / MB, graphicsBytes_ / MB, stalls_);
+
+    ring_.destroy();
+    if (pool_ != VK_NULL_HANDLE)     vkDestroyCommandPool(device_, pool_, nullptr);
+    if (timeline_ != VK_NULL_HANDLE) vkDestroySemaphore(device_, timeline_, nullptr);
+    pool_     = VK_NULL_HANDLE;
+    timeline_ = VK_NULL_HANDLE;
+    queue_    = VK_NULL_HANDLE;
+    slots_    = {};
+    pending_.clear();
+    acquires_.clear();
+    graphicsCopies_.clear();
+    graphicsOwned_.clear();
+    current_ = 0;
+    submitted_ = handedOut_ = 0;
+    batches_ = bytes_ = graphicsBytes_ = stalls_ = 0;
+}
+
+// =============================================================================
+// ENQUEUE / SUBMIT
+// =============================================================================
+uint64_t UploadScheduler::enqueue(VkBuffer dst, VkDeviceSize dstOffset, const void* data, VkDeviceSize size)
+{
+    if (dst == VK_NULL_HANDLE || data == nullptr || size == 0) return 0;
+    if (!valid()) {
+        LOG_ERROR_CAT("Upload", "enqueue() before UploadScheduler::init — {} bytes dropped", size);
+        return 0;
+    }
+
+    // The copy runs unlocked — only the bookkeeping is serialized
+    const StagingAlloc staged = ring_.allocate(size, STAGING_ALIGN);
+    if (!staged.valid()) {
+        LOG_ERROR_CAT("Upload", "No staging space for {} bytes — upload dropped", size);
+        return 0;
+    }
+    std::memcpy(staged.cpu, data, size);
+    ring_.flush(staged);
+
+    std::lock_guard lock(mutex_);
+    pending_.push_back(Copy{ staged.buffer, dst, VkBufferCopy{ staged.offset, dstOffset, size }, staged.id });
+    return submitted_ + 1;
+}
+
+void UploadScheduler::forget(VkBuffer buffer) noexcept
+{
+    if (buffer == VK_NULL_HANDLE) return;
+    std::lock_guard lock(mutex_);
+    graphicsOwned_.erase(buffer);
+    std::erase_if(acquires_, [buffer](const Acquire& a) { return a.buffer == buffer; });
+
+    // Never recorded — their staging goes straight back
+    const auto drop = [&](std::vector<Copy>& copies) {
+        std::erase_if(copies, [&](const Copy& c) {
+            if (c.dst != buffer) return false;
+            ring_.retire(c.stagingId, VK_NULL_HANDLE, 0);
+            return true;
+        });
+    };
+    drop(pending_);
+    drop(graphicsCopies_);
+}
+
+uint64_t UploadScheduler::submit() noexcept
+{
+    std::lock_guard lock(mutex_);
+    if (pending_.empty()) return 0;
+
+    TRACE_SCOPE("Upload", "Submit");
+
+    // Destinations a past batch released to graphics belong to graphics now —
+    // the transfer queue may not write them again, so their copies wait for
+    // recordAcquires() and run on the graphics command buffer instead
+    if (dedicated()) {
+        const auto owned = std::stable_partition(pending_.begin(), pending_.end(),
+            [this](const Copy& c) { return !graphicsOwned_.contains(c.dst); });
+        graphicsCopies_.insert(graphicsCopies_.end(), std::make_move_iterator(owned), std::make_move_iterator(pending_.end()));
+        pending_.erase(owned, pending_.end());
+        if (pending_.empty()) return 0;
+    }
+
+    Slot& slot = slots_[current_];
+    if (slot.value != 0 && !isComplete(slot.value)) {
+        ++stalls_;
+        wait(slot.value);
+    }
+    const uint64_t value = submitted_ + 1;
+
+    vkResetCommandBuffer(slot.cmd, 0);
+    VkCommandBufferBeginInfo beginInfo{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(slot.cmd, &beginInfo);
+
+    // One vkCmdCopyBuffer per run of copies with the same source and destination
+    std::vector<VkBufferCopy> regions;
+    VkDeviceSize batchBytes = 0;
+    for (size_t i = 0; i < pending_.size();) {
+        const VkBuffer src = pending_[i].src;
+        const VkBuffer dst = pending_[i].dst;
+        regions.clear();
+        for (; i < pending_.size() && pending_[i].src == src && pending_[i].dst == dst; ++i) {
+            regions.push_back(pending_[i].region);
+            batchBytes += pending_[i].region.size;
+        }
+        vkCmdCopyBuffer(slot.cmd, src, dst, static_cast<uint32_t>(regions.size()), regions.data());
+    }
+
+    // Queue-family ownership: release every destination to graphics
+    if (dedicated()) {
+        std::vector<VkBuffer> dsts;
+        dsts.reserve(pending_.size());
+        for (const Copy& c : pending_) dsts.push_back(c.dst);
+        std::sort(dsts.begin(), dsts.end());
+        dsts.erase(std::unique(dsts.begin(), dsts.end()), dsts.end());
+
+        std::vector<VkBufferMemoryBarrier> releases;
+        releases.reserve(dsts.size());
+        for (VkBuffer b : dsts) {
+            VkBufferMemoryBarrier r{ VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
+            r.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+            r.dstAccessMask       = 0;
+            r.srcQueueFamilyIndex = transferFamily_;
+            r.dstQueueFamilyIndex = graphicsFamily_;
+            r.buffer              = b;
+            r.offset              = 0;
+            r.size                = VK_WHOLE_SIZE;
+            releases.push_back(r);
+            acquires_.push_back(Acquire{ value, b });
+            graphicsOwned_.insert(b);
+        }
+        vkCmdPipelineBarrier(slot.cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+                             0, nullptr, static_cast<uint32_t>(releases.size()), releases.data(), 0, nullptr);
+    }
+    vkEndCommandBuffer(slot.cmd);
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo{ VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+    timelineInfo.signalSemaphoreValueCount = 1;
+    timelineInfo.pSignalSemaphoreValues    = &value;
+
+    VkSubmitInfo submitInfo{ VK_STRUCTURE_TYPE_SUBMIT_INFO };
+    submitInfo.pNext                = &timelineInfo;
+    submitInfo.commandBufferCount   = 1;
+    submitInfo.pCommandBuffers      = &slot.cmd;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores    = &timeline_;
+
+    const VkResult r = vkQueueSubmit(queue_, 1, &submitInfo, VK_NULL_HANDLE);
+    if (r != VK_SUCCESS) {
+        // Nothing was queued — drop the batch and hand its staging straight back
+        LOG_ERROR_CAT("Upload", "Upload batch submit failed ({}) — {} copies dropped", static_cast<int>(r), pending_.size());
+        for (const Acquire& a : acquires_)
+            if (a.value == value) graphicsOwned_.erase(a.buffer);
+        std::erase_if(acquires_, [value](const Acquire& a) { return a.value == value; });
+        for (const Copy& c : pending_) ring_.retire(c.stagingId, VK_NULL_HANDLE, 0);
+        pending_.clear();
+        return 0;
+    }
+
+    // Staging spans are free again once this batch's value has passed
+    for (const Copy& c : pending_) ring_.retire(c.stagingId, timeline_, value);
+    pending_.clear();
+
+    slot.value = value;
+    submitted_ = value;
+    ++batches_;
+    bytes_ += batchBytes;
+    TRACE_COUNTER("Upload", "batchBytes", batchBytes);
+
+    current_ = (current_ + 1) % SLOTS;
+    return value;
+}
+
+UploadWait UploadScheduler::recordAcquires(VkCommandBuffer graphicsCmd) noexcept
+{
+    std::vector<uint64_t> staging;
+    const UploadWait w = recordAcquiresInto(graphicsCmd, staging);
+    // Their staging is read by graphicsCmd — free once that frame's fence has passed
+    if (!staging.empty())
+        retireQueue().retire([this, ids = std::move(staging)] {
+            for (const uint64_t id : ids) ring_.retire(id, VK_NULL_HANDLE, 0);
+        });
+    return w;
+}
+
+UploadWait UploadScheduler::recordAcquiresInto(VkCommandBuffer graphicsCmd, std::vector<uint64_t>& staging) noexcept
+{
+    std::lock_guard lock(mutex_);
+    if (!valid()) return {};
+
+    if (!acquires_.empty()) {
+        std::vector<VkBufferMemoryBarrier> barriers;
+        barriers.reserve(acquires_.size());
+        for (const Acquire& a : acquires_) {
+            VkBufferMemoryBarrier b{ VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
+            b.srcAccessMask       = 0;
+            b.dstAccessMask       = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+            b.srcQueueFamilyIndex = transferFamily_;
+            b.dstQueueFamilyIndex = graphicsFamily_;
+            b.buffer              = a.buffer;
+            b.offset              = 0;
+            b.size                = VK_WHOLE_SIZE;
+            barriers.push_back(b);
+        }
+        vkCmdPipelineBarrier(graphicsCmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0,
+                             0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data(), 0, nullptr);
+        acquires_.clear();
+    }
+
+    // Rewrites of graphics-owned buffers — ordered after earlier frames' reads and before later ones
+    if (!graphicsCopies_.empty()) {
+        TRACE_SCOPE("Upload", "GraphicsCopies");
+        VkMemoryBarrier before{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        before.srcAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+        before.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(graphicsCmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                             1, &before, 0, nullptr, 0, nullptr);
+        VkDeviceSize copied = 0;
+        for (const Copy& c : graphicsCopies_) {
+            vkCmdCopyBuffer(graphicsCmd, c.src, c.dst, 1, &c.region);
+            staging.push_back(c.stagingId);
+            copied += c.region.size;
+        }
+        VkMemoryBarrier after{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        after.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        after.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+        vkCmdPipelineBarrier(graphicsCmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0,
+                             1, &after, 0, nullptr, 0, nullptr);
+        graphicsCopies_.clear();
+        graphicsBytes_ += copied;
+    }
+
+    if (submitted_ == handedOut_) return {};
+    handedOut_ = submitted_;
+    return UploadWait{ timeline_, submitted_ };
+}
+
+void UploadScheduler::flushAndWait() noexcept
+{
+    TRACE_SCOPE("Upload", "FlushAndWait");
+    submit();
+    {
+        std::lock_guard lock(mutex_);
+        if (!valid() || (submitted_ == handedOut_ && graphicsCopies_.empty())) return;
+    }
+
+    // Graphics-side consumers follow on the graphics queue — acquire there, behind a timeline wait
+    VkDevice dev = device_;
+    VkCommandBuffer cmd = beginOneTime(g_ctx().commandPool_);
+    std::vector<uint64_t> staging;
+    const UploadWait w = recordAcquiresInto(cmd, staging);
+    vkEndCommandBuffer(cmd);
+
+    const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    VkTimelineSemaphoreSubmitInfo timelineInfo{ VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+    timelineInfo.waitSemaphoreValueCount = w.needed() ? 1 : 0;
+    timelineInfo.pWaitSemaphoreValues    = &w.value;
+
+    VkSubmitInfo submitInfo{ VK_STRUCTURE_TYPE_SUBMIT_INFO };
+    submitInfo.pNext              = &timelineInfo;
+    submitInfo.waitSemaphoreCount = w.needed() ? 1 : 0;
+    submitInfo.pWaitSemaphores    = &w.semaphore;
+    submitInfo.pWaitDstStageMask  = &waitStage;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers    = &cmd;
+
+    VkFence fence = VK_NULL_HANDLE;
+    VkFenceCreateInfo fenceInfo{ VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+    if (vkCreateFence(dev, &fenceInfo, nullptr, &fence) == VK_SUCCESS &&
+        vkQueueSubmit(g_ctx().graphicsQueue_, 1, &submitInfo, fence) == VK_SUCCESS) {
+        vkWaitForFences(dev, 1, &fence, VK_TRUE, UINT64_MAX);
+    } else {
+        LOG_ERROR_CAT("Upload", "flushAndWait: graphics acquire submit failed — waiting for the device");
+        vkDeviceWaitIdle(dev);
+    }
+    if (fence != VK_NULL_HANDLE) vkDestroyFence(dev, fence, nullptr);
+    vkFreeCommandBuffers(dev, g_ctx().commandPool_, 1, &cmd);
+    for (const uint64_t id : staging) ring_.retire(id, VK_NULL_HANDLE, 0);   // graphics copies are done
+}
+
+// =============================================================================
+// TICKETS
+// =============================================================================
+uint64_t UploadScheduler::completedValue() const noexcept
+{
+    uint64_t v = 0;
+    if (timeline_ != VK_NULL_HANDLE) vkGetSemaphoreCounterValue(device_, timeline_, &v);
+    return v;
+}
+
+bool UploadScheduler::isComplete(uint64_t ticket) const noexcept
+{
+    return ticket == 0 || completedValue() >= ticket;
+}
+
+void UploadScheduler::wait(uint64_t ticket) const noexcept
+{
+    if (ticket == 0 || timeline_ == VK_NULL_HANDLE) return;
+    VkSemaphoreWaitInfo waitInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO };
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores    = &timeline_;
+    waitInfo.pValues        = &ticket;
+    if (vkWaitSemaphores(device_, &waitInfo, UINT64_MAX) != VK_SUCCESS)
+        LOG_ERROR_CAT("Upload", "vkWaitSemaphores failed on upload ticket {}", ticket);
+}
+
+} // namespace RTX
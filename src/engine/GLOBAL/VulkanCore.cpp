@@ -18,6 +18,7 @@
 #include "engine/GLOBAL/VulkanCore.hpp"
 #include "engine/GLOBAL/VulkanRenderer.hpp"
 #include "engine/GLOBAL/RTXHandler.hpp"
+#include "engine/GLOBAL/UploadScheduler.hpp"
 #include "engine/GLOBAL/PipelineManager.hpp"
 #include "engine/GLOBAL/GlobalBindings.hpp"
 #include "engine/GLOBAL/logging.hpp"
@@ -42,31 +43,6 @@ using namespace RTX;
 namespace RTX {
 }
 
-// =============================================================================
-// VulkanCore.cpp — Persistent staging globals — ONLY ONE DEFINITION
-// =============================================================================
-namespace VulkanRTXDetail {  // Put in a named namespace to avoid conflicts
-
-    alignas(64) std::mutex g_stagingMutex;
-    alignas(64) uint64_t   g_stagingPool = 0;
-    alignas(64) VkDeviceMemory g_stagingMem = VK_NULL_HANDLE;
-    alignas(64) VkBuffer   g_stagingBuffer = VK_NULL_HANDLE;
-    alignas(64) void*      g_mappedBase = nullptr;
-    alignas(64) std::atomic<VkDeviceSize> g_mappedOffset{0};
-
-    constexpr VkDeviceSize STAGING_POOL_SIZE = 1ULL << 30; // 1 GB — production
-
-} // namespace VulkanRTXDetail
-
-// Convenient aliases — use these everywhere in the file
-using VulkanRTXDetail::g_stagingMutex;
-using VulkanRTXDetail::g_stagingPool;
-using VulkanRTXDetail::g_stagingMem;
-using VulkanRTXDetail::g_stagingBuffer;
-using VulkanRTXDetail::g_mappedBase;
-using VulkanRTXDetail::g_mappedOffset;
-using VulkanRTXDetail::STAGING_POOL_SIZE;
-
 static std::unique_ptr<RTX::PipelineManager> g_pipelineManager = nullptr;
 
 // =============================================================================
@@ -121,20 +97,6 @@ VulkanRTX::~VulkanRTX() noexcept {
     LOG_TRACE_CAT("RTX", "VulkanRTX destructor — START");
     RTX::AmouranthAI::get().onMemoryEvent("VulkanRTX", sizeof(VulkanRTX));
 
-    // OPT: Unmap persistent staging if active
-    if (g_mappedBase) {
-        vkUnmapMemory(device_, g_stagingMem);
-        g_mappedBase = nullptr;
-        g_mappedOffset = 0;
-        LOG_TRACE_CAT("RTX", "Persistent staging unmapped");
-    }
-    if (g_stagingPool) {
-        BUFFER_DESTROY(g_stagingPool);
-        g_stagingPool = 0;
-        g_stagingMem = VK_NULL_HANDLE;
-        LOG_TRACE_CAT("RTX", "Persistent staging pool destroyed");
-    }
-
     // --- 1. Black Fallback (Image + Memory + View) ---
     if (blackFallbackView_.valid()) {
         LOG_TRACE_CAT("RTX", "Destroying blackFallbackView");
@@ -158,6 +120,7 @@ VulkanRTX::~VulkanRTX() noexcept {
         LOG_TRACE_CAT("RTX", "Destroying sbtBuffer");
         sbtBuffer_.reset();
     }
+    BUFFER_DESTROY(sbtEnc_);
 
     // --- 3. Descriptor Sets (Free before Pool) ---
     for (auto& set : descriptorSets_) {
@@ -360,18 +323,10 @@ void VulkanRTX::setRayTracingPipeline(VkPipeline p, VkPipelineLayout l) noexcept
     RTX::AmouranthAI::get().onMemoryEvent("RTPipelineLayout", sizeof(VkPipelineLayout));
 
     LOG_INFO_CAT("RTX", "HANDLE_CREATE: {} | Tag: {}", "rtPipeline", "RTPipeline");
-    rtPipeline_ = RTX::Handle<VkPipeline>(p, g_ctx().device(),
-        [](VkDevice d, VkPipeline pp, const VkAllocationCallbacks*) {
-            LOG_TRACE_CAT("RTX", "Destroying RTPipeline: 0x{:x}", reinterpret_cast<uintptr_t>(pp));
-            vkDestroyPipeline(d, pp, nullptr);
-        }, 0, "RTPipeline");
+    rtPipeline_ = RTX::Handle<VkPipeline>(p, g_ctx().device(), "RTPipeline");
 
     LOG_INFO_CAT("RTX", "HANDLE_CREATE: {} | Tag: {}", "rtPipelineLayout", "RTPipelineLayout");
-    rtPipelineLayout_ = RTX::Handle<VkPipelineLayout>(l, g_ctx().device(),
-        [](VkDevice d, VkPipelineLayout pl, const VkAllocationCallbacks*) {
-            LOG_TRACE_CAT("RTX", "Destroying RTPipelineLayout: 0x{:x}", reinterpret_cast<uintptr_t>(pl));
-            vkDestroyPipelineLayout(d, pl, nullptr);
-        }, 0, "RTPipelineLayout");
+    rtPipelineLayout_ = RTX::Handle<VkPipelineLayout>(l, g_ctx().device(), "RTPipelineLayout");
 
     LOG_SUCCESS_CAT("RTX", "{}Ray tracing pipeline bound — PINK PHOTONS ETERNAL{}", PLASMA_FUCHSIA, RESET);
     LOG_TRACE_CAT("RTX", "setRayTracingPipeline — COMPLETE");
@@ -381,31 +336,6 @@ void VulkanRTX::buildAccelerationStructures()
 {
     LOG_INFO_CAT("RTX", "{}Building acceleration structures — LAS awakening{}", PLASMA_FUCHSIA, RESET);
 
-    // === FORCE STAGING POOL CREATION FIRST (CRITICAL FIX) ===
-    {
-        std::lock_guard<std::mutex> lock(g_stagingMutex);
-        if (!g_stagingPool) {
-            LOG_INFO_CAT("RTX", "Forcing persistent 1GB staging pool creation (pre-LAS)");
-            BUFFER_CREATE(g_stagingPool, 1ULL << 30,
-                          VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                          "persistent_staging_1GB_FORCED");
-
-            g_stagingBuffer = RAW_BUFFER(g_stagingPool);
-            g_stagingMem    = BUFFER_MEMORY(g_stagingPool);
-
-            if (g_stagingMem == VK_NULL_HANDLE) {
-                LOG_FATAL_CAT("RTX", "Failed to create 1GB staging pool — OOM or invalid memory type");
-                return;
-            }
-
-            VK_CHECK(vkMapMemory(device_, g_stagingMem, 0, VK_WHOLE_SIZE, 0, &g_mappedBase),
-                     "Failed to map persistent staging buffer");
-            g_mappedOffset.store(0);
-            LOG_SUCCESS_CAT("RTX", "1GB persistent staging pool FORCED ONLINE");
-        }
-    }
-
     // Simple test cube
     std::vector<glm::vec3> vertices = {
         {-1,-1,-1}, {1,-1,-1}, {1,1,-1}, {-1,1,-1},
@@ -432,32 +362,11 @@ void VulkanRTX::buildAccelerationStructures()
                   VK_BUFFER_USAGE_TRANSFER_DST_BIT,
                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, "amouranth_index_buffer");
 
-    // === SAFE UPLOAD USING PERSISTENT STAGING ===
-    VkCommandBuffer cmd = beginSingleTimeCommands(g_ctx().commandPool());
-
-    VkDeviceSize vOffset = g_mappedOffset.fetch_add(vertices.size() * sizeof(glm::vec3) + 256, std::memory_order_relaxed);
-    VkDeviceSize iOffset = g_mappedOffset.fetch_add(indices.size()  * sizeof(uint32_t)  + 256, std::memory_order_relaxed);
-
-    std::memcpy((char*)g_mappedBase + vOffset, vertices.data(), vertices.size() * sizeof(glm::vec3));
-    std::memcpy((char*)g_mappedBase + iOffset, indices.data(),  indices.size()  * sizeof(uint32_t));
-
-    VkBufferCopy vcopy{ .srcOffset = vOffset, .dstOffset = 0, .size = vertices.size() * sizeof(glm::vec3) };
-    VkBufferCopy icopy{ .srcOffset = iOffset, .dstOffset = 0, .size = indices.size()  * sizeof(uint32_t) };
-
-    vkCmdCopyBuffer(cmd, g_stagingBuffer, RAW_BUFFER(vbuf), 1, &vcopy);
-    vkCmdCopyBuffer(cmd, g_stagingBuffer, RAW_BUFFER(ibuf), 1, &icopy);
-
-    VkMemoryBarrier barrier{
-        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
-        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
-        .dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR
-    };
-    vkCmdPipelineBarrier(cmd,
-        VK_PIPELINE_STAGE_TRANSFER_BIT,
-        VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
-        0, 1, &barrier, 0, nullptr, 0, nullptr);
-
-    endSingleTimeCommands(cmd, g_ctx().graphicsQueue(), g_ctx().commandPool());
+    // === UPLOAD — staging ring + transfer queue; on graphics when this returns ===
+    uploadBatch({
+        { vertices.data(), vertices.size() * sizeof(glm::vec3), vbuf, "amouranth_vertex_buffer" },
+        { indices.data(),  indices.size()  * sizeof(uint32_t),  ibuf, "amouranth_index_buffer"  },
+    }, g_ctx().commandPool(), g_ctx().graphicsQueue());
 
     LOG_SUCCESS_CAT("RTX", "Geometry uploaded — building BLAS/TLAS via global LAS");
 
@@ -484,6 +393,9 @@ void VulkanRTX::buildAccelerationStructures()
         RESET);
 }
 
+// Batched through the upload scheduler — pool/queue are only used when the
+// scheduler is unavailable. async: the copies ride the next frame's transfer
+// submit and the frame acquires them; otherwise they are on graphics on return.
 void VulkanRTX::uploadBatch(
     const std::vector<std::tuple<const void*, VkDeviceSize, uint64_t, const char*>>& batch,
     VkCommandPool pool,
@@ -492,7 +404,6 @@ void VulkanRTX::uploadBatch(
 {
     if (batch.empty()) return;
 
-    VkDevice dev = g_ctx().device();
     VkDeviceSize totalSize = 0;
     for (const auto& [src, size, dst, name] : batch)
         if (src && size > 0) totalSize += size;
@@ -500,94 +411,52 @@ void VulkanRTX::uploadBatch(
 
     LOG_TRACE_CAT("RTX", "uploadBatch: {} bytes (async={})", totalSize, async);
 
-    // Lazy-init persistent staging
-    {
-        std::lock_guard<std::mutex> lock(g_stagingMutex);
-        if (g_stagingPool == 0) {
-            BUFFER_CREATE(g_stagingPool, STAGING_POOL_SIZE,
-                          VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                          "persistent_staging_pool");
-
-            g_stagingMem = BUFFER_MEMORY(g_stagingPool);
-            g_stagingBuffer = RAW_BUFFER(g_stagingPool);
-
-            // FIXED: Null guard for lazy staging mem (prevents vkMapMemory on null — VUID-vkMapMemory-memory-parameter)
-            if (g_stagingMem == VK_NULL_HANDLE) {
-                LOG_FATAL_CAT("RTX", "Lazy BUFFER_CREATE failed: g_stagingMem null (OOM? Skipping uploadBatch.");
-                return;  // Early exit — no map on null
-            }
-
-            void* mapped = nullptr;
-
-            // FIXED: Null guard before lazy staging map (VUID-vkMapMemory-memory-parameter + segfault fix)
-            if (g_stagingMem == VK_NULL_HANDLE) {
-                LOG_FATAL_CAT("RTX", "Lazy staging map aborted: g_stagingMem null (realloc failed?). Skipping.");
-                mapped = nullptr;
-                return;
-            }
-            VK_CHECK(vkMapMemory(dev, g_stagingMem, 0, VK_WHOLE_SIZE, 0, &mapped),
-                     "Failed to map persistent staging");
-
-            g_mappedBase = mapped;
-            g_mappedOffset.store(0);
-            LOG_INFO_CAT("RTX", "Persistent 1GB staging pool initialized");
+    auto& scheduler = RTX::uploadScheduler();
+    if (scheduler.valid()) {
+        uint64_t ticket = 0;
+        for (const auto& [src, size, dstHandle, name] : batch) {
+            if (!src || size == 0) continue;
+            VkBuffer dstBuf = RAW_BUFFER(dstHandle);
+            if (!dstBuf) continue;
+            ticket = scheduler.enqueue(dstBuf, 0, src, size);
+            LOG_TRACE_CAT("RTX", "Queued {} bytes → {}", size, name);
         }
+        if (!async) scheduler.flushAndWait();
+        LOG_BIN_PERF_CAT("RTX", "Batch upload {} bytes queued (async={}, ticket {})", totalSize, async, ticket);
+        return;
     }
 
-    if (!g_stagingBuffer) return;
-
-    VkCommandBuffer cmd = beginSingleTimeCommands(pool);
-
-    VkDeviceSize offset = g_mappedOffset.fetch_add(totalSize + 256);
-    if (offset + totalSize >= STAGING_POOL_SIZE) {
-        offset = 0;
-        g_mappedOffset.store(256);
+    // Fallback — private staging buffer, one graphics submit, blocking
+    uint64_t staging = 0;
+    BUFFER_CREATE(staging, totalSize,
+                  VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                  "uploadBatch_staging");
+    void* mapped = nullptr;
+    BUFFER_MAP(staging, mapped);
+    if (!mapped) {
+        LOG_ERROR_CAT("RTX", "uploadBatch: staging buffer not mappable — {} bytes dropped", totalSize);
+        BUFFER_DESTROY(staging);
+        return;
     }
 
+    VkCommandBuffer cmd = beginSingleTimeCommands(pool);
+    VkDeviceSize offset = 0;
     for (const auto& [src, size, dstHandle, name] : batch) {
         if (!src || size == 0) continue;
-
-        void* dstPtr = static_cast<char*>(g_mappedBase) + offset;
-        std::memcpy(dstPtr, src, size);
-
-        VkBuffer dstBuf = RAW_BUFFER(dstHandle);
-        if (dstBuf) {
-            VkBufferCopy copy{};
-            copy.srcOffset = offset;
-            copy.dstOffset = 0;
-            copy.size = size;
-            vkCmdCopyBuffer(cmd, g_stagingBuffer, dstBuf, 1, &copy);
+        std::memcpy(static_cast<char*>(mapped) + offset, src, size);
+        if (VkBuffer dstBuf = RAW_BUFFER(dstHandle)) {
+            VkBufferCopy copy{ .srcOffset = offset, .dstOffset = 0, .size = size };
+            vkCmdCopyBuffer(cmd, RAW_BUFFER(staging), dstBuf, 1, &copy);
         }
-
         offset += size;
         LOG_TRACE_CAT("RTX", "Staged {} bytes → {}", size, name);
     }
+    BUFFER_FLUSH(staging, 0, offset);
+    endSingleTimeCommands(cmd, queue, pool);
+    BUFFER_DESTROY(staging);
 
-    // RAW FENCE — no renderer() call
-    VkFence fence = VK_NULL_HANDLE;
-    if (async) {
-        VkFenceCreateInfo fenceInfo = {};
-        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-        VK_CHECK(vkCreateFence(dev, &fenceInfo, nullptr, &fence),
-                 "Failed to create upload fence");
-    }
-
-    VkSubmitInfo submit = {};
-    submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submit.commandBufferCount = 1;
-    submit.pCommandBuffers = &cmd;
-
-    VK_CHECK(vkQueueSubmit(queue, 1, &submit, fence),
-             "Failed to submit upload batch");
-
-    if (!async) {
-        VK_CHECK(vkWaitForFences(dev, 1, &fence, VK_TRUE, UINT64_MAX),
-                 "Sync upload wait failed");
-        vkDestroyFence(dev, fence, nullptr);
-    }
-
-    LOG_PERF_CAT("RTX", "Batch upload {} bytes submitted (async={})", totalSize, async);
+    LOG_BIN_PERF_CAT("RTX", "Batch upload {} bytes submitted on graphics (no upload scheduler)", totalSize);
 }
 
 // =============================================================================
@@ -622,11 +491,7 @@ void VulkanRTX::initDescriptorPoolAndSets() {
     VK_CHECK(vkCreateDescriptorPool(device_, &poolInfo, nullptr, &rawPool), "Failed to create descriptor pool");
     LOG_DEBUG_CAT("RTX", "Raw descriptor pool created: 0x{:x}", reinterpret_cast<uintptr_t>(rawPool));
     LOG_INFO_CAT("RTX", "HANDLE_CREATE: {} | Tag: {}", "descriptorPool", "RTXDescriptorPool");
-    descriptorPool_ = RTX::Handle<VkDescriptorPool>(rawPool, device_,
-        [](VkDevice d, VkDescriptorPool p, const VkAllocationCallbacks*) {
-            LOG_TRACE_CAT("RTX", "Destroying descriptor pool: 0x{:x}", reinterpret_cast<uintptr_t>(p));
-            if (p != VK_NULL_HANDLE) vkDestroyDescriptorPool(d, p, nullptr);
-        }, 0, "RTXDescriptorPool");
+    descriptorPool_ = RTX::Handle<VkDescriptorPool>(rawPool, device_, "RTXDescriptorPool");
     RTX::AmouranthAI::get().onMemoryEvent("Descriptor Pool", 0);
 
     // Step 2: Create or validate descriptor set layouts (CRITICAL: Ensure non-null!)
@@ -708,19 +573,14 @@ void VulkanRTX::initShaderBindingTable(VkPhysicalDevice pd) {
 
     VkBuffer rawBuffer = RAW_BUFFER(sbtEnc);
     LOG_INFO_CAT("RTX", "HANDLE_CREATE: {} | Tag: {}", "sbtBuffer", "SBTBuffer");
-    sbtBuffer_ = RTX::Handle<VkBuffer>(rawBuffer, device_,
-        [](VkDevice d, VkBuffer b, const VkAllocationCallbacks*) {
-            LOG_TRACE_CAT("RTX", "Destroying SBT buffer: 0x{:x}", reinterpret_cast<uintptr_t>(b));
-            vkDestroyBuffer(d, b, nullptr);
-        }, 0, "SBTBuffer");
+    // Non-owning view — the tracker (sbtEnc_) destroys the buffer
+    sbtBuffer_ = RTX::Handle<VkBuffer>(rawBuffer, device_, RTX::NonOwning, "SBTBuffer");
 
+    // Memory is a shared DeviceHeap block — view only, never freed here
     VkDeviceMemory rawMemory = BUFFER_MEMORY(sbtEnc);
     LOG_INFO_CAT("RTX", "HANDLE_CREATE: {} | Tag: {}", "sbtMemory", "SBTMemory");
-    sbtMemory_ = RTX::Handle<VkDeviceMemory>(rawMemory, device_,
-        [](VkDevice d, VkDeviceMemory m, const VkAllocationCallbacks*) {
-            LOG_TRACE_CAT("RTX", "Freeing SBT memory: 0x{:x}", reinterpret_cast<uintptr_t>(m));
-            vkFreeMemory(d, m, nullptr);
-        }, 64_MB, "SBTMemory");
+    sbtMemory_ = RTX::Handle<VkDeviceMemory>(rawMemory, device_, RTX::NonOwning, "SBTMemory");
+    sbtEnc_ = sbtEnc;
 
     std::vector<uint8_t> handles(groupCount * handleSize);
     LOG_TRACE_CAT("RTX", "Fetching {} shader group handles", groupCount);
@@ -801,8 +661,7 @@ void VulkanRTX::initBlackFallbackImage() {
     LOG_DEBUG_CAT("RTX", "Black image created: 0x{:x}", reinterpret_cast<uintptr_t>(rawImg));
 
     LOG_INFO_CAT("RTX", "HANDLE_CREATE: blackFallbackImage | Tag: BlackFallbackImage");
-    blackFallbackImage_ = RTX::Handle<VkImage>(rawImg, device_);  // Auto-destroy
-    blackFallbackImage_.tag = "BlackFallbackImage";
+    blackFallbackImage_ = RTX::Handle<VkImage>(rawImg, device_, "BlackFallbackImage");
 
     // --- MEMORY ALLOCATION ---
     VkMemoryRequirements memReqs{};
@@ -830,9 +689,8 @@ void VulkanRTX::initBlackFallbackImage() {
     VK_CHECK(vkBindImageMemory(device_, rawImg, rawMem, 0), "Failed to bind black memory");
 
     LOG_INFO_CAT("RTX", "HANDLE_CREATE: blackFallbackMemory | Tag: BlackFallbackMemory");
-    blackFallbackMemory_ = RTX::Handle<VkDeviceMemory>(rawMem, device_);
-    blackFallbackMemory_.tag = "BlackFallbackMemory";
-    blackFallbackMemory_.size = memReqs.size;
+    RTX::memoryBudget().chargeMemory(rawMem, "BlackFallback", allocInfo.memoryTypeIndex, memReqs.size);
+    blackFallbackMemory_ = RTX::Handle<VkDeviceMemory>(rawMem, device_, "BlackFallbackMemory");
 
     // --- COPY STAGING → IMAGE (async variant for speed) ---
     VkCommandBuffer cmd = beginSingleTimeCommands(g_ctx().commandPool());
@@ -894,8 +752,7 @@ void VulkanRTX::initBlackFallbackImage() {
     LOG_DEBUG_CAT("RTX", "Black image view created: 0x{:x}", reinterpret_cast<uintptr_t>(rawView));
 
     LOG_INFO_CAT("RTX", "HANDLE_CREATE: blackFallbackView | Tag: BlackFallbackView");
-    blackFallbackView_ = RTX::Handle<VkImageView>(rawView, device_);
-    blackFallbackView_.tag = "BlackFallbackView";
+    blackFallbackView_ = RTX::Handle<VkImageView>(rawView, device_, "BlackFallbackView");
 
     LOG_SUCCESS_CAT("RTX", "{}Black fallback image ready — safety net active{}", PLASMA_FUCHSIA, RESET);
     RTX::AmouranthAI::get().onMemoryEvent("Black Fallback Image", memReqs.size);
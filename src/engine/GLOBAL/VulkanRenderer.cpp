@@ -20,7 +20,10 @@
 #include "engine/GLOBAL/VulkanRenderer.hpp"
 #include "engine/GLOBAL/PipelineManager.hpp"
 #include "engine/GLOBAL/logging.hpp"
+#include "engine/GLOBAL/Trace.hpp"
 #include "engine/GLOBAL/RTXHandler.hpp"
+#include "engine/GLOBAL/MemoryBudget.hpp"
+#include "engine/GLOBAL/UploadScheduler.hpp"
 #include "engine/GLOBAL/LAS.hpp"
 #include "engine/GLOBAL/SDL3.hpp"
 #include "engine/GLOBAL/OptionsMenu.hpp"
@@ -42,6 +45,8 @@
 #include <sstream>
 #include <thread>
 #include <print>
+#include <array>
+#include <span>
 
 using namespace Logging::Color;
 using namespace RTX;
@@ -65,6 +70,74 @@ float getJitter() {
     std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
     return dist(quantumRng);
 }
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Frame Submit — one command buffer, semaphore waits/signals with 64-bit stages
+// ──────────────────────────────────────────────────────────────────────────────
+// value is ignored by binary semaphores; stage NONE waits at ALL_COMMANDS
+struct SemaphoreOp {
+    VkSemaphore           semaphore = VK_NULL_HANDLE;
+    uint64_t              value     = 0;
+    VkPipelineStageFlags2 stage     = VK_PIPELINE_STAGE_2_NONE;
+};
+constexpr size_t MAX_SEMAPHORE_OPS = 4;
+
+// synchronization2: vkQueueSubmit2, stages exactly as declared. Otherwise
+// vkQueueSubmit + timeline values, stages through RTX::legacyStages()
+VkResult submitFrame(VkQueue queue, VkCommandBuffer cmd, std::span<const SemaphoreOp> waits,
+                     std::span<const SemaphoreOp> signals, bool sync2) noexcept {
+    const auto stageOf = [](const SemaphoreOp& op) {
+        return op.stage != VK_PIPELINE_STAGE_2_NONE ? op.stage : VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    };
+
+    if (sync2) {
+        std::array<VkSemaphoreSubmitInfo, MAX_SEMAPHORE_OPS> waitInfo{}, signalInfo{};
+        for (size_t i = 0; i < waits.size(); ++i)
+            waitInfo[i] = { VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, nullptr, waits[i].semaphore, waits[i].value, stageOf(waits[i]), 0 };
+        for (size_t i = 0; i < signals.size(); ++i)
+            signalInfo[i] = { VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, nullptr, signals[i].semaphore, signals[i].value, stageOf(signals[i]), 0 };
+        const VkCommandBufferSubmitInfo cmdInfo{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO, nullptr, cmd, 0 };
+
+        VkSubmitInfo2 submit{ VK_STRUCTURE_TYPE_SUBMIT_INFO_2 };
+        submit.waitSemaphoreInfoCount   = static_cast<uint32_t>(waits.size());
+        submit.pWaitSemaphoreInfos      = waitInfo.data();
+        submit.commandBufferInfoCount   = 1;
+        submit.pCommandBufferInfos      = &cmdInfo;
+        submit.signalSemaphoreInfoCount = static_cast<uint32_t>(signals.size());
+        submit.pSignalSemaphoreInfos    = signalInfo.data();
+        return vkQueueSubmit2(queue, 1, &submit, VK_NULL_HANDLE);
+    }
+
+    std::array<VkSemaphore, MAX_SEMAPHORE_OPS>          waitSemaphores{}, signalSemaphores{};
+    std::array<VkPipelineStageFlags, MAX_SEMAPHORE_OPS> waitStages{};
+    std::array<uint64_t, MAX_SEMAPHORE_OPS>             waitValues{}, signalValues{};
+    for (size_t i = 0; i < waits.size(); ++i) {
+        waitSemaphores[i] = waits[i].semaphore;
+        waitValues[i]     = waits[i].value;
+        waitStages[i]     = RTX::legacyStages(stageOf(waits[i]));
+    }
+    for (size_t i = 0; i < signals.size(); ++i) {
+        signalSemaphores[i] = signals[i].semaphore;
+        signalValues[i]     = signals[i].value;
+    }
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo = { VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+    timelineInfo.waitSemaphoreValueCount   = static_cast<uint32_t>(waits.size());
+    timelineInfo.pWaitSemaphoreValues      = waitValues.data();
+    timelineInfo.signalSemaphoreValueCount = static_cast<uint32_t>(signals.size());
+    timelineInfo.pSignalSemaphoreValues    = signalValues.data();
+
+    VkSubmitInfo submit = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+    submit.pNext                = &timelineInfo;
+    submit.waitSemaphoreCount   = static_cast<uint32_t>(waits.size());
+    submit.pWaitSemaphores      = waitSemaphores.data();
+    submit.pWaitDstStageMask    = waitStages.data();
+    submit.commandBufferCount   = 1;
+    submit.pCommandBuffers      = &cmd;
+    submit.signalSemaphoreCount = static_cast<uint32_t>(signals.size());
+    submit.pSignalSemaphores    = signalSemaphores.data();
+    return vkQueueSubmit(queue, 1, &submit, VK_NULL_HANDLE);
+}
 }
 
 // ──────────────────────────────────────────────────────────────────────────────
@@ -81,11 +154,19 @@ void VulkanRenderer::toggleFpsTarget() noexcept {
         case FpsTarget::FPS_120: fpsTarget_ = FpsTarget::FPS_UNLIMITED; break;
         case FpsTarget::FPS_UNLIMITED: fpsTarget_ = FpsTarget::FPS_60; break;
     }
+    framePacer_.setTargetFps(static_cast<uint32_t>(fpsTarget_));
 }
 
 void VulkanRenderer::toggleDenoising() noexcept {
     denoisingEnabled_ = !denoisingEnabled_;
     resetAccumulation_ = true;
+
+    // Back on after a budget eviction — the target has to come back first
+    if (denoisingEnabled_ && Options::RTX::ENABLE_DENOISING && !denoiserView_.valid()) {
+        waitForInFlightFrames();            // denoiser sets are rewritten below
+        createDenoiserImage();
+        updateDenoiserDescriptors();
+    }
 }
 
 void VulkanRenderer::toggleAdaptiveSampling() noexcept {
@@ -100,6 +181,7 @@ void VulkanRenderer::setTonemapType(TonemapType type) noexcept {
 void VulkanRenderer::setOverclockMode(bool enabled) noexcept {
     overclockMode_ = enabled;
     fpsTarget_ = enabled ? FpsTarget::FPS_UNLIMITED : FpsTarget::FPS_120;
+    framePacer_.setTargetFps(static_cast<uint32_t>(fpsTarget_));
 }
 
 // ──────────────────────────────────────────────────────────────────────────────
@@ -134,14 +216,17 @@ void VulkanRenderer::cleanup() noexcept {
     }
 
     // ── PHASE 1: Wait for all in-flight frames to finish ─────────────────────
-    LOG_TRACE_CAT("RENDERER", "cleanup — waiting for in-flight fences");
-    for (auto fence : inFlightFences_) {
-        if (fence) vkWaitForFences(dev, 1, &fence, VK_TRUE, UINT64_MAX);
-    }
+    LOG_TRACE_CAT("RENDERER", "cleanup — waiting for in-flight frames");
+    framePacer_.waitIdle();
 
     // ── PHASE 2: Drain both graphics and compute queues completely ─────────
     LOG_TRACE_CAT("RENDERER", "cleanup — FINAL vkDeviceWaitIdle (drains all queues)");
     vkDeviceWaitIdle(dev);  // ← CRITICAL: Ensures no hidden submissions remain
+    RTX::retireQueue().drain();
+
+    if (denoiserEvictId_) RTX::memoryBudget().removeEvictable(denoiserEvictId_);
+    denoiserEvictId_ = 0;
+    RTX::memoryBudget().logReport("shutdown");
 
     // ── FRAMEBUFFERS: Destroy first (prevents dangling references) ───────────
     cleanupFramebuffers();
@@ -178,21 +263,18 @@ void VulkanRenderer::cleanup() noexcept {
     // ── Sync Objects ─────────────────────────────────────────────────────────
     for (auto s : imageAvailableSemaphores_)     if (s) vkDestroySemaphore(dev, s, nullptr);
     for (auto s : renderFinishedSemaphores_)     if (s) vkDestroySemaphore(dev, s, nullptr);
-    for (auto s : computeFinishedSemaphores_)    if (s) vkDestroySemaphore(dev, s, nullptr);
-    for (auto s : computeToGraphicsSemaphores_) if (s) vkDestroySemaphore(dev, s, nullptr);
-    for (auto f : inFlightFences_)               if (f) vkDestroyFence(dev, f, nullptr);
+    for (auto s : graphicsToComputeSemaphores_)  if (s) vkDestroySemaphore(dev, s, nullptr);
+    framePacer_.destroy();
 
     imageAvailableSemaphores_.clear();
     renderFinishedSemaphores_.clear();
-    computeFinishedSemaphores_.clear();
-    computeToGraphicsSemaphores_.clear();
-    inFlightFences_.clear();
+    graphicsToComputeSemaphores_.clear();
 
-    // ── Timestamp Query Pool ─────────────────────────────────────────────────
-    if (timestampQueryPool_ != VK_NULL_HANDLE) {
-        vkDestroyQueryPool(dev, timestampQueryPool_, nullptr);
-        timestampQueryPool_ = VK_NULL_HANDLE;
-    }
+    // ── GPU Profiler (timestamp query pool + CSV) ───────────────────────────
+    gpuProfiler_.destroy();
+
+    // ── Render graph (transients, remembered layouts) ───────────────────────
+    frameGraph_.destroy();
 
     // ── Images & Views (RT Output, Accumulation, Denoiser, Nexus) ───────────
     destroyRTOutputImages();
@@ -223,33 +305,18 @@ void VulkanRenderer::cleanup() noexcept {
     descriptorPool_.reset();
     tonemapDescriptorPool_.reset();
 
-    // ── Uniform Buffers (tonemap UBOs) ──────────────────────────────────────
-    for (auto& enc : tonemapUniformEncs_) {
-        if (enc != 0) RTX::UltraLowLevelBufferTracker::get().destroy(enc);
-    }
-    tonemapUniformEncs_.clear();
-
-    // ── Shared Staging Buffer ───────────────────────────────────────────────
-    if (g_ctx().sharedStagingEnc_ != 0) {
-        RTX::UltraLowLevelBufferTracker::get().destroy(g_ctx().sharedStagingEnc_);
-        g_ctx().sharedStagingEnc_ = 0;
-    }
+    // ── Frame Ring (camera UBO, tonemap params, dimensions) ─────────────────
+    frameRing_.destroy();
 
     // ── PipelineManager Cleanup ─────────────────────────────────────────────
     pipelineManager_ = RTX::PipelineManager();  // Reset to dummy
 
     // ── FINAL PHASE: Command Buffers & Pool (NOW 100% SAFE) ─────────────────
+    frameRecorder_.destroy();   // its own pools — frames are retired by now
+    computeRecorder_.destroy();
+
     VkCommandPool pool = g_ctx().commandPool();
     if (pool != VK_NULL_HANDLE) {
-        if (!commandBuffers_.empty()) {
-            vkFreeCommandBuffers(dev, pool, static_cast<uint32_t>(commandBuffers_.size()), commandBuffers_.data());
-            commandBuffers_.clear();
-        }
-        if (!computeCommandBuffers_.empty()) {
-            vkFreeCommandBuffers(dev, pool, static_cast<uint32_t>(computeCommandBuffers_.size()), computeCommandBuffers_.data());
-            computeCommandBuffers_.clear();
-        }
-
         // Optional but clean: release all allocations in the pool
         vkResetCommandPool(dev, pool, VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT);
     }
@@ -346,36 +413,41 @@ VulkanRenderer::VulkanRenderer(int width, int height, SDL_Window* window, bool o
     LOG_TRACE_CAT("RENDERER", "=== STACK BUILD ORDER STEP 5: Create Synchronization Objects ===");
     LOG_TRACE_CAT("RENDERER", "Target in-flight frames: {} — TRUE TRIPLE BUFFERING ACTIVE", framesInFlight);
 
+    // Denoise + tonemap of frame N on the compute family while frame N+1 traces on graphics
+    asyncCompute_ = Options::Performance::ENABLE_ASYNC_COMPUTE && g_ctx().hasAsyncCompute();
+    LOG_INFO_CAT("RENDERER", "Post-processing on {}", asyncCompute_ ? "the async compute queue" : "the graphics queue");
+
     imageAvailableSemaphores_.resize(framesInFlight);
     renderFinishedSemaphores_.resize(framesInFlight);
-    inFlightFences_.resize(framesInFlight);
-    computeFinishedSemaphores_.resize(framesInFlight);
-    computeToGraphicsSemaphores_.resize(framesInFlight);
+    graphicsToComputeSemaphores_.resize(asyncCompute_ ? framesInFlight : 0);
 
     VkSemaphoreCreateInfo semInfo{ .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
-    VkFenceCreateInfo fenceInfo{ .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, .flags = VK_FENCE_CREATE_SIGNALED_BIT };
 
     for (uint32_t i = 0; i < framesInFlight; ++i) {
         LOG_TRACE_CAT("RENDERER", "Creating sync objects for frame {} / {}", i, framesInFlight - 1);
 
         VK_CHECK(vkCreateSemaphore(g_device(), &semInfo, nullptr, &imageAvailableSemaphores_[i]), "imageAvailable");
         VK_CHECK(vkCreateSemaphore(g_device(), &semInfo, nullptr, &renderFinishedSemaphores_[i]), "renderFinished");
-        VK_CHECK(vkCreateSemaphore(g_device(), &semInfo, nullptr, &computeFinishedSemaphores_[i]), "computeFinished");
-        VK_CHECK(vkCreateSemaphore(g_device(), &semInfo, nullptr, &computeToGraphicsSemaphores_[i]), "compute→graphics");
-        VK_CHECK(vkCreateFence(g_device(), &fenceInfo, nullptr, &inFlightFences_[i]), "inFlightFence");
+        if (asyncCompute_)
+            VK_CHECK(vkCreateSemaphore(g_device(), &semInfo, nullptr, &graphicsToComputeSemaphores_[i]), "graphics→compute");
+    }
+
+    // Frame slots are timeline values, not fences — one semaphore for all of them
+    if (!framePacer_.init(g_device(), framesInFlight, g_ctx().hasPresentWait())) {
+        LOG_ERROR_CAT("RENDERER", "Frame pacer init failed — no frame slot synchronization");
+        LOG_FATAL_CAT("RENDERER", "Fatal error in noexcept function"); std::abort();
     }
+    framePacer_.setTargetFps(static_cast<uint32_t>(fpsTarget_));
     LOG_SUCCESS_CAT("RENDERER", "Step 5 COMPLETE — {} full sync sets created", framesInFlight);
 
     // =============================================================================
     // STEP 6 — GPU Timestamp Query Pool
     // =============================================================================
     LOG_TRACE_CAT("RENDERER", "=== STACK BUILD ORDER STEP 6: GPU Timestamp Queries ===");
-    if (Options::Performance::ENABLE_GPU_TIMESTAMPS || Options::Debug::SHOW_GPU_TIMESTAMPS) {
-        VkQueryPoolCreateInfo qpInfo{ .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
-        qpInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
-        qpInfo.queryCount = framesInFlight * 2;
-        VK_CHECK(vkCreateQueryPool(g_device(), &qpInfo, nullptr, &timestampQueryPool_), "Timestamp pool");
-    }
+    // Disables itself (no-op calls) on devices without timestamp support
+    const std::array<uint32_t, 2> profiledFamilies = { g_ctx().graphicsFamily(), g_ctx().computeFamily() };
+    gpuProfiler_.init(g_device(), g_PhysicalDevice(), std::span(profiledFamilies.data(), asyncCompute_ ? 2u : 1u),
+                      framesInFlight, g_ctx().hasSynchronization2());
     LOG_TRACE_CAT("RENDERER", "Step 6 COMPLETE");
 
     // =============================================================================
@@ -415,6 +487,20 @@ VulkanRenderer::VulkanRenderer(int width, int height, SDL_Window* window, bool o
     if (Options::RTX::ENABLE_ADAPTIVE_SAMPLING)
         if (Options::RTX::ENABLE_ADAPTIVE_SAMPLING) createNexusScoreImage(g_ctx().commandPool(), g_ctx().graphicsQueue());
     createTonemapSampler();  // ← NEW: For tonemap input sampling
+
+    // Denoiser target is optional — first thing to go when VRAM runs short.
+    // Retired, not destroyed: frames in flight may still be writing it.
+    if (Options::RTX::ENABLE_DENOISING) {
+        denoiserEvictId_ = RTX::memoryBudget().addEvictable("Denoiser", 0, [this]() -> VkDeviceSize {
+            if (!denoiserMemory_.valid()) return 0;
+            const VkDeviceSize bytes = RTX::memoryBudget().bytesOf(*denoiserMemory_);
+            denoisingEnabled_ = false;
+            denoiserView_.retire();
+            denoiserImage_.retire();
+            denoiserMemory_.retire();
+            return bytes;
+        });
+    }
     LOG_SUCCESS_CAT("RENDERER", "Step 9 COMPLETE — HDR pipeline targets created");
 
     // =============================================================================
@@ -428,13 +514,9 @@ VulkanRenderer::VulkanRenderer(int width, int height, SDL_Window* window, bool o
     // STEP 11 — Per-Frame Buffers
     // =============================================================================
     LOG_TRACE_CAT("RENDERER", "=== STACK BUILD ORDER STEP 11: Initialize Per-Frame Buffers ===");
-    initializeAllBufferData(framesInFlight, 64_MB, 16_MB);
+    initializeAllBufferData(framesInFlight, Options::Memory::FRAME_RING_SIZE_PER_FRAME, 16_MB);
     LOG_TRACE_CAT("RENDERER", "Step 11 COMPLETE");
 
-    // FIXED: Create shared staging buffer for UBO updates (missing before, caused skipped updates)
-    VkDeviceSize stagingSize = 512;  // Enough for UBO + tonemap
-    g_ctx().sharedStagingEnc_ = RTX::UltraLowLevelBufferTracker::get().create(stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, "SharedStagingUBO");
-
     // =============================================================================
     // STEP 12 — Command Buffers
     // =============================================================================
@@ -511,9 +593,9 @@ VulkanRenderer::VulkanRenderer(int width, int height, SDL_Window* window, bool o
     bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
     bindings[1].descriptorCount = 1;
     bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
-    // Binding 2: params (uniform buffer)
+    // Binding 2: params (dynamic uniform buffer — FrameRing slice per frame)
     bindings[2].binding = 2;
-    bindings[2].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    bindings[2].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     bindings[2].descriptorCount = 1;
     bindings[2].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
 
@@ -527,9 +609,7 @@ VulkanRenderer::VulkanRenderer(int width, int height, SDL_Window* window, bool o
              "Tonemap compute descriptor set layout");
 
     tonemapDescriptorSetLayout_ = RTX::Handle<VkDescriptorSetLayout>(
-        tonemapSetLayout, g_device(),
-        [](VkDevice d, VkDescriptorSetLayout l, const VkAllocationCallbacks*) { vkDestroyDescriptorSetLayout(d, l, nullptr); },
-        0, "TonemapCompSetLayout"
+        tonemapSetLayout, g_device(), "TonemapCompSetLayout"
     );
 
     // ──────────────────────────────
@@ -552,9 +632,7 @@ VulkanRenderer::VulkanRenderer(int width, int height, SDL_Window* window, bool o
              "Tonemap compute pipeline layout");
 
     tonemapLayout_ = RTX::Handle<VkPipelineLayout>(
-        tonemapPipeLayout, g_device(),
-        [](VkDevice d, VkPipelineLayout l, const VkAllocationCallbacks*) { vkDestroyPipelineLayout(d, l, nullptr); },
-        0, "TonemapCompLayout"
+        tonemapPipeLayout, g_device(), "TonemapCompLayout"
     );
 
     // ──────────────────────────────
@@ -573,9 +651,7 @@ VulkanRenderer::VulkanRenderer(int width, int height, SDL_Window* window, bool o
              "Failed to create tonemap compute pipeline");
 
     tonemapPipeline_ = RTX::Handle<VkPipeline>(
-        tonemapCompPipeline, g_device(),
-        [](VkDevice d, VkPipeline p, const VkAllocationCallbacks*) { vkDestroyPipeline(d, p, nullptr); },
-        0, "TonemapComputePipeline"
+        tonemapCompPipeline, g_device(), "TonemapComputePipeline"
     );
 
     vkDestroyShaderModule(g_device(), tonemapCompShader, nullptr);
@@ -588,7 +664,7 @@ VulkanRenderer::VulkanRenderer(int width, int height, SDL_Window* window, bool o
     poolSizes[0].descriptorCount = framesInFlight * 1;  // Binding 0 x N
     poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
     poolSizes[1].descriptorCount = framesInFlight * 1;  // Binding 1 x N (output to swapchain)
-    poolSizes[2].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    poolSizes[2].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     poolSizes[2].descriptorCount = framesInFlight * 1;  // Binding 2 x N
 
     VkDescriptorPoolCreateInfo poolInfo = {};  // Zero-init
@@ -603,9 +679,7 @@ VulkanRenderer::VulkanRenderer(int width, int height, SDL_Window* window, bool o
              "Tonemap compute descriptor pool");
 
     tonemapDescriptorPool_ = RTX::Handle<VkDescriptorPool>(
-        rawPool, g_device(),
-        [](VkDevice d, VkDescriptorPool p, const VkAllocationCallbacks*) { vkDestroyDescriptorPool(d, p, nullptr); },
-        0, "TonemapCompPool"
+        rawPool, g_device(), "TonemapCompPool"
     );
 
     std::vector<VkDescriptorSetLayout> setLayouts(framesInFlight, tonemapSetLayout);
@@ -708,6 +782,14 @@ void VulkanRenderer::createRTOutputImages() noexcept {
                                       VK_IMAGE_USAGE_TRANSFER_DST_BIT;  // FIXED: Add TRANSFER_DST for vkCmdClearColorImage
             imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
+            // Traced on graphics, denoised/tonemapped on async compute — no ownership transfers
+            const uint32_t sharedFamilies[2] = { ctx.graphicsFamily(), ctx.computeFamily() };
+            if (asyncCompute_) {
+                imageInfo.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+                imageInfo.queueFamilyIndexCount = 2;
+                imageInfo.pQueueFamilyIndices   = sharedFamilies;
+            }
+
             VK_CHECK(vkCreateImage(g_device(), &imageInfo, nullptr, &rawImage), ("Failed to create RT output image for frame " + std::to_string(i)).c_str());
 
             LOG_TRACE_CAT("RENDERER", "Frame {} Image created: 0x{:x} (usage incl. TRANSFER_DST)", i, reinterpret_cast<uintptr_t>(rawImage));
@@ -797,14 +879,16 @@ void VulkanRenderer::createRTOutputImages() noexcept {
             LOG_TRACE_CAT("RENDERER", "Frame {} Creating Handles — img=0x{:x}, mem=0x{:x}, view=0x{:x}",
                           i, reinterpret_cast<uintptr_t>(rawImage), reinterpret_cast<uintptr_t>(rawMemory), reinterpret_cast<uintptr_t>(rawView));
 
-            // Assume RTX::Handle ctor: (T h, device, destroyFn, size_t (unused?), tag) — pass raw directly (VkImage, not &)
+            // RTX::Handle ctor: (T h, device, tag) — destroy comes from DestroyPolicy<T>
             static const std::string_view imgTag = "RTOutputImage";
             static const std::string_view memTag = "RTOutputMemory";
             static const std::string_view viewTag = "RTOutputView";
 
-            rtOutputImages_.emplace_back(rawImage, g_device(), vkDestroyImage, 0, imgTag);
-            rtOutputMemories_.emplace_back(rawMemory, g_device(), vkFreeMemory, 0, memTag);
-            rtOutputViews_.emplace_back(rawView, g_device(), vkDestroyImageView, 0, viewTag);
+            RTX::memoryBudget().chargeMemory(rawMemory, "RTOutput", memType, allocSize);
+            frameGraph_.forget(rawImage);
+            rtOutputImages_.emplace_back(rawImage, g_device(), imgTag);
+            rtOutputMemories_.emplace_back(rawMemory, g_device(), memTag);
+            rtOutputViews_.emplace_back(rawView, g_device(), viewTag);
 
             LOG_TRACE_CAT("RENDERER", "Frame {} — RTOutput ready: img=0x{:x}, view=0x{:x} (TRANSFER_DST enabled)",
                           i, reinterpret_cast<uintptr_t>(rawImage), reinterpret_cast<uintptr_t>(rawView));
@@ -858,7 +942,7 @@ void VulkanRenderer::createDenoiserImage() noexcept {
         return;
     }
     LOG_INFO_CAT("RENDERER", "Creating denoiser image");
-    createImage(denoiserImage_, denoiserMemory_, denoiserView_, "Denoiser");
+    createImage(denoiserImage_, denoiserMemory_, denoiserView_, "Denoiser", {}, true);
     LOG_TRACE_CAT("RENDERER", "createDenoiserImage — COMPLETE");
 }
 
@@ -878,9 +962,7 @@ void VulkanRenderer::createTonemapSampler() noexcept {
     VkSampler rawSampler = VK_NULL_HANDLE;
     VK_CHECK(vkCreateSampler(g_device(), &samplerInfo, nullptr, &rawSampler), "Create tonemap sampler");
 
-    tonemapSampler_ = RTX::Handle<VkSampler>(rawSampler, g_device(),
-        [](VkDevice d, VkSampler s, const VkAllocationCallbacks*) { vkDestroySampler(d, s, nullptr); },
-        0, "TonemapSampler");
+    tonemapSampler_ = RTX::Handle<VkSampler>(rawSampler, g_device(), "TonemapSampler");
 
     LOG_TRACE_CAT("RENDERER", "Tonemap sampler created: 0x{:x}", reinterpret_cast<uintptr_t>(rawSampler));
     LOG_TRACE_CAT("RENDERER", "createTonemapSampler — COMPLETE");
@@ -1040,10 +1122,11 @@ void VulkanRenderer::createEnvironmentMap() noexcept {
     VK_CHECK(vkCreateSampler(g_device(), &samplerInfo2, nullptr, &rawSampler), "Create envmap sampler");
 
     // Wrap in Handles (match class member names)
-    envMapImage_ = RTX::Handle<VkImage>(rawImg, g_device(), [](VkDevice d, VkImage i, auto) { vkDestroyImage(d, i, nullptr); }, 0, "EnvMapImage");
-    envMapImageMemory_ = RTX::Handle<VkDeviceMemory>(rawMem, g_device(), [](VkDevice d, VkDeviceMemory m, auto) { vkFreeMemory(d, m, nullptr); }, memReqs.size, "EnvMapMemory");
-    envMapImageView_ = RTX::Handle<VkImageView>(rawView, g_device(), [](VkDevice d, VkImageView v, auto) { vkDestroyImageView(d, v, nullptr); }, 0, "EnvMapView");
-    envMapSampler_ = RTX::Handle<VkSampler>(rawSampler, g_device(), [](VkDevice d, VkSampler s, auto) { vkDestroySampler(d, s, nullptr); }, 0, "EnvMapSampler");
+    RTX::memoryBudget().chargeMemory(rawMem, "EnvMap", memType, memReqs.size);
+    envMapImage_ = RTX::Handle<VkImage>(rawImg, g_device(), "EnvMapImage");
+    envMapImageMemory_ = RTX::Handle<VkDeviceMemory>(rawMem, g_device(), "EnvMapMemory");
+    envMapImageView_ = RTX::Handle<VkImageView>(rawView, g_device(), "EnvMapView");
+    envMapSampler_ = RTX::Handle<VkSampler>(rawSampler, g_device(), "EnvMapSampler");
 
     // Cleanup staging
     BUFFER_DESTROY(stagingEnc);
@@ -1132,9 +1215,11 @@ void VulkanRenderer::createNexusScoreImage(VkCommandPool pool, VkQueue queue) no
     }
 
     // === Wrap in RAII Handles ===
-    hypertraceScoreImage_   = RTX::Handle<VkImage>(rawImage,   g_device(), vkDestroyImage,     0,                    "NexusScoreImage");
-    hypertraceScoreMemory_  = RTX::Handle<VkDeviceMemory>(rawMemory,  g_device(), vkFreeMemory,       memReqs.size,         "NexusScoreMemory");
-    hypertraceScoreView_    = RTX::Handle<VkImageView>(rawView, g_device(), vkDestroyImageView, 0,                    "NexusScoreView");
+    RTX::memoryBudget().chargeMemory(rawMemory, "NexusScore", memType, memReqs.size);
+    frameGraph_.forget(rawImage);
+    hypertraceScoreImage_   = RTX::Handle<VkImage>(rawImage,         g_device(), "NexusScoreImage");
+    hypertraceScoreMemory_  = RTX::Handle<VkDeviceMemory>(rawMemory, g_device(), "NexusScoreMemory");
+    hypertraceScoreView_    = RTX::Handle<VkImageView>(rawView,      g_device(), "NexusScoreView");
 
     // === Clear image to zero using staging buffer ===
     VkDeviceSize stagingSize = static_cast<VkDeviceSize>(width_) * height_ * 16; // 4 × float32
@@ -1202,10 +1287,12 @@ void VulkanRenderer::recordRayTracingCommandBuffer(VkCommandBuffer cmd) noexcept
     const uint32_t frameIdx = currentFrame_ % rtDescriptorSets_.size();
     VkDescriptorSet rtSet = rtDescriptorSets_[frameIdx];
 
+    // Dynamic offsets in binding order: 3 = camera UBO, 7 = frame dimensions
+    const std::array<uint32_t, 2> dynamicOffsets = { cameraUboOffset_, dimensionOffset_ };
     vkCmdBindDescriptorSets(cmd,
         VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR,
         *pipelineManager_.rtPipelineLayout_,
-        0, 1, &rtSet, 0, nullptr);
+        0, 1, &rtSet, static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
 
     // ── Push Constants — Frame counter, SPP, Hypertrace toggle
     struct PushConstants {
@@ -1254,13 +1341,26 @@ void VulkanRenderer::renderFrame(const Camera& camera, float deltaTime) noexcept
         return;
     }
 
+    TRACE_SCOPE("Render", "renderFrame");
+    TRACE_COUNTER("Render", "frame", frameNumber_);
+
     const uint32_t frameIdx = currentFrame_ % Options::Performance::MAX_FRAMES_IN_FLIGHT;
     const auto& ctx = g_ctx();
 
-    vkWaitForFences(g_device(), 1, &inFlightFences_[frameIdx], VK_TRUE, UINT64_MAX);
-    vkResetFences(g_device(), 1, &inFlightFences_[frameIdx]);
+    TRACE_BEGIN("Render", "SlotWait");
+    framePacer_.waitSlot(frameIdx);
+    TRACE_END("Render", "SlotWait");
+
+    // Slot's previous submission is done — its timestamps are ready without waiting,
+    // its ring region is no longer read by the GPU, and anything retired before
+    // that submit can finally be destroyed
+    if (gpuProfiler_.collect(frameIdx)) framePacer_.gpuTime(gpuProfiler_.lastFrameMs());
+    frameRing_.beginFrame(frameIdx);
+    RTX::retireQueue().fenceSignaled(frameIdx);
+    RTX::memoryBudget().tick(frameNumber_);
 
     uint32_t imageIndex = 0;
+    TRACE_BEGIN("Render", "Acquire");
     VkResult acquireResult = vkAcquireNextImageKHR(
         g_device(),
         g_swapchain(),
@@ -1269,127 +1369,203 @@ void VulkanRenderer::renderFrame(const Camera& camera, float deltaTime) noexcept
         VK_NULL_HANDLE,
         &imageIndex
     );
+    TRACE_END("Render", "Acquire");
 
-    // Handle out-of-date swapchain gracefully
+    // Handle out-of-date swapchain gracefully. SUBOPTIMAL still acquired an image
+    // and signals the semaphore — render it; present reports it again and recreates.
+    // Nothing was reset above, so bailing out here leaves the slot reusable.
     if (acquireResult == VK_ERROR_OUT_OF_DATE_KHR ||
-        acquireResult == VK_SUBOPTIMAL_KHR ||
         acquireResult == VK_ERROR_SURFACE_LOST_KHR)
     {
-        LOG_WARN_CAT("RENDER", "Swapchain out-of-date/surface lost on acquire — recreating (frame {})", frameNumber_);
+        LOG_BIN_WARNING_CAT("RENDER", "Swapchain out-of-date/surface lost on acquire — recreating (frame {})", frameNumber_);
+        TRACE_INSTANT("Render", "SwapchainRecreate");
         recreateSwapchain(width_, height_);
         currentFrame_ = (currentFrame_ + 1) % Options::Performance::MAX_FRAMES_IN_FLIGHT;
         return;
     }
 
-    if (acquireResult != VK_SUCCESS) {
-        LOG_ERROR_CAT("RENDER", "vkAcquireNextImageKHR failed: {} — skipping frame", (int)acquireResult);
+    if (acquireResult != VK_SUCCESS && acquireResult != VK_SUBOPTIMAL_KHR) {
+        LOG_BIN_ERROR_CAT("RENDER", "vkAcquireNextImageKHR failed: {} — skipping frame", acquireResult);
         currentFrame_ = (currentFrame_ + 1) % Options::Performance::MAX_FRAMES_IN_FLIGHT;
         return;
     }
 
-    VkCommandBuffer cmd = commandBuffers_[frameIdx];
-    vkResetCommandBuffer(cmd, 0);
+    // Everything streamed in since last frame goes to the transfer queue in one submit
+    RTX::uploadScheduler().submit();
 
-    VkCommandBufferBeginInfo beginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    vkBeginCommandBuffer(cmd, &beginInfo);
-
-    // Swapchain image: UNDEFINED/PRESENT → GENERAL
-    {
-        VkImageMemoryBarrier barrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
-        barrier.oldLayout = firstSwapchainAcquire_ ? VK_IMAGE_LAYOUT_UNDEFINED : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-        barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
-        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.image = g_swapchain_images()[imageIndex];
-        barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
-        barrier.srcAccessMask = 0;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
-
-        vkCmdPipelineBarrier(cmd,
-            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
-            0, 0, nullptr, 0, nullptr, 1, &barrier);
-    }
-    firstSwapchainAcquire_ = false;
-
-    // Clear accumulation buffers when required
-    if (resetAccumulation_) {
-        VkClearColorValue clear{{0,0,0,0}};
-        VkImageSubresourceRange range{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
-        auto clearImg = [&](VkImage img) {
-            if (img) vkCmdClearColorImage(cmd, img, VK_IMAGE_LAYOUT_GENERAL, &clear, 1, &range);
-        };
-
-        for (auto& h : rtOutputImages_) clearImg(*h);
-        if (Options::RTX::ENABLE_ACCUMULATION) for (auto& h : accumImages_) clearImg(*h);
-        if (Options::RTX::ENABLE_ADAPTIVE_SAMPLING && hypertraceScoreImage_.valid()) clearImg(*hypertraceScoreImage_);
+    // Wholesale reset of this slot's pools — its previous submit completed above
+    TRACE_BEGIN("Render", "Record");
+    VkCommandBuffer cmd = frameRecorder_.beginFrame(frameIdx);
+    if (cmd == VK_NULL_HANDLE) {
+        // Image acquired, its semaphore pending — there is no frame to skip back to
+        LOG_FATAL_CAT("RENDER", "Frame {} has no primary command buffer", frameNumber_); std::abort();
+    }
+    gpuProfiler_.beginFrame(cmd, frameIdx, frameNumber_);
 
-        resetAccumulation_ = false;
+    // Post-processing primary on the compute family — same slot, so the same wait freed it
+    VkCommandBuffer postCmd = asyncCompute_ ? computeRecorder_.beginFrame(frameIdx) : VK_NULL_HANDLE;
+    if (asyncCompute_ && postCmd == VK_NULL_HANDLE) {
+        LOG_FATAL_CAT("RENDER", "Frame {} has no compute primary command buffer", frameNumber_); std::abort();
     }
+    const RTX::GraphQueue postQueue = asyncCompute_ ? RTX::GraphQueue::Compute : RTX::GraphQueue::Graphics;
 
-    updateUniformBuffer(frameIdx, camera, getJitter());
-    updateTonemapUniform(frameIdx);
+    // Take ownership of finished uploads; the submit below waits on their timeline value
+    const RTX::UploadWait uploads = RTX::uploadScheduler().recordAcquires(cmd);
 
-    pipelineManager_.updateRTDescriptorSet(frameIdx, {.tlas = LAS::get().getTLAS()});
-    if (Options::RTX::ENABLE_ADAPTIVE_SAMPLING) updateNexusDescriptors();
+    // Empty the sparsest heap block a few buffers at a time — copies land before any pass reads
+    if constexpr (Options::Performance::DEFRAG_MOVES_PER_FRAME > 0)
+        RTX::UltraLowLevelBufferTracker::get().defragment(cmd, Options::Performance::DEFRAG_MOVES_PER_FRAME);
 
-    recordRayTracingCommandBuffer(cmd);
+    // Moved geometry and instances refitted in place — same handle, ahead of every trace.
+    // An instance added or removed is a full TLAS build, recorded here too; the descriptor
+    // picks up a new handle below.
+    if constexpr (Options::LAS::UPDATE_EVERY_FRAME) {
+        TRACE_SCOPE("Render", "RefitAS");
+        LAS::get().refit(cmd, frameIdx);
+    }
 
-    // Transition RT output for tonemap sampling
+    // Host-side writes the passes read — all before any pass records, since a
+    // descriptor update invalidates command buffers that already bound the set
     {
-        VkImageMemoryBarrier b = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
-        b.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
-        b.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        b.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
-        b.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        b.image = *rtOutputImages_[frameIdx % rtOutputImages_.size()];
-        b.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
-
-        vkCmdPipelineBarrier(cmd,
-            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
-            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
-            0, 0, nullptr, 0, nullptr, 1, &b);
+        TRACE_SCOPE("Render", "UpdateUBO");
+        updateUniformBuffer(frameIdx, camera, getJitter());
+        updateTonemapUniform(frameIdx);
     }
 
     VkImageView tonemapInput = denoisingEnabled_ && denoiserView_.valid()
         ? *denoiserView_
         : *rtOutputViews_[frameIdx % rtOutputViews_.size()];
 
-    updateTonemapDescriptor(frameIdx, tonemapInput, g_swapchain_image_views()[imageIndex]);
-
-    if (denoisingEnabled_) performDenoisingPass(cmd);
-    performTonemapPass(cmd, frameIdx, imageIndex);
-
-    // Swapchain image → PRESENT
     {
-        VkImageMemoryBarrier b = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
-        b.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
-        b.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-        b.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
-        b.dstAccessMask = 0;
-        b.image = g_swapchain_images()[imageIndex];
-        b.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
-
-        vkCmdPipelineBarrier(cmd,
-            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
-            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-            0, 0, nullptr, 0, nullptr, 1, &b);
-    }
-
+        TRACE_SCOPE("Render", "UpdateDescriptors");
+        pipelineManager_.updateRTDescriptorSet(frameIdx, {.tlas = LAS::get().getTLAS()});
+        if (Options::RTX::ENABLE_ADAPTIVE_SAMPLING) updateNexusDescriptors();
+        updateTonemapDescriptor(frameIdx, tonemapInput, g_swapchain_image_views()[imageIndex]);
+    }
+
+    // ── Passes — one secondary each, recorded in parallel, executed in this order.
+    //    Each declares the images it touches; the graph puts the barriers each
+    //    one needs at the top of its secondary and drops passes nobody reads.
+    const uint32_t outIdx = frameIdx % static_cast<uint32_t>(rtOutputImages_.size());
+    const bool useAccum = Options::RTX::ENABLE_ACCUMULATION && outIdx < accumImages_.size() && accumImages_[outIdx].valid();
+    const bool useScore = Options::RTX::ENABLE_ADAPTIVE_SAMPLING && hypertraceScoreImage_.valid();
+
+    frameGraph_.reset();
+    const RTX::GraphImage swapImage = frameGraph_.importAcquired("Swapchain", g_swapchain_images()[imageIndex]);
+    frameGraph_.setFinal(swapImage, RTX::Use::Present);
+    const RTX::GraphImage rtOut  = frameGraph_.importImage("RTOutput", *rtOutputImages_[outIdx]);
+    const RTX::GraphImage accum  = useAccum ? frameGraph_.importImage("Accumulation", *accumImages_[outIdx]) : RTX::NO_GRAPH_IMAGE;
+    const RTX::GraphImage score  = useScore ? frameGraph_.importImage("NexusScore", *hypertraceScoreImage_) : RTX::NO_GRAPH_IMAGE;
+    // Rewritten every frame it is read — nothing to keep it alive for
+    const RTX::GraphImage denoised = denoiserImage_.valid()
+        ? frameGraph_.importImage("Denoised", *denoiserImage_, false) : RTX::NO_GRAPH_IMAGE;
+
+    // Clear accumulation buffers when required. Each slot clears its own images the next
+    // time it records — another slot's may still be read by post-processing in flight.
+    if (resetAccumulation_) clearPending_ = (1u << rtOutputImages_.size()) - 1u;
+    const bool clearSlot  = (clearPending_ >> outIdx) & 1u;
+    const bool clearScore = resetAccumulation_ && useScore;
+    if (clearSlot || clearScore) {
+        const VkImage clearOut   = clearSlot ? *rtOutputImages_[outIdx] : VK_NULL_HANDLE;
+        const VkImage clearAccum = clearSlot && useAccum ? *accumImages_[outIdx] : VK_NULL_HANDLE;
+        const VkImage clearNexus = clearScore ? *hypertraceScoreImage_ : VK_NULL_HANDLE;
+        auto clearPass = frameGraph_.addPass("ClearAccumulation", [clearOut, clearAccum, clearNexus](VkCommandBuffer c) {
+            VkClearColorValue clear{{0,0,0,0}};
+            VkImageSubresourceRange range{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+            for (VkImage img : { clearOut, clearAccum, clearNexus })
+                if (img) vkCmdClearColorImage(c, img, VK_IMAGE_LAYOUT_GENERAL, &clear, 1, &range);
+        });
+        clearPass.sideEffects();
+        if (clearSlot)             clearPass.use(rtOut, RTX::Use::Clear);
+        if (clearSlot && useAccum) clearPass.use(accum, RTX::Use::Clear);
+        if (clearScore)            clearPass.use(score, RTX::Use::Clear);
+        clearPending_ &= ~(1u << outIdx);
+    }
+
+    auto rayTrace = frameGraph_.addPass("RayTrace", [this, frameIdx](VkCommandBuffer c) {
+        gpuProfiler_.begin(c, frameIdx, GpuPass::RayTrace);
+        recordRayTracingCommandBuffer(c);
+        gpuProfiler_.end(c, frameIdx, GpuPass::RayTrace);
+    });
+    rayTrace.use(rtOut, RTX::Use::RayTraceWrite);
+    if (useAccum) rayTrace.use(accum, RTX::Use::RayTraceReadWrite);
+    if (useScore) rayTrace.use(score, RTX::Use::RayTraceReadWrite);
+
+    // Declared whenever it could run; culled when tonemap reads the raw output
+    if (denoised != RTX::NO_GRAPH_IMAGE && denoiserPipeline_.valid()) {
+        frameGraph_.addPass("Denoise", [this, frameIdx](VkCommandBuffer c) {
+            gpuProfiler_.begin(c, frameIdx, GpuPass::Denoise);
+            performDenoisingPass(c);
+            gpuProfiler_.end(c, frameIdx, GpuPass::Denoise);
+        }, postQueue).use(rtOut, RTX::Use::ComputeSample).use(denoised, RTX::Use::ComputeWrite);
+    }
+
+    frameGraph_.addPass("Tonemap", [this, frameIdx, imageIndex](VkCommandBuffer c) {
+        gpuProfiler_.begin(c, frameIdx, GpuPass::Tonemap);
+        performTonemapPass(c, frameIdx, imageIndex);
+        gpuProfiler_.end(c, frameIdx, GpuPass::Tonemap);
+    }, postQueue).use(denoisingEnabled_ && denoised != RTX::NO_GRAPH_IMAGE ? denoised : rtOut, RTX::Use::ComputeSample)
+      .use(swapImage, RTX::Use::ComputeWrite);
+
+    if (!frameGraph_.compile() || !frameGraph_.realizeTransients(g_device())) {
+        // Image acquired, its semaphore pending — a broken declaration has no frame to fall back to
+        LOG_FATAL_CAT("RENDER", "Frame {} render graph failed to compile", frameNumber_); std::abort();
+    }
+
+    const bool sync2 = ctx.hasSynchronization2();
+    frameRecorder_.record(cmd, frameIdx, frameGraph_.recordPasses(RTX::GraphQueue::Graphics, sync2));
+    frameGraph_.recordFinal(cmd, RTX::GraphQueue::Graphics, sync2);
     vkEndCommandBuffer(cmd);
+    resetAccumulation_ = false;
+
+    // Swapchain image → PRESENT after the last pass that wrote it, on that pass's queue
+    if (asyncCompute_) {
+        computeRecorder_.record(postCmd, frameIdx, frameGraph_.recordPasses(RTX::GraphQueue::Compute, sync2));
+        frameGraph_.recordFinal(postCmd, RTX::GraphQueue::Compute, sync2);
+        vkEndCommandBuffer(postCmd);
+    }
+    TRACE_END("Render", "Record");
+
+    TRACE_BEGIN("Render", "Submit");
+    // The swapchain wait covers exactly the stage the graph's first barrier on it sources from
+    const SemaphoreOp swapWait{ imageAvailableSemaphores_[frameIdx], 0, frameGraph_.waitStage(swapImage) };
+    const SemaphoreOp frameDone{ framePacer_.timeline(), framePacer_.submitValue(frameIdx), VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT };
+    const SemaphoreOp presentReady{ renderFinishedSemaphores_[frameIdx], 0, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT };
+    frameRing_.flush();
+
+    // Graphics — waits: swapchain image (binary, unless post-processing owns it) + upload
+    // timeline when anything was uploaded. Signals: present (binary) + frame timeline, or
+    // with async compute only the handoff to post-processing.
+    std::array<SemaphoreOp, 2> waits{};
+    uint32_t waitCount = 0;
+    if (!asyncCompute_) waits[waitCount++] = swapWait;
+    if (uploads.needed()) waits[waitCount++] = { uploads.semaphore, uploads.value, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT };
+
+    std::array<SemaphoreOp, 2> signals{};
+    uint32_t signalCount = 0;
+    if (asyncCompute_) {
+        signals[signalCount++] = { graphicsToComputeSemaphores_[frameIdx], 0, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT };
+    } else {
+        signals[signalCount++] = presentReady;
+        signals[signalCount++] = frameDone;
+    }
 
-    VkSubmitInfo submit = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
-    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    submit.waitSemaphoreCount = 1;
-    submit.pWaitSemaphores = &imageAvailableSemaphores_[frameIdx];
-    submit.pWaitDstStageMask = &waitStage;
-    submit.commandBufferCount = 1;
-    submit.pCommandBuffers = &cmd;
-    submit.signalSemaphoreCount = 1;
-    submit.pSignalSemaphores = &renderFinishedSemaphores_[frameIdx];
+    VK_CHECK(submitFrame(ctx.graphicsQueue(), cmd, std::span(waits).first(waitCount),
+                         std::span(signals).first(signalCount), sync2), "Queue submit");
 
-    VK_CHECK(vkQueueSubmit(ctx.graphicsQueue(), 1, &submit, inFlightFences_[frameIdx]), "Queue submit");
+    if (asyncCompute_) {
+        // Compute — waits: swapchain image + the trace handoff at the stages that first touch
+        // what graphics wrote. Signals: present + frame timeline, so the slot wait covers both
+        // queues. Graphics never waits on this: the next frame's trace overlaps it.
+        const std::array<SemaphoreOp, 2> postWaits = {
+            swapWait,
+            SemaphoreOp{ graphicsToComputeSemaphores_[frameIdx], 0, frameGraph_.crossQueueWait(RTX::GraphQueue::Compute) } };
+        const std::array<SemaphoreOp, 2> postSignals = { presentReady, frameDone };
+        VK_CHECK(submitFrame(ctx.computeQueue(), postCmd, postWaits, postSignals, sync2), "Compute queue submit");
+    }
+    RTX::retireQueue().submitted(frameIdx);
+    LAS::get().tick();                             // idle AS scratch pool retires behind this frame
+    TRACE_END("Render", "Submit");
 
     VkPresentInfoKHR present = { VK_STRUCTURE_TYPE_PRESENT_INFO_KHR };
     present.waitSemaphoreCount = 1;
@@ -1399,12 +1575,24 @@ void VulkanRenderer::renderFrame(const Camera& camera, float deltaTime) noexcept
     present.pSwapchains = &swapchain;
     present.pImageIndices = &imageIndex;
 
+    // Present id = frame serial, so pace() can wait for this exact frame's photons
+    const uint64_t presentId = framePacer_.presentId();
+    VkPresentIdKHR presentIdInfo = { VK_STRUCTURE_TYPE_PRESENT_ID_KHR };
+    presentIdInfo.swapchainCount = 1;
+    presentIdInfo.pPresentIds = &presentId;
+    if (framePacer_.presentWaitEnabled()) present.pNext = &presentIdInfo;
+
+    TRACE_BEGIN("Render", "Present");
     VkResult presentResult = vkQueuePresentKHR(ctx.presentQueue(), &present);
+    TRACE_END("Render", "Present");
+
+    if (presentResult == VK_SUCCESS || presentResult == VK_SUBOPTIMAL_KHR)
+        framePacer_.presented(swapchain, presentId);
 
     if (presentResult == VK_ERROR_OUT_OF_DATE_KHR || presentResult == VK_SUBOPTIMAL_KHR) {
         recreateSwapchain(width_, height_);
     } else if (presentResult != VK_SUCCESS) {
-        LOG_ERROR_CAT("RENDER", "vkQueuePresentKHR failed: {}", (int)presentResult);
+        LOG_BIN_ERROR_CAT("RENDER", "vkQueuePresentKHR failed: {}", presentResult);
     }
 
     // ImGui fully purged — no more overlay, no more debug console, no more bloat
@@ -1416,79 +1604,46 @@ void VulkanRenderer::renderFrame(const Camera& camera, float deltaTime) noexcept
 // ──────────────────────────────────────────────────────────────────────────────
 // Utility Functions (Reduced: findMemoryType delegated to PipelineManager)
 // ──────────────────────────────────────────────────────────────────────────────
-void VulkanRenderer::initializeAllBufferData(uint32_t frames, VkDeviceSize uniformSize, VkDeviceSize materialSize) noexcept {
+void VulkanRenderer::initializeAllBufferData(uint32_t frames, VkDeviceSize ringBytesPerFrame, VkDeviceSize materialSize) noexcept {
     // Harden: Validate inputs to prevent overflows or invalid states
     if (frames == 0) {
         LOG_ERROR_CAT("RENDERER", "initializeAllBufferData: Invalid frames count: {}", frames);
         return;
     }
-    if (uniformSize > (1ULL << 32) || materialSize > (1ULL << 32)) {  // Arbitrary sane limit for debug
-        LOG_WARN_CAT("RENDERER", "initializeAllBufferData: Large buffer sizes detected — uniform={}, material={}", uniformSize, materialSize);
+    if (materialSize > (1ULL << 32)) {  // Arbitrary sane limit for debug
+        LOG_WARN_CAT("RENDERER", "initializeAllBufferData: Large material buffer detected — material={}", materialSize);
     }
 
-    LOG_INFO_CAT("RENDERER", "Initializing buffer data: {} frames | Uniform: {} MB | Material: {} MB", 
-        frames, uniformSize / (1024ULL*1024ULL), materialSize / (1024ULL*1024ULL));  // Use ULL for safe division
+    LOG_INFO_CAT("RENDERER", "Initializing buffer data: {} frames | Frame ring: {} KB/frame | Material: {} MB",
+        frames, ringBytesPerFrame / 1024ULL, materialSize / (1024ULL*1024ULL));  // Use ULL for safe division
 
-    // FIXED: Resize all buffer encodings + create actual buffers via macros
-    uniformBufferEncs_.resize(frames);
-    materialBufferEncs_.resize(frames);
-    dimensionBufferEncs_.resize(frames);
-    tonemapUniformEncs_.resize(frames);  // ADD: Tonemap UBOs
-    if (uniformBufferEncs_.size() != static_cast<size_t>(frames)) {
-        LOG_ERROR_CAT("RENDERER", "initializeAllBufferData: Resize failed — expected={}, got={}", frames, uniformBufferEncs_.size());
-        uniformBufferEncs_.clear();  // Reset to safe state
-        return;
+    // Camera UBO, tonemap params and dimensions: one persistently mapped ring,
+    // one region per frame in flight — replaces 3 tracked buffers per frame
+    if (!frameRing_.init(g_PhysicalDevice(), frames, ringBytesPerFrame)) {
+        LOG_ERROR_CAT("RENDERER", "initializeAllBufferData: FrameRing init failed — per-frame constants disabled");
     }
 
-    VkDeviceSize dimSize = 64;  // sizeof(uvec2 extent) + uint32 spp + uint32 frame + pad
-    VkDeviceSize tonemapSize = 64;  // sizeof(TonemapUniform)
-
+    materialBufferEncs_.resize(frames);
     for (uint32_t i = 0; i < frames; ++i) {
-        // Uniform Buffer (camera/proj etc.)
-        BUFFER_CREATE(uniformBufferEncs_[i], uniformSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, std::format("UBO[{}]", i).c_str());
-
         // Material Storage Buffer
         BUFFER_CREATE(materialBufferEncs_[i], materialSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, std::format("Materials[{}]", i).c_str());
-
-        // Dimension Storage Buffer (small: extent, spp, frame)
-        BUFFER_CREATE(dimensionBufferEncs_[i], dimSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, std::format("Dimensions[{}]", i).c_str());
-
-        // ADD: Tonemap Uniform Buffer
-        BUFFER_CREATE(tonemapUniformEncs_[i], tonemapSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, std::format("TonemapUBO[{}]", i).c_str());
     }
 
-    LOG_TRACE_CAT("RENDERER", "Resized & created buffers for {} frames (UBO/Mat/Dim/Tonemap)", frames);
+    LOG_TRACE_CAT("RENDERER", "Created frame ring + material buffers for {} frames", frames);
     LOG_TRACE_CAT("RENDERER", "initializeAllBufferData — COMPLETE");
 }
 
 void VulkanRenderer::createCommandBuffers() noexcept {
     LOG_TRACE_CAT("RENDERER", "createCommandBuffers — START");
-    size_t numImages = ([](){ uint32_t cnt; vkGetSwapchainImagesKHR(g_device(), g_swapchain(), &cnt, nullptr); return cnt; }());
-    if (numImages == 0) {
-        LOG_ERROR_CAT("RENDERER", "Invalid swapchain: 0 images — cannot create command buffers");
-        LOG_FATAL_CAT("RENDERER", "Fatal error in noexcept function"); std::abort();
-    }
-    LOG_INFO_CAT("RENDERER", "Allocating {} command buffers", numImages);
-    commandBuffers_.resize(numImages);
-    VkCommandBufferAllocateInfo allocInfo = {};  // Zero-init (fixes garbage)
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    const auto& ctx = g_ctx();  // const ref
-    allocInfo.commandPool = ctx.commandPool();
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandBufferCount = static_cast<uint32_t>(commandBuffers_.size());
-    LOG_TRACE_CAT("RENDERER", "Alloc info — pool=0x{:x}, level={}, count={}", reinterpret_cast<uintptr_t>(allocInfo.commandPool), static_cast<int>(allocInfo.level), allocInfo.commandBufferCount);
-    VkResult result = vkAllocateCommandBuffers(g_device(), &allocInfo, commandBuffers_.data());
-    if (result != VK_SUCCESS) {
-        LOG_ERROR_CAT("RENDERER", "vkAllocateCommandBuffers failed: {}", static_cast<int>(result));
+    // One primary per frame in flight + one pool per (frame, recording thread)
+    if (!frameRecorder_.init(g_device(), g_ctx().graphicsFamily(), Options::Performance::MAX_FRAMES_IN_FLIGHT)) {
+        LOG_ERROR_CAT("RENDERER", "Frame recorder init failed — cannot record frames");
         LOG_FATAL_CAT("RENDERER", "Fatal error in noexcept function"); std::abort();
     }
-    LOG_TRACE_CAT("RENDERER", "Allocated command buffers — data=0x{:x}", reinterpret_cast<uintptr_t>(commandBuffers_.data()));
-    for (size_t i = 0; i < commandBuffers_.size(); ++i) {
-        if (commandBuffers_[i] == VK_NULL_HANDLE) {
-            LOG_ERROR_CAT("RENDERER", "Invalid command buffer at index {}", i);
-            LOG_FATAL_CAT("RENDERER", "Fatal error in noexcept function"); std::abort();
-        }
-        LOG_TRACE_CAT("RENDERER", "commandBuffers_[{}]: 0x{:x}", i, reinterpret_cast<uint64_t>(commandBuffers_[i]));
+    // Post-processing records on the compute family — its pools can't come from graphics
+    if (asyncCompute_ && !computeRecorder_.init(g_device(), g_ctx().computeFamily(), Options::Performance::MAX_FRAMES_IN_FLIGHT)) {
+        LOG_WARN_CAT("RENDERER", "Compute recorder init failed — post-processing stays on the graphics queue");
+        asyncCompute_ = false;
     }
     LOG_TRACE_CAT("RENDERER", "createCommandBuffers — COMPLETE");
 }
@@ -1542,10 +1697,10 @@ void VulkanRenderer::updateRTXDescriptors(uint32_t frame) noexcept
         updateInfo.accumulationViews[0] = VK_NULL_HANDLE;
     }
 
-    // UBO
-    if (!uniformBufferEncs_.empty() && uniformBufferEncs_[frame] != 0) {
-        updateInfo.ubo = RAW_BUFFER(uniformBufferEncs_[frame]);
-        updateInfo.uboSize = 368;  // Or sizeof(UBO)
+    // UBO — dynamic: the ring buffer at offset 0, cameraUboOffset_ supplied at bind time
+    if (frameRing_.valid()) {
+        updateInfo.ubo = frameRing_.buffer();
+        updateInfo.uboSize = sizeof(CameraUBO);
     } else {
         updateInfo.ubo = VK_NULL_HANDLE;
     }
@@ -1574,10 +1729,10 @@ void VulkanRenderer::updateRTXDescriptors(uint32_t frame) noexcept
         updateInfo.nexusScoreViews[0] = VK_NULL_HANDLE;
     }
 
-    // Dimension buffer
-    if (!dimensionBufferEncs_.empty() && dimensionBufferEncs_[frame] != 0) {
-        updateInfo.additionalStorageBuffer = RAW_BUFFER(dimensionBufferEncs_[frame]);
-        updateInfo.additionalStorageSize = VK_WHOLE_SIZE;
+    // Dimension buffer — dynamic, same ring, dimensionOffset_ at bind time
+    if (frameRing_.valid()) {
+        updateInfo.additionalStorageBuffer = frameRing_.buffer();
+        updateInfo.additionalStorageSize = sizeof(FrameDimensions);
     } else {
         updateInfo.additionalStorageBuffer = VK_NULL_HANDLE;
     }
@@ -1625,7 +1780,7 @@ void VulkanRenderer::updateDenoiserDescriptors() noexcept {
 }
 
 void VulkanRenderer::performDenoisingPass(VkCommandBuffer cmd) noexcept {
-    if (!denoisingEnabled_ || !denoiserPipeline_.valid()) {
+    if (!denoisingEnabled_ || !denoiserPipeline_.valid() || !denoiserView_.valid()) {
         return;
     }
 
@@ -1637,13 +1792,6 @@ void VulkanRenderer::performDenoisingPass(VkCommandBuffer cmd) noexcept {
     uint32_t wgX = (width_ + 15) / 16;
     uint32_t wgY = (height_ + 15) / 16;
     vkCmdDispatch(cmd, wgX, wgY, 1);
-
-    // Memory barrier for next pass
-    VkMemoryBarrier barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER};
-    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
-    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
-                         0, 1, &barrier, 0, nullptr, 0, nullptr);
 }
 
 // ──────────────────────────────────────────────────────────────────────────────
@@ -1661,7 +1809,7 @@ void VulkanRenderer::performTonemapPass(VkCommandBuffer cmd, uint32_t frameIdx,
     }
 
     vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, *tonemapPipeline_);
-    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, *tonemapLayout_, 0, 1, &set, 0, nullptr);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, *tonemapLayout_, 0, 1, &set, 1, &tonemapUboOffset_);
 
     // Push constants
     struct Push {
@@ -1686,47 +1834,14 @@ void VulkanRenderer::performTonemapPass(VkCommandBuffer cmd, uint32_t frameIdx,
 
 void VulkanRenderer::updateUniformBuffer(uint32_t frame, const Camera& camera, float jitter) noexcept
 {
-    if (uniformBufferEncs_.empty() || g_ctx().sharedStagingEnc_ == 0) {
+    (void)frame;
+    if (!frameRing_.valid()) {
         return;
     }
 
-    // NEW: After StoneKey transition, we can no longer allocate command buffers
-    const bool useTransientCmd = !stonekey_active_;  // only frames 0–3
-
-    const auto& ctx = g_ctx();
-    VkCommandBuffer cmd = VK_NULL_HANDLE;
-
-    // ------------------------------------------------------------------
-    // 1. Map + fill staging buffer (this is safe — uses g_device() only for memory)
-    // ------------------------------------------------------------------
-    void* data = nullptr;
-    VkResult r = vkMapMemory(g_device(),
-                             BUFFER_MEMORY(g_ctx().sharedStagingEnc_),
-                             0, VK_WHOLE_SIZE, 0, &data);
-
-    if (r != VK_SUCCESS || data == nullptr) {
-        // recovery path unchanged — still safe
-        vkUnmapMemory(g_device(), BUFFER_MEMORY(g_ctx().sharedStagingEnc_));
-        VkMappedMemoryRange range{VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, nullptr,
-                                  BUFFER_MEMORY(g_ctx().sharedStagingEnc_), 0, VK_WHOLE_SIZE};
-        vkInvalidateMappedMemoryRanges(g_device(), 1, &range);
-        r = vkMapMemory(g_device(), BUFFER_MEMORY(g_ctx().sharedStagingEnc_), 0, VK_WHOLE_SIZE, 0, &data);
-        if (r != VK_SUCCESS || data == nullptr) {
-            LOG_FATAL_CAT("RENDERER", "vkMapMemory failed permanently — frame {} lost", frameNumber_);
-            return;
-        }
-    }
-
-    alignas(16) struct LocalUBO {
-        glm::mat4 view, proj, viewProj, invView, invProj;
-        glm::vec4 cameraPos;
-        glm::vec2 jitter;
-        uint32_t frame;
-        float time;
-        uint32_t spp;
-        float _pad[3];
-    } ubo{};
-
+    // Written straight into this frame's ring region — host-coherent, so no
+    // staging copy, no flush, no transfer barrier; the queue submit orders it
+    CameraUBO ubo{};
     const auto& cam = GlobalCamera::get();
     ubo.view      = cam.view();
     ubo.proj      = cam.proj(width_ / float(height_));
@@ -1739,120 +1854,44 @@ void VulkanRenderer::updateUniformBuffer(uint32_t frame, const Camera& camera, f
     ubo.time      = frameTime_;
     ubo.spp       = currentSpp_;
 
-    std::memcpy(data, &ubo, sizeof(ubo));
-    vkUnmapMemory(g_device(), BUFFER_MEMORY(g_ctx().sharedStagingEnc_));
-
-    // ------------------------------------------------------------------
-    // 2. Copy staging → device-local UBO
-    // ------------------------------------------------------------------
-    if (useTransientCmd) {
-        // Frames 0–3 only — safe to allocate a one-time command buffer
-        cmd = pipelineManager_.beginSingleTimeCommands(ctx.commandPool());
-    } else {
-        // Frame 4+ — use the per-frame command buffer that is already recording
-        cmd = commandBuffers_[frame];
-    }
-
-    if (cmd != VK_NULL_HANDLE) {
-        VkBuffer src = RTX::UltraLowLevelBufferTracker::get().getData(g_ctx().sharedStagingEnc_)->buffer;
-        VkBuffer dst = RAW_BUFFER(uniformBufferEncs_[frame]);
-
-        VkBufferCopy copyRegion{};
-        copyRegion.size = sizeof(ubo);
-        vkCmdCopyBuffer(cmd, src, dst, 1, &copyRegion);
-
-        VkMemoryBarrier barrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_UNIFORM_READ_BIT;
-
-        vkCmdPipelineBarrier(cmd,
-            VK_PIPELINE_STAGE_TRANSFER_BIT,
-            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR |
-            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT |
-            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-            0, 1, &barrier, 0, nullptr, 0, nullptr);
+    const RTX::RingSlice uboSlice = frameRing_.push(ubo);
+    if (!uboSlice.valid()) {
+        LOG_WARN_CAT("RENDERER", "Camera UBO ring allocation failed — frame {} reuses stale constants", frameNumber_);
+        return;
     }
+    cameraUboOffset_ = uboSlice.dynamicOffset();
 
-    // ------------------------------------------------------------------
-    // 3. Submit transient command buffer only if we allocated one
-    // ------------------------------------------------------------------
-    if (useTransientCmd && cmd != VK_NULL_HANDLE) {
-        pipelineManager_.endSingleTimeCommands(ctx.commandPool(), ctx.graphicsQueue(), cmd);
+    const FrameDimensions dims{
+        .width  = static_cast<uint32_t>(width_),
+        .height = static_cast<uint32_t>(height_),
+        .spp    = currentSpp_,
+        .frame  = static_cast<uint32_t>(frameNumber_ & 0xFFFFFFFFULL)
+    };
+    if (const RTX::RingSlice dimSlice = frameRing_.push(dims); dimSlice.valid()) {
+        dimensionOffset_ = dimSlice.dynamicOffset();
     }
-    // else: barriers already recorded into the main per-frame cmd → nothing to do
 }
 
 void VulkanRenderer::updateTonemapUniform(uint32_t frame) noexcept {
-
-    if (tonemapUniformEncs_.empty() || g_ctx().sharedStagingEnc_ == 0) {
-        return;
-    }
-
-    // FIXED: Explicit null-guard on staging memory Handle (post-resize ghost prevention)
-    if (BUFFER_MEMORY(g_ctx().sharedStagingEnc_) == VK_NULL_HANDLE) {
-        LOG_WARN_CAT("RENDERER", "Shared staging memory null for tonemap UBO — skipping update (recreate needed?)");
-        return;
-    }
-
-    void* data = nullptr;
-    VkResult mapRes = vkMapMemory(g_device(), BUFFER_MEMORY(g_ctx().sharedStagingEnc_), 0, VK_WHOLE_SIZE, 0, &data);
-    if (mapRes != VK_SUCCESS || data == nullptr) {
-        LOG_WARN_CAT("RENDERER", "Tonemap UBO map failed: {} or null for frame {} (OOM post-resize?) — skipping memcpy.", static_cast<int>(mapRes), frame);
+    (void)frame;
+    if (!frameRing_.valid()) {
         return;
     }
 
-    struct TonemapUniform {
-        float exposure;
-        uint32_t type;
-        uint32_t enabled;
-        float nexusScore;
-        uint32_t frame;
-        uint32_t spp;
-        float _pad[2];
-    } ubo = {};  // Zero-init
-
-    // FIXED: Set exposure from member (add float exposure_ = 1.0f; to class if missing)
-    ubo.exposure = currentExposure_;  // Assume member
-
-    ubo.type = static_cast<uint32_t>(tonemapType_);
-    ubo.enabled = tonemapEnabled_ ? 1u : 0u;
+    TonemapUniform ubo = {};  // Zero-init
+    ubo.exposure   = currentExposure_;
+    ubo.type       = static_cast<uint32_t>(tonemapType_);
+    ubo.enabled    = tonemapEnabled_ ? 1u : 0u;
     ubo.nexusScore = currentNexusScore_;
-    ubo.frame = frameNumber_;
-    ubo.spp = currentSpp_;  // FIXED: Match your naming (from logs)
+    ubo.frame      = frameNumber_;
+    ubo.spp        = currentSpp_;
 
-    std::memcpy(data, &ubo, sizeof(ubo));
-    vkUnmapMemory(g_device(), BUFFER_MEMORY(g_ctx().sharedStagingEnc_));
-
-    // FIXED: Guard copyCmd on valid device UBO (post-resize index/Handle poison)
-    VkBuffer deviceBuf = RAW_BUFFER(tonemapUniformEncs_[frame]);
-    if (deviceBuf == VK_NULL_HANDLE) {
-        LOG_WARN_CAT("RENDERER", "Tonemap device UBO null for frame {} — skipping staging-to-device copy", frame);
+    const RTX::RingSlice slice = frameRing_.push(ubo);
+    if (!slice.valid()) {
+        LOG_WARN_CAT("RENDERER", "Tonemap UBO ring allocation failed — frame {} reuses stale params", frameNumber_);
         return;
     }
-
-    // FIXED: Copy staging to device UBO (similar to updateUniformBuffer)
-    const auto& ctx = g_ctx();
-    VkCommandPool cmdPool = ctx.commandPool();
-    VkQueue queue = ctx.graphicsQueue();
-    VkCommandBuffer copyCmd = pipelineManager_.beginSingleTimeCommands(cmdPool);
-    if (copyCmd != VK_NULL_HANDLE) {
-        VkBufferCopy copyRegion = {0, 0, sizeof(ubo)};
-        VkBuffer stagingBuf = RTX::UltraLowLevelBufferTracker::get().getData(g_ctx().sharedStagingEnc_)->buffer;
-        if (stagingBuf == VK_NULL_HANDLE) {
-            LOG_WARN_CAT("RENDERER", "Staging buffer null — aborting copy for frame {}", frame);
-        } else {
-            vkCmdCopyBuffer(copyCmd, stagingBuf, deviceBuf, 1, &copyRegion);
-            
-            VkMemoryBarrier barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER};
-            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-            barrier.dstAccessMask = VK_ACCESS_UNIFORM_READ_BIT;
-            vkCmdPipelineBarrier(copyCmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
-        }
-        
-        pipelineManager_.endSingleTimeCommands(cmdPool, queue, copyCmd);
-    } else {
-        LOG_WARN_CAT("RENDERER", "Failed to begin single-time cmds for tonemap copy — frame {} skipped", frame);
-    }
+    tonemapUboOffset_ = slice.dynamicOffset();
 }
 
 // ──────────────────────────────────────────────────────────────────────────────
@@ -1902,8 +1941,6 @@ void VulkanRenderer::setRenderMode(int mode) noexcept {
 }
 
 void VulkanRenderer::createFramebuffers() noexcept {
-    // FIXED: Idle post-framebuffer recreate to flush stale maps (prevents fragmented staging post-resize)
-    vkDeviceWaitIdle(g_device());
     framebuffers_.resize(([](){ uint32_t cnt; vkGetSwapchainImagesKHR(g_device(), g_swapchain(), &cnt, nullptr); return cnt; }()));
 
     for (size_t i = 0; i < ([](){ uint32_t cnt; vkGetSwapchainImagesKHR(g_device(), g_swapchain(), &cnt, nullptr); return cnt; }()); ++i) {
@@ -1923,8 +1960,6 @@ void VulkanRenderer::createFramebuffers() noexcept {
     }
 
     LOG_SUCCESS_CAT("RENDERER", "Framebuffers recreated — {} total", framebuffers_.size());
-    // FIXED: Idle post-framebuffer recreate to flush maps (prevents fragmented staging post-resize)
-    vkDeviceWaitIdle(g_device());
 }
 
 void VulkanRenderer::cleanupFramebuffers() noexcept {
@@ -1995,7 +2030,7 @@ VkShaderModule VulkanRenderer::loadShader(const std::string& filename) const
 // ──────────────────────────────────────────────────────────────────────────────
 void VulkanRenderer::updateTonemapDescriptor(uint32_t frameIdx, VkImageView inputView, VkImageView outputView) noexcept
 {
-    if (frameIdx >= tonemapSets_.size() || tonemapSets_[frameIdx] == VK_NULL_HANDLE)
+    if (frameIdx >= tonemapSets_.size() || tonemapSets_[frameIdx] == VK_NULL_HANDLE || !frameRing_.valid())
         return;
 
     VkDescriptorImageInfo inputInfo{
@@ -2009,10 +2044,11 @@ void VulkanRenderer::updateTonemapDescriptor(uint32_t frameIdx, VkImageView inpu
         .imageLayout = VK_IMAGE_LAYOUT_GENERAL
     };
 
+    // Dynamic UBO — ring buffer at offset 0, tonemapUboOffset_ supplied at bind time
     VkDescriptorBufferInfo uboInfo{
-        .buffer = RAW_BUFFER(tonemapUniformEncs_[frameIdx]),
+        .buffer = frameRing_.buffer(),
         .offset = 0,
-        .range = VK_WHOLE_SIZE
+        .range = sizeof(TonemapUniform)
     };
 
     std::array<VkWriteDescriptorSet, 3> writes = {{
@@ -2034,7 +2070,7 @@ void VulkanRenderer::updateTonemapDescriptor(uint32_t frameIdx, VkImageView inpu
           .dstSet = tonemapSets_[frameIdx],
           .dstBinding = 2,
           .descriptorCount = 1,
-          .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+          .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
           .pBufferInfo = &uboInfo }
     }};
 
@@ -2050,70 +2086,6 @@ void VulkanRenderer::updateTonemapDescriptorsInitial() noexcept
     LOG_TRACE_CAT("RENDERER", "updateTonemapDescriptorsInitial — Deferred to per-frame (triple buffer safe)");
 }
 
-bool VulkanRenderer::recreateTonemapUBOs() noexcept {
-    // FIXED: Destroy old (loop vkDestroyBuffer/vkFreeMemory + tracker.destroy)
-    for (size_t i = 0; i < tonemapUniformEncs_.size(); ++i) {
-        auto enc = tonemapUniformEncs_[i];
-        if (enc != 0) {
-            RTX::UltraLowLevelBufferTracker::get().destroy(enc);
-            tonemapUniformEncs_[i] = 0;
-        }
-    }
-    tonemapUniformEncs_.clear();
-
-    // Reforge (fixed-size 64B UNIFORM)
-    VkDeviceSize uboSize = 64;  // sizeof(TonemapUniform)
-    VkBufferUsageFlags usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-    VkMemoryPropertyFlags props = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
-
-    uint32_t framesInFlight = Options::Performance::MAX_FRAMES_IN_FLIGHT;  // FIXED: Use options
-    tonemapUniformEncs_.resize(framesInFlight);
-
-    bool allGood = true;
-    for (uint32_t i = 0; i < framesInFlight; ++i) {  // FIXED: uint32_t
-        auto handle = RTX::UltraLowLevelBufferTracker::get().create(uboSize, usage, props, std::format("TonemapUBO[{}]", i));
-        if (handle == 0) {
-            LOG_ERROR_CAT("Renderer", "Tonemap UBO forge FAILED for frame {}", i);
-            allGood = false;
-            break;
-        }
-        tonemapUniformEncs_[i] = handle;
-        LOG_DEBUG_CAT("Renderer", "Tonemap UBO recreated for frame {}", i);
-    }
-
-    if (!allGood) {
-        tonemapUniformEncs_.clear();  // Reset on fail
-    }
-    return allGood;
-}
-
-void VulkanRenderer::destroySharedStaging() noexcept {
-    if (g_ctx().sharedStagingEnc_ != 0) {
-        RTX::UltraLowLevelBufferTracker::get().destroy(g_ctx().sharedStagingEnc_);
-        // FIXED: Reset via tracker; no pointer
-        g_ctx().sharedStagingEnc_ = 0;
-        LOG_DEBUG_CAT("Renderer", "Shared staging destroyed");
-    }
-}
-
-bool VulkanRenderer::createSharedStaging() noexcept {
-    VkDeviceSize size = 512;  // Or your shared size (from logs)
-    VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-    VkMemoryPropertyFlags props = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-
-    auto enc = RTX::UltraLowLevelBufferTracker::get().create(size, usage, props, "SharedStagingUBO");
-    if (enc == 0) {
-        LOG_ERROR_CAT("Renderer", "Shared staging forge FAILED");
-        return false;
-    }
-    g_ctx().sharedStagingEnc_ = enc;
-
-    
-    // FIXED: Bound via tracker
-    LOG_DEBUG_CAT("Renderer", "Shared staging recreated: enc=0x{:x}", g_ctx().sharedStagingEnc_);
-    return true;
-}
-
 void VulkanRenderer::onWindowResize(uint32_t w, uint32_t h) noexcept
 {
     if (w == 0 || h == 0) {
@@ -2129,12 +2101,14 @@ void VulkanRenderer::onWindowResize(uint32_t w, uint32_t h) noexcept
                  PULSAR_GREEN, width_, height_, w, h, RESET);
 
     // ===================================================================
-    // 1. NUCLEAR SHUTDOWN — STONEKEY DEMANDS TOTAL SILENCE
+    // 1. QUIESCE — in-flight frames only, not the whole device
+    //    The command pool reset and swapchain rebuild need every frame's
+    //    command buffer retired, so the frame timeline is waited; the present
+    //    queue is drained for the old swapchain images. Anything else
+    //    (async uploads, one-time builds) keeps running.
     // ===================================================================
-    waitForAllFences();
-    vkQueueWaitIdle(g_ctx().graphicsQueue());
+    waitForInFlightFrames();
     vkQueueWaitIdle(g_ctx().presentQueue());
-    vkDeviceWaitIdle(g_device());
 
     // Reset the one true command pool — all command buffers are now dust
     vkResetCommandPool(g_device(), g_ctx().commandPool(), VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT);
@@ -2142,7 +2116,6 @@ void VulkanRenderer::onWindowResize(uint32_t w, uint32_t h) noexcept
     width_  = static_cast<int>(w);
     height_ = static_cast<int>(h);
     resetAccumulation_ = true;
-    firstSwapchainAcquire_ = true;
 
     // ===================================================================
     // 2. ANNIHILATE — BUT PRESERVE g_swapchain() UNTIL AFTER PRESENT
@@ -2169,13 +2142,11 @@ void VulkanRenderer::onWindowResize(uint32_t w, uint32_t h) noexcept
 
     createRTOutputImages();
     createAccumulationImages();
-    if (Options::RTX::ENABLE_DENOISING) createDenoiserImage();
+    if (Options::RTX::ENABLE_DENOISING && denoisingEnabled_) createDenoiserImage();
     if (Options::RTX::ENABLE_ADAPTIVE_SAMPLING)
         createNexusScoreImage(g_ctx().commandPool(), g_ctx().graphicsQueue());
 
     createFramebuffers();
-    commandBuffers_.clear();
-    createCommandBuffers();
 
     // Re-allocate tonemap sets — fresh and pure
     if (tonemapDescriptorPool_.valid() && *tonemapDescriptorPool_) {
@@ -2198,14 +2169,20 @@ void VulkanRenderer::onWindowResize(uint32_t w, uint32_t h) noexcept
                     COSMIC_GOLD, w, h, RESET);
 }
 
-void VulkanRenderer::waitForAllFences() const noexcept
+void VulkanRenderer::waitForInFlightFrames() const noexcept
 {
-    if (!inFlightFences_.empty()) {
-        vkWaitForFences(g_device(), inFlightFences_.size(), inFlightFences_.data(), VK_TRUE, UINT64_MAX);
-        vkResetFences(g_device(), inFlightFences_.size(), inFlightFences_.data());
+    if (framePacer_.valid()) {
+        // Last submitted serial on the frame timeline covers every slot
+        framePacer_.waitIdle();
+        RTX::retireQueue().allSignaled();
     }
 }
 
+void VulkanRenderer::paceFrame() noexcept
+{
+    if (!minimized_) framePacer_.pace(g_swapchain());
+}
+
 // ──────────────────────────────────────────────────────────────────────────────
 // FINAL & CORRECT — createImage + createImageArray
 // ──────────────────────────────────────────────────────────────────────────────
@@ -2213,7 +2190,9 @@ void VulkanRenderer::waitForAllFences() const noexcept
 void VulkanRenderer::createImage(RTX::Handle<VkImage>& image,
                                  RTX::Handle<VkDeviceMemory>& memory,
                                  RTX::Handle<VkImageView>& view,
-                                 const std::string& name) noexcept
+                                 const std::string& name,
+                                 std::string_view budgetTag,
+                                 bool sharedWithCompute) noexcept
 {
     VkImageCreateInfo info = {};
     info.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
@@ -2227,6 +2206,13 @@ void VulkanRenderer::createImage(RTX::Handle<VkImage>& image,
     info.usage         = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
     info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
+    const uint32_t sharedFamilies[2] = { g_ctx().graphicsFamily(), g_ctx().computeFamily() };
+    if (sharedWithCompute && asyncCompute_) {
+        info.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+        info.queueFamilyIndexCount = 2;
+        info.pQueueFamilyIndices   = sharedFamilies;
+    }
+
     VkImage rawImg = VK_NULL_HANDLE;
     VK_CHECK(vkCreateImage(g_device(), &info, nullptr, &rawImg), name.c_str());
 
@@ -2257,9 +2243,11 @@ void VulkanRenderer::createImage(RTX::Handle<VkImage>& image,
     VkImageView rawView = VK_NULL_HANDLE;
     VK_CHECK(vkCreateImageView(g_device(), &vinfo, nullptr, &rawView), name.c_str());
 
-    image  = RTX::Handle<VkImage>(rawImg, g_device(), vkDestroyImage, 0, name + "_Img");
-    memory = RTX::Handle<VkDeviceMemory>(rawMem, g_device(), vkFreeMemory, reqs.size, name + "_Mem");
-    view   = RTX::Handle<VkImageView>(rawView, g_device(), vkDestroyImageView, 0, name + "_View");
+    RTX::memoryBudget().chargeMemory(rawMem, budgetTag.empty() ? std::string_view(name) : budgetTag, memType, reqs.size);
+    frameGraph_.forget(rawImg);   // a recycled handle must not inherit an old layout
+    image  = RTX::Handle<VkImage>(rawImg, g_device(), name + "_Img");
+    memory = RTX::Handle<VkDeviceMemory>(rawMem, g_device(), name + "_Mem");
+    view   = RTX::Handle<VkImageView>(rawView, g_device(), name + "_View");
 
     // Transition to GENERAL
     VkCommandBuffer cmd = pipelineManager_.beginSingleTimeCommands(g_ctx().commandPool());
@@ -2297,7 +2285,7 @@ void VulkanRenderer::createImageArray(std::vector<RTX::Handle<VkImage>>& images,
         RTX::Handle<VkImage>       img;
         RTX::Handle<VkDeviceMemory> mem;
         RTX::Handle<VkImageView>   view;
-        createImage(img, mem, view, name + std::to_string(i));
+        createImage(img, mem, view, name + std::to_string(i), name);
         images.emplace_back(std::move(img));
         memories.emplace_back(std::move(mem));
         views.emplace_back(std::move(view));
@@ -17,6 +17,8 @@
 #include "engine/GLOBAL/VulkanRenderer.hpp"
 #include "engine/GLOBAL/PipelineManager.hpp"
 #include "engine/GLOBAL/MeshLoader.hpp"
+#include "engine/GLOBAL/Trace.hpp"
+#include "engine/GLOBAL/UploadScheduler.hpp"
 #include "main.hpp"
 
 #include <iostream>
@@ -126,6 +128,8 @@ Application::Application(const std::string& title, int width, int height)
 }
 
 Application::~Application() {
+    // Renderer teardown retires its graph transients — must precede RTX::shutdown()'s heap purge
+    if (renderer_) renderer_->cleanup();
     LOG_SUCCESS_CAT("APP", "{}Application destroyed — Pink photons eternal.{}", COSMIC_GOLD, RESET);
 }
 
@@ -136,6 +140,9 @@ void Application::run() {
     auto fpsStart = std::chrono::steady_clock::now();
 
     while (!quit_) {
+        // Sleep off the slack first, so input and deltaTime are sampled as late as the target allows
+        if (renderer_) renderer_->paceFrame();
+
         const auto now = std::chrono::steady_clock::now();
         const float deltaTime = std::chrono::duration<float>(now - lastFrameTime_).count();
         lastFrameTime_ = now;
@@ -605,6 +612,9 @@ static void phase5_rtxAscension()
     forgeCommandPool();
     LOG_SUCCESS_CAT("MAIN5", "{}TRANSIENT COMMAND POOL @ 0x{:016X} — PHOTON ORDERS READY{}", SAPPHIRE_BLUE, (uint64_t)g_ctx().commandPool_, RESET);
 
+    if (!RTX::uploadScheduler().init(g_ctx().device()))
+        LOG_WARN_CAT("MAIN5", "Upload scheduler unavailable — uploads fall back to one-time graphics submits");
+
     LOG_SUCCESS_CAT("MAIN5", "{}[PHASE 5 COMPLETE] RTX ASCENSION COMPLETE — PINK PHOTONS NOW OMNISCIENT{}", DIAMOND_SPARKLE, RESET);
 }
 
@@ -673,6 +683,7 @@ static void phase9_gracefulShutdown()
     LOG_INFO_CAT("MAIN", "{}[PHASE 9/10] GRACEFUL SHUTDOWN — PHOTONS RETURNING HOME{}", VALHALLA_GOLD, RESET);
 
     if (g_ctx().device()) vkDeviceWaitIdle(g_ctx().device());
+    Logging::Trace::stop();
 
     g_app.reset();
     if (g_pipeline_manager) { delete g_pipeline_manager; g_pipeline_manager = nullptr; }
@@ -684,12 +695,38 @@ static void phase9_gracefulShutdown()
     SDL3Window::destroy();  // This calls SDL_Quit() exactly once
 
     LOG_SUCCESS_CAT("MAIN", "{}THE EMPIRE RESTS — PINK PHOTONS ETERNAL — NOVEMBER 21, 2025{}", DIAMOND_SPARKLE, RESET);
+    Logging::Logger::shutdown();   // drain the ring, trim + close amouranth_engine.log
+}
+
+// =============================================================================
+// COMMAND LINE
+//   --trace[=<file>]   record CPU trace events, dump Chrome/Perfetto JSON on exit
+//   --gpu-csv=<file>   per-frame GPU pass timings (ms), one row per frame
+// =============================================================================
+static void parseCommandLine(int argc, char** argv)
+{
+    constexpr std::string_view TRACE_FLAG = "--trace";
+    constexpr std::string_view GPU_CSV_FLAG = "--gpu-csv=";
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == TRACE_FLAG) {
+            Logging::Trace::start("amouranth_trace.json");
+        } else if (arg.starts_with(TRACE_FLAG) && arg.size() > TRACE_FLAG.size() + 1 && arg[TRACE_FLAG.size()] == '=') {
+            Logging::Trace::start(std::string(arg.substr(TRACE_FLAG.size() + 1)));
+        } else if (arg.starts_with(GPU_CSV_FLAG) && arg.size() > GPU_CSV_FLAG.size()) {
+            GpuProfiler::setCsvPath(std::string(arg.substr(GPU_CSV_FLAG.size())));
+        } else {
+            LOG_WARN_CAT("MAIN", "Ignoring unknown argument: {}", arg);
+        }
+    }
 }
 
 // =============================================================================
 // MAIN — THE FINAL ASCENSION — NOW CORRECT AND ETERNAL
 // =============================================================================
-int main(int, char**) {
+int main(int argc, char** argv) {
+    Logging::Trace::setThreadName("main");
+    parseCommandLine(argc, argv);
     try {
         phase1_preInitialization();
         phase2_iconPreload();
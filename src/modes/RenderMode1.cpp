@@ -102,14 +102,14 @@ void RenderMode1::initResources() {
     imgInfo.format = VK_FORMAT_R32G32B32A32_SFLOAT;
     imgInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
     VkImage rawImg; vkCreateImage(g_device(), &imgInfo, nullptr, &rawImg);
-    accumImage_ = RTX::Handle<VkImage>(rawImg, g_device(), vkDestroyImage, 0, "AccumImg");
+    accumImage_ = RTX::Handle<VkImage>(rawImg, g_device(), "AccumImg");
 
     VkMemoryRequirements memReqs; vkGetImageMemoryRequirements(g_device(), rawImg, &memReqs);
     uint32_t memType = g_pipeline_manager->findMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
     VkMemoryAllocateInfo alloc{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, nullptr, memReqs.size, memType};
     VkDeviceMemory mem; vkAllocateMemory(g_device(), &alloc, nullptr, &mem);
     vkBindImageMemory(g_device(), rawImg, mem, 0);
-    accumMem_ = RTX::Handle<VkDeviceMemory>(mem, g_device(), vkFreeMemory, memReqs.size, "AccumMem");
+    accumMem_ = RTX::Handle<VkDeviceMemory>(mem, g_device(), "AccumMem");
 
     VkImageViewCreateInfo viewInfo{VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
     viewInfo.image = rawImg;
@@ -117,24 +117,24 @@ void RenderMode1::initResources() {
     viewInfo.format = imgInfo.format;
     viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
     VkImageView view; vkCreateImageView(g_device(), &viewInfo, nullptr, &view);
-    accumView_ = RTX::Handle<VkImageView>(view, g_device(), vkDestroyImageView, 0, "AccumView");
+    accumView_ = RTX::Handle<VkImageView>(view, g_device(), "AccumView");
 
     // Output Image
     imgInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
     imgInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
     vkCreateImage(g_device(), &imgInfo, nullptr, &rawImg);
-    outputImage_ = RTX::Handle<VkImage>(rawImg, g_device(), vkDestroyImage, 0, "OutputImg");
+    outputImage_ = RTX::Handle<VkImage>(rawImg, g_device(), "OutputImg");
 
     vkGetImageMemoryRequirements(g_device(), rawImg, &memReqs);
     alloc.allocationSize = memReqs.size;
     vkAllocateMemory(g_device(), &alloc, nullptr, &mem);
     vkBindImageMemory(g_device(), rawImg, mem, 0);
-    outputMem_ = RTX::Handle<VkDeviceMemory>(mem, g_device(), vkFreeMemory, memReqs.size, "OutputMem");
+    outputMem_ = RTX::Handle<VkDeviceMemory>(mem, g_device(), "OutputMem");
 
     viewInfo.image = rawImg;
     viewInfo.format = imgInfo.format;
     vkCreateImageView(g_device(), &viewInfo, nullptr, &view);
-    outputView_ = RTX::Handle<VkImageView>(view, g_device(), vkDestroyImageView, 0, "OutputView");
+    outputView_ = RTX::Handle<VkImageView>(view, g_device(), "OutputView");
 
     // Transition
     VkCommandBuffer cmd = VulkanRTX::beginSingleTimeCommands(g_ctx().commandPool());
@@ -158,15 +158,12 @@ void RenderMode1::initResources() {
 }
 
 void RenderMode1::cleanupResources() {
-    vkDeviceWaitIdle(g_device());
-    g_rtx().updateRTXDescriptors(0, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                                 VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                                 VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE);
+    // Retired, not destroyed — frames in flight may still write these
     if (uniformBuf_) BUFFER_DESTROY(uniformBuf_);
     if (accumulationBuf_) BUFFER_DESTROY(accumulationBuf_);
-    accumImage_.reset(); outputImage_.reset();
-    accumView_.reset(); outputView_.reset();
-    accumMem_.reset(); outputMem_.reset();
+    accumView_.retire(); outputView_.retire();
+    accumImage_.retire(); outputImage_.retire();
+    accumMem_.retire(); outputMem_.retire();
 }
 
 void RenderMode1::updateUniforms(float) {
@@ -29,12 +29,8 @@ RenderMode2::RenderMode2(VulkanRTX& rtx, uint32_t width, uint32_t height)
 RenderMode2::~RenderMode2() {
     LOG_INFO_CAT("RenderMode2", "Destructor invoked — Safe cleanup");
 
-    vkDeviceWaitIdle(g_ctx().device());
-
-    rtx_.updateRTXDescriptors(0,
-        VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-        VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-        VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE);
+    outputView_.retire();
+    outputImage_.retire();
 
     LOG_SUCCESS_CAT("RenderMode2", "Mode 2 destroyed — RAINBOW PHOTONS ETERNAL");
 }
@@ -59,7 +55,7 @@ void RenderMode2::initResources() {
     LOG_INFO_CAT("RenderMode2", "Creating output image: {}×{} | Format: R8G8B8A8_UNORM", width_, height_);
     VK_CHECK(vkCreateImage(device, &imgInfo, nullptr, &rawImg), "Output image creation");
     LOG_DEBUG_CAT("RenderMode2", "Output image created: 0x{:x}", reinterpret_cast<uint64_t>(rawImg));
-    outputImage_ = RTX::Handle<VkImage>(rawImg, device, vkDestroyImage, 0, "OutputImage");
+    outputImage_ = RTX::Handle<VkImage>(rawImg, device, "OutputImage");
 
     VkImageViewCreateInfo viewInfo{VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
     viewInfo.image = rawImg;
@@ -68,7 +64,7 @@ void RenderMode2::initResources() {
     viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
     VkImageView rawView;
     VK_CHECK(vkCreateImageView(device, &viewInfo, nullptr, &rawView), "Output view creation");
-    outputView_ = RTX::Handle<VkImageView>(rawView, device, vkDestroyImageView, 0, "OutputView");
+    outputView_ = RTX::Handle<VkImageView>(rawView, device, "OutputView");
 
     LOG_INFO_CAT("RenderMode2", "Updating RTX descriptors for frame 0 (output only)");
     rtx_.updateRTXDescriptors(0, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
@@ -107,16 +103,9 @@ void RenderMode2::clearAnimated(VkCommandBuffer cmd) {
 void RenderMode2::onResize(uint32_t width, uint32_t height) {
     LOG_INFO_CAT("RenderMode2", "onResize() — New: {}×{} (old: {}×{})", width, height, width_, height_);
 
-    auto& ctx = g_ctx();
-    VkDevice device = ctx.device();
-    VK_CHECK(vkDeviceWaitIdle(device), "vkDeviceWaitIdle failed in onResize");
-
-    rtx_.updateRTXDescriptors(0, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                              VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                              VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE);
-
-    outputImage_.reset();
-    outputView_.reset();
+    // Retired, not destroyed — frames in flight may still write the old image
+    outputView_.retire();
+    outputImage_.retire();
     width_ = width;
     height_ = height;
     startTime_ = std::chrono::steady_clock::now();
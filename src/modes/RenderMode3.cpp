@@ -31,12 +31,9 @@ RenderMode3::RenderMode3(VulkanRTX& rtx, uint32_t width, uint32_t height)
 
 RenderMode3::~RenderMode3() {
     LOG_INFO_CAT("RenderMode3", "Destructor invoked — Safe cleanup");
-    vkDeviceWaitIdle(g_ctx().device());
 
-    rtx_.updateRTXDescriptors(0,
-        VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-        VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-        VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE);
+    outputView_.retire();
+    outputImage_.retire();
 
     LOG_SUCCESS_CAT("RenderMode3", "Mode 3 destroyed — CHAOS PHOTONS ETERNAL");
 }
@@ -59,7 +56,7 @@ void RenderMode3::initResources() {
 
     VkImage rawImg;
     VK_CHECK(vkCreateImage(device, &imgInfo, nullptr, &rawImg), "Output image creation");
-    outputImage_ = RTX::Handle<VkImage>(rawImg, device, vkDestroyImage, 0, "OutputImage");
+    outputImage_ = RTX::Handle<VkImage>(rawImg, device, "OutputImage");
 
     VkImageViewCreateInfo viewInfo{VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
     viewInfo.image = rawImg;
@@ -68,7 +65,7 @@ void RenderMode3::initResources() {
     viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
     VkImageView rawView;
     VK_CHECK(vkCreateImageView(device, &viewInfo, nullptr, &rawView), "Output view creation");
-    outputView_ = RTX::Handle<VkImageView>(rawView, device, vkDestroyImageView, 0, "OutputView");
+    outputView_ = RTX::Handle<VkImageView>(rawView, device, "OutputView");
 
     rtx_.updateRTXDescriptors(0, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
                               VK_NULL_HANDLE, *outputView_, VK_NULL_HANDLE, VK_NULL_HANDLE,
@@ -104,14 +101,9 @@ void RenderMode3::clearRandom(VkCommandBuffer cmd) {
 void RenderMode3::onResize(uint32_t width, uint32_t height) {
     LOG_INFO_CAT("RenderMode3", "onResize() — New: {}×{} → Re-seeding chaos", width, height);
 
-    vkDeviceWaitIdle(g_ctx().device());
-
-    rtx_.updateRTXDescriptors(0, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                              VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                              VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE);
-
-    outputImage_.reset();
-    outputView_.reset();
+    // Retired, not destroyed — frames in flight may still write the old image
+    outputView_.retire();
+    outputImage_.retire();
 
     width_ = width;
     height_ = height;
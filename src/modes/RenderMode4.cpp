@@ -29,12 +29,8 @@ RenderMode4::RenderMode4(VulkanRTX& rtx, uint32_t width, uint32_t height)
 RenderMode4::~RenderMode4() {
     LOG_INFO_CAT("RenderMode4", "Destructor invoked — Safe cleanup");
 
-    vkDeviceWaitIdle(g_ctx().device());
-
-    rtx_.updateRTXDescriptors(0,
-        VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-        VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-        VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE);
+    outputView_.retire();
+    outputImage_.retire();
 
     LOG_SUCCESS_CAT("RenderMode4", "Mode 4 destroyed — CAMERA PHOTONS ETERNAL");
 }
@@ -58,7 +54,7 @@ void RenderMode4::initResources() {
     VkImage rawImg;
     LOG_INFO_CAT("RenderMode4", "Creating output image: {}×{} | Format: R8G8B8A8_UNORM", width_, height_);
     VK_CHECK(vkCreateImage(device, &imgInfo, nullptr, &rawImg), "Output image creation");
-    outputImage_ = RTX::Handle<VkImage>(rawImg, device, vkDestroyImage, 0, "OutputImage");
+    outputImage_ = RTX::Handle<VkImage>(rawImg, device, "OutputImage");
 
     VkImageViewCreateInfo viewInfo{VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
     viewInfo.image = rawImg;
@@ -67,7 +63,7 @@ void RenderMode4::initResources() {
     viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
     VkImageView rawView;
     VK_CHECK(vkCreateImageView(device, &viewInfo, nullptr, &rawView), "Output view creation");
-    outputView_ = RTX::Handle<VkImageView>(rawView, device, vkDestroyImageView, 0, "OutputView");
+    outputView_ = RTX::Handle<VkImageView>(rawView, device, "OutputView");
 
     LOG_INFO_CAT("RenderMode4", "Updating RTX descriptors for frame 0 (output only)");
     rtx_.updateRTXDescriptors(0, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
@@ -111,16 +107,9 @@ void RenderMode4::clearCameraTinted(VkCommandBuffer cmd) {
 void RenderMode4::onResize(uint32_t width, uint32_t height) {
     LOG_INFO_CAT("RenderMode4", "onResize() — New: {}×{} (old: {}×{})", width, height, width_, height_);
 
-    auto& ctx = g_ctx();
-    VkDevice device = ctx.device();
-    VK_CHECK(vkDeviceWaitIdle(device), "vkDeviceWaitIdle failed in onResize");
-
-    rtx_.updateRTXDescriptors(0, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                              VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                              VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE);
-
-    outputImage_.reset();
-    outputView_.reset();
+    // Retired, not destroyed — frames in flight may still write the old image
+    outputView_.retire();
+    outputImage_.retire();
 
     width_  = width;
     height_ = height;
@@ -29,11 +29,8 @@ RenderMode5::RenderMode5(VulkanRTX& rtx, uint32_t width, uint32_t height)
 
 RenderMode5::~RenderMode5()
 {
-    vkDeviceWaitIdle(g_ctx().device());
-
-    rtx_.updateRTXDescriptors(0, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                              VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                              VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE);
+    outputView_.retire();
+    outputImage_.retire();
 
     LOG_SUCCESS_CAT("RenderMode5", "Mode 5 destroyed — PLASMA PHOTONS ETERNAL");
 }
@@ -55,7 +52,7 @@ void RenderMode5::initResources()
 
     VkImage rawImg;
     VK_CHECK(vkCreateImage(device, &imgInfo, nullptr, &rawImg), "Plasma output image");
-    outputImage_ = RTX::Handle<VkImage>(rawImg, device, vkDestroyImage, 0, "PlasmaImage");
+    outputImage_ = RTX::Handle<VkImage>(rawImg, device, "PlasmaImage");
 
     VkImageViewCreateInfo viewInfo{VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
     viewInfo.image = rawImg;
@@ -64,7 +61,7 @@ void RenderMode5::initResources()
     viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
     VkImageView rawView;
     VK_CHECK(vkCreateImageView(device, &viewInfo, nullptr, &rawView), "Plasma view");
-    outputView_ = RTX::Handle<VkImageView>(rawView, device, vkDestroyImageView, 0, "PlasmaView");
+    outputView_ = RTX::Handle<VkImageView>(rawView, device, "PlasmaView");
 
     rtx_.updateRTXDescriptors(0, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
                               VK_NULL_HANDLE, *outputView_, VK_NULL_HANDLE, VK_NULL_HANDLE,
@@ -119,14 +116,10 @@ void RenderMode5::clearPlasma(VkCommandBuffer cmd)
 
 void RenderMode5::onResize(uint32_t width, uint32_t height)
 {
-    vkDeviceWaitIdle(g_ctx().device());
-
-    rtx_.updateRTXDescriptors(0, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                              VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                              VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE);
 
-    outputImage_.reset();
-    outputView_.reset();
+    // Retired, not destroyed — frames in flight may still write the old image
+    outputView_.retire();
+    outputImage_.retire();
 
     width_  = width;
     height_ = height;
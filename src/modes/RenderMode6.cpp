@@ -28,11 +28,8 @@ RenderMode6::RenderMode6(VulkanRTX& rtx, uint32_t width, uint32_t height)
 
 RenderMode6::~RenderMode6()
 {
-    vkDeviceWaitIdle(g_ctx().device());
-
-    rtx_.updateRTXDescriptors(0, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                              VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                              VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE);
+    outputView_.retire();
+    outputImage_.retire();
 
     LOG_SUCCESS_CAT("RenderMode6", "Mode 6 destroyed — {} frames rendered — PHOTONS COUNTED", frameCount_);
 }
@@ -54,7 +51,7 @@ void RenderMode6::initResources()
 
     VkImage rawImg;
     VK_CHECK(vkCreateImage(device, &imgInfo, nullptr, &rawImg), "FrameCounter image");
-    outputImage_ = RTX::Handle<VkImage>(rawImg, device, vkDestroyImage, 0, "FrameCounterImage");
+    outputImage_ = RTX::Handle<VkImage>(rawImg, device, "FrameCounterImage");
 
     VkImageViewCreateInfo viewInfo{VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
     viewInfo.image = rawImg;
@@ -63,7 +60,7 @@ void RenderMode6::initResources()
     viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
     VkImageView rawView;
     VK_CHECK(vkCreateImageView(device, &viewInfo, nullptr, &rawView), "FrameCounter view");
-    outputView_ = RTX::Handle<VkImageView>(rawView, device, vkDestroyImageView, 0, "FrameCounterView");
+    outputView_ = RTX::Handle<VkImageView>(rawView, device, "FrameCounterView");
 
     rtx_.updateRTXDescriptors(0, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
                               VK_NULL_HANDLE, *outputView_, VK_NULL_HANDLE, VK_NULL_HANDLE,
@@ -108,14 +105,10 @@ void RenderMode6::clearWithFrameNumber(VkCommandBuffer cmd)
 
 void RenderMode6::onResize(uint32_t width, uint32_t height)
 {
-    vkDeviceWaitIdle(g_ctx().device());
-
-    rtx_.updateRTXDescriptors(0, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                              VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                              VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE);
 
-    outputImage_.reset();
-    outputView_.reset();
+    // Retired, not destroyed — frames in flight may still write the old image
+    outputView_.retire();
+    outputImage_.retire();
 
     width_ = width;
     height_ = height;
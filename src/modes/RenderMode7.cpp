@@ -30,11 +30,8 @@ RenderMode7::RenderMode7(VulkanRTX& rtx, uint32_t width, uint32_t height)
 
 RenderMode7::~RenderMode7()
 {
-    vkDeviceWaitIdle(g_ctx().device());
-
-    rtx_.updateRTXDescriptors(0, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                              VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                              VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE);
+    outputView_.retire();
+    outputImage_.retire();
 
     LOG_SUCCESS_CAT("RenderMode7", "Mode 7 destroyed — VORTEX PHOTONS CONSUMED");
 }
@@ -56,7 +53,7 @@ void RenderMode7::initResources()
 
     VkImage rawImg;
     VK_CHECK(vkCreateImage(device, &imgInfo, nullptr, &rawImg), "Vortex image");
-    outputImage_ = RTX::Handle<VkImage>(rawImg, device, vkDestroyImage, 0, "VortexImage");
+    outputImage_ = RTX::Handle<VkImage>(rawImg, device, "VortexImage");
 
     VkImageViewCreateInfo viewInfo{VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
     viewInfo.image = rawImg;
@@ -65,7 +62,7 @@ void RenderMode7::initResources()
     viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
     VkImageView rawView;
     VK_CHECK(vkCreateImageView(device, &viewInfo, nullptr, &rawView), "Vortex view");
-    outputView_ = RTX::Handle<VkImageView>(rawView, device, vkDestroyImageView, 0, "VortexView");
+    outputView_ = RTX::Handle<VkImageView>(rawView, device, "VortexView");
 
     rtx_.updateRTXDescriptors(0, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
                               VK_NULL_HANDLE, *outputView_, VK_NULL_HANDLE, VK_NULL_HANDLE,
@@ -131,14 +128,10 @@ void RenderMode7::clearVortex(VkCommandBuffer cmd)
 
 void RenderMode7::onResize(uint32_t width, uint32_t height)
 {
-    vkDeviceWaitIdle(g_ctx().device());
-
-    rtx_.updateRTXDescriptors(0, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                              VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                              VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE);
 
-    outputImage_.reset();
-    outputView_.reset();
+    // Retired, not destroyed — frames in flight may still write the old image
+    outputView_.retire();
+    outputImage_.retire();
 
     width_  = width;
     height_ = height;
@@ -29,15 +29,11 @@ RenderMode9::RenderMode9(VulkanRTX& rtx, uint32_t width, uint32_t height)
 
 RenderMode9::~RenderMode9()
 {
-    vkDeviceWaitIdle(g_ctx().device());
-
-    rtx_.updateRTXDescriptors(0,
-        VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-        VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-        VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE);
-
     if (uniformBuf_) BUFFER_DESTROY(uniformBuf_);
 
+    outputView_.retire();
+    outputImage_.retire();
+
     LOG_SUCCESS_CAT("RenderMode9", "Mode 9 destroyed — The truth remains.");
 }
 
@@ -64,7 +60,7 @@ void RenderMode9::initResources()
 
     VkImage rawImg;
     VK_CHECK(vkCreateImage(device, &imgInfo, nullptr, &rawImg), "Ascension output image");
-    outputImage_ = RTX::Handle<VkImage>(rawImg, device, vkDestroyImage, 0, "AscensionImage");
+    outputImage_ = RTX::Handle<VkImage>(rawImg, device, "AscensionImage");
 
     VkImageViewCreateInfo viewInfo{VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
     viewInfo.image = rawImg;
@@ -73,7 +69,7 @@ void RenderMode9::initResources()
     viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
     VkImageView rawView;
     VK_CHECK(vkCreateImageView(device, &viewInfo, nullptr, &rawView), "Ascension view");
-    outputView_ = RTX::Handle<VkImageView>(rawView, device, vkDestroyImageView, 0, "AscensionView");
+    outputView_ = RTX::Handle<VkImageView>(rawView, device, "AscensionView");
 
     rtx_.updateRTXDescriptors(0,
         RAW_BUFFER(uniformBuf_), VK_NULL_HANDLE, VK_NULL_HANDLE,
@@ -127,16 +123,11 @@ void RenderMode9::onResize(uint32_t width, uint32_t height)
 {
     LOG_INFO_CAT("RenderMode9", "onResize() {}x{} — Re-ascending...", width, height);
 
-    vkDeviceWaitIdle(g_ctx().device());
-
-    rtx_.updateRTXDescriptors(0, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                              VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
-                              VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE);
-
     if (uniformBuf_) BUFFER_DESTROY(uniformBuf_);
     uniformBuf_ = 0;
-    outputImage_.reset();
-    outputView_.reset();
+    // Retired, not destroyed — frames in flight may still write the old image
+    outputView_.retire();
+    outputImage_.retire();
 
     width_  = width;
     height_ = height;
@@ -0,0 +1,217 @@
+// =============================================================================
+// HeadlessVulkan.hpp — AMOURANTH RTX Engine © 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. Creative Commons Attribution-NonCommercial 4.0 International (CC BY-NC 4.0)
+//    https://creativecommons.org/licenses/by-nc/4.0/legalcode
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// HEADLESS DEVICE FOR device/ TESTS — no window, no surface, no swapchain
+//   One instance, one device, one graphics+compute queue, one command pool.
+//   Picks a CPU device (lavapipe/llvmpipe) first so CI results are stable;
+//   AMOURANTH_TEST_DEVICE=<substring> selects by name instead.
+//   init() returns false when no usable device exists — the test then
+//   returns Tests::SKIP and ctest reports it skipped, not failed.
+//   Requirements::accelerationStructure also enables buffer device address
+//   and VK_KHR_acceleration_structure (+ deferred host operations).
+// =============================================================================
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace Tests {
+
+class HeadlessVulkan {
+public:
+    struct Requirements {
+        bool accelerationStructure = false;
+    };
+
+    VkInstance                 instance = VK_NULL_HANDLE;
+    VkPhysicalDevice           physical = VK_NULL_HANDLE;
+    VkDevice                   device   = VK_NULL_HANDLE;
+    VkQueue                    queue    = VK_NULL_HANDLE;
+    uint32_t                   family   = UINT32_MAX;
+    VkCommandPool              pool     = VK_NULL_HANDLE;
+    VkPhysicalDeviceProperties props{};
+    bool                       synchronization2      = false;
+    bool                       accelerationStructure = false;
+
+    HeadlessVulkan() = default;
+    ~HeadlessVulkan() { destroy(); }
+    HeadlessVulkan(const HeadlessVulkan&) = delete;
+    HeadlessVulkan& operator=(const HeadlessVulkan&) = delete;
+
+    [[nodiscard]] bool init(Requirements req = {}) {
+        VkApplicationInfo app{ .sType = VK_STRUCTURE_TYPE_APPLICATION_INFO };
+        app.pApplicationName = "amouranth-tests";
+        app.apiVersion       = VK_API_VERSION_1_3;
+        VkInstanceCreateInfo ici{ .sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO };
+        ici.pApplicationInfo = &app;
+        if (vkCreateInstance(&ici, nullptr, &instance) != VK_SUCCESS) {
+            std::printf("  no Vulkan instance — skipping\n");
+            instance = VK_NULL_HANDLE;
+            return false;
+        }
+
+        uint32_t count = 0;
+        vkEnumeratePhysicalDevices(instance, &count, nullptr);
+        std::vector<VkPhysicalDevice> devices(count);
+        vkEnumeratePhysicalDevices(instance, &count, devices.data());
+
+        const char* wanted = std::getenv("AMOURANTH_TEST_DEVICE");
+        int best = -1;
+        for (uint32_t i = 0; i < count; ++i) {
+            VkPhysicalDeviceProperties p{};
+            vkGetPhysicalDeviceProperties(devices[i], &p);
+            if (p.apiVersion < VK_API_VERSION_1_3 || pickFamily(devices[i]) == UINT32_MAX) continue;
+            if (req.accelerationStructure && !hasExtension(devices[i], VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME)) continue;
+            const int score = rank(devices[i], wanted);
+            if (score > 0 && (best < 0 || score > rank(devices[static_cast<uint32_t>(best)], wanted)))
+                best = static_cast<int>(i);
+        }
+        if (best < 0) {
+            std::printf("  no Vulkan 1.3 device%s — skipping\n", req.accelerationStructure ? " with acceleration structures" : "");
+            return false;
+        }
+        physical = devices[static_cast<uint32_t>(best)];
+        family   = pickFamily(physical);
+        vkGetPhysicalDeviceProperties(physical, &props);
+
+        VkPhysicalDeviceAccelerationStructureFeaturesKHR asSupport{ .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR };
+        VkPhysicalDeviceVulkan12Features v12Support{ .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES };
+        VkPhysicalDeviceVulkan13Features v13Support{ .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES };
+        v13Support.pNext = &v12Support;
+        if (req.accelerationStructure) v12Support.pNext = &asSupport;
+        VkPhysicalDeviceFeatures2 support{ .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, .pNext = &v13Support };
+        vkGetPhysicalDeviceFeatures2(physical, &support);
+
+        if (req.accelerationStructure && (!asSupport.accelerationStructure || !v12Support.bufferDeviceAddress)) {
+            std::printf("  %s lacks accelerationStructure/bufferDeviceAddress — skipping\n", props.deviceName);
+            return false;
+        }
+
+        VkPhysicalDeviceAccelerationStructureFeaturesKHR asFeatures{ .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR };
+        asFeatures.accelerationStructure = req.accelerationStructure;
+        VkPhysicalDeviceVulkan12Features v12{ .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES };
+        v12.bufferDeviceAddress = v12Support.bufferDeviceAddress;
+        v12.timelineSemaphore   = v12Support.timelineSemaphore;
+        v12.hostQueryReset      = v12Support.hostQueryReset;
+        if (req.accelerationStructure) v12.pNext = &asFeatures;
+        VkPhysicalDeviceVulkan13Features v13{ .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES, .pNext = &v12 };
+        v13.synchronization2 = v13Support.synchronization2;
+
+        std::vector<const char*> extensions;
+        if (req.accelerationStructure) {
+            extensions.push_back(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME);
+            extensions.push_back(VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME);
+        }
+
+        const float priority = 1.0f;
+        VkDeviceQueueCreateInfo qci{ .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO };
+        qci.queueFamilyIndex = family;
+        qci.queueCount       = 1;
+        qci.pQueuePriorities = &priority;
+        VkDeviceCreateInfo dci{ .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO, .pNext = &v13 };
+        dci.queueCreateInfoCount    = 1;
+        dci.pQueueCreateInfos       = &qci;
+        dci.enabledExtensionCount   = static_cast<uint32_t>(extensions.size());
+        dci.ppEnabledExtensionNames = extensions.data();
+        if (vkCreateDevice(physical, &dci, nullptr, &device) != VK_SUCCESS) {
+            std::printf("  vkCreateDevice failed on %s — skipping\n", props.deviceName);
+            device = VK_NULL_HANDLE;
+            return false;
+        }
+        vkGetDeviceQueue(device, family, 0, &queue);
+        synchronization2      = v13.synchronization2;
+        accelerationStructure = req.accelerationStructure;
+
+        VkCommandPoolCreateInfo pci{ .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+        pci.flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        pci.queueFamilyIndex = family;
+        vkCreateCommandPool(device, &pci, nullptr, &pool);
+
+        std::printf("  device: %s (sync2 %s)\n", props.deviceName, synchronization2 ? "on" : "off");
+        return true;
+    }
+
+    void destroy() noexcept {
+        if (device) {
+            vkDeviceWaitIdle(device);
+            if (pool) vkDestroyCommandPool(device, pool, nullptr);
+            vkDestroyDevice(device, nullptr);
+        }
+        if (instance) vkDestroyInstance(instance, nullptr);
+        pool = VK_NULL_HANDLE; device = VK_NULL_HANDLE; instance = VK_NULL_HANDLE;
+    }
+
+    [[nodiscard]] VkCommandBuffer begin() const {
+        VkCommandBufferAllocateInfo ai{ .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+        ai.commandPool        = pool;
+        ai.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        ai.commandBufferCount = 1;
+        VkCommandBuffer cmd = VK_NULL_HANDLE;
+        vkAllocateCommandBuffers(device, &ai, &cmd);
+        VkCommandBufferBeginInfo bi{ .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+        bi.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkBeginCommandBuffer(cmd, &bi);
+        return cmd;
+    }
+
+    // Ends, submits, waits for the queue and frees `cmd`
+    [[nodiscard]] bool submitAndWait(VkCommandBuffer cmd) const {
+        vkEndCommandBuffer(cmd);
+        VkSubmitInfo si{ .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO };
+        si.commandBufferCount = 1;
+        si.pCommandBuffers    = &cmd;
+        const bool ok = vkQueueSubmit(queue, 1, &si, VK_NULL_HANDLE) == VK_SUCCESS && vkQueueWaitIdle(queue) == VK_SUCCESS;
+        vkFreeCommandBuffers(device, pool, 1, &cmd);
+        return ok;
+    }
+
+    [[nodiscard]] uint32_t memoryType(uint32_t typeBits, VkMemoryPropertyFlags flags) const {
+        VkPhysicalDeviceMemoryProperties mem{};
+        vkGetPhysicalDeviceMemoryProperties(physical, &mem);
+        for (uint32_t i = 0; i < mem.memoryTypeCount; ++i)
+            if ((typeBits & (1u << i)) && (mem.memoryTypes[i].propertyFlags & flags) == flags) return i;
+        return UINT32_MAX;
+    }
+
+private:
+    [[nodiscard]] static uint32_t pickFamily(VkPhysicalDevice pd) {
+        uint32_t n = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(pd, &n, nullptr);
+        std::vector<VkQueueFamilyProperties> families(n);
+        vkGetPhysicalDeviceQueueFamilyProperties(pd, &n, families.data());
+        constexpr VkQueueFlags want = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT;
+        for (uint32_t i = 0; i < n; ++i)
+            if ((families[i].queueFlags & want) == want) return i;
+        return UINT32_MAX;
+    }
+
+    [[nodiscard]] static bool hasExtension(VkPhysicalDevice pd, const char* name) {
+        uint32_t n = 0;
+        vkEnumerateDeviceExtensionProperties(pd, nullptr, &n, nullptr);
+        std::vector<VkExtensionProperties> exts(n);
+        vkEnumerateDeviceExtensionProperties(pd, nullptr, &n, exts.data());
+        for (const auto& e : exts)
+            if (std::strcmp(e.extensionName, name) == 0) return true;
+        return false;
+    }
+
+    [[nodiscard]] static int rank(VkPhysicalDevice pd, const char* wanted) {
+        VkPhysicalDeviceProperties p{};
+        vkGetPhysicalDeviceProperties(pd, &p);
+        return wanted ? (std::strstr(p.deviceName, wanted) ? 2 : 0)
+                      : (p.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU ? 2 : 1);
+    }
+};
+
+} // namespace Tests
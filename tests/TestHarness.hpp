@@ -0,0 +1,105 @@
+// =============================================================================
+// TestHarness.hpp — AMOURANTH RTX Engine © 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. Creative Commons Attribution-NonCommercial 4.0 International (CC BY-NC 4.0)
+//    https://creativecommons.org/licenses/by-nc/4.0/legalcode
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// HOST TEST + BENCHMARK HARNESS — no framework, ctest reads the exit code
+//   CHECK(cond) / CHECK_EQ(a, b)   record a failure, keep going
+//   REQUIRE(cond)                  record a failure, return 1 from main
+//   return Tests::finish("name");  0 when every CHECK held
+//   return Tests::SKIP;            no device / feature — ctest reports Skipped
+// Benchmarks time with Tests::Clock and report Tests::percentiles().
+// AMOURANTH_BENCH_SCALE (env, default 1.0) stretches every benchmark's
+// iteration count — ctest runs stay short, real measurements use 10+.
+// =============================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+#define CHECK(cond) do { if (!(cond)) ::Tests::fail(__FILE__, __LINE__, #cond); } while (0)
+#define CHECK_EQ(a, b) do { if (!((a) == (b))) ::Tests::fail(__FILE__, __LINE__, #a " == " #b); } while (0)
+#define REQUIRE(cond) do { if (!(cond)) { ::Tests::fail(__FILE__, __LINE__, #cond); return 1; } } while (0)
+
+namespace Tests {
+
+constexpr int SKIP = 77;   // SKIP_RETURN_CODE in tests/CMakeLists.txt
+
+using Clock = std::chrono::steady_clock;
+
+inline int g_failures = 0;
+
+inline void fail(const char* file, int line, const char* what) noexcept {
+    std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", file, line, what);
+    ++g_failures;
+}
+
+[[nodiscard]] inline int finish(const char* name) noexcept {
+    if (g_failures) std::fprintf(stderr, "[%s] %d check(s) failed\n", name, g_failures);
+    else            std::printf("[%s] ok\n", name);
+    return g_failures ? 1 : 0;
+}
+
+[[nodiscard]] inline double nsSince(Clock::time_point t) noexcept {
+    return std::chrono::duration<double, std::nano>(Clock::now() - t).count();
+}
+
+[[nodiscard]] inline double scale() noexcept {
+    const char* s = std::getenv("AMOURANTH_BENCH_SCALE");
+    const double v = s ? std::atof(s) : 1.0;
+    return v > 0.0 ? v : 1.0;
+}
+
+[[nodiscard]] inline uint64_t scaled(uint64_t n) noexcept {
+    return std::max<uint64_t>(1, static_cast<uint64_t>(static_cast<double>(n) * scale()));
+}
+
+// CPU time of the calling thread / the whole process, in ns
+[[nodiscard]] inline int64_t threadCpuNs() noexcept {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+}
+
+[[nodiscard]] inline int64_t processCpuNs() noexcept {
+    timespec ts{};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+}
+
+struct Percentiles {
+    double p50 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+    double mean = 0.0;
+};
+
+// Reorders `samples`
+[[nodiscard]] inline Percentiles percentiles(std::vector<double>& samples) {
+    Percentiles p;
+    if (samples.empty()) return p;
+    auto at = [&](double q) {
+        const size_t i = std::min(samples.size() - 1, static_cast<size_t>(q * static_cast<double>(samples.size())));
+        std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(i), samples.end());
+        return samples[i];
+    };
+    p.p50 = at(0.50);
+    p.p99 = at(0.99);
+    p.max = *std::max_element(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double s : samples) sum += s;
+    p.mean = sum / static_cast<double>(samples.size());
+    return p;
+}
+
+} // namespace Tests
@@ -0,0 +1,167 @@
+// =============================================================================
+// LegacyLog.hpp — AMOURANTH RTX Engine © 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. Creative Commons Attribution-NonCommercial 4.0 International (CC BY-NC 4.0)
+//    https://creativecommons.org/licenses/by-nc/4.0/legalcode
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// BASELINE FOR THE LOGGING BENCHMARKS — the pre-ring logger, kept verbatim:
+//   LegacyQueue   vformat to std::string, mutex, deque<tuple> (producer side)
+//                 + 64-entry batch pop with a 100 µs sleep when empty
+//   legacyRender  the old printMessage batch path: per-call std::format
+//                 temporaries, ostringstream thread id, localtime + strftime,
+//                 map lookup for the category color
+// Only benchmarks include this. Do not "fix" it — it is the control.
+// =============================================================================
+
+#pragma once
+
+#include "engine/GLOBAL/logging.hpp"
+
+#include <deque>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace Legacy {
+
+using Entry = std::tuple<uint64_t, std::source_location, Logging::LogLevel, std::string, std::string,
+                         std::chrono::steady_clock::time_point>;
+
+class LegacyQueue {
+public:
+    template<typename... Args>
+    void log(std::source_location loc, Logging::LogLevel level, std::string_view category,
+             std::string_view fmt, const Args&... args) {
+        auto now = std::chrono::steady_clock::now();
+        uint64_t id = seq_.fetch_add(1, std::memory_order_relaxed);
+        auto msg = std::vformat(fmt, std::make_format_args(args...));
+        std::scoped_lock lk(mutex_);
+        queue_.emplace_back(id, loc, level, std::string{category}, std::move(msg), now);
+    }
+
+    // Returns false when it slept instead
+    bool popBatch(std::vector<Entry>& batch) {
+        {
+            std::unique_lock lk(mutex_);
+            if (!queue_.empty()) {
+                batch.clear();
+                while (!queue_.empty() && batch.size() < 64) {
+                    batch.push_back(std::move(queue_.front()));
+                    queue_.pop_front();
+                }
+                return true;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        return false;
+    }
+
+private:
+    std::atomic<uint64_t> seq_{0};
+    std::mutex mutex_;
+    std::deque<Entry> queue_;
+};
+
+inline std::string_view categoryColor(std::string_view cat) {
+    using namespace Color;
+    struct CIless {
+        bool operator()(std::string_view a, std::string_view b) const {
+            size_t n = std::min(a.size(), b.size());
+            for (size_t i = 0; i < n; ++i)
+                if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i])))
+                    return std::tolower(static_cast<unsigned char>(a[i])) < std::tolower(static_cast<unsigned char>(b[i]));
+            return a.size() < b.size();
+        }
+    };
+    static const std::map<std::string_view, std::string_view, CIless> map{
+        {"General", DIAMOND_SPARKLE}, {"MAIN", VALHALLA_GOLD}, {"Init", AURORA_BOREALIS},
+        {"Dispose", PARTY_PINK}, {"Logger", ELECTRIC_BLUE}, {"Vulkan", SAPPHIRE_BLUE},
+        {"Device", QUASAR_BLUE}, {"Swapchain", OCEAN_TEAL}, {"Command", CHROMIUM_SILVER},
+        {"Queue", OBSIDIAN_BLACK}, {"RayTrace", TURQUOISE_BLUE}, {"RTX", HYPERSPACE_WARP},
+        {"Accel", PULSAR_GREEN}, {"TLAS", SUPERNOVA_ORANGE}, {"BLAS", SUPERNOVA_ORANGE},
+        {"LAS", SUPERNOVA_ORANGE}, {"AI", COSMIC_GOLD}, {"Memory", PEACHES_AND_CREAM},
+        {"SBT", RASPBERRY_PINK}, {"Shader", NEBULA_VIOLET}, {"Renderer", BRIGHT_PINKISH_PURPLE},
+        {"Render", THERMO_PINK}, {"Tonemap", PEACHES_AND_CREAM}, {"GBuffer", QUANTUM_FLUX},
+        {"Post", NUCLEAR_REACTOR}, {"Buffer", BRONZE_BROWN}, {"Image", LIME_YELLOW},
+        {"Texture", SPEARMINT_MINT}, {"Sampler", LILAC_LAVENDER}, {"Descriptor", FUCHSIA_MAGENTA},
+        {"Perf", COSMIC_GOLD}, {"FPS", FIERY_ORANGE}, {"GPU", BLACK_HOLE},
+        {"CPU", PLASMA_FUCHSIA}, {"Input", SPEARMINT_MINT}, {"Audio", OCEAN_TEAL},
+        {"Physics", EMERALD_GREEN}, {"SIMULATION", BRONZE_BROWN}, {"MeshLoader", LIME_YELLOW},
+        {"GLTF", QUANTUM_PURPLE}, {"Material", PEACHES_AND_CREAM}, {"Debug", ARCTIC_CYAN},
+        {"ATTEMPT", QUANTUM_PURPLE}, {"VOID", COSMIC_VOID}, {"SPLASH", LILAC_LAVENDER},
+        {"MARKER", DIAMOND_SPARKLE}, {"SDL3_window", SAPPHIRE_BLUE}, {"SDL3_audio", SAPPHIRE_BLUE},
+        {"SDL3_font", SAPPHIRE_BLUE}, {"SDL3_image", SAPPHIRE_BLUE}, {"SDL3_init", SAPPHIRE_BLUE},
+        {"SDL3_input", SAPPHIRE_BLUE}, {"SDL3_vulkan", SAPPHIRE_BLUE}, {"PIPELINE", SPEARMINT_MINT}
+    };
+    if (auto it = map.find(cat); it != map.end()) [[likely]]
+        return it->second;
+    return DIAMOND_WHITE;
+}
+
+inline void legacyRender(std::source_location loc, Logging::LogLevel level, std::string_view category,
+                         std::string formattedMessage, std::chrono::steady_clock::time_point timestamp,
+                         std::chrono::steady_clock::time_point firstLogTime,
+                         std::string& term_out, std::string& file_out) {
+    using namespace Color;
+    const auto& info = Logging::LEVEL_INFOS[static_cast<size_t>(level)];
+    const std::string_view levelColor = info.color;
+    const std::string_view levelBg    = info.bg;
+    const std::string_view levelStr   = info.str;
+    const std::string_view catColor   = categoryColor(category);
+
+    const auto deltaUs = std::chrono::duration_cast<std::chrono::microseconds>(timestamp - firstLogTime).count();
+
+    const std::string deltaStr = [deltaUs]() -> std::string {
+        if (deltaUs < 10'000) [[likely]] return std::format("{:>7}µs", deltaUs);
+        if (deltaUs < 1'000'000) return std::format("{:>7.3f}ms", deltaUs / 1'000.0);
+        if (deltaUs < 60'000'000) return std::format("{:>7.3f}s", deltaUs / 1'000'000.0);
+        if (deltaUs < 3'600'000'000) return std::format("{:>7.1f}m", deltaUs / 60'000'000.0);
+        return std::format("{:>7.1f}h", deltaUs / 3'600'000'000.0);
+    }();
+
+    const std::string timeStr = []() -> std::string {
+        auto now = std::chrono::system_clock::now();
+        auto tt  = std::chrono::system_clock::to_time_t(now);
+        auto tm  = *std::localtime(&tt);
+        char buf[9];
+        std::strftime(buf, sizeof(buf), "%H:%M:%S", &tm);
+        return std::string(buf);
+    }();
+
+    const std::string threadId = []() {
+        std::ostringstream oss; oss << std::this_thread::get_id(); return oss.str();
+    }();
+
+    const std::string fileLine = std::format("{}:{}:{}", loc.file_name(), loc.line(), loc.function_name());
+
+    const std::string plain_line1 = std::format("{:<{}} {:>{}} {:>{}} [{:>{}}] [{:>{}}] {}\n",
+                                                levelStr, LEVEL_WIDTH,
+                                                deltaStr, DELTA_WIDTH,
+                                                timeStr,  TIME_WIDTH,
+                                                category, CAT_WIDTH,
+                                                threadId, THREAD_WIDTH,
+                                                formattedMessage);
+    const std::string plain_line2 = std::format("{}\n", fileLine);
+    const std::string plain = plain_line1 + plain_line2 + "\n";
+
+    std::ostringstream oss;
+    oss << levelBg << std::format("{:<{}}", levelStr, LEVEL_WIDTH) << RESET
+        << " " << std::format("{:>{}}", deltaStr, DELTA_WIDTH) << " "
+        << std::format("{:>{}}", timeStr, TIME_WIDTH) << " "
+        << catColor << std::format("[{:<{}}]", category, CAT_WIDTH - 2) << RESET
+        << " " << LIME_GREEN << std::format("[{:>{}}]", threadId, THREAD_WIDTH - 2) << RESET
+        << " " << levelColor << formattedMessage << RESET << '\n'
+        << CHROMIUM_SILVER << fileLine << RESET << '\n'
+        << '\n';
+    term_out += oss.str();
+    file_out += plain;
+}
+
+} // namespace Legacy
@@ -0,0 +1,150 @@
+// =============================================================================
+// bench_log_flusher.cpp — AMOURANTH RTX Engine © 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. Creative Commons Attribution-NonCommercial 4.0 International (CC BY-NC 4.0)
+//    https://creativecommons.org/licenses/by-nc/4.0/legalcode
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// FLUSHER CPU AT 5x LOAD — 100k msg/s for a few seconds, rendered to both a
+// colored and a plain sink that discard the bytes (no I/O in the numbers).
+//   logger   the real Logger: ring, one-pass printMessage, cached thread id
+//   legacy   deque+mutex + the old per-line printMessage (bench/LegacyLog.hpp)
+// Flusher CPU = process CPU − producer thread CPU over the run, reported as
+// % of one core and ns per message.
+// =============================================================================
+
+#include "TestHarness.hpp"
+#include "bench/LegacyLog.hpp"
+
+#include <thread>
+
+namespace {
+
+constexpr uint64_t MESSAGES_PER_SECOND = 100'000;
+constexpr uint64_t RUN_SECONDS         = 2;
+constexpr uint64_t BURSTS_PER_SECOND   = 1'000;   // 100 lines per millisecond
+
+class DiscardSink final : public Logging::LogSink {
+public:
+    explicit DiscardSink(Logging::SinkFormat f) : format_(f) {}
+    [[nodiscard]] Logging::SinkFormat format() const noexcept override { return format_; }
+    void write(std::string_view bytes) override { bytes_ += bytes.size(); }
+    [[nodiscard]] uint64_t bytes() const noexcept { return bytes_; }
+private:
+    Logging::SinkFormat format_;
+    uint64_t bytes_ = 0;
+};
+
+struct Result {
+    double wallSeconds = 0.0;
+    int64_t consumerCpuNs = 0;
+    uint64_t messages = 0;
+};
+
+// Emits `total` messages at MESSAGES_PER_SECOND in 1 ms bursts; returns its own CPU time
+template<typename Emit>
+int64_t paceProducer(uint64_t total, Emit&& emit) {
+    const int64_t cpu0 = Tests::threadCpuNs();
+    const uint64_t perBurst = MESSAGES_PER_SECOND / BURSTS_PER_SECOND;
+    auto next = Tests::Clock::now();
+    for (uint64_t i = 0; i < total;) {
+        for (uint64_t b = 0; b < perBurst && i < total; ++b, ++i) emit(i);
+        next += std::chrono::microseconds(1'000'000 / BURSTS_PER_SECOND);
+        std::this_thread::sleep_until(next);
+    }
+    return Tests::threadCpuNs() - cpu0;
+}
+
+Result runLogger(uint64_t total) {
+    auto& logger = Logging::Logger::get();
+    Logging::Logger::clearSinks();
+    Logging::Logger::addSink(std::make_unique<DiscardSink>(Logging::SinkFormat::Colored));
+    Logging::Logger::addSink(std::make_unique<DiscardSink>(Logging::SinkFormat::Plain));
+    Logging::Logger::setOverflowPolicy(Logging::OverflowPolicy::Block);
+    const auto loc = std::source_location::current();
+
+    const int64_t cpu0 = Tests::processCpuNs();
+    const auto t0 = Tests::Clock::now();
+    int64_t producerCpu = 0;
+    std::jthread producer([&] {
+        producerCpu = paceProducer(total, [&](uint64_t i) {
+            logger.log(loc, Logging::LogLevel::Perf, Logging::LogCategory::Render, "Render",
+                       "frame {} pass {} took {:.3f} ms", i / 100, i % 100, 0.01 * static_cast<double>(i % 100));
+        });
+    });
+    producer.join();
+    Logging::Logger::setAsync(false);   // drains the ring and joins the flusher
+    const double wall = Tests::nsSince(t0) / 1e9;
+    return {wall, Tests::processCpuNs() - cpu0 - producerCpu, total};
+}
+
+Result runLegacy(uint64_t total) {
+    Legacy::LegacyQueue queue;
+    const auto first = std::chrono::steady_clock::now();
+    const auto loc = std::source_location::current();
+    std::atomic<bool> done{false};
+    uint64_t rendered = 0;
+
+    const int64_t cpu0 = Tests::processCpuNs();
+    const auto t0 = Tests::Clock::now();
+    std::jthread flusher([&] {
+        std::vector<Legacy::Entry> batch;
+        batch.reserve(64);
+        std::string terminal_batch;
+        std::string file_batch;
+        DiscardSink colored(Logging::SinkFormat::Colored);
+        DiscardSink plain(Logging::SinkFormat::Plain);
+        for (;;) {
+            const bool finishing = done.load(std::memory_order_acquire);
+            if (!queue.popBatch(batch)) { if (finishing) break; continue; }
+            std::sort(batch.begin(), batch.end(),
+                      [](const Legacy::Entry& a, const Legacy::Entry& b) { return std::get<0>(a) < std::get<0>(b); });
+            terminal_batch.clear();
+            file_batch.clear();
+            for (auto& e : batch)
+                Legacy::legacyRender(std::get<1>(e), std::get<2>(e), std::get<3>(e), std::move(std::get<4>(e)),
+                                     std::get<5>(e), first, terminal_batch, file_batch);
+            colored.write(terminal_batch);
+            plain.write(file_batch);
+            rendered += batch.size();
+        }
+    });
+    int64_t producerCpu = 0;
+    std::jthread producer([&] {
+        producerCpu = paceProducer(total, [&](uint64_t i) {
+            queue.log(loc, Logging::LogLevel::Perf, "Render",
+                      "frame {} pass {} took {:.3f} ms", i / 100, i % 100, 0.01 * static_cast<double>(i % 100));
+        });
+    });
+    producer.join();
+    done.store(true, std::memory_order_release);
+    flusher.join();
+    const double wall = Tests::nsSince(t0) / 1e9;
+    CHECK_EQ(rendered, total);
+    return {wall, Tests::processCpuNs() - cpu0 - producerCpu, total};
+}
+
+void report(const char* name, const Result& r) {
+    std::printf("  %-8s flusher %7.1f ms CPU over %.2f s  = %5.1f%% of a core, %6.0f ns/msg\n",
+                name, static_cast<double>(r.consumerCpuNs) / 1e6, r.wallSeconds,
+                100.0 * static_cast<double>(r.consumerCpuNs) / (r.wallSeconds * 1e9),
+                static_cast<double>(r.consumerCpuNs) / static_cast<double>(r.messages));
+}
+
+} // namespace
+
+int main() {
+    const uint64_t total = Tests::scaled(MESSAGES_PER_SECOND * RUN_SECONDS);
+    std::printf("[bench_log_flusher] %llu messages at %llu msg/s\n",
+                static_cast<unsigned long long>(total), static_cast<unsigned long long>(MESSAGES_PER_SECOND));
+
+    const Result legacy = runLegacy(total);
+    const Result logger = runLogger(total);
+    report("legacy", legacy);
+    report("logger", logger);
+
+    CHECK_EQ(Logging::Logger::get().droppedCount(), 0u);
+    return Tests::finish("bench_log_flusher");
+}
@@ -0,0 +1,82 @@
+// =============================================================================
+// bench_log_gate.cpp — AMOURANTH RTX Engine © 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. Creative Commons Attribution-NonCommercial 4.0 International (CC BY-NC 4.0)
+//    https://creativecommons.org/licenses/by-nc/4.0/legalcode
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// COST OF A SILENCED LOG SITE — built twice from this file:
+//   bench_log_gate_out   DISABLE_TRACE_AND_DEBUG_LOGS defined (shipping)
+//   bench_log_gate_in    DEBUG compiled in, Render held at Info at runtime
+// A tight per-object loop carries four DEBUG/TRACE sites whose arguments
+// are expensive. Compare ns/iteration across the two runs; the arguments
+// must never be evaluated in either (gate 1 discards them, gate 2 checks
+// before evaluating them).
+// =============================================================================
+
+#include "TestHarness.hpp"
+#include "engine/GLOBAL/logging.hpp"
+
+#include <cmath>
+
+namespace {
+
+constexpr uint64_t ITERATIONS  = 200'000;
+constexpr int      REPETITIONS = 50;
+
+uint64_t g_argEvaluations = 0;
+volatile double g_sink = 0.0;
+
+[[maybe_unused, nodiscard]] double expensiveArg(double x) noexcept {
+    ++g_argEvaluations;
+    return std::sqrt(std::abs(x)) * std::log1p(std::abs(x));
+}
+
+double objectLoop(uint64_t n) {
+    double acc = 0.0;
+    for (uint64_t i = 0; i < n; ++i) {
+        const double x = static_cast<double>(i) * 0.5;
+        acc += x * 1.0001;
+        LOG_DEBUG_CAT("Render", "object {} x={:.3f} metric={:.3f}", i, x, expensiveArg(x));
+        acc -= x * 0.0001;
+        LOG_DEBUG_CAT("Render", "object {} acc={:.3f}", i, acc);
+        LOG_DEBUG_CAT("Render", "object {} metric2={:.3f}", i, expensiveArg(acc));
+        acc *= 0.999999;
+        LOG_TRACE_CAT("Render", "object {} done", i);
+    }
+    return acc;
+}
+
+} // namespace
+
+int main() {
+#ifdef DISABLE_TRACE_AND_DEBUG_LOGS
+    constexpr const char* variant = "DEBUG compiled out";
+    static_assert(!Logging::compiledIn(Logging::LogLevel::Debug, Logging::LogCategory::Render));
+#else
+    constexpr const char* variant = "DEBUG compiled in, runtime-silenced";
+    static_assert(Logging::compiledIn(Logging::LogLevel::Debug, Logging::LogCategory::Render));
+#endif
+    Logging::setCategoryLevel(Logging::LogCategory::Render, Logging::LogLevel::Info);
+
+    const uint64_t n = Tests::scaled(ITERATIONS);
+    g_sink = objectLoop(n);   // warm-up
+
+    std::vector<double> perIter;
+    perIter.reserve(REPETITIONS);
+    for (int r = 0; r < REPETITIONS; ++r) {
+        const auto t0 = Tests::Clock::now();
+        g_sink = objectLoop(n);
+        perIter.push_back(Tests::nsSince(t0) / static_cast<double>(n));
+    }
+    const Tests::Percentiles p = Tests::percentiles(perIter);
+
+    std::printf("[bench_log_gate] %s\n", variant);
+    std::printf("  %llu iterations x %d reps, 4 log sites each: p50 %.3f ns/iter  p99 %.3f ns/iter\n",
+                static_cast<unsigned long long>(n), REPETITIONS, p.p50, p.p99);
+
+    CHECK_EQ(g_argEvaluations, 0u);
+    return Tests::finish("bench_log_gate");
+}
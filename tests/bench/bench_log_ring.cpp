@@ -0,0 +1,132 @@
+// =============================================================================
+// bench_log_ring.cpp — AMOURANTH RTX Engine © 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. Creative Commons Attribution-NonCommercial 4.0 International (CC BY-NC 4.0)
+//    https://creativecommons.org/licenses/by-nc/4.0/legalcode
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// PRODUCER LATENCY — LogRing (MPSC slots) vs the deque+mutex it replaced
+// Each producer times one enqueue: format a typical hot-path line, claim,
+// copy, publish. One consumer drains and discards, so the numbers are the
+// queue plus formatting — rendering and I/O are bench_log_flusher's job.
+// Reported at 1 / 8 / 32 producers: p50, p99, max (ns per message).
+// =============================================================================
+
+#include "TestHarness.hpp"
+#include "bench/LegacyLog.hpp"
+
+#include <latch>
+#include <thread>
+
+namespace {
+
+constexpr uint64_t MESSAGES_PER_THREAD = 20'000;
+
+struct Result {
+    Tests::Percentiles latency;
+    double seconds = 0.0;
+    uint64_t messages = 0;
+};
+
+template<typename Produce, typename Consume>
+Result run(unsigned threads, uint64_t perThread, Produce&& produce, Consume&& consume) {
+    std::vector<std::vector<double>> samples(threads);
+    std::latch go(threads + 1);
+    std::atomic<bool> done{false};
+
+    std::jthread consumer([&] { while (!done.load(std::memory_order_acquire)) consume(); consume(); });
+
+    std::vector<std::jthread> producers;
+    for (unsigned t = 0; t < threads; ++t)
+        producers.emplace_back([&, t] {
+            auto& mine = samples[t];
+            mine.reserve(perThread);
+            go.arrive_and_wait();
+            for (uint64_t i = 0; i < perThread; ++i) {
+                const auto t0 = Tests::Clock::now();
+                produce(t, i);
+                mine.push_back(Tests::nsSince(t0));
+            }
+        });
+
+    const auto start = Tests::Clock::now();
+    go.arrive_and_wait();
+    producers.clear();
+    const double seconds = Tests::nsSince(start) / 1e9;
+    done.store(true, std::memory_order_release);
+    consumer.join();
+
+    std::vector<double> all;
+    all.reserve(static_cast<size_t>(threads) * perThread);
+    for (auto& s : samples) all.insert(all.end(), s.begin(), s.end());
+    return {Tests::percentiles(all), seconds, static_cast<uint64_t>(threads) * perThread};
+}
+
+Result runRing(unsigned threads, uint64_t perThread) {
+    auto ring = std::make_unique<Logging::LogRing>();
+    const auto loc = std::source_location::current();
+
+    auto produce = [&](unsigned t, uint64_t i) {
+        char buf[Logging::LOG_SLOT_MESSAGE_SIZE];
+        Logging::TruncatingOut out = std::format_to(Logging::TruncatingOut{buf, buf + sizeof(buf)},
+                                                    "frame {} pass {} took {:.3f} ms", i, t, 0.25 * static_cast<double>(t));
+        Logging::LogSlot* slot = ring->claim();
+        while (!slot) { std::this_thread::yield(); slot = ring->claim(); }   // OverflowPolicy::Block
+        slot->id       = i;
+        slot->loc      = loc;
+        slot->time     = std::chrono::steady_clock::now();
+        slot->threadId = Logging::currentThreadId();
+        slot->fmtId    = 0;
+        slot->level    = Logging::LogLevel::Perf;
+        slot->catId    = Logging::LogCategory::Render;
+        slot->catLen   = 6;
+        slot->msgLen   = static_cast<uint16_t>(std::min(out.count, sizeof(buf)));
+        std::memcpy(slot->cat, "Render", slot->catLen);
+        std::memcpy(slot->msg, buf, slot->msgLen);
+        Logging::LogRing::publish(slot);
+    };
+    auto consume = [&] {
+        bool any = false;
+        while (Logging::LogSlot* s = ring->peek()) { Logging::LogRing::release(s); any = true; }
+        if (!any) std::this_thread::yield();
+    };
+    return run(threads, perThread, produce, consume);
+}
+
+Result runLegacy(unsigned threads, uint64_t perThread) {
+    Legacy::LegacyQueue queue;
+    std::vector<Legacy::Entry> batch;
+    batch.reserve(64);
+    const auto loc = std::source_location::current();
+
+    auto produce = [&](unsigned t, uint64_t i) {
+        queue.log(loc, Logging::LogLevel::Perf, "Render", "frame {} pass {} took {:.3f} ms", i, t, 0.25 * static_cast<double>(t));
+    };
+    auto consume = [&] { while (queue.popBatch(batch)) {} };
+    return run(threads, perThread, produce, consume);
+}
+
+void report(const char* name, unsigned threads, const Result& r) {
+    std::printf("  %-12s %2u thr  p50 %8.0f ns  p99 %9.0f ns  max %10.0f ns  %7.2f M msg/s\n",
+                name, threads, r.latency.p50, r.latency.p99, r.latency.max,
+                static_cast<double>(r.messages) / r.seconds / 1e6);
+}
+
+} // namespace
+
+int main() {
+    const uint64_t perThread = Tests::scaled(MESSAGES_PER_THREAD);
+    std::printf("[bench_log_ring] enqueue latency, %llu messages per producer\n",
+                static_cast<unsigned long long>(perThread));
+
+    for (unsigned threads : {1u, 8u, 32u}) {
+        const Result ring   = runRing(threads, perThread);
+        const Result legacy = runLegacy(threads, perThread);
+        report("ring", threads, ring);
+        report("deque+mutex", threads, legacy);
+        CHECK_EQ(ring.messages, static_cast<uint64_t>(threads) * perThread);
+    }
+    return Tests::finish("bench_log_ring");
+}
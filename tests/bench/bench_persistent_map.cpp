@@ -0,0 +1,164 @@
+// =============================================================================
+// bench_persistent_map.cpp — AMOURANTH RTX Engine © 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. Creative Commons Attribution-NonCommercial 4.0 International (CC BY-NC 4.0)
+//    https://creativecommons.org/licenses/by-nc/4.0/legalcode
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// HOST WRITES PER FRAME — map/unmap every time vs mapped once
+//   The frame's host writes before persistent mapping: camera UBO, tonemap
+//   params, dimensions, one mode UBO — each one a dedicated VkDeviceMemory,
+//   vkMapMemory → memcpy → vkUnmapMemory.
+//   Now: the same four ranges sub-allocated from a DeviceHeap block mapped at
+//   creation — memcpy into base + offset, DeviceHeap::flush() (a no-op on
+//   HOST_COHERENT types, an atom-rounded vkFlushMappedMemoryRanges otherwise).
+//   Runs on every host-visible memory type of a headless device (lavapipe
+//   when present); reports CPU µs per frame and the saving.
+// =============================================================================
+
+#include "TestHarness.hpp"
+#include "HeadlessVulkan.hpp"
+#include "engine/GLOBAL/DeviceHeap.hpp"
+
+#include <array>
+#include <cstring>
+
+namespace {
+
+constexpr uint64_t FRAMES = 20'000;
+constexpr std::array<VkDeviceSize, 4> WRITES = {256, 64, 16, 1024};   // camera, tonemap, dims, mode UBO
+
+struct Result {
+    double cpuUsPerFrame  = 0.0;
+    double wallUsPerFrame = 0.0;
+};
+
+[[nodiscard]] VkBuffer makeBuffer(VkDevice device, VkDeviceSize size) {
+    VkBufferCreateInfo bi{ .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+    bi.size        = size;
+    bi.usage       = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    bi.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    VkBuffer b = VK_NULL_HANDLE;
+    vkCreateBuffer(device, &bi, nullptr, &b);
+    return b;
+}
+
+template<class Frame>
+Result measure(uint64_t frames, Frame&& frame) {
+    for (uint64_t f = 0; f < frames / 10; ++f) frame(f);   // warm-up
+    const int64_t cpu0 = Tests::threadCpuNs();
+    const auto t0 = Tests::Clock::now();
+    for (uint64_t f = 0; f < frames; ++f) frame(f);
+    const double n = static_cast<double>(frames);
+    return {static_cast<double>(Tests::threadCpuNs() - cpu0) / 1e3 / n, Tests::nsSince(t0) / 1e3 / n};
+}
+
+// Old path — one VkDeviceMemory per buffer, mapped around every write
+Result runMapUnmap(const Tests::HeadlessVulkan& vk, uint32_t type, bool coherent, uint64_t frames) {
+    std::array<VkBuffer, WRITES.size()> buffers{};
+    std::array<VkDeviceMemory, WRITES.size()> memory{};
+    for (size_t i = 0; i < WRITES.size(); ++i) {
+        buffers[i] = makeBuffer(vk.device, WRITES[i]);
+        VkMemoryRequirements req{};
+        vkGetBufferMemoryRequirements(vk.device, buffers[i], &req);
+        VkMemoryAllocateInfo ai{ .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+        ai.allocationSize  = req.size;
+        ai.memoryTypeIndex = type;
+        vkAllocateMemory(vk.device, &ai, nullptr, &memory[i]);
+        vkBindBufferMemory(vk.device, buffers[i], memory[i], 0);
+    }
+
+    std::array<uint8_t, 1024> payload{};
+    const Result r = measure(frames, [&](uint64_t f) {
+        payload[0] = static_cast<uint8_t>(f);
+        for (size_t i = 0; i < WRITES.size(); ++i) {
+            void* p = nullptr;
+            vkMapMemory(vk.device, memory[i], 0, VK_WHOLE_SIZE, 0, &p);
+            std::memcpy(p, payload.data(), WRITES[i]);
+            if (!coherent) {
+                VkMappedMemoryRange range{ .sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE };
+                range.memory = memory[i];
+                range.size   = VK_WHOLE_SIZE;
+                vkFlushMappedMemoryRanges(vk.device, 1, &range);
+            }
+            vkUnmapMemory(vk.device, memory[i]);
+        }
+    });
+
+    for (size_t i = 0; i < WRITES.size(); ++i) {
+        vkDestroyBuffer(vk.device, buffers[i], nullptr);
+        vkFreeMemory(vk.device, memory[i], nullptr);
+    }
+    return r;
+}
+
+// New path — ranges of one persistently mapped block
+Result runPersistent(const Tests::HeadlessVulkan& vk, VkMemoryPropertyFlags props, uint64_t frames) {
+    RTX::DeviceHeap heap;
+    heap.init(vk.device, vk.physical);
+    std::array<VkBuffer, WRITES.size()> buffers{};
+    std::array<RTX::HeapAllocation, WRITES.size()> allocs{};
+    for (size_t i = 0; i < WRITES.size(); ++i) {
+        buffers[i] = makeBuffer(vk.device, WRITES[i]);
+        VkMemoryRequirements req{};
+        vkGetBufferMemoryRequirements(vk.device, buffers[i], &req);
+        allocs[i] = heap.allocate(req, props, RTX::HeapResource::Linear, "bench");
+        vkBindBufferMemory(vk.device, buffers[i], allocs[i].memory, allocs[i].offset);
+    }
+
+    std::array<uint8_t, 1024> payload{};
+    const Result r = measure(frames, [&](uint64_t f) {
+        payload[0] = static_cast<uint8_t>(f);
+        for (size_t i = 0; i < WRITES.size(); ++i) {
+            std::memcpy(allocs[i].mapped, payload.data(), WRITES[i]);
+            heap.flush(allocs[i], 0, WRITES[i]);
+        }
+    });
+
+    for (size_t i = 0; i < WRITES.size(); ++i) {
+        vkDestroyBuffer(vk.device, buffers[i], nullptr);
+        heap.free(allocs[i]);
+    }
+    heap.releaseAll();
+    return r;
+}
+
+} // namespace
+
+int main() {
+    std::printf("[bench_persistent_map]\n");
+
+    Tests::HeadlessVulkan vk;
+    if (!vk.init()) return Tests::g_failures ? 1 : Tests::SKIP;
+
+    const uint64_t frames = Tests::scaled(FRAMES);
+    std::printf("  %llu frames, %zu host writes each\n", static_cast<unsigned long long>(frames), WRITES.size());
+
+    VkPhysicalDeviceMemoryProperties mem{};
+    vkGetPhysicalDeviceMemoryProperties(vk.physical, &mem);
+    uint32_t measured = 0;
+    for (uint32_t type = 0; type < mem.memoryTypeCount; ++type) {
+        const VkMemoryPropertyFlags flags = mem.memoryTypes[type].propertyFlags;
+        if (!(flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)) continue;
+        // The heap picks the first type with these flags — skip types it would never land on
+        const VkMemoryPropertyFlags props = flags & (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT |
+                                                     VK_MEMORY_PROPERTY_HOST_CACHED_BIT | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        if (vk.memoryType(~0u, props) != type) continue;
+
+        const bool coherent = flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        const Result before = runMapUnmap(vk, type, coherent, frames);
+        const Result after  = runPersistent(vk, props, frames);
+        std::printf("  type %u (%s%s%s)\n", type, coherent ? "coherent" : "non-coherent",
+                    (flags & VK_MEMORY_PROPERTY_HOST_CACHED_BIT) ? ", cached" : "",
+                    (flags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) ? ", device-local" : "");
+        std::printf("    map/unmap   %8.3f us CPU/frame  (%8.3f us wall)\n", before.cpuUsPerFrame, before.wallUsPerFrame);
+        std::printf("    persistent  %8.3f us CPU/frame  (%8.3f us wall)\n", after.cpuUsPerFrame, after.wallUsPerFrame);
+        std::printf("    saved       %8.3f us CPU/frame\n", before.cpuUsPerFrame - after.cpuUsPerFrame);
+        CHECK(after.cpuUsPerFrame >= 0.0 && before.cpuUsPerFrame >= 0.0);
+        ++measured;
+    }
+    CHECK(measured > 0);
+    return Tests::finish("bench_persistent_map");
+}
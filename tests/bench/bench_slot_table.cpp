@@ -0,0 +1,172 @@
+// =============================================================================
+// bench_slot_table.cpp — AMOURANTH RTX Engine © 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. Creative Commons Attribution-NonCommercial 4.0 International (CC BY-NC 4.0)
+//    https://creativecommons.org/licenses/by-nc/4.0/legalcode
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// TRACKER LOOKUP UNDER CONTENTION — SlotTable vs the mutex + unordered_map
+// it replaced. 16 reader threads resolve handles the way RAW_BUFFER does
+// (lookup, read two fields) while one churn thread creates and destroys
+// buffers like a streaming frame. Latency is timed per batch of lookups and
+// reported per lookup: p50 / p99 / max, plus aggregate lookups per second.
+// =============================================================================
+
+#include "TestHarness.hpp"
+#include "engine/GLOBAL/SlotTable.hpp"
+
+#include <latch>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+constexpr unsigned READERS            = 16;
+constexpr uint32_t RESIDENT           = 4096;     // handles that live through the run
+constexpr uint64_t BATCHES_PER_THREAD = 4'000;
+constexpr uint32_t BATCH              = 64;       // lookups per timed sample
+
+// Same shape as the tracker's BufferData, minus the Vulkan types
+struct Entry {
+    uint64_t    buffer = 0;
+    uint64_t    size   = 0;
+    uint64_t    offset = 0;
+    std::string tag;
+};
+
+// What UltraLowLevelBufferTracker looked like before the slot table
+class MutexMap {
+public:
+    uint64_t insert(Entry&& e) {
+        std::lock_guard<std::mutex> lk(mutex_);
+        const uint64_t h = ++counter_;
+        map_.emplace(h, std::move(e));
+        return h;
+    }
+    bool remove(uint64_t h, Entry& out) {
+        std::lock_guard<std::mutex> lk(mutex_);
+        auto it = map_.find(h);
+        if (it == map_.end()) return false;
+        out = std::move(it->second);
+        map_.erase(it);
+        return true;
+    }
+    Entry* lookup(uint64_t h) {
+        std::lock_guard<std::mutex> lk(mutex_);
+        auto it = map_.find(h);
+        return it == map_.end() ? nullptr : &it->second;
+    }
+private:
+    std::mutex mutex_;
+    std::unordered_map<uint64_t, Entry> map_;
+    uint64_t counter_ = 0;
+};
+
+struct Result {
+    Tests::Percentiles latency;   // ns per lookup
+    double seconds = 0.0;
+    uint64_t lookups = 0;
+    uint64_t misses  = 0;
+    uint64_t churned = 0;
+};
+
+Entry makeEntry(uint64_t i) { return {0x1000 + i, 256 * (i % 97 + 1), 0, "Bench_Buffer"}; }
+
+template<class Table>
+Result run(Table& table, uint64_t batches) {
+    std::vector<uint64_t> resident(RESIDENT);
+    for (uint32_t i = 0; i < RESIDENT; ++i) resident[i] = table.insert(makeEntry(i));
+
+    std::vector<std::vector<double>> samples(READERS);
+    std::vector<uint64_t> misses(READERS, 0);
+    std::vector<uint64_t> checksums(READERS, 0);
+    std::latch go(READERS + 1);
+    std::atomic<bool> done{false};
+    uint64_t churned = 0;
+
+    // Create/destroy pressure — the lookups share the table with it
+    std::jthread churn([&] {
+        std::vector<uint64_t> mine;
+        mine.reserve(64);
+        go.arrive_and_wait();
+        Entry out;
+        for (uint64_t i = 0; !done.load(std::memory_order_acquire); ++i) {
+            mine.push_back(table.insert(makeEntry(RESIDENT + i)));
+            if (mine.size() == 64) {
+                for (uint64_t h : mine) table.remove(h, out);
+                mine.clear();
+            }
+            ++churned;
+        }
+        for (uint64_t h : mine) table.remove(h, out);
+    });
+
+    std::vector<std::jthread> readers;
+    for (unsigned t = 0; t < READERS; ++t)
+        readers.emplace_back([&, t] {
+            auto& mine = samples[t];
+            mine.reserve(batches);
+            uint32_t cursor = t * 131;
+            uint64_t sum = 0;
+            go.arrive_and_wait();
+            for (uint64_t b = 0; b < batches; ++b) {
+                const auto t0 = Tests::Clock::now();
+                for (uint32_t k = 0; k < BATCH; ++k) {
+                    cursor = (cursor + 2654435761u) % RESIDENT;
+                    if (const Entry* e = table.lookup(resident[cursor])) sum += e->buffer + e->offset;
+                    else ++misses[t];
+                }
+                mine.push_back(Tests::nsSince(t0) / BATCH);
+            }
+            checksums[t] = sum;
+        });
+
+    const auto start = Tests::Clock::now();
+    readers.clear();
+    const double seconds = Tests::nsSince(start) / 1e9;
+    done.store(true, std::memory_order_release);
+    churn.join();
+
+    Entry out;
+    for (uint64_t h : resident) table.remove(h, out);
+
+    std::vector<double> all;
+    all.reserve(static_cast<size_t>(READERS) * batches);
+    for (auto& s : samples) all.insert(all.end(), s.begin(), s.end());
+    uint64_t missed = 0;
+    for (uint64_t m : misses) missed += m;
+    return {Tests::percentiles(all), seconds, static_cast<uint64_t>(READERS) * batches * BATCH, missed, churned};
+}
+
+void report(const char* name, const Result& r) {
+    std::printf("  %-16s p50 %7.1f ns  p99 %8.1f ns  max %9.1f ns  %8.1f M lookups/s  (%llu create/destroy alongside)\n",
+                name, r.latency.p50, r.latency.p99, r.latency.max,
+                static_cast<double>(r.lookups) / r.seconds / 1e6, static_cast<unsigned long long>(r.churned));
+}
+
+} // namespace
+
+int main() {
+    const uint64_t batches = Tests::scaled(BATCHES_PER_THREAD);
+    std::printf("[bench_slot_table] %u readers x %llu x %u lookups, %u resident handles, 1 churn thread\n",
+                READERS, static_cast<unsigned long long>(batches), BATCH, RESIDENT);
+
+    auto slots = std::make_unique<RTX::SlotTable<Entry>>();
+    const Result slot = run(*slots, batches);
+    MutexMap map;
+    const Result locked = run(map, batches);
+    report("SlotTable", slot);
+    report("mutex+map", locked);
+    std::printf("  p50 speedup %.1fx, p99 speedup %.1fx\n",
+                locked.latency.p50 / slot.latency.p50, locked.latency.p99 / slot.latency.p99);
+
+    // Resident handles never go stale, whatever the churn does
+    CHECK_EQ(slot.misses, 0u);
+    CHECK_EQ(locked.misses, 0u);
+    CHECK_EQ(slots->size(), 0u);
+    return Tests::finish("bench_slot_table");
+}
@@ -0,0 +1,293 @@
+// =============================================================================
+// test_blas_batch.cpp — AMOURANTH RTX Engine © 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. Creative Commons Attribution-NonCommercial 4.0 International (CC BY-NC 4.0)
+//    https://creativecommons.org/licenses/by-nc/4.0/legalcode
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// 1000 BLAS THROUGH ONE SCRATCH ARENA ON A HEADLESS DEVICE (lavapipe picked
+// when present; skipped without VK_KHR_acceleration_structure)
+//   The scene-load path of VulkanAccel::createBLASBatch, minus the engine
+//   context: ScratchPlan::pack with a budget small enough to force many
+//   batches, recordBuildBatches() into one command buffer, one compaction
+//   query pool of 1000 queries from recordCompactedSizes(), one submit.
+//   • every query comes back non-zero and no larger than the build
+//   • a sample of meshes rebuilt alone, each with its own scratch, report
+//     the same compacted size — batches sharing the arena didn't clobber
+//     each other (checked on CPU devices, whose builders are deterministic;
+//     reported elsewhere)
+// =============================================================================
+
+#include "TestHarness.hpp"
+#include "HeadlessVulkan.hpp"
+#include "engine/GLOBAL/AccelBatch.hpp"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t     MESHES        = 1000;
+constexpr uint32_t     MAX_TRIS      = 64;
+constexpr VkDeviceSize BUDGET        = 256u << 10;   // far under the engine's — many batches
+constexpr VkDeviceSize AS_ALIGN      = 256;          // acceleration structure offsets
+constexpr uint32_t     SAMPLE_STRIDE = 97;           // meshes rebuilt alone
+
+struct Pfn {
+    PFN_vkGetAccelerationStructureBuildSizesKHR          sizes  = nullptr;
+    PFN_vkCreateAccelerationStructureKHR                 create = nullptr;
+    PFN_vkDestroyAccelerationStructureKHR                destroy = nullptr;
+    PFN_vkCmdBuildAccelerationStructuresKHR              build  = nullptr;
+    PFN_vkCmdWriteAccelerationStructuresPropertiesKHR    write  = nullptr;
+
+    [[nodiscard]] bool load(VkDevice d) {
+        sizes   = reinterpret_cast<PFN_vkGetAccelerationStructureBuildSizesKHR>(vkGetDeviceProcAddr(d, "vkGetAccelerationStructureBuildSizesKHR"));
+        create  = reinterpret_cast<PFN_vkCreateAccelerationStructureKHR>(vkGetDeviceProcAddr(d, "vkCreateAccelerationStructureKHR"));
+        destroy = reinterpret_cast<PFN_vkDestroyAccelerationStructureKHR>(vkGetDeviceProcAddr(d, "vkDestroyAccelerationStructureKHR"));
+        build   = reinterpret_cast<PFN_vkCmdBuildAccelerationStructuresKHR>(vkGetDeviceProcAddr(d, "vkCmdBuildAccelerationStructuresKHR"));
+        write   = reinterpret_cast<PFN_vkCmdWriteAccelerationStructuresPropertiesKHR>(vkGetDeviceProcAddr(d, "vkCmdWriteAccelerationStructuresPropertiesKHR"));
+        return sizes && create && destroy && build && write;
+    }
+};
+
+struct Buffer {
+    VkBuffer        buffer  = VK_NULL_HANDLE;
+    VkDeviceMemory  memory  = VK_NULL_HANDLE;
+    VkDeviceAddress address = 0;
+    void*           mapped  = nullptr;
+};
+
+[[nodiscard]] Buffer makeBuffer(const Tests::HeadlessVulkan& vk, VkDeviceSize size, VkBufferUsageFlags usage,
+                                VkMemoryPropertyFlags props) {
+    Buffer b;
+    VkBufferCreateInfo bi{ .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+    bi.size        = size;
+    bi.usage       = usage | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    bi.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateBuffer(vk.device, &bi, nullptr, &b.buffer) != VK_SUCCESS) return {};
+
+    VkMemoryRequirements req{};
+    vkGetBufferMemoryRequirements(vk.device, b.buffer, &req);
+    VkMemoryAllocateFlagsInfo flags{ .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO };
+    flags.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+    VkMemoryAllocateInfo ai{ .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, .pNext = &flags };
+    ai.allocationSize  = req.size;
+    ai.memoryTypeIndex = vk.memoryType(req.memoryTypeBits, props);
+    if (ai.memoryTypeIndex == UINT32_MAX || vkAllocateMemory(vk.device, &ai, nullptr, &b.memory) != VK_SUCCESS) {
+        vkDestroyBuffer(vk.device, b.buffer, nullptr);
+        return {};
+    }
+    vkBindBufferMemory(vk.device, b.buffer, b.memory, 0);
+    if (props & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) vkMapMemory(vk.device, b.memory, 0, VK_WHOLE_SIZE, 0, &b.mapped);
+
+    VkBufferDeviceAddressInfo info{ .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO };
+    info.buffer = b.buffer;
+    b.address = vkGetBufferDeviceAddress(vk.device, &info);
+    return b;
+}
+
+void release(const Tests::HeadlessVulkan& vk, Buffer& b) {
+    if (b.buffer) vkDestroyBuffer(vk.device, b.buffer, nullptr);
+    if (b.memory) vkFreeMemory(vk.device, b.memory, nullptr);
+    b = {};
+}
+
+[[nodiscard]] VkDeviceSize aligned(VkDeviceSize v, VkDeviceSize a) { return (v + a - 1) & ~(a - 1); }
+
+// Every mesh: a random triangle soup of 1..MAX_TRIS triangles, unindexed vertices
+struct Scene {
+    std::vector<uint32_t> tris, firstVertex;
+    uint32_t vertexCount = 0;
+};
+
+[[nodiscard]] Scene makeScene() {
+    Scene s;
+    std::mt19937 rng(1000);
+    s.tris.resize(MESHES);
+    s.firstVertex.resize(MESHES);
+    for (uint32_t i = 0; i < MESHES; ++i) {
+        s.tris[i] = 1 + rng() % MAX_TRIS;
+        s.firstVertex[i] = s.vertexCount;
+        s.vertexCount += s.tris[i] * 3;
+    }
+    return s;
+}
+
+struct Build {
+    VkAccelerationStructureGeometryKHR          geometry{ .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR };
+    VkAccelerationStructureBuildRangeInfoKHR    range{};
+    VkAccelerationStructureBuildGeometryInfoKHR info{ .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR };
+    VkAccelerationStructureBuildSizesInfoKHR    sizes{ .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR };
+    VkAccelerationStructureKHR                  as = VK_NULL_HANDLE;
+};
+
+// Describes mesh i and sizes it; geometry lives in `b`, so b must not move afterwards
+void describe(VkDevice device, const Pfn& fn, const Scene& scene, const Buffer& geometry, uint32_t i, Build& b) {
+    auto& tri = b.geometry.geometry.triangles;
+    b.geometry.geometryType = VK_GEOMETRY_TYPE_TRIANGLES_KHR;
+    b.geometry.flags        = VK_GEOMETRY_OPAQUE_BIT_KHR;
+    tri.sType               = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_TRIANGLES_DATA_KHR;
+    tri.vertexFormat        = VK_FORMAT_R32G32B32_SFLOAT;
+    tri.vertexStride        = 3 * sizeof(float);
+    tri.vertexData.deviceAddress = geometry.address + scene.firstVertex[i] * tri.vertexStride;
+    tri.maxVertex           = scene.tris[i] * 3 - 1;
+    tri.indexType           = VK_INDEX_TYPE_NONE_KHR;
+    b.range.primitiveCount  = scene.tris[i];
+
+    b.info.type          = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+    b.info.flags         = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR;
+    b.info.mode          = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+    b.info.geometryCount = 1;
+    b.info.pGeometries   = &b.geometry;
+    fn.sizes(device, VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR, &b.info, &b.range.primitiveCount, &b.sizes);
+}
+
+[[nodiscard]] bool createAS(VkDevice device, const Pfn& fn, VkBuffer storage, VkDeviceSize offset, Build& b) {
+    VkAccelerationStructureCreateInfoKHR ci{ .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR };
+    ci.buffer = storage;
+    ci.offset = offset;
+    ci.size   = b.sizes.accelerationStructureSize;
+    ci.type   = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+    if (fn.create(device, &ci, nullptr, &b.as) != VK_SUCCESS) return false;
+    b.info.dstAccelerationStructure = b.as;
+    return true;
+}
+
+[[nodiscard]] bool readSizes(VkDevice device, VkQueryPool pool, std::vector<VkDeviceSize>& out) {
+    return vkGetQueryPoolResults(device, pool, 0, static_cast<uint32_t>(out.size()), out.size() * sizeof(VkDeviceSize),
+                                 out.data(), sizeof(VkDeviceSize), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT) == VK_SUCCESS;
+}
+
+// Mesh i alone — its own storage, its own scratch, its own submit
+[[nodiscard]] VkDeviceSize buildAlone(const Tests::HeadlessVulkan& vk, const Pfn& fn, const Scene& scene,
+                                      const Buffer& geometry, uint32_t i) {
+    Build b;
+    describe(vk.device, fn, scene, geometry, i, b);
+    Buffer storage = makeBuffer(vk, b.sizes.accelerationStructureSize, VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR,
+                                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    Buffer scratch = makeBuffer(vk, b.sizes.buildScratchSize + AS_ALIGN, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    VkDeviceSize compacted = 0;
+    if (storage.buffer && scratch.buffer && createAS(vk.device, fn, storage.buffer, 0, b)) {
+        b.info.scratchData.deviceAddress = aligned(scratch.address, AS_ALIGN);
+        const VkAccelerationStructureBuildRangeInfoKHR* range = &b.range;
+        VkCommandBuffer cmd = vk.begin();
+        fn.build(cmd, 1, &b.info, &range);
+        accelBuildBarrier(cmd);
+        const VkQueryPool pool = recordCompactedSizes(vk.device, cmd, fn.write, { &b.as, 1 });
+        std::vector<VkDeviceSize> size(1);
+        if (vk.submitAndWait(cmd) && pool && readSizes(vk.device, pool, size)) compacted = size[0];
+        if (pool) vkDestroyQueryPool(vk.device, pool, nullptr);
+        fn.destroy(vk.device, b.as, nullptr);
+    }
+    release(vk, scratch);
+    release(vk, storage);
+    return compacted;
+}
+
+} // namespace
+
+int main() {
+    std::printf("[test_blas_batch]\n");
+
+    Tests::HeadlessVulkan vk;
+    if (!vk.init({ .accelerationStructure = true })) return Tests::g_failures ? 1 : Tests::SKIP;
+    Pfn fn;
+    REQUIRE(fn.load(vk.device));
+
+    VkPhysicalDeviceAccelerationStructurePropertiesKHR asProps{ .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_PROPERTIES_KHR };
+    VkPhysicalDeviceProperties2 props2{ .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2, .pNext = &asProps };
+    vkGetPhysicalDeviceProperties2(vk.physical, &props2);
+    const VkDeviceSize scratchAlign = asProps.minAccelerationStructureScratchOffsetAlignment;
+
+    // ── Geometry: every mesh's triangles in one host-visible buffer
+    const Scene scene = makeScene();
+    Buffer geometry = makeBuffer(vk, scene.vertexCount * 3 * sizeof(float),
+                                 VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR,
+                                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    REQUIRE(geometry.mapped);
+    {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> pos(-10.0f, 10.0f);
+        auto* f = static_cast<float*>(geometry.mapped);
+        for (uint32_t v = 0; v < scene.vertexCount * 3; ++v) f[v] = pos(rng);
+    }
+
+    // ── Size everything, one storage buffer for all 1000 structures
+    std::vector<Build> builds(MESHES);
+    std::vector<VkDeviceSize> scratchSizes(MESHES), storageOffsets(MESHES);
+    VkDeviceSize storageSize = 0;
+    for (uint32_t i = 0; i < MESHES; ++i) {
+        describe(vk.device, fn, scene, geometry, i, builds[i]);
+        scratchSizes[i]   = builds[i].sizes.buildScratchSize;
+        storageOffsets[i] = storageSize;
+        storageSize = aligned(storageSize + builds[i].sizes.accelerationStructureSize, AS_ALIGN);
+    }
+    Buffer storage = makeBuffer(vk, storageSize, VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR,
+                                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    REQUIRE(storage.buffer);
+    for (uint32_t i = 0; i < MESHES; ++i) REQUIRE(createAS(vk.device, fn, storage.buffer, storageOffsets[i], builds[i]));
+
+    // ── The plan, one arena, one submit
+    const ScratchPlan plan = ScratchPlan::pack(scratchSizes, scratchAlign, BUDGET);
+    CHECK(plan.batchCount() > 1);
+    Buffer arena = makeBuffer(vk, plan.arenaSize + scratchAlign, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                              VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    REQUIRE(arena.buffer);
+
+    std::vector<VkAccelerationStructureBuildGeometryInfoKHR> infos(MESHES);
+    std::vector<const VkAccelerationStructureBuildRangeInfoKHR*> ranges(MESHES);
+    std::vector<VkAccelerationStructureKHR> structures(MESHES);
+    for (uint32_t i = 0; i < MESHES; ++i) {
+        infos[i]      = builds[i].info;
+        ranges[i]     = &builds[i].range;
+        structures[i] = builds[i].as;
+    }
+
+    const auto t0 = Tests::Clock::now();
+    VkCommandBuffer cmd = vk.begin();
+    recordBuildBatches(cmd, fn.build, plan, aligned(arena.address, scratchAlign), infos, ranges);
+    accelBuildBarrier(cmd);
+    const VkQueryPool queries = recordCompactedSizes(vk.device, cmd, fn.write, structures);
+    CHECK(queries != VK_NULL_HANDLE);
+    REQUIRE(vk.submitAndWait(cmd));
+    const double ms = Tests::nsSince(t0) / 1e6;
+
+    std::vector<VkDeviceSize> compacted(MESHES);
+    REQUIRE(queries && readSizes(vk.device, queries, compacted));
+    vkDestroyQueryPool(vk.device, queries, nullptr);
+
+    std::printf("  %u BLAS, %u batches, arena %llu bytes (budget %llu), one submit %.1f ms\n",
+                MESHES, plan.batchCount(), static_cast<unsigned long long>(plan.arenaSize),
+                static_cast<unsigned long long>(BUDGET), ms);
+
+    VkDeviceSize built = 0, shrunk = 0;
+    for (uint32_t i = 0; i < MESHES; ++i) {
+        CHECK(compacted[i] > 0);
+        CHECK(compacted[i] <= builds[i].sizes.accelerationStructureSize);
+        built  += builds[i].sizes.accelerationStructureSize;
+        shrunk += compacted[i];
+    }
+    std::printf("  compacted %llu → %llu bytes\n", static_cast<unsigned long long>(built), static_cast<unsigned long long>(shrunk));
+
+    // ── Shared arena vs a scratch of its own
+    const bool deterministic = vk.props.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU;
+    uint32_t sampled = 0, differing = 0;
+    for (uint32_t i = 0; i < MESHES; i += SAMPLE_STRIDE) {
+        const VkDeviceSize alone = buildAlone(vk, fn, scene, geometry, i);
+        CHECK(alone > 0);
+        if (alone != compacted[i]) ++differing;
+        ++sampled;
+    }
+    std::printf("  %u meshes rebuilt alone, %u compacted sizes differ%s\n", sampled, differing,
+                deterministic ? "" : " (not checked on this device)");
+    if (deterministic) CHECK_EQ(differing, 0u);
+
+    for (Build& b : builds) fn.destroy(vk.device, b.as, nullptr);
+    release(vk, arena);
+    release(vk, storage);
+    release(vk, geometry);
+    return Tests::finish("test_blas_batch");
+}
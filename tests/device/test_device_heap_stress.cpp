@@ -0,0 +1,207 @@
+// =============================================================================
+// test_device_heap_stress.cpp — AMOURANTH RTX Engine © 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. Creative Commons Attribution-NonCommercial 4.0 International (CC BY-NC 4.0)
+//    https://creativecommons.org/licenses/by-nc/4.0/legalcode
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// DeviceHeap UNDER CHURN ON A HEADLESS DEVICE (lavapipe picked when present)
+//   • a few thousand real buffers cost a handful of vkAllocateMemory calls —
+//     blocks + dedicated, never one per buffer
+//   • freeing a random 70% leaves holes; refilling with the same sizes reuses
+//     them without a new block
+//   • relocation the way the tracker's defragment() does it: allocate with
+//     excludeBlock, copy (source has TRANSFER_SRC), free the old range — the
+//     sparsest block empties and the bytes survive the move
+//   • everything freed → no sub-allocations, at most one spare block per type;
+//     releaseAll() → no device memory left
+// =============================================================================
+
+#include "TestHarness.hpp"
+#include "HeadlessVulkan.hpp"
+#include "engine/GLOBAL/DeviceHeap.hpp"
+
+#include <algorithm>
+#include <random>
+
+namespace {
+
+constexpr uint32_t     BUFFERS  = 3000;
+constexpr VkDeviceSize MIN_SIZE = 4u << 10;
+constexpr VkDeviceSize MAX_SIZE = 128u << 10;
+constexpr double       FREE_FRACTION = 0.7;
+
+constexpr VkBufferUsageFlags USAGE = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                                     VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+constexpr VkMemoryPropertyFlags PROPS = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+struct Live {
+    VkBuffer            buffer = VK_NULL_HANDLE;
+    VkDeviceSize        size   = 0;
+    RTX::HeapAllocation alloc{};
+    uint32_t            stamp  = 0;
+};
+
+[[nodiscard]] bool make(const Tests::HeadlessVulkan& vk, RTX::DeviceHeap& heap, VkDeviceSize size, uint32_t stamp,
+                        Live& out, uint32_t excludeBlock = UINT32_MAX) {
+    VkBufferCreateInfo bi{ .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+    bi.size        = size;
+    bi.usage       = USAGE;
+    bi.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateBuffer(vk.device, &bi, nullptr, &out.buffer) != VK_SUCCESS) return false;
+    VkMemoryRequirements req{};
+    vkGetBufferMemoryRequirements(vk.device, out.buffer, &req);
+    out.alloc = heap.allocate(req, PROPS, RTX::HeapResource::Linear, "stress", excludeBlock);
+    if (!out.alloc.valid() || vkBindBufferMemory(vk.device, out.buffer, out.alloc.memory, out.alloc.offset) != VK_SUCCESS) {
+        heap.free(out.alloc);
+        vkDestroyBuffer(vk.device, out.buffer, nullptr);
+        return false;
+    }
+    out.size  = size;
+    out.stamp = stamp;
+    return true;
+}
+
+void release(const Tests::HeadlessVulkan& vk, RTX::DeviceHeap& heap, Live& l) {
+    vkDestroyBuffer(vk.device, l.buffer, nullptr);
+    heap.free(l.alloc);
+    l = {};
+}
+
+void fill(const Live& l) {
+    auto* words = static_cast<uint32_t*>(l.alloc.mapped);
+    for (VkDeviceSize i = 0; i < l.size / sizeof(uint32_t); ++i) words[i] = l.stamp ^ static_cast<uint32_t>(i);
+}
+
+[[nodiscard]] bool intact(const Live& l) {
+    const auto* words = static_cast<const uint32_t*>(l.alloc.mapped);
+    for (VkDeviceSize i = 0; i < l.size / sizeof(uint32_t); ++i)
+        if (words[i] != (l.stamp ^ static_cast<uint32_t>(i))) return false;
+    return true;
+}
+
+void print(const char* when, const RTX::HeapStats& s) {
+    std::printf("  %-10s %4llu vkAllocateMemory (%llu blocks + %llu dedicated) | %5llu sub-allocations | "
+                "%7.1f / %7.1f MB | fragmentation %5.1f%%\n",
+                when, static_cast<unsigned long long>(s.deviceAllocations), static_cast<unsigned long long>(s.blocks),
+                static_cast<unsigned long long>(s.dedicated), static_cast<unsigned long long>(s.subAllocations),
+                s.usedBytes / 1048576.0, s.reservedBytes / 1048576.0, s.fragmentation * 100.0);
+}
+
+} // namespace
+
+int main() {
+    std::printf("[test_device_heap_stress]\n");
+
+    Tests::HeadlessVulkan vk;
+    if (!vk.init()) return Tests::g_failures ? 1 : Tests::SKIP;
+
+    RTX::DeviceHeap heap;
+    heap.init(vk.device, vk.physical);
+
+    const uint32_t count = static_cast<uint32_t>(Tests::scaled(BUFFERS));
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<VkDeviceSize> sizes(MIN_SIZE / 256, MAX_SIZE / 256);
+
+    // ── Fill ────────────────────────────────────────────────────────────────
+    std::vector<Live> live(count);
+    VkDeviceSize requested = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        REQUIRE(make(vk, heap, sizes(rng) * 256, i, live[i]));
+        REQUIRE(live[i].alloc.mapped != nullptr);
+        fill(live[i]);
+        requested += live[i].size;
+    }
+    const RTX::HeapStats full = heap.stats();
+    print("filled", full);
+    CHECK_EQ(full.subAllocations + full.dedicated, static_cast<uint64_t>(count));
+    CHECK(full.usedBytes >= requested);
+    CHECK(full.deviceAllocations * 100 <= count);   // ≥ 100 buffers per vkAllocateMemory
+    CHECK(full.deviceAllocations < vk.props.limits.maxMemoryAllocationCount);
+
+    // ── Punch holes ─────────────────────────────────────────────────────────
+    std::vector<uint32_t> order(count);
+    for (uint32_t i = 0; i < count; ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+    const uint32_t freed = static_cast<uint32_t>(count * FREE_FRACTION);
+    std::vector<VkDeviceSize> freedSizes;
+    freedSizes.reserve(freed);
+    for (uint32_t k = 0; k < freed; ++k) {
+        freedSizes.push_back(live[order[k]].size);
+        release(vk, heap, live[order[k]]);
+    }
+    const RTX::HeapStats holed = heap.stats();
+    print("holed", holed);
+    CHECK_EQ(holed.subAllocations + holed.dedicated, static_cast<uint64_t>(count - freed));
+    CHECK(holed.blocks <= full.blocks);
+    CHECK(holed.fragmentation > 0.0);
+
+    // ── Refill the same sizes — TLSF reuses the holes, no new block ─────────
+    for (uint32_t k = 0; k < freed; ++k) {
+        Live& slot = live[order[k]];
+        REQUIRE(make(vk, heap, freedSizes[k], count + k, slot));
+        fill(slot);
+    }
+    const RTX::HeapStats refilled = heap.stats();
+    print("refilled", refilled);
+    CHECK_EQ(refilled.subAllocations + refilled.dedicated, static_cast<uint64_t>(count));
+    CHECK(refilled.blocks <= full.blocks);
+
+    // ── Thin out again, then relocate the sparsest block's survivors ────────
+    for (uint32_t k = 0; k < freed; ++k) release(vk, heap, live[order[k]]);
+    const uint32_t sparse = heap.sparsestBlock();
+    const RTX::HeapStats before = heap.stats();
+    if (sparse == UINT32_MAX) {
+        std::printf("  every buffer landed in one block — nothing to relocate\n");
+    } else {
+        std::vector<std::pair<Live, Live>> moves;
+        for (Live& l : live) {
+            if (!l.buffer || l.alloc.block != sparse) continue;
+            Live fresh;
+            REQUIRE(make(vk, heap, l.size, l.stamp, fresh, sparse));
+            CHECK(fresh.alloc.block != sparse);
+            moves.emplace_back(l, fresh);
+        }
+        VkCommandBuffer cmd = vk.begin();
+        for (const auto& [from, to] : moves) {
+            const VkBufferCopy region{ 0, 0, from.size };
+            vkCmdCopyBuffer(cmd, from.buffer, to.buffer, 1, &region);
+        }
+        REQUIRE(vk.submitAndWait(cmd));
+
+        uint32_t corrupted = 0;
+        for (auto& [from, to] : moves) {
+            if (!intact(to)) ++corrupted;
+            for (Live& l : live)
+                if (l.buffer == from.buffer) { release(vk, heap, l); l = to; break; }
+        }
+        CHECK_EQ(corrupted, 0u);
+        const RTX::HeapStats after = heap.stats();
+        std::printf("  relocated %zu buffer(s) out of block #%u\n", moves.size(), sparse);
+        print("relocated", after);
+        CHECK_EQ(after.subAllocations, before.subAllocations);
+        CHECK(after.blocks <= before.blocks + 1);   // at most one fresh block to land in
+        CHECK(std::none_of(live.begin(), live.end(), [&](const Live& l) { return l.buffer && l.alloc.block == sparse; }));
+    }
+
+    // ── Survivors still hold their bytes ────────────────────────────────────
+    uint32_t damaged = 0;
+    for (const Live& l : live)
+        if (l.buffer && !intact(l)) ++damaged;
+    CHECK_EQ(damaged, 0u);
+
+    // ── Drain ───────────────────────────────────────────────────────────────
+    for (Live& l : live)
+        if (l.buffer) release(vk, heap, l);
+    const RTX::HeapStats empty = heap.stats();
+    print("empty", empty);
+    CHECK_EQ(empty.subAllocations, 0u);
+    CHECK_EQ(empty.dedicated, 0u);
+    CHECK(empty.blocks <= 1);   // one spare per (type, kind) absorbs churn
+    heap.releaseAll();
+    CHECK_EQ(heap.stats().deviceAllocations, 0u);
+
+    return Tests::finish("test_device_heap_stress");
+}
@@ -0,0 +1,131 @@
+// =============================================================================
+// test_gpu_profiler.cpp — AMOURANTH RTX Engine © 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. Creative Commons Attribution-NonCommercial 4.0 International (CC BY-NC 4.0)
+//    https://creativecommons.org/licenses/by-nc/4.0/legalcode
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// GpuProfiler ON A HEADLESS DEVICE — it must degrade, never break the frame
+//   • never initialised / no timestamp-capable family → every call a no-op,
+//     collect() false, stats empty, command buffers still submit
+//   • a family with timestampValidBits == 0 in the set disables it
+//   • where timestamps work (lavapipe does): passes that were recorded get
+//     samples, passes that were not stay empty, a slot that never began
+//     collects nothing
+//   • destroy() mid-run returns recording to the no-op state
+// =============================================================================
+
+#include "TestHarness.hpp"
+#include "HeadlessVulkan.hpp"
+#include "engine/GLOBAL/GpuProfiler.hpp"
+
+namespace {
+
+constexpr uint32_t FRAMES_IN_FLIGHT = Options::Performance::MAX_FRAMES_IN_FLIGHT;
+constexpr uint32_t FRAMES           = 12;
+
+void expectNoOp(GpuProfiler& prof, const Tests::HeadlessVulkan* vk) {
+    CHECK(!prof.enabled());
+    VkCommandBuffer cmd = vk ? vk->begin() : VK_NULL_HANDLE;
+    prof.beginFrame(cmd, 0, 1);
+    prof.begin(cmd, 0, GpuPass::RayTrace);
+    prof.end(cmd, 0, GpuPass::RayTrace);
+    if (vk) CHECK(vk->submitAndWait(cmd));
+    CHECK(!prof.collect(0));
+    CHECK_EQ(prof.stats(GpuPass::RayTrace).samples, 0u);
+    CHECK(prof.lastFrameMs() == 0.0);
+}
+
+[[nodiscard]] uint32_t familyWithoutTimestamps(VkPhysicalDevice pd) {
+    uint32_t n = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(pd, &n, nullptr);
+    std::vector<VkQueueFamilyProperties> families(n);
+    vkGetPhysicalDeviceQueueFamilyProperties(pd, &n, families.data());
+    for (uint32_t i = 0; i < n; ++i)
+        if (families[i].timestampValidBits == 0) return i;
+    return UINT32_MAX;
+}
+
+} // namespace
+
+int main() {
+    std::printf("[test_gpu_profiler]\n");
+
+    // No device at all
+    {
+        GpuProfiler prof;
+        expectNoOp(prof, nullptr);
+    }
+
+    Tests::HeadlessVulkan vk;
+    if (!vk.init()) return Tests::g_failures ? 1 : Tests::SKIP;
+
+    // No queue family given → narrowest validBits is 0
+    {
+        GpuProfiler prof;
+        prof.init(vk.device, vk.physical, {}, FRAMES_IN_FLIGHT, vk.synchronization2);
+        expectNoOp(prof, &vk);
+    }
+
+    // A family without timestamps anywhere in the set wins
+    if (const uint32_t bare = familyWithoutTimestamps(vk.physical); bare != UINT32_MAX) {
+        GpuProfiler prof;
+        const uint32_t families[] = {vk.family, bare};
+        prof.init(vk.device, vk.physical, families, FRAMES_IN_FLIGHT, vk.synchronization2);
+        expectNoOp(prof, &vk);
+    }
+
+    // The real family
+    GpuProfiler prof;
+    const uint32_t families[] = {vk.family};
+    prof.init(vk.device, vk.physical, families, FRAMES_IN_FLIGHT, vk.synchronization2);
+    if (!prof.enabled()) {
+        std::printf("  %s has no usable timestamps — checking the disabled path only\n", vk.props.deviceName);
+        expectNoOp(prof, &vk);
+        return Tests::finish("test_gpu_profiler");
+    }
+
+    CHECK(!prof.collect(1));   // slot never began
+    for (uint32_t f = 0; f < FRAMES; ++f) {
+        const uint32_t idx = f % FRAMES_IN_FLIGHT;
+        VkCommandBuffer cmd = vk.begin();
+        prof.beginFrame(cmd, idx, f);
+        prof.begin(cmd, idx, GpuPass::RayTrace);
+        prof.end(cmd, idx, GpuPass::RayTrace);
+        prof.begin(cmd, idx, GpuPass::Tonemap);
+        prof.end(cmd, idx, GpuPass::Tonemap);
+        REQUIRE(vk.submitAndWait(cmd));
+        CHECK(prof.collect(idx));
+        CHECK(!prof.collect(idx));   // harvested once
+    }
+
+    const GpuProfiler::Stats rt = prof.stats(GpuPass::RayTrace);
+    CHECK_EQ(rt.samples, FRAMES);
+    CHECK(rt.minMs >= 0.0 && rt.minMs <= rt.avgMs && rt.avgMs <= rt.p99Ms);
+    CHECK_EQ(prof.stats(GpuPass::Tonemap).samples, FRAMES);
+    CHECK_EQ(prof.stats(GpuPass::Denoise).samples, 0u);
+    CHECK(prof.lastFrameMs() >= 0.0);
+    std::printf("  RayTrace bracket: avg %.4f ms, frame span %.4f ms\n", rt.avgMs, prof.lastFrameMs());
+
+    // A frame that began but recorded no pass collects nothing measurable
+    {
+        VkCommandBuffer cmd = vk.begin();
+        prof.beginFrame(cmd, 0, FRAMES);
+        REQUIRE(vk.submitAndWait(cmd));
+        CHECK(!prof.collect(0));
+        CHECK_EQ(prof.stats(GpuPass::RayTrace).samples, FRAMES);
+    }
+
+    // History survives destroy(); recording and collecting do not
+    prof.destroy();
+    CHECK(!prof.enabled());
+    VkCommandBuffer cmd = vk.begin();
+    prof.beginFrame(cmd, 0, FRAMES + 1);
+    prof.begin(cmd, 0, GpuPass::RayTrace);
+    prof.end(cmd, 0, GpuPass::RayTrace);
+    REQUIRE(vk.submitAndWait(cmd));
+    CHECK(!prof.collect(0));
+    return Tests::finish("test_gpu_profiler");
+}
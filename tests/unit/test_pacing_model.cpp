@@ -0,0 +1,263 @@
+// =============================================================================
+// test_pacing_model.cpp — AMOURANTH RTX Engine © 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. Creative Commons Attribution-NonCommercial 4.0 International (CC BY-NC 4.0)
+//    https://creativecommons.org/licenses/by-nc/4.0/legalcode
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// PACING HARNESS — PacingModel driven by a simulated CPU, GPU and display
+// on a virtual clock, the way FramePacer drives it (no Vulkan, no sleeping):
+//   pace()    wait for frame N−queueDepth on the display (present_wait),
+//             observe it, sleep until plan(N)
+//   submit    after the frame's CPU time; the GPU queues behind earlier work
+//   display   FIFO — first vblank at or after GPU completion, one per vblank
+// Scenarios and what the latency target means in each:
+//   steady    CPU+GPU well inside a period: every vblank gets a new frame and
+//             input→photon latency ≈ the predicted budget, far below the
+//             unpaced loop (acquire-limited, ~3 frames of queue)
+//   overload  CPU+GPU > a period, each < a period: queue depth 2, the rate
+//             holds at one frame per vblank instead of halving
+//   spike     one 40 ms CPU frame: counted as missed, grid re-phased onto the
+//             next reachable vblank, and the hitch doesn't inflate the budget —
+//             latency back on target the frame after
+//   step      load jumps from the steady to the overload case and stays: the
+//             model follows it to queue depth 2 within a bounded number of frames
+//   timer     no present_wait: grid free-runs on the clock, frames leave one
+//             period apart and finish by their deadline
+// =============================================================================
+
+#include "TestHarness.hpp"
+#include "engine/GLOBAL/FramePacer.hpp"
+
+#include <random>
+
+namespace {
+
+constexpr int64_t MS       = 1'000'000;
+constexpr int64_t P60      = 1'000'000'000 / 60;
+constexpr int64_t MARGIN   = MS / 2;                   // Options::Performance::FRAME_PACING_MARGIN_MS
+constexpr uint32_t WARMUP  = 120;
+constexpr uint32_t FRAMES  = 600;
+constexpr uint32_t FRAMES_IN_FLIGHT = 3;               // unpaced baseline: swapchain images ahead
+
+struct Load {
+    int64_t cpu = 0, cpuJitter = 0;
+    int64_t gpu = 0, gpuJitter = 0;
+};
+
+struct Frame {
+    int64_t start   = 0;   // CPU starts (input sampled)
+    int64_t submit  = 0;
+    int64_t gpuEnd  = 0;
+    int64_t display = 0;
+};
+
+class Sim {
+public:
+    Sim(int64_t refresh, bool presentWait, uint32_t seed)
+        : refresh_(refresh), presentWait_(presentWait), rng_(seed) {
+        model.setPeriod(refresh);
+        model.setMargin(MARGIN);
+        model.setDisplayLocked(presentWait);
+        frames_.push_back({});                         // serial 0 = nothing
+    }
+
+    RTX::PacingModel model;
+
+    // One paced frame; cpuOverride replaces the sampled CPU time
+    void paced(const Load& load, int64_t cpuOverride = 0) {
+        const uint64_t n = frames_.size();
+        if (presentWait_) {
+            const uint64_t depth = model.queueDepth();
+            const uint64_t target = n > depth ? n - depth : 0;
+            if (target > observed_) {
+                now_ = std::max(now_, frames_[target].display);
+                model.observe(target, frames_[target].display);
+                observed_ = target;
+            }
+        }
+        now_ = std::max(now_, model.plan(n, now_));
+        run(load, cpuOverride, true);
+    }
+
+    // The loop without pacing: starts as soon as a swapchain image is free
+    void unpaced(const Load& load) {
+        const uint64_t n = frames_.size();
+        if (n > FRAMES_IN_FLIGHT) now_ = std::max(now_, frames_[n - FRAMES_IN_FLIGHT].display);
+        run(load, 0, false);
+    }
+
+    [[nodiscard]] const Frame& frame(uint64_t serial) const { return frames_[serial]; }
+    [[nodiscard]] uint64_t last() const { return frames_.size() - 1; }
+
+    [[nodiscard]] Tests::Percentiles latencyMs(uint64_t from, uint64_t to) const {
+        std::vector<double> v;
+        for (uint64_t s = from; s <= to; ++s) v.push_back(static_cast<double>(frames_[s].display - frames_[s].start) / MS);
+        return Tests::percentiles(v);
+    }
+
+    // Frames whose display did not follow the previous one by exactly `interval`
+    [[nodiscard]] uint32_t irregular(uint64_t from, uint64_t to, int64_t interval) const {
+        uint32_t n = 0;
+        for (uint64_t s = from + 1; s <= to; ++s)
+            if (frames_[s].display - frames_[s - 1].display != interval) ++n;
+        return n;
+    }
+
+private:
+    [[nodiscard]] int64_t sample(int64_t mean, int64_t jitter) {
+        if (jitter == 0) return mean;
+        std::normal_distribution<double> d(static_cast<double>(mean), static_cast<double>(jitter));
+        return std::max<int64_t>(MS / 10, static_cast<int64_t>(d(rng_)));
+    }
+
+    void run(const Load& load, int64_t cpuOverride, bool feed) {
+        Frame f;
+        f.start  = now_;
+        const int64_t cpu = cpuOverride ? cpuOverride : sample(load.cpu, load.cpuJitter);
+        const int64_t gpu = sample(load.gpu, load.gpuJitter);
+        f.submit = f.start + cpu;
+        f.gpuEnd = std::max(f.submit, gpuBusy_) + gpu;
+        gpuBusy_ = f.gpuEnd;
+        if (presentWait_) {
+            // FIFO: next vblank after the GPU is done, and never two frames on one vblank
+            f.display = (f.gpuEnd + refresh_ - 1) / refresh_ * refresh_;
+            if (frames_.size() > 1) f.display = std::max(f.display, frames_.back().display + refresh_);
+        } else {
+            f.display = f.gpuEnd;                      // immediate — completion is what we see
+        }
+        if (feed) {
+            model.cpuSample(cpu);
+            model.submitted(f.submit);
+            model.gpuSample(gpu);                      // GpuProfiler frame span
+            if (!presentWait_) model.observe(frames_.size(), f.gpuEnd);
+        }
+        frames_.push_back(f);
+        now_ = f.submit;                               // CPU free for the next frame
+    }
+
+    int64_t  refresh_;
+    bool     presentWait_;
+    std::mt19937 rng_;
+    std::vector<Frame> frames_;
+    int64_t  now_      = 1'000 * MS;
+    int64_t  gpuBusy_  = 0;
+    uint64_t observed_ = 0;
+};
+
+void steady() {
+    std::printf("  steady   60 Hz, CPU 3 ms, GPU 5 ms\n");
+    const Load load{3 * MS, MS / 4, 5 * MS, MS / 4};
+
+    Sim paced(P60, true, 1);
+    for (uint32_t i = 0; i < WARMUP + FRAMES; ++i) paced.paced(load);
+    Sim unpaced(P60, true, 1);
+    for (uint32_t i = 0; i < WARMUP + FRAMES; ++i) unpaced.unpaced(load);
+
+    const Tests::Percentiles p = paced.latencyMs(WARMUP, paced.last());
+    const Tests::Percentiles u = unpaced.latencyMs(WARMUP, unpaced.last());
+    const RTX::PacingModel::Stats s = paced.model.stats();
+    std::printf("    paced    latency p50 %5.2f  p99 %5.2f ms | budget %.2f ms | %llu late, %llu missed\n",
+                p.p50, p.p99, s.budgetMs, static_cast<unsigned long long>(s.late), static_cast<unsigned long long>(s.missed));
+    std::printf("    unpaced  latency p50 %5.2f  p99 %5.2f ms\n", u.p50, u.p99);
+
+    CHECK_EQ(paced.model.queueDepth(), 1u);
+    CHECK(paced.irregular(WARMUP, paced.last(), P60) <= FRAMES / 100);   // a new frame every vblank
+    CHECK(p.p99 * MS < P60);                                            // inside one refresh
+    CHECK(p.p99 <= s.budgetMs + 1.0);                                   // ≈ the predicted budget
+    CHECK(p.p50 * 2.0 < u.p50);                                         // well under the queued loop
+    CHECK(s.late <= s.frames / 100);
+}
+
+void overload() {
+    std::printf("  overload 60 Hz, CPU 9 ms, GPU 12 ms\n");
+    const Load load{9 * MS, MS / 4, 12 * MS, MS / 4};
+    Sim sim(P60, true, 2);
+    for (uint32_t i = 0; i < WARMUP + FRAMES; ++i) sim.paced(load);
+
+    const Tests::Percentiles p = sim.latencyMs(WARMUP, sim.last());
+    const double interval = static_cast<double>(sim.frame(sim.last()).display - sim.frame(WARMUP).display)
+                          / static_cast<double>(sim.last() - WARMUP);
+    std::printf("    latency p50 %5.2f  p99 %5.2f ms | display interval %.2f ms | queue %u\n",
+                p.p50, p.p99, interval / MS, sim.model.queueDepth());
+
+    CHECK_EQ(sim.model.queueDepth(), 2u);
+    CHECK(interval <= 1.02 * static_cast<double>(P60));               // rate holds, no halving
+    CHECK(p.p99 * MS < 3 * P60);                                       // under the unpaced queue
+}
+
+void spike() {
+    std::printf("  spike    60 Hz, CPU 3 ms, GPU 5 ms, one 40 ms CPU frame\n");
+    const Load load{3 * MS, MS / 4, 5 * MS, MS / 4};
+    constexpr uint32_t RECOVERY = 2;
+    Sim sim(P60, true, 3);
+    for (uint32_t i = 0; i < WARMUP; ++i) sim.paced(load);
+    const uint64_t missedBefore = sim.model.stats().missed;
+    sim.paced(load, 40 * MS);
+    const uint64_t spikeSerial = sim.last();
+    for (uint32_t i = 0; i < WARMUP; ++i) sim.paced(load);
+
+    const uint64_t settled = spikeSerial + RECOVERY;
+    const Tests::Percentiles p = sim.latencyMs(settled, sim.last());
+    std::printf("    missed +%llu | after %u frames: latency p99 %5.2f ms, %u irregular vblanks\n",
+                static_cast<unsigned long long>(sim.model.stats().missed - missedBefore), RECOVERY, p.p99,
+                sim.irregular(settled, sim.last(), P60));
+
+    CHECK(sim.model.stats().missed > missedBefore);
+    CHECK(sim.frame(spikeSerial + 1).display - sim.frame(spikeSerial).display == P60);   // whole vblanks only
+    CHECK(p.p99 <= sim.model.stats().budgetMs + 1.0);
+    CHECK_EQ(sim.irregular(settled, sim.last(), P60), 0u);
+}
+
+void step() {
+    std::printf("  step     60 Hz, CPU 3 → 9 ms, GPU 5 → 12 ms\n");
+    const Load light{3 * MS, MS / 4, 5 * MS, MS / 4};
+    const Load heavy{9 * MS, MS / 4, 12 * MS, MS / 4};
+    constexpr uint32_t SETTLE = 30;
+    Sim sim(P60, true, 5);
+    for (uint32_t i = 0; i < WARMUP; ++i) sim.paced(light);
+    uint32_t frames = 0;
+    while (sim.model.queueDepth() != 2 && frames < 4 * SETTLE) { sim.paced(heavy); ++frames; }
+    const uint64_t deep = sim.last();
+    for (uint32_t i = 0; i < WARMUP; ++i) sim.paced(heavy);
+
+    const uint64_t settled = deep + SETTLE;
+    const Tests::Percentiles p = sim.latencyMs(settled, sim.last());
+    std::printf("    queue depth 2 after %u frames | then latency p99 %5.2f ms, %u irregular vblanks\n",
+                frames, p.p99, sim.irregular(settled, sim.last(), P60));
+
+    CHECK(frames <= SETTLE);
+    CHECK(p.p99 * MS < 3 * P60);
+    CHECK(sim.irregular(settled, sim.last(), P60) <= WARMUP / 100);
+}
+
+void timer() {
+    std::printf("  timer    60 Hz target, no present_wait, CPU 3 ms, GPU 5 ms\n");
+    const Load load{3 * MS, MS / 4, 5 * MS, MS / 4};
+    Sim sim(P60, false, 4);
+    for (uint32_t i = 0; i < WARMUP + FRAMES; ++i) sim.paced(load);
+
+    const double interval = static_cast<double>(sim.frame(sim.last()).start - sim.frame(WARMUP).start)
+                          / static_cast<double>(sim.last() - WARMUP);
+    const RTX::PacingModel::Stats s = sim.model.stats();
+    std::printf("    start interval %.3f ms | deadline error avg %.3f  p99 %.3f ms | %llu late\n",
+                interval / MS, s.meanErrorMs, s.p99ErrorMs, static_cast<unsigned long long>(s.late));
+
+    CHECK(std::abs(interval - static_cast<double>(P60)) < 0.01 * static_cast<double>(P60));
+    CHECK(s.late <= s.frames / 100);
+    CHECK(s.p99ErrorMs < static_cast<double>(P60) / MS / 2);
+}
+
+} // namespace
+
+int main() {
+    std::printf("[test_pacing_model]\n");
+    steady();
+    overload();
+    spike();
+    step();
+    timer();
+    return Tests::finish("test_pacing_model");
+}
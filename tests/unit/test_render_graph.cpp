@@ -0,0 +1,360 @@
+// =============================================================================
+// test_render_graph.cpp — AMOURANTH RTX Engine © 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. Creative Commons Attribution-NonCommercial 4.0 International (CC BY-NC 4.0)
+//    https://creativecommons.org/licenses/by-nc/4.0/legalcode
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// RENDER GRAPH SOLVER ON THE HOST — declaration + compile() only, no device.
+// Images are fake handles and nothing is recorded; the checks are on the
+// barriers and layouts the solver derives:
+//   frame    the renderer's shape — ray trace → tonemap into the acquired
+//            swapchain image → present — then the same frame again, where
+//            imports start from where the last frame left them
+//   hazards  RAW made visible once per stage/access, WAR execution-only,
+//            WAW flushes the write
+//   cull     unread writes go; side effects and retained imports stay
+//   alias    disjoint transients of one usage share a slot, overlap or a
+//            different usage doesn't; a reused slot starts UNDEFINED and
+//            waits for the previous tenant
+//   queues   graphics → compute handoff: wait mask, layout-only barrier
+//   errors   two layouts in one pass, graphics after compute
+//   forget   a forgotten handle starts from its declared initial state again
+//   legacy   sync2 → legacy masks for the non-sync2 paths: shared bits kept,
+//            sync2-only bits mapped to their superset, unknown ones widened
+// =============================================================================
+
+#include "TestHarness.hpp"
+#include "engine/GLOBAL/RenderGraph.hpp"
+
+#include <cstdint>
+#include <string_view>
+
+namespace {
+
+using RTX::GraphBarrier;
+using RTX::GraphImage;
+using RTX::GraphQueue;
+using RTX::ImageUse;
+using RTX::RenderGraph;
+using RTX::TransientDesc;
+namespace Use = RTX::Use;
+
+constexpr VkPipelineStageFlags2 RT      = VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR;
+constexpr VkPipelineStageFlags2 COMPUTE = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+constexpr ImageUse RayTraceRead{ RT, VK_ACCESS_2_SHADER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL };
+
+constexpr TransientDesc STORAGE{ VK_FORMAT_R16G16B16A16_SFLOAT, { 64, 64 }, VK_IMAGE_USAGE_STORAGE_BIT };
+constexpr TransientDesc SAMPLED{ VK_FORMAT_R16G16B16A16_SFLOAT, { 64, 64 },
+                                 VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT };
+
+[[nodiscard]] VkImage fakeImage(uintptr_t n) { return reinterpret_cast<VkImage>(n << 8); }
+
+const auto noop = [](VkCommandBuffer) {};
+
+[[nodiscard]] bool same(const ImageUse& a, const ImageUse& b) {
+    return a.stage == b.stage && a.access == b.access && a.layout == b.layout;
+}
+
+// The one barrier on image before order index o (nullptr if none or several)
+[[nodiscard]] const GraphBarrier* barrierOn(const RenderGraph& g, uint32_t o, GraphImage image) {
+    const GraphBarrier* found = nullptr;
+    for (const GraphBarrier& b : g.barriers(o)) {
+        if (b.image != image) continue;
+        if (found) return nullptr;
+        found = &b;
+    }
+    return found;
+}
+
+// ── ray trace → tonemap → present, twice ────────────────────────────────────
+void declareFrame(RenderGraph& g, GraphImage& out, GraphImage& sc) {
+    g.reset();
+    out = g.importImage("rtOutput", fakeImage(1));
+    sc  = g.importAcquired("swapchain", fakeImage(2));
+    g.setFinal(sc, Use::Present);
+    g.addPass("rt", noop).use(out, Use::RayTraceWrite);
+    g.addPass("tonemap", noop).use(out, Use::ComputeSample).use(sc, Use::ComputeWrite);
+}
+
+int frame() {
+    std::printf("  frame\n");
+    RenderGraph g;
+    GraphImage out = 0, sc = 0;
+
+    declareFrame(g, out, sc);
+    REQUIRE(g.compile());
+    CHECK_EQ(g.order().size(), 2u);
+    CHECK_EQ(g.barriers(0).size(), 0u);                        // first write of a Created import
+    CHECK_EQ(g.barriers(1).size(), 2u);
+    if (const GraphBarrier* b = barrierOn(g, 1, out)) {        // RAW + GENERAL → SHADER_READ_ONLY
+        CHECK(same(b->src, { RT, VK_ACCESS_2_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_GENERAL }));
+        CHECK(same(b->dst, Use::ComputeSample));
+    } else CHECK(!"one barrier on rtOutput before tonemap");
+    if (const GraphBarrier* b = barrierOn(g, 1, sc)) {         // discard, chain onto the acquire wait
+        CHECK(same(b->src, { COMPUTE, VK_ACCESS_2_NONE, VK_IMAGE_LAYOUT_UNDEFINED }));
+        CHECK(same(b->dst, Use::ComputeWrite));
+    } else CHECK(!"one barrier on the swapchain image before tonemap");
+    CHECK_EQ(g.waitStage(sc), COMPUTE);
+    REQUIRE(g.finalBarriers().size() == 1u);
+    const GraphBarrier& present = g.finalBarriers()[0];
+    CHECK_EQ(present.image, sc);
+    CHECK(same(present.src, { COMPUTE, VK_ACCESS_2_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_GENERAL }));
+    CHECK(same(present.dst, Use::Present));
+
+    // Next frame: rtOutput was left SHADER_READ_ONLY by tonemap — WAR + transition back
+    declareFrame(g, out, sc);
+    REQUIRE(g.compile());
+    if (const GraphBarrier* b = barrierOn(g, 0, out)) {
+        CHECK(same(b->src, { COMPUTE, VK_ACCESS_2_NONE, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL }));
+        CHECK(same(b->dst, Use::RayTraceWrite));
+    } else CHECK(!"one barrier on rtOutput before rt in frame 2");
+    CHECK_EQ(g.barriers(1).size(), 2u);
+    CHECK_EQ(g.finalBarriers().size(), 1u);
+    return 0;
+}
+
+// ── RAW / WAR / WAW on one image in one layout ──────────────────────────────
+int hazards() {
+    std::printf("  hazards\n");
+    RenderGraph g;
+    const GraphImage x = g.importImage("x", fakeImage(3));
+    g.addPass("write", noop).use(x, Use::ComputeWrite);
+    g.addPass("read1", noop).use(x, Use::ComputeRead).sideEffects();
+    g.addPass("read2", noop).use(x, Use::ComputeRead).sideEffects();
+    g.addPass("readRT", noop).use(x, RayTraceRead).sideEffects();
+    g.addPass("rewrite", noop).use(x, Use::ComputeWrite);
+    g.addPass("rewrite2", noop).use(x, Use::ComputeWrite);
+    REQUIRE(g.compile());
+    REQUIRE(g.order().size() == 6u);
+
+    CHECK_EQ(g.barriers(0).size(), 0u);
+    const ImageUse lastWrite{ COMPUTE, VK_ACCESS_2_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_GENERAL };
+    if (const GraphBarrier* b = barrierOn(g, 1, x)) {          // RAW: make the write visible
+        CHECK(same(b->src, lastWrite));
+        CHECK(same(b->dst, Use::ComputeRead));
+    } else CHECK(!"RAW barrier before read1");
+    CHECK_EQ(g.barriers(2).size(), 0u);                        // already visible to compute reads
+    if (const GraphBarrier* b = barrierOn(g, 3, x)) {          // new stage: visible there too
+        CHECK(same(b->src, lastWrite));
+        CHECK(same(b->dst, RayTraceRead));
+    } else CHECK(!"RAW barrier before readRT");
+    if (const GraphBarrier* b = barrierOn(g, 4, x)) {          // WAR: wait for every reader, no flush
+        CHECK(same(b->src, { COMPUTE | RT, VK_ACCESS_2_NONE, VK_IMAGE_LAYOUT_GENERAL }));
+        CHECK(same(b->dst, Use::ComputeWrite));
+    } else CHECK(!"WAR barrier before rewrite");
+    if (const GraphBarrier* b = barrierOn(g, 5, x)) {          // WAW: flush the previous write
+        CHECK(same(b->src, lastWrite));
+        CHECK(same(b->dst, Use::ComputeWrite));
+    } else CHECK(!"WAW barrier before rewrite2");
+    CHECK_EQ(g.barrierCount(), 4u);
+    return 0;
+}
+
+// ── culling ─────────────────────────────────────────────────────────────────
+int cull() {
+    std::printf("  cull\n");
+    RenderGraph g;
+    const GraphImage scratch = g.createTransient("scratch", STORAGE);
+    const GraphImage out     = g.importImage("out", fakeImage(4));
+    const GraphImage tmp     = g.importImage("tmp", fakeImage(5), false);   // not retained, no final
+    g.addPass("dead", noop).use(scratch, Use::ComputeWrite);
+    g.addPass("fx", noop).use(out, Use::ComputeWrite);
+    g.addPass("debug", noop).sideEffects();
+    g.addPass("unread", noop).use(tmp, Use::ComputeWrite);
+    REQUIRE(g.compile());
+
+    REQUIRE(g.order().size() == 2u);
+    CHECK_EQ(g.order()[0], 1u);
+    CHECK_EQ(g.order()[1], 2u);
+    CHECK(std::string_view(g.passName(g.order()[0])) == "fx");
+    CHECK_EQ(g.aliasSlot(scratch), RTX::NO_ALIAS_SLOT);        // culled transient: no memory
+    CHECK_EQ(g.aliasSlots(), 0u);
+
+    // A read keeps the chain that produces it alive
+    g.reset();
+    const GraphImage t = g.createTransient("t", STORAGE);
+    const GraphImage o = g.importImage("out", fakeImage(4));
+    g.addPass("produce", noop).use(t, Use::ComputeWrite);
+    g.addPass("consume", noop).use(t, Use::ComputeRead).use(o, Use::ComputeWrite);
+    REQUIRE(g.compile());
+    CHECK_EQ(g.order().size(), 2u);
+    return 0;
+}
+
+// ── transient aliasing ──────────────────────────────────────────────────────
+int alias() {
+    std::printf("  alias\n");
+    RenderGraph g;
+    const GraphImage a   = g.createTransient("a", STORAGE);
+    const GraphImage b   = g.createTransient("b", STORAGE);
+    const GraphImage c   = g.createTransient("c", STORAGE);
+    const GraphImage d   = g.createTransient("d", SAMPLED);
+    const GraphImage out = g.importImage("out", fakeImage(6));
+    g.addPass("p0", noop).use(a, Use::ComputeWrite);
+    g.addPass("p1", noop).use(a, Use::ComputeRead).use(b, Use::ComputeWrite);
+    g.addPass("p2", noop).use(b, Use::ComputeRead).use(c, Use::ComputeWrite);
+    g.addPass("p3", noop).use(c, Use::ComputeRead).use(d, Use::ComputeWrite);
+    g.addPass("p4", noop).use(d, Use::ComputeRead).use(out, Use::ComputeWrite);
+    REQUIRE(g.compile());
+    REQUIRE(g.order().size() == 5u);
+
+    CHECK_EQ(g.aliasSlots(), 3u);
+    CHECK_EQ(g.aliasSlot(a), g.aliasSlot(c));                  // [0,1] and [2,3]
+    CHECK(g.aliasSlot(b) != g.aliasSlot(a));                   // [1,2] overlaps both
+    CHECK(g.aliasSlot(d) != g.aliasSlot(a) && g.aliasSlot(d) != g.aliasSlot(b));   // other usage
+
+    // c's first use: contents discarded, after a's last reader and write in the slot
+    if (const GraphBarrier* bc = barrierOn(g, 2, c)) {
+        CHECK_EQ(bc->src.layout, VK_IMAGE_LAYOUT_UNDEFINED);
+        CHECK_EQ(bc->src.stage, COMPUTE);
+        CHECK(same(bc->dst, Use::ComputeWrite));
+    } else CHECK(!"one barrier on c at its first use");
+    if (const GraphBarrier* ba = barrierOn(g, 0, a)) {         // fresh slot: nothing to wait for
+        CHECK(same(ba->src, { VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE, VK_IMAGE_LAYOUT_UNDEFINED }));
+    } else CHECK(!"one barrier on a at its first use");
+
+    // Next frame, same graph: slot 0 was last held by c, read in p3
+    g.reset();
+    const GraphImage a2 = g.createTransient("a", STORAGE);
+    const GraphImage o2 = g.importImage("out", fakeImage(6));
+    g.addPass("p0", noop).use(a2, Use::ComputeWrite);
+    g.addPass("p1", noop).use(a2, Use::ComputeRead).use(o2, Use::ComputeWrite);
+    REQUIRE(g.compile());
+    if (const GraphBarrier* ba = barrierOn(g, 0, a2)) {
+        CHECK_EQ(ba->src.layout, VK_IMAGE_LAYOUT_UNDEFINED);
+        CHECK_EQ(ba->src.stage, COMPUTE);
+    } else CHECK(!"one barrier on a at its first use in frame 2");
+    return 0;
+}
+
+// ── graphics → compute handoff ──────────────────────────────────────────────
+int queues() {
+    std::printf("  queues\n");
+    RenderGraph g;
+    const GraphImage x = g.importImage("x", fakeImage(7));
+    const GraphImage y = g.importImage("y", fakeImage(8));
+    const GraphImage z = g.importImage("z", fakeImage(9));
+    g.addPass("trace", noop, GraphQueue::Graphics).use(x, Use::RayTraceWrite).use(y, Use::RayTraceWrite);
+    g.addPass("post", noop, GraphQueue::Compute)
+        .use(x, Use::ComputeRead).use(y, Use::ComputeSample).use(z, Use::ComputeWrite);
+    REQUIRE(g.compile());
+
+    CHECK(g.usesQueue(GraphQueue::Graphics));
+    CHECK(g.usesQueue(GraphQueue::Compute));
+    CHECK_EQ(g.crossQueueWait(GraphQueue::Compute), COMPUTE);
+    CHECK_EQ(g.crossQueueWait(GraphQueue::Graphics), VK_PIPELINE_STAGE_2_NONE);
+    CHECK_EQ(barrierOn(g, 1, x), nullptr);                     // same layout: the semaphore is enough
+    if (const GraphBarrier* b = barrierOn(g, 1, y)) {          // layout change only, chained on the wait
+        CHECK(same(b->src, { COMPUTE, VK_ACCESS_2_NONE, VK_IMAGE_LAYOUT_GENERAL }));
+        CHECK(same(b->dst, Use::ComputeSample));
+        CHECK(b->queue == GraphQueue::Compute);
+    } else CHECK(!"one barrier on y before post");
+    return 0;
+}
+
+// ── declaration errors ──────────────────────────────────────────────────────
+int errors() {
+    std::printf("  errors (two logged errors expected)\n");
+    RenderGraph g;
+    const GraphImage x = g.importImage("x", fakeImage(10));
+    g.addPass("both", noop).use(x, Use::ComputeSample).use(x, Use::ComputeWrite);
+    CHECK(!g.compile());
+
+    g.reset();
+    const GraphImage y = g.importImage("y", fakeImage(11));
+    const GraphImage z = g.importImage("z", fakeImage(12));
+    g.addPass("async", noop, GraphQueue::Compute).use(y, Use::ComputeWrite);
+    g.addPass("late", noop, GraphQueue::Graphics).use(z, Use::RayTraceWrite);
+    CHECK(!g.compile());
+
+    // Stage and access of two uses in one layout merge into one
+    g.reset();
+    const GraphImage w = g.importImage("w", fakeImage(13));
+    g.addPass("write", noop).use(w, Use::ComputeWrite);
+    g.addPass("rw", noop).use(w, Use::ComputeRead).use(w, RayTraceRead).sideEffects();
+    REQUIRE(g.compile());
+    if (const GraphBarrier* b = barrierOn(g, 1, w)) CHECK_EQ(b->dst.stage, COMPUTE | RT);
+    else CHECK(!"one merged barrier on w");
+    return 0;
+}
+
+// ── forget ──────────────────────────────────────────────────────────────────
+int forget() {
+    std::printf("  forget\n");
+    RenderGraph g;
+    const auto declare = [&] {
+        g.reset();
+        const GraphImage x = g.importImage("lut", fakeImage(14));
+        g.addPass("sample", noop).use(x, Use::ComputeSample).sideEffects();
+        return x;
+    };
+
+    GraphImage x = declare();
+    REQUIRE(g.compile());
+    if (const GraphBarrier* b = barrierOn(g, 0, x)) CHECK_EQ(b->src.layout, VK_IMAGE_LAYOUT_GENERAL);
+    else CHECK(!"initial transition");
+
+    x = declare();
+    REQUIRE(g.compile());
+    CHECK_EQ(g.barrierCount(), 0u);                            // still SHADER_READ_ONLY, already visible
+
+    g.forget(fakeImage(14));
+    x = declare();
+    REQUIRE(g.compile());
+    if (const GraphBarrier* b = barrierOn(g, 0, x)) CHECK_EQ(b->src.layout, VK_IMAGE_LAYOUT_GENERAL);
+    else CHECK(!"transition again after forget()");
+    return 0;
+}
+
+// ── sync2 → legacy masks ────────────────────────────────────────────────────
+int legacy() {
+    std::printf("  legacy\n");
+    CHECK_EQ(RTX::legacyStages(VK_PIPELINE_STAGE_2_NONE), 0u);
+    CHECK_EQ(RTX::legacyStages(COMPUTE | RT),
+             static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR));
+    CHECK_EQ(RTX::legacyStages(VK_PIPELINE_STAGE_2_TRANSFER_BIT), static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_TRANSFER_BIT));
+    // Above bit 31 — a cast would drop these to 0
+    CHECK_EQ(RTX::legacyStages(VK_PIPELINE_STAGE_2_COPY_BIT | VK_PIPELINE_STAGE_2_CLEAR_BIT),
+             static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_TRANSFER_BIT));
+    CHECK_EQ(RTX::legacyStages(VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT),
+             static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT));
+    CHECK_EQ(RTX::legacyStages(VK_PIPELINE_STAGE_2_PRE_RASTERIZATION_SHADERS_BIT),
+             static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT));
+    // No legacy twin (video decode) — the whole wait widens
+    CHECK_EQ(RTX::legacyStages(COMPUTE | VK_PIPELINE_STAGE_2_VIDEO_DECODE_BIT_KHR),
+             static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT));
+
+    CHECK_EQ(RTX::legacyAccess(VK_ACCESS_2_NONE), 0u);
+    CHECK_EQ(RTX::legacyAccess(VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT),
+             static_cast<VkAccessFlags>(VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT));
+    CHECK_EQ(RTX::legacyAccess(VK_ACCESS_2_SHADER_SAMPLED_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT),
+             static_cast<VkAccessFlags>(VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT));
+    CHECK_EQ(RTX::legacyAccess(VK_ACCESS_2_VIDEO_DECODE_READ_BIT_KHR),
+             static_cast<VkAccessFlags>(VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT));
+
+    // Every stage and access the renderer's uses declare survives unchanged
+    for (const ImageUse& u : { Use::RayTraceWrite, Use::RayTraceReadWrite, Use::ComputeSample, Use::ComputeRead,
+                               Use::ComputeWrite, Use::ComputeReadWrite, Use::Clear }) {
+        CHECK_EQ(RTX::legacyStages(u.stage), static_cast<VkPipelineStageFlags>(u.stage));
+        CHECK_EQ(RTX::legacyAccess(u.access), static_cast<VkAccessFlags>(u.access));
+    }
+    return 0;
+}
+
+} // namespace
+
+int main() {
+    std::printf("[test_render_graph]\n");
+    frame();
+    hazards();
+    cull();
+    alias();
+    queues();
+    errors();
+    forget();
+    legacy();
+    return Tests::finish("test_render_graph");
+}
@@ -0,0 +1,134 @@
+// =============================================================================
+// test_scratch_plan.cpp — AMOURANTH RTX Engine © 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. Creative Commons Attribution-NonCommercial 4.0 International (CC BY-NC 4.0)
+//    https://creativecommons.org/licenses/by-nc/4.0/legalcode
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// SCRATCH PLAN ON THE HOST — ScratchPlan::pack, no device:
+//   basic     one batch under budget, aligned offsets, arena = the batch
+//   split     a build that doesn't fit starts the next batch at offset 0
+//   oversize  a build bigger than the budget gets a batch of its own
+//   edges     empty input, alignment 0 = 1, exact fit stays in the batch
+//   scene     1000 random sizes: every batch fits, nothing inside a batch
+//             overlaps, the arena covers every build
+// =============================================================================
+
+#include "TestHarness.hpp"
+#include "engine/GLOBAL/AccelBatch.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr VkDeviceSize ALIGN = 128;
+
+[[nodiscard]] VkDeviceSize aligned(VkDeviceSize v, VkDeviceSize a) { return (v + a - 1) & ~(a - 1); }
+
+int basic() {
+    const std::vector<VkDeviceSize> sizes = { 100, 256, 1 };
+    const ScratchPlan plan = ScratchPlan::pack(sizes, ALIGN, 4096);
+    REQUIRE(plan.offsets.size() == 3);
+    CHECK_EQ(plan.batchCount(), 1u);
+    CHECK_EQ(plan.batchEnd(0), 3u);
+    CHECK_EQ(plan.offsets[0], 0u);
+    CHECK_EQ(plan.offsets[1], 128u);
+    CHECK_EQ(plan.offsets[2], 384u);
+    CHECK_EQ(plan.arenaSize, 512u);
+    return 0;
+}
+
+int split() {
+    const std::vector<VkDeviceSize> sizes = { 300, 300, 300, 300, 300 };   // 384 each aligned
+    const ScratchPlan plan = ScratchPlan::pack(sizes, ALIGN, 1000);
+    REQUIRE(plan.batchCount() == 3);
+    CHECK_EQ(plan.batchStart[0], 0u);
+    CHECK_EQ(plan.batchStart[1], 2u);
+    CHECK_EQ(plan.batchStart[2], 4u);
+    CHECK_EQ(plan.batchEnd(2), 5u);
+    CHECK_EQ(plan.offsets[2], 0u);          // each batch reuses the arena from its base
+    CHECK_EQ(plan.offsets[3], 384u);
+    CHECK_EQ(plan.offsets[4], 0u);
+    CHECK_EQ(plan.arenaSize, 768u);         // the largest batch, not the sum
+    return 0;
+}
+
+int oversize() {
+    const std::vector<VkDeviceSize> sizes = { 100, 5000, 100 };
+    const ScratchPlan plan = ScratchPlan::pack(sizes, ALIGN, 1024);
+    REQUIRE(plan.batchCount() == 3);
+    CHECK_EQ(plan.batchStart[1], 1u);
+    CHECK_EQ(plan.batchEnd(1), 2u);
+    CHECK_EQ(plan.offsets[1], 0u);
+    CHECK_EQ(plan.arenaSize, aligned(5000, ALIGN));   // over budget, but it has to build
+    return 0;
+}
+
+int edges() {
+    const ScratchPlan none = ScratchPlan::pack({}, ALIGN, 1024);
+    CHECK_EQ(none.batchCount(), 0u);
+    CHECK_EQ(none.arenaSize, 0u);
+
+    const std::vector<VkDeviceSize> odd = { 3, 5 };
+    const ScratchPlan unaligned = ScratchPlan::pack(odd, 0, 1024);
+    REQUIRE(unaligned.offsets.size() == 2);
+    CHECK_EQ(unaligned.offsets[1], 3u);
+    CHECK_EQ(unaligned.arenaSize, 8u);
+
+    const std::vector<VkDeviceSize> exact = { 512, 512 };
+    const ScratchPlan fit = ScratchPlan::pack(exact, ALIGN, 1024);
+    CHECK_EQ(fit.batchCount(), 1u);
+    CHECK_EQ(fit.arenaSize, 1024u);
+    return 0;
+}
+
+int scene() {
+    constexpr VkDeviceSize BUDGET = 1u << 20;
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<VkDeviceSize> small(1, 64 << 10), large(1, 3u << 20);
+    std::vector<VkDeviceSize> sizes(1000);
+    for (size_t i = 0; i < sizes.size(); ++i) sizes[i] = (i % 97 == 0) ? large(rng) : small(rng);
+
+    const ScratchPlan plan = ScratchPlan::pack(sizes, 256, BUDGET);
+    REQUIRE(plan.offsets.size() == sizes.size());
+    REQUIRE(plan.batchCount() > 1);
+    CHECK_EQ(plan.batchStart[0], 0u);
+
+    VkDeviceSize largest = 0;
+    for (uint32_t b = 0; b < plan.batchCount(); ++b) {
+        const uint32_t first = plan.batchStart[b], end = plan.batchEnd(b);
+        REQUIRE(first < end);
+        CHECK_EQ(plan.offsets[first], 0u);
+        VkDeviceSize cursor = 0;
+        for (uint32_t i = first; i < end; ++i) {
+            CHECK_EQ(plan.offsets[i] % 256, 0u);
+            CHECK(plan.offsets[i] >= cursor);                       // no overlap with the build before
+            cursor = plan.offsets[i] + aligned(sizes[i], 256);
+            CHECK(cursor <= plan.arenaSize);
+        }
+        CHECK(cursor <= BUDGET || end - first == 1);                // only a lone oversize build exceeds it
+        // Greedy: the next batch's first build would not have fit in this one
+        if (b + 1 < plan.batchCount()) CHECK(cursor + aligned(sizes[end], 256) > BUDGET);
+        largest = std::max(largest, cursor);
+    }
+    CHECK_EQ(plan.arenaSize, largest);
+    std::printf("  scene: %zu builds → %u batches, arena %llu bytes\n", sizes.size(), plan.batchCount(),
+                static_cast<unsigned long long>(plan.arenaSize));
+    return 0;
+}
+
+} // namespace
+
+int main() {
+    std::printf("[test_scratch_plan]\n");
+    basic();
+    split();
+    oversize();
+    edges();
+    scene();
+    return Tests::finish("test_scratch_plan");
+}
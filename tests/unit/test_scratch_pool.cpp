@@ -0,0 +1,110 @@
+// =============================================================================
+// test_scratch_pool.cpp — AMOURANTH RTX Engine © 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. Creative Commons Attribution-NonCommercial 4.0 International (CC BY-NC 4.0)
+//    https://creativecommons.org/licenses/by-nc/4.0/legalcode
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// SCRATCH POOL ON THE HOST — ScratchSizing, the policy behind LAS's
+// ScratchPool, no device:
+//   grow      first request allocates, capacity rounded to the alignment,
+//             smaller requests reuse it, a larger one grows to it, never shrinks
+//   steady    1000 frames of TLAS rebuilds + refits: one allocation, then none
+//   idle      released exactly at the idle limit, a request restarts the count,
+//             nothing to release while nothing is held
+//   restart   after a release the high-water mark starts over
+// =============================================================================
+
+#include "TestHarness.hpp"
+#include "engine/GLOBAL/AccelBatch.hpp"
+
+namespace {
+
+constexpr VkDeviceSize ALIGN = 128;
+
+int grow() {
+    ScratchSizing s;
+    s.setAlignment(ALIGN);
+    CHECK(!s.held());
+    CHECK(s.request(1000));                   // nothing held yet
+    CHECK(s.held());
+    CHECK_EQ(s.capacity(), 1024u);
+    CHECK_EQ(s.grows(), 1u);
+
+    CHECK(!s.request(1024));                  // fits the rounding
+    CHECK(!s.request(10));
+    CHECK_EQ(s.capacity(), 1024u);
+    CHECK_EQ(s.highWater(), 1024u);
+
+    CHECK(s.request(1025));
+    CHECK_EQ(s.capacity(), 1152u);
+    CHECK_EQ(s.grows(), 2u);
+    CHECK(!s.request(1));                     // grow-only
+    CHECK_EQ(s.capacity(), 1152u);
+
+    ScratchSizing odd;
+    odd.setAlignment(0);                      // 0 = 1
+    CHECK(odd.request(7));
+    CHECK_EQ(odd.capacity(), 7u);
+    return 0;
+}
+
+int steady() {
+    ScratchSizing s;
+    s.setAlignment(256);
+    uint32_t allocations = 0;
+    for (uint32_t frame = 0; frame < 1000; ++frame) {
+        allocations += s.request(frame % 60 == 0 ? 300000 : 200000);   // periodic TLAS rebuild
+        allocations += s.request(40000);                               // refit
+        CHECK(!s.tick(600));
+    }
+    CHECK_EQ(allocations, 1u);
+    CHECK_EQ(s.grows(), 1u);
+    CHECK_EQ(s.capacity(), 300032u);
+    return 0;
+}
+
+int idle() {
+    ScratchSizing s;
+    CHECK(!s.tick(1));                        // nothing held — nothing to release
+    CHECK_EQ(s.idle(), 0u);
+
+    (void)s.request(4096);
+    for (uint32_t i = 1; i < 10; ++i) CHECK(!s.tick(10));
+    (void)s.request(64);                      // used — the count starts over
+    CHECK_EQ(s.idle(), 0u);
+    for (uint32_t i = 1; i < 10; ++i) CHECK(!s.tick(10));
+    CHECK(s.tick(10));                        // the tenth idle frame
+    s.released();
+    CHECK(!s.held());
+    CHECK_EQ(s.capacity(), 0u);
+    CHECK(!s.tick(10));
+    return 0;
+}
+
+int restart() {
+    ScratchSizing s;
+    s.setAlignment(ALIGN);
+    (void)s.request(1 << 20);                 // scene load
+    (void)s.request(500);
+    s.released();
+
+    CHECK_EQ(s.highWater(), 0u);
+    CHECK(s.request(500));                    // sized to what is asked for now, not the load
+    CHECK_EQ(s.capacity(), 512u);
+    CHECK_EQ(s.grows(), 2u);
+    return 0;
+}
+
+} // namespace
+
+int main() {
+    std::printf("[test_scratch_pool]\n");
+    grow();
+    steady();
+    idle();
+    restart();
+    return Tests::finish("test_scratch_pool");
+}
@@ -0,0 +1,149 @@
+// =============================================================================
+// test_tlas_instances.cpp — AMOURANTH RTX Engine © 2025 by Zachary Geurts <gzac5314@gmail.com>
+// =============================================================================
+//
+// Dual Licensed:
+// 1. Creative Commons Attribution-NonCommercial 4.0 International (CC BY-NC 4.0)
+//    https://creativecommons.org/licenses/by-nc/4.0/legalcode
+// 2. Commercial licensing: gzac5314@gmail.com
+//
+// TLAS INSTANCES ON THE HOST — InstanceList.hpp, no device:
+//   transform  glm's column-major mat4 → row-major 3x4: element (row r,
+//              column c) lands in matrix[r][c], translation in column 3,
+//              the bottom row dropped — a transposed copy fails here
+//   instance   custom index and SBT offset clipped to 24 bits, mask, flags,
+//              BLAS reference
+//   dirty      per-region stale tracking: a new instance is stale everywhere,
+//              flush() hands back coalesced runs once, unchanged writes dirty
+//              nothing, one region flushing leaves the others stale
+//   lifetime   invalidate() marks everything, clear() empties, region count
+//              clamped to [1, MAX_REGIONS]
+// =============================================================================
+
+#include "TestHarness.hpp"
+#include "engine/GLOBAL/InstanceList.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Runs = std::vector<std::pair<uint32_t, uint32_t>>;
+
+[[nodiscard]] Runs flush(InstanceList& list, uint32_t region) {
+    Runs runs;
+    list.flush(region, [&](uint32_t first, uint32_t count) { runs.emplace_back(first, count); });
+    return runs;
+}
+
+[[nodiscard]] VkAccelerationStructureInstanceKHR at(float x) {
+    glm::mat4 m(1.0f);
+    m[3][0] = x;
+    return makeInstance({ .transform = m }, 0x1000);
+}
+
+int transform() {
+    const VkTransformMatrixKHR id = toTransform(glm::mat4(1.0f));
+    for (int r = 0; r < 3; ++r)
+        for (int c = 0; c < 4; ++c) CHECK_EQ(id.matrix[r][c], r == c ? 1.0f : 0.0f);
+
+    // m[c][r] = 10c + r — every element distinct, so a transpose can't pass
+    glm::mat4 m(0.0f);
+    for (int c = 0; c < 4; ++c)
+        for (int r = 0; r < 4; ++r) m[c][r] = static_cast<float>(10 * c + r);
+    const VkTransformMatrixKHR t = toTransform(m);
+    for (int r = 0; r < 3; ++r)
+        for (int c = 0; c < 4; ++c) CHECK_EQ(t.matrix[r][c], static_cast<float>(10 * c + r));
+
+    glm::mat4 moved(1.0f);
+    moved[3][0] = 5.0f; moved[3][1] = -2.0f; moved[3][2] = 7.5f;   // glm::translate's layout
+    const VkTransformMatrixKHR tr = toTransform(moved);
+    CHECK_EQ(tr.matrix[0][3], 5.0f);
+    CHECK_EQ(tr.matrix[1][3], -2.0f);
+    CHECK_EQ(tr.matrix[2][3], 7.5f);
+    CHECK_EQ(tr.matrix[0][0], 1.0f);
+    return 0;
+}
+
+int instance() {
+    const VkAccelerationStructureInstanceKHR inst = makeInstance({
+        .customIndex = 0x12345678u, .mask = 0x0F, .sbtOffset = 0xABCDEF01u,
+        .flags = VK_GEOMETRY_INSTANCE_FORCE_OPAQUE_BIT_KHR }, 0xDEAD0000ull);
+    CHECK_EQ(inst.instanceCustomIndex, 0x345678u);
+    CHECK_EQ(inst.mask, 0x0Fu);
+    CHECK_EQ(inst.instanceShaderBindingTableRecordOffset, 0xCDEF01u);
+    CHECK_EQ(inst.flags, static_cast<VkGeometryInstanceFlagsKHR>(VK_GEOMETRY_INSTANCE_FORCE_OPAQUE_BIT_KHR));
+    CHECK_EQ(inst.accelerationStructureReference, 0xDEAD0000ull);
+    return 0;
+}
+
+int dirty() {
+    InstanceList list;
+    list.setRegions(3);
+    for (int i = 0; i < 4; ++i) list.add(at(static_cast<float>(i)));
+    for (uint32_t r = 0; r < 3; ++r) CHECK_EQ(list.staleCount(r), 4u);
+
+    CHECK((flush(list, 0) == Runs{ { 0, 4 } }));
+    CHECK_EQ(list.staleCount(0), 0u);
+    CHECK_EQ(list.staleCount(1), 4u);          // the other regions haven't seen any of it
+    CHECK(flush(list, 0).empty());             // current — nothing to write twice
+
+    // Unchanged values dirty nothing
+    CHECK(!list.set(2, list[2]));
+    CHECK(!list.setTransform(2, list[2].transform));
+    CHECK_EQ(list.staleCount(0), 0u);
+
+    // Separate edits → separate runs; neighbours coalesce
+    CHECK(list.setTransform(1, toTransform(glm::mat4(2.0f))));
+    CHECK(list.set(3, at(30.0f)));
+    CHECK_EQ(list.staleCount(0), 2u);
+    CHECK_EQ(list.staleCount(1), 4u);          // already stale there — not counted twice
+    CHECK((flush(list, 0) == Runs{ { 1, 1 }, { 3, 1 } }));
+    CHECK(list.setTransform(2, toTransform(glm::mat4(3.0f))));
+    CHECK(list.setTransform(1, toTransform(glm::mat4(4.0f))));
+    CHECK((flush(list, 0) == Runs{ { 1, 2 } }));
+
+    // Region 1 catches up with everything at once; region 2 still waits
+    CHECK((flush(list, 1) == Runs{ { 0, 4 } }));
+    CHECK_EQ(list.staleCount(2), 4u);
+    CHECK_EQ(list[3].transform.matrix[0][3], 30.0f);
+    return 0;
+}
+
+int lifetime() {
+    InstanceList list;
+    list.setRegions(2);
+    for (int i = 0; i < 5; ++i) list.add(at(static_cast<float>(i)));
+    (void)flush(list, 0);
+    (void)flush(list, 1);
+
+    list.invalidate();                         // ring reallocated — every region starts empty
+    CHECK_EQ(list.staleCount(0), 5u);
+    CHECK_EQ(list.staleCount(1), 5u);
+    CHECK((flush(list, 1) == Runs{ { 0, 5 } }));
+
+    list.clear();
+    CHECK_EQ(list.size(), 0u);
+    CHECK_EQ(list.staleCount(0), 0u);
+    CHECK(flush(list, 0).empty());
+    list.add(at(1.0f));
+    CHECK((flush(list, 0) == Runs{ { 0, 1 } }));
+
+    list.setRegions(0);
+    CHECK_EQ(list.regions(), 1u);
+    list.setRegions(InstanceList::MAX_REGIONS + 4);
+    CHECK_EQ(list.regions(), InstanceList::MAX_REGIONS);
+    CHECK_EQ(list.staleCount(InstanceList::MAX_REGIONS - 1), 1u);   // setRegions invalidates
+    return 0;
+}
+
+} // namespace
+
+int main() {
+    std::printf("[test_tlas_instances]\n");
+    transform();
+    instance();
+    dirty();
+    lifetime();
+    return Tests::finish("test_tlas_instances");
+}